@@ -0,0 +1,215 @@
+/**
+ * @file bench.c
+ * @brief This file contains the implementation of the microbenchmark harness.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "bench.h"
+
+#include <platform/platform.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** @brief The most operations a calibrated sample may run. Bounds calibration of no-op cases. */
+#define BENCH_MAX_ITERATIONS_PER_SAMPLE (1ULL << 30)
+
+void bench_suite_add(bench_suite* suite, bench_case bench) {
+    if (suite->count == BENCH_MAX_CASES) {
+        fprintf(stderr, "bench_suite_add - suite is full, dropping %s/%s.\n", bench.group, bench.name);
+        return;
+    }
+    suite->cases[suite->count++] = bench;
+}
+
+void bench_suite_add_check(bench_suite* suite, bench_check check) {
+    if (suite->check_count == BENCH_MAX_CHECKS) {
+        fprintf(stderr, "bench_suite_add_check - suite is full, dropping %s/%s.\n", check.group, check.name);
+        return;
+    }
+    suite->checks[suite->check_count++] = check;
+}
+
+/**
+ * @brief Checks if "group/name" contains the configured filter text.
+ */
+static b8 bench_name_matches(const bench_config* config, const char* group, const char* name) {
+    if (!config->filter) {
+        return TRUE;
+    }
+
+    char full_name[256];
+    snprintf(full_name, sizeof(full_name), "%s/%s", group, name);
+    return strstr(full_name, config->filter) != 0;
+}
+
+b8 bench_matches(const bench_config* config, const bench_case* bench) {
+    return bench_name_matches(config, bench->group, bench->name);
+}
+
+/**
+ * @brief Times a single sample.
+ * @return The duration of the sample in seconds.
+ */
+static f64 bench_time_sample(const bench_case* bench, void* user_data, u64 iterations) {
+    f64 start = platform_get_absolute_time();
+    bench->run(user_data, iterations);
+    return platform_get_absolute_time() - start;
+}
+
+/**
+ * @brief Finds the number of operations one sample needs to last at least `min_seconds`.
+ */
+static u64 bench_calibrate(const bench_case* bench, void* user_data, f64 min_seconds) {
+    u64 iterations = 1;
+    while (iterations < BENCH_MAX_ITERATIONS_PER_SAMPLE) {
+        f64 elapsed = bench_time_sample(bench, user_data, iterations);
+        if (elapsed >= min_seconds) {
+            break;
+        }
+
+        // Jump close to the target when the sample is long enough to extrapolate from, otherwise double.
+        u64 next = elapsed > min_seconds / 100 ? (u64)((f64)iterations * min_seconds / elapsed * 1.1) : iterations * 2;
+        iterations = next > iterations ? next : iterations * 2;
+    }
+    return iterations;
+}
+
+/** @brief Orders samples for qsort. */
+static int bench_compare_f64(const void* a, const void* b) {
+    f64 x = *(const f64*)a;
+    f64 y = *(const f64*)b;
+    return (x > y) - (x < y);
+}
+
+/** @brief Gets a percentile of sorted samples, using the nearest-rank method. */
+static f64 bench_percentile(const f64* sorted, u32 count, f64 percentile) {
+    u32 rank = (u32)(percentile / 100.0 * (f64)count + 0.5);
+    rank = rank == 0 ? 1 : (rank > count ? count : rank);
+    return sorted[rank - 1];
+}
+
+b8 bench_run(const bench_config* config, const bench_case* bench, bench_result* out_result) {
+    if (!bench->run) {
+        fprintf(stderr, "bench_run - %s/%s has no run function.\n", bench->group, bench->name);
+        return FALSE;
+    }
+
+    u32 sample_count = config->samples;
+    if (sample_count == 0 || sample_count > BENCH_MAX_SAMPLES) {
+        sample_count = BENCH_MAX_SAMPLES;
+    }
+
+    void* user_data = bench->setup ? bench->setup(bench->param) : 0;
+
+    u64 iterations = bench->iterations_per_sample;
+    if (iterations == 0) {
+        iterations = bench_calibrate(bench, user_data, config->min_sample_seconds);
+    }
+
+    for (u32 i = 0; i < config->warmup_samples; ++i) {
+        bench_time_sample(bench, user_data, iterations);
+    }
+
+    static f64 samples[BENCH_MAX_SAMPLES];
+    f64 total = 0;
+    for (u32 i = 0; i < sample_count; ++i) {
+        samples[i] = bench_time_sample(bench, user_data, iterations) * 1e9 / (f64)iterations;
+        total += samples[i];
+    }
+
+    if (bench->teardown) {
+        bench->teardown(user_data);
+    }
+
+    qsort(samples, sample_count, sizeof(f64), bench_compare_f64);
+
+    out_result->source = bench;
+    out_result->samples = sample_count;
+    out_result->iterations_per_sample = iterations;
+    out_result->min_ns = samples[0];
+    out_result->p50_ns = bench_percentile(samples, sample_count, 50);
+    out_result->p90_ns = bench_percentile(samples, sample_count, 90);
+    out_result->p99_ns = bench_percentile(samples, sample_count, 99);
+    out_result->max_ns = samples[sample_count - 1];
+    out_result->mean_ns = total / (f64)sample_count;
+    out_result->ops_per_second = out_result->p50_ns > 0 ? 1e9 / out_result->p50_ns : 0;
+    return TRUE;
+}
+
+b8 bench_run_checks(const bench_config* config, const bench_suite* suite) {
+    u32 run = 0;
+    u32 failed = 0;
+    for (u32 i = 0; i < suite->check_count; ++i) {
+        const bench_check* check = &suite->checks[i];
+        if (!bench_name_matches(config, check->group, check->name)) {
+            continue;
+        }
+        b8 passed = check->check();
+        printf("%-4s %s/%s\n", passed ? "PASS" : "FAIL", check->group, check->name);
+        fflush(stdout);
+        run++;
+        failed += passed ? 0 : 1;
+    }
+    printf("%u of %u checks passed.\n", run - failed, run);
+    return failed == 0;
+}
+
+void bench_check_failed(const char* file, u32 line, const char* condition) {
+    fprintf(stderr, "%s:%u: check failed: %s\n", file, line, condition);
+}
+
+void bench_print_header() {
+    printf("%-44s %12s %12s %12s %12s %12s %14s\n", "benchmark", "min ns", "p50 ns", "p90 ns", "p99 ns", "max ns", "ops/s");
+}
+
+void bench_print_result(const bench_result* result) {
+    char full_name[128];
+    snprintf(full_name, sizeof(full_name), "%s/%s/%llu", result->source->group, result->source->name, result->source->param);
+    printf("%-44s %12.1f %12.1f %12.1f %12.1f %12.1f %14.0f\n", full_name, result->min_ns, result->p50_ns, result->p90_ns,
+           result->p99_ns, result->max_ns, result->ops_per_second);
+}
+
+b8 bench_write_csv(const char* path, const bench_result* results, u32 count) {
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        fprintf(stderr, "bench_write_csv - unable to open '%s'.\n", path);
+        return FALSE;
+    }
+
+    fprintf(file, "group,name,param,samples,iterations_per_sample,min_ns,p50_ns,p90_ns,p99_ns,max_ns,mean_ns,ops_per_second\n");
+    for (u32 i = 0; i < count; ++i) {
+        const bench_result* r = &results[i];
+        fprintf(file, "%s,%s,%llu,%u,%llu,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.1f\n", r->source->group, r->source->name,
+                r->source->param, r->samples, r->iterations_per_sample, r->min_ns, r->p50_ns, r->p90_ns, r->p99_ns,
+                r->max_ns, r->mean_ns, r->ops_per_second);
+    }
+
+    fclose(file);
+    return TRUE;
+}
+
+b8 bench_write_json(const char* path, const bench_result* results, u32 count) {
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        fprintf(stderr, "bench_write_json - unable to open '%s'.\n", path);
+        return FALSE;
+    }
+
+    // Names are plain identifiers, so they need no escaping.
+    fprintf(file, "[\n");
+    for (u32 i = 0; i < count; ++i) {
+        const bench_result* r = &results[i];
+        fprintf(file,
+                "  {\"group\": \"%s\", \"name\": \"%s\", \"param\": %llu, \"samples\": %u, \"iterations_per_sample\": %llu, "
+                "\"min_ns\": %.3f, \"p50_ns\": %.3f, \"p90_ns\": %.3f, \"p99_ns\": %.3f, \"max_ns\": %.3f, \"mean_ns\": %.3f, "
+                "\"ops_per_second\": %.1f}%s\n",
+                r->source->group, r->source->name, r->source->param, r->samples, r->iterations_per_sample, r->min_ns,
+                r->p50_ns, r->p90_ns, r->p99_ns, r->max_ns, r->mean_ns, r->ops_per_second, i + 1 < count ? "," : "");
+    }
+    fprintf(file, "]\n");
+
+    fclose(file);
+    return TRUE;
+}
@@ -0,0 +1,303 @@
+#pragma once
+
+/**
+ * @file bench.h
+ * @brief This file contains the microbenchmark harness.
+ *
+ * @details A benchmark case is a function that runs the measured operation a given number of
+ * times. The harness first calibrates how many operations one sample needs to be long enough
+ * to time reliably with platform_get_absolute_time, runs a number of unrecorded warmup samples,
+ * then records the time per operation of every sample and reports its percentiles. Results are
+ * printed as a table and can be written out as CSV or JSON, so runs can be compared over time.
+ *
+ * Besides the timed cases, a suite holds checks: untimed functions that exercise a primitive's
+ * edge cases and verify its results with BENCH_CHECK, so the bench also catches regressions in
+ * the behaviour it measures.
+ * @copyright Copyright (c) 2025
+ */
+
+#include <defines.h>
+
+/** @brief The maximum number of cases a suite can hold. */
+#define BENCH_MAX_CASES 128
+
+/** @brief The maximum number of checks a suite can hold. */
+#define BENCH_MAX_CHECKS 64
+
+/** @brief The maximum number of samples recorded per case. */
+#define BENCH_MAX_SAMPLES 1024
+
+/**
+ * @brief Runs the measured operation `iterations` times.
+ * @param user_data The case's user data, as returned by its setup function.
+ * @param iterations The number of operations to run.
+ */
+typedef void (*PFN_bench_run)(void* user_data, u64 iterations);
+
+/**
+ * @brief Prepares the state a case runs on. Not timed.
+ * @param param The case's parameter, as given when it was added.
+ * @return The user data passed to the run and teardown functions.
+ */
+typedef void* (*PFN_bench_setup)(u64 param);
+
+/**
+ * @brief Releases the state created by the setup function. Not timed.
+ * @param user_data The case's user data.
+ */
+typedef void (*PFN_bench_teardown)(void* user_data);
+
+/**
+ * @struct bench_case
+ * @brief A single benchmark.
+ */
+typedef struct bench_case {
+    /** @brief The group the case belongs to, e.g. "memory". */
+    const char* group;
+
+    /** @brief The name of the case within its group. */
+    const char* name;
+
+    /** @brief A parameter passed to setup, e.g. a block size. Also reported with the results. */
+    u64 param;
+
+    /**
+     * @brief The number of operations per sample. 0 calibrates it automatically. 1 measures
+     * the latency of single operations (including the timer's own overhead).
+     */
+    u64 iterations_per_sample;
+
+    /** @brief An optional function preparing the case's state. */
+    PFN_bench_setup setup;
+
+    /** @brief The measured function. */
+    PFN_bench_run run;
+
+    /** @brief An optional function releasing the case's state. */
+    PFN_bench_teardown teardown;
+} bench_case;
+
+/**
+ * @brief Exercises a primitive and verifies the results.
+ * @return `b8 TRUE` if every verified condition held, otherwise `b8 FALSE`.
+ */
+typedef b8 (*PFN_bench_check)();
+
+/**
+ * @struct bench_check
+ * @brief A single check.
+ */
+typedef struct bench_check {
+    /** @brief The group the check belongs to, e.g. "ring_queue". */
+    const char* group;
+
+    /** @brief The name of the check within its group. */
+    const char* name;
+
+    /** @brief The checking function. */
+    PFN_bench_check check;
+} bench_check;
+
+/**
+ * @struct bench_result
+ * @brief The measurements of a single case. Times are nanoseconds per operation.
+ */
+typedef struct bench_result {
+    /** @brief The case that was measured. */
+    const bench_case* source;
+
+    /** @brief The number of recorded samples. */
+    u32 samples;
+
+    /** @brief The number of operations per sample. */
+    u64 iterations_per_sample;
+
+    /** @brief The fastest sample. */
+    f64 min_ns;
+
+    /** @brief The median sample. */
+    f64 p50_ns;
+
+    /** @brief The 90th percentile sample. */
+    f64 p90_ns;
+
+    /** @brief The 99th percentile sample. */
+    f64 p99_ns;
+
+    /** @brief The slowest sample. */
+    f64 max_ns;
+
+    /** @brief The mean over all samples. */
+    f64 mean_ns;
+
+    /** @brief The throughput at the median: operations per second. */
+    f64 ops_per_second;
+} bench_result;
+
+/**
+ * @struct bench_config
+ * @brief Controls how every case is run.
+ */
+typedef struct bench_config {
+    /** @brief The number of unrecorded samples run before measuring. */
+    u32 warmup_samples;
+
+    /** @brief The number of recorded samples. At most BENCH_MAX_SAMPLES. */
+    u32 samples;
+
+    /** @brief The duration a calibrated sample should last at least, in seconds. */
+    f64 min_sample_seconds;
+
+    /** @brief If not 0, only cases whose "group/name" contains this text are run. */
+    const char* filter;
+} bench_config;
+
+/**
+ * @struct bench_suite
+ * @brief The set of registered cases.
+ */
+typedef struct bench_suite {
+    /** @brief The number of registered cases. */
+    u32 count;
+
+    /** @brief The registered cases. */
+    bench_case cases[BENCH_MAX_CASES];
+
+    /** @brief The number of registered checks. */
+    u32 check_count;
+
+    /** @brief The registered checks. */
+    bench_check checks[BENCH_MAX_CHECKS];
+} bench_suite;
+
+/**
+ * @brief Fails the calling check if `condition` does not hold, reporting the condition and its location.
+ * @note Returns from the calling function, so only use it where nothing is left to release.
+ */
+#define BENCH_CHECK(condition)                                  \
+    do {                                                        \
+        if (!(condition)) {                                     \
+            bench_check_failed(__FILE__, __LINE__, #condition); \
+            return FALSE;                                       \
+        }                                                       \
+    } while (0)
+
+
+/**
+ * @brief Adds a case to a suite.
+ * @param suite A pointer to the suite.
+ * @param bench The case to add. Copied.
+ */
+void bench_suite_add(bench_suite* suite, bench_case bench);
+
+
+/**
+ * @brief Adds a check to a suite.
+ * @param suite A pointer to the suite.
+ * @param check The check to add. Copied.
+ */
+void bench_suite_add_check(bench_suite* suite, bench_check check);
+
+
+/**
+ * @brief Checks if a case passes the configured filter.
+ * @param config A pointer to the configuration.
+ * @param bench A pointer to the case.
+ * @return `b8 TRUE` if the case should run, otherwise `b8 FALSE`.
+ */
+b8 bench_matches(const bench_config* config, const bench_case* bench);
+
+
+/**
+ * @brief Runs and measures a single case.
+ * @param config A pointer to the configuration.
+ * @param bench A pointer to the case to run.
+ * @param out_result A pointer to receive the measurements.
+ * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+ */
+b8 bench_run(const bench_config* config, const bench_case* bench, bench_result* out_result);
+
+
+/**
+ * @brief Runs every check of a suite that passes the configured filter, printing one line per check to stdout.
+ * @param config A pointer to the configuration.
+ * @param suite A pointer to the suite.
+ * @return `b8 TRUE` if every check passed, otherwise `b8 FALSE`.
+ */
+b8 bench_run_checks(const bench_config* config, const bench_suite* suite);
+
+
+/**
+ * @brief Reports a failed BENCH_CHECK to stderr.
+ * @param file The source file of the check.
+ * @param line The line of the check.
+ * @param condition The text of the condition that did not hold.
+ */
+void bench_check_failed(const char* file, u32 line, const char* condition);
+
+
+/**
+ * @brief Prints the header of the results table to stdout.
+ */
+void bench_print_header();
+
+
+/**
+ * @brief Prints a single result as a row of the results table to stdout.
+ * @param result A pointer to the result.
+ */
+void bench_print_result(const bench_result* result);
+
+
+/**
+ * @brief Writes results to a CSV file, one row per case.
+ * @param path The path of the file to write.
+ * @param results The results.
+ * @param count The number of results.
+ * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+ */
+b8 bench_write_csv(const char* path, const bench_result* results, u32 count);
+
+
+/**
+ * @brief Writes results to a JSON file as an array of objects, one per case.
+ * @param path The path of the file to write.
+ * @param results The results.
+ * @param count The number of results.
+ * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+ */
+b8 bench_write_json(const char* path, const bench_result* results, u32 count);
+
+
+/**
+ * @brief Keeps the compiler from optimizing away a value a benchmark computes.
+ * @param value A pointer to the value.
+ */
+static inline void bench_do_not_optimize(const void* value) {
+    __asm__ __volatile__("" : : "r"(value) : "memory");
+}
+
+
+/** @brief Registers the allocator and bulk memory benchmarks. */
+void bench_register_memory(bench_suite* suite);
+
+/** @brief Registers the logging benchmarks. */
+void bench_register_logger(bench_suite* suite);
+
+/** @brief Registers the event system benchmarks. */
+void bench_register_event(bench_suite* suite);
+
+/** @brief Registers the container benchmarks. */
+void bench_register_containers(bench_suite* suite);
+
+/** @brief Registers the string and name interning benchmarks. */
+void bench_register_kstring(bench_suite* suite);
+
+/** @brief Registers the entity component system and transform hierarchy benchmarks. */
+void bench_register_ecs(bench_suite* suite);
+
+/** @brief Registers the math batch kernel benchmarks. */
+void bench_register_math(bench_suite* suite);
+
+/** @brief Registers the ring_queue, hashtable and pool_allocator checks. */
+void bench_register_checks(bench_suite* suite);
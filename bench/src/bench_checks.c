@@ -0,0 +1,447 @@
+/**
+ * @file bench_checks.c
+ * @brief This file contains the checks of the ring_queue, hashtable and pool_allocator.
+ *
+ * @details The benchmarks only measure these primitives, so the checks are what catches a
+ * regression in their behaviour: partial and wrapping batches, concurrent MPMC batches,
+ * hashtable churn against a reference, and pool exhaustion and growth. Run them with --check.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "bench.h"
+
+#include <containers/hashtable.h>
+#include <containers/ring_queue.h>
+#include <core/job_system.h>
+#include <core/katomic.h>
+#include <core/kmemory.h>
+#include <core/pool_allocator.h>
+
+#include <stdio.h>
+
+/** @brief The capacity of the queues of the single-threaded checks. */
+#define RING_CHECK_CAPACITY 64
+
+/** @brief The number of jobs that both produce and consume in the concurrent MPMC check. */
+#define RING_CHECK_JOBS 8
+
+/** @brief The number of values each job of the concurrent MPMC check produces. */
+#define RING_CHECK_VALUES_PER_JOB 20000
+
+/** @brief The worker threads of the concurrent MPMC check, started even on a single core so the jobs overlap. */
+#define RING_CHECK_WORKERS 3
+
+/** @brief The largest batch moved per call by the concurrent MPMC check. */
+#define RING_CHECK_MAX_BATCH 16
+
+/** @brief The number of distinct keys the hashtable churn check draws from. */
+#define HASHTABLE_CHECK_KEYS 1024
+
+/** @brief The number of slots of the hashtable churn check's table. */
+#define HASHTABLE_CHECK_CAPACITY 256
+
+/** @brief The number of operations of the hashtable churn check. */
+#define HASHTABLE_CHECK_OPERATIONS 200000
+
+/** @brief The number of elements in the first block of the pool checks. */
+#define POOL_CHECK_COUNT 8
+
+/** @brief The longest key name used by the hashtable check. */
+#define CHECK_NAME_LENGTH 32
+
+/** @brief Advances a xorshift64 state, so every run draws the same sequence. */
+static u64 check_random(u64* state) {
+    u64 x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+// ring_queue
+
+/**
+ * @brief Fills a queue with partial batches, overflows it and drains it, for one threading model.
+ * @details Batch sizes that do not divide the capacity make the positions wrap mid-batch.
+ */
+static b8 ring_check_batch_fifo(ring_queue_type type) {
+    ring_queue queue;
+    BENCH_CHECK(ring_queue_create(type, sizeof(u64), RING_CHECK_CAPACITY, 0, &queue));
+
+    u64 values[RING_CHECK_CAPACITY * 2];
+    for (u64 i = 0; i < RING_CHECK_CAPACITY * 2; ++i) {
+        values[i] = i;
+    }
+
+    // Fill in two batches; the second one only partially fits.
+    BENCH_CHECK(ring_queue_enqueue_batch(&queue, values, 40) == 40);
+    BENCH_CHECK(ring_queue_enqueue_batch(&queue, values + 40, 40) == RING_CHECK_CAPACITY - 40);
+    BENCH_CHECK(ring_queue_count(&queue) == RING_CHECK_CAPACITY);
+    BENCH_CHECK(!ring_queue_enqueue(&queue, values));
+    BENCH_CHECK(ring_queue_enqueue_batch(&queue, values, 1) == 0);
+
+    u64 out[RING_CHECK_CAPACITY * 2];
+    BENCH_CHECK(ring_queue_dequeue_batch(&queue, out, RING_CHECK_CAPACITY * 2) == RING_CHECK_CAPACITY);
+    for (u64 i = 0; i < RING_CHECK_CAPACITY; ++i) {
+        BENCH_CHECK(out[i] == i);
+    }
+    BENCH_CHECK(ring_queue_dequeue_batch(&queue, out, 1) == 0);
+    BENCH_CHECK(!ring_queue_dequeue(&queue, out));
+
+    // Wrap the positions many times with batches of 7 in and 5 out, checking the order throughout.
+    u64 next_in = 0;
+    u64 next_out = 0;
+    for (u32 round = 0; round < 1000; ++round) {
+        u64 batch[7];
+        for (u64 i = 0; i < 7; ++i) {
+            batch[i] = next_in + i;
+        }
+        next_in += ring_queue_enqueue_batch(&queue, batch, 7);
+
+        u64 count = ring_queue_dequeue_batch(&queue, out, 5);
+        for (u64 i = 0; i < count; ++i) {
+            BENCH_CHECK(out[i] == next_out + i);
+        }
+        next_out += count;
+        BENCH_CHECK(ring_queue_count(&queue) == next_in - next_out);
+    }
+    BENCH_CHECK(next_in > RING_CHECK_CAPACITY * 10);
+
+    u64 count;
+    while ((count = ring_queue_dequeue_batch(&queue, out, RING_CHECK_CAPACITY)) != 0) {
+        for (u64 i = 0; i < count; ++i) {
+            BENCH_CHECK(out[i] == next_out + i);
+        }
+        next_out += count;
+    }
+    BENCH_CHECK(next_out == next_in);
+    BENCH_CHECK(ring_queue_total_enqueued(&queue) == RING_CHECK_CAPACITY + next_in);
+
+    ring_queue_destroy(&queue);
+    return TRUE;
+}
+
+static b8 check_ring_queue_st_batch() {
+    return ring_check_batch_fifo(RING_QUEUE_TYPE_SINGLE_THREADED);
+}
+
+static b8 check_ring_queue_spsc_batch() {
+    return ring_check_batch_fifo(RING_QUEUE_TYPE_SPSC);
+}
+
+static b8 check_ring_queue_mpmc_batch() {
+    return ring_check_batch_fifo(RING_QUEUE_TYPE_MPMC);
+}
+
+/**
+ * @struct ring_check_threaded_state
+ * @brief The state shared by the jobs of the concurrent MPMC check.
+ */
+typedef struct ring_check_threaded_state {
+    /** @brief The queue every job enqueues to and dequeues from. */
+    ring_queue queue;
+
+    /** @brief How many times each value was dequeued. Accessed atomically. */
+    u32* seen;
+
+    /** @brief Set if a job dequeued a value out of its producer's order. Accessed atomically. */
+    u32 out_of_order;
+} ring_check_threaded_state;
+
+/**
+ * @brief Records dequeued values and checks that each producer's values arrive in increasing order.
+ * @details A consumer claims ever later positions, and a producer places its values at ever later
+ * positions, so within one consumer the values of any producer must strictly increase.
+ */
+static void ring_check_consume(ring_check_threaded_state* state, const u64* values, u64 count, i64* last_seen) {
+    for (u64 i = 0; i < count; ++i) {
+        u64 producer = values[i] / RING_CHECK_VALUES_PER_JOB;
+        if (producer >= RING_CHECK_JOBS || (i64)values[i] <= last_seen[producer]) {
+            katomic_store(&state->out_of_order, 1, KATOMIC_RELAXED);
+            continue;
+        }
+        last_seen[producer] = (i64)values[i];
+        katomic_fetch_add(&state->seen[values[i]], 1, KATOMIC_RELAXED);
+    }
+}
+
+/**
+ * @brief Produces this job's values in varying batch sizes, consuming a batch after every attempt.
+ * @details Consuming after every attempt guarantees progress even when the jobs run one after another.
+ */
+static void ring_check_threaded_job(u32 start, u32 end, void* data) {
+    ring_check_threaded_state* state = data;
+    for (u32 job = start; job < end; ++job) {
+        i64 last_seen[RING_CHECK_JOBS];
+        for (u32 i = 0; i < RING_CHECK_JOBS; ++i) {
+            last_seen[i] = -1;
+        }
+
+        u64 first = (u64)job * RING_CHECK_VALUES_PER_JOB;
+        u64 produced = 0;
+        u64 values[RING_CHECK_MAX_BATCH];
+        while (produced < RING_CHECK_VALUES_PER_JOB) {
+            u64 count = 1 + (produced + job) % RING_CHECK_MAX_BATCH;
+            if (count > RING_CHECK_VALUES_PER_JOB - produced) {
+                count = RING_CHECK_VALUES_PER_JOB - produced;
+            }
+            for (u64 i = 0; i < count; ++i) {
+                values[i] = first + produced + i;
+            }
+            produced += ring_queue_enqueue_batch(&state->queue, values, count);
+
+            u64 consumed = ring_queue_dequeue_batch(&state->queue, values, 1 + job % RING_CHECK_MAX_BATCH);
+            ring_check_consume(state, values, consumed, last_seen);
+        }
+    }
+}
+
+/** @brief Runs producing and consuming jobs on one MPMC queue and checks every value arrives exactly once. */
+static b8 check_ring_queue_mpmc_threaded() {
+    const u64 total = (u64)RING_CHECK_JOBS * RING_CHECK_VALUES_PER_JOB;
+    BENCH_CHECK(job_system_initialize(RING_CHECK_WORKERS));
+
+    // Aligned, as the ring_queue positions are cache-line aligned.
+    ring_check_threaded_state* state = kallocate_aligned(sizeof(ring_check_threaded_state), KCACHE_LINE_SIZE, MEMORY_TAG_APPLICATION);
+    BENCH_CHECK(ring_queue_create(RING_QUEUE_TYPE_MPMC, sizeof(u64), 256, 0, &state->queue));
+    state->seen = kallocate(sizeof(u32) * total, MEMORY_TAG_APPLICATION);
+    state->out_of_order = 0;
+
+    job_counter counter = {0};
+    job_system_parallel_for(RING_CHECK_JOBS, 1, ring_check_threaded_job, state, &counter);
+    job_system_wait(&counter);
+
+    // Whatever the jobs left behind is drained here, still in order per producer.
+    i64 last_seen[RING_CHECK_JOBS];
+    for (u32 i = 0; i < RING_CHECK_JOBS; ++i) {
+        last_seen[i] = -1;
+    }
+    u64 values[RING_CHECK_MAX_BATCH];
+    u64 count;
+    while ((count = ring_queue_dequeue_batch(&state->queue, values, RING_CHECK_MAX_BATCH)) != 0) {
+        ring_check_consume(state, values, count, last_seen);
+    }
+
+    b8 exactly_once = TRUE;
+    for (u64 i = 0; i < total; ++i) {
+        exactly_once &= state->seen[i] == 1;
+    }
+    b8 in_order = !state->out_of_order;
+    u64 total_enqueued = ring_queue_total_enqueued(&state->queue);
+
+    kfree(state->seen, sizeof(u32) * total, MEMORY_TAG_APPLICATION);
+    ring_queue_destroy(&state->queue);
+    kfree_aligned(state, sizeof(ring_check_threaded_state), KCACHE_LINE_SIZE, MEMORY_TAG_APPLICATION);
+    job_system_shutdown();
+
+    BENCH_CHECK(exactly_once);
+    BENCH_CHECK(in_order);
+    BENCH_CHECK(total_enqueued == total);
+    return TRUE;
+}
+
+// hashtable
+
+/**
+ * @brief Inserts, overwrites and removes random keys, comparing the table to a reference after every phase.
+ * @details The table stays near its load limit, so removals keep creating tombstones and inserts
+ * keep dropping them again.
+ */
+static b8 check_hashtable_churn() {
+    hashtable table;
+    BENCH_CHECK(hashtable_create(sizeof(u64), HASHTABLE_CHECK_CAPACITY, 0, FALSE, &table));
+
+    static char names[HASHTABLE_CHECK_KEYS][CHECK_NAME_LENGTH];
+    static u64 reference[HASHTABLE_CHECK_KEYS];
+    static b8 present[HASHTABLE_CHECK_KEYS];
+    for (u32 i = 0; i < HASHTABLE_CHECK_KEYS; ++i) {
+        snprintf(names[i], CHECK_NAME_LENGTH, "entity_%u", i);
+        present[i] = FALSE;
+    }
+
+    const u32 max_live = HASHTABLE_CHECK_CAPACITY - HASHTABLE_CHECK_CAPACITY / 8;
+    u64 random = 0x9E3779B97F4A7C15ull;
+    u32 live = 0;
+    for (u32 op = 0; op < HASHTABLE_CHECK_OPERATIONS; ++op) {
+        u32 key = (u32)(check_random(&random) % HASHTABLE_CHECK_KEYS);
+        u64 value = check_random(&random);
+        if (present[key] && (value & 1)) {
+            BENCH_CHECK(hashtable_remove(&table, names[key]));
+            BENCH_CHECK(!hashtable_remove(&table, names[key]));
+            present[key] = FALSE;
+            live--;
+        } else if (present[key] || live < max_live) {
+            BENCH_CHECK(hashtable_set(&table, names[key], &value));
+            live += present[key] ? 0 : 1;
+            present[key] = TRUE;
+            reference[key] = value;
+        }
+        BENCH_CHECK(table.count == live);
+        BENCH_CHECK(table.count + table.tombstones < table.capacity);
+
+        if (op % 4096 == 0 || op == HASHTABLE_CHECK_OPERATIONS - 1) {
+            for (u32 i = 0; i < HASHTABLE_CHECK_KEYS; ++i) {
+                u64 stored = 0;
+                BENCH_CHECK(hashtable_get(&table, names[i], &stored) == present[i]);
+                BENCH_CHECK(!present[i] || stored == reference[i]);
+            }
+        }
+    }
+
+    // Fill the rest of the way: inserts succeed up to the load limit and fail beyond it.
+    for (u32 i = 0; i < HASHTABLE_CHECK_KEYS && live < max_live; ++i) {
+        if (!present[i]) {
+            BENCH_CHECK(hashtable_set(&table, names[i], &reference[i]));
+            present[i] = TRUE;
+            live++;
+        }
+    }
+    BENCH_CHECK(table.count == max_live);
+    for (u32 i = 0; i < HASHTABLE_CHECK_KEYS; ++i) {
+        if (!present[i]) {
+            BENCH_CHECK(!hashtable_set(&table, names[i], &reference[i]));
+            break;
+        }
+    }
+
+    hashtable_clear(&table);
+    BENCH_CHECK(table.count == 0 && table.tombstones == 0);
+    BENCH_CHECK(!hashtable_get_ref(&table, names[0]));
+
+    hashtable_destroy(&table);
+    return TRUE;
+}
+
+// pool_allocator
+
+/**
+ * @brief Allocates `count` chunks, checking their alignment and stamping each with its index.
+ */
+static b8 pool_check_allocate(pool_allocator* pool, u64** chunks, u64 first, u64 count) {
+    for (u64 i = first; i < first + count; ++i) {
+        chunks[i] = pool_allocator_allocate(pool);
+        BENCH_CHECK(chunks[i] != 0);
+        BENCH_CHECK(((u64)chunks[i] & (pool->alignment - 1)) == 0);
+        chunks[i][0] = i;
+        chunks[i][2] = ~i;
+    }
+    return TRUE;
+}
+
+/** @brief Checks that every chunk still holds its stamp, so no two chunks overlap. */
+static b8 pool_check_stamps(u64** chunks, u64 count) {
+    for (u64 i = 0; i < count; ++i) {
+        BENCH_CHECK(chunks[i][0] == i && chunks[i][2] == ~i);
+    }
+    return TRUE;
+}
+
+/** @brief Exhausts a pool that cannot grow, then frees and reuses its chunks. */
+static b8 check_pool_allocator_exhaustion() {
+    pool_allocator_config config = {0};
+    config.element_size = 3 * sizeof(u64);
+    config.element_count = POOL_CHECK_COUNT;
+    config.alignment = 32;
+    config.growth = POOL_GROWTH_NONE;
+    config.tag = MEMORY_TAG_APPLICATION;
+    pool_allocator pool;
+    BENCH_CHECK(pool_allocator_create(&config, &pool));
+
+    u64* chunks[POOL_CHECK_COUNT];
+    BENCH_CHECK(pool_check_allocate(&pool, chunks, 0, POOL_CHECK_COUNT));
+    BENCH_CHECK(pool_check_stamps(chunks, POOL_CHECK_COUNT));
+
+    // Exhausted: the allocation fails (and logs an error) instead of growing.
+    BENCH_CHECK(pool_allocator_allocate(&pool) == 0);
+
+    pool_allocator_stats stats;
+    pool_allocator_get_stats(&pool, &stats);
+    BENCH_CHECK(stats.capacity == POOL_CHECK_COUNT && stats.in_use == POOL_CHECK_COUNT);
+    BENCH_CHECK(stats.block_count == 1);
+
+    // A freed chunk is handed out again before the pool reports exhaustion.
+    pool_allocator_free(&pool, chunks[3]);
+    BENCH_CHECK(pool_allocator_allocate(&pool) == chunks[3]);
+    BENCH_CHECK(pool_allocator_allocate(&pool) == 0);
+
+    // free_all returns every chunk at once; they can all be taken again.
+    pool_allocator_free_all(&pool);
+    pool_allocator_get_stats(&pool, &stats);
+    BENCH_CHECK(stats.in_use == 0 && stats.peak_in_use == POOL_CHECK_COUNT);
+    BENCH_CHECK(pool_check_allocate(&pool, chunks, 0, POOL_CHECK_COUNT));
+    BENCH_CHECK(pool_check_stamps(chunks, POOL_CHECK_COUNT));
+    BENCH_CHECK(pool_allocator_allocate(&pool) == 0);
+
+    pool_allocator_destroy(&pool);
+    return TRUE;
+}
+
+/**
+ * @brief Grows a pool into a third block with the given policy, checking block count, capacity and chunk integrity.
+ * @param growth The growth policy.
+ * @param third_block_count The number of chunks the policy gives the third block.
+ */
+static b8 pool_check_growth(pool_allocator_growth growth, u64 third_block_count) {
+    pool_allocator_config config = {0};
+    config.element_size = 3 * sizeof(u64);
+    config.element_count = POOL_CHECK_COUNT;
+    config.growth = growth;
+    config.tag = MEMORY_TAG_APPLICATION;
+    pool_allocator pool;
+    BENCH_CHECK(pool_allocator_create(&config, &pool));
+
+    // One chunk more than the first two blocks hold, so the pool grows twice.
+    const u64 expected_capacity = pool.stats.capacity * (growth == POOL_GROWTH_DOUBLE ? 3 : 2) + third_block_count;
+    const u64 count = expected_capacity - third_block_count + 1;
+    u64* chunks[POOL_CHECK_COUNT * 3 + 1];
+    BENCH_CHECK(pool_check_allocate(&pool, chunks, 0, count));
+    BENCH_CHECK(pool_check_stamps(chunks, count));
+
+    pool_allocator_stats stats;
+    pool_allocator_get_stats(&pool, &stats);
+    BENCH_CHECK(stats.block_count == 3);
+    BENCH_CHECK(stats.capacity == expected_capacity);
+    BENCH_CHECK(stats.in_use == count && stats.peak_in_use == count);
+
+    // Freeing every other chunk and allocating again reuses them without growing.
+    for (u64 i = 0; i < count; i += 2) {
+        pool_allocator_free(&pool, chunks[i]);
+    }
+    for (u64 i = 0; i < count; i += 2) {
+        BENCH_CHECK(pool_check_allocate(&pool, chunks, i, 1));
+    }
+    BENCH_CHECK(pool_check_stamps(chunks, count));
+    pool_allocator_get_stats(&pool, &stats);
+    BENCH_CHECK(stats.block_count == 3 && stats.capacity == expected_capacity);
+
+    // free_all keeps every block, so the whole capacity is available without growing.
+    pool_allocator_free_all(&pool);
+    for (u64 i = 0; i < expected_capacity; ++i) {
+        BENCH_CHECK(pool_allocator_allocate(&pool) != 0);
+    }
+    pool_allocator_get_stats(&pool, &stats);
+    BENCH_CHECK(stats.block_count == 3 && stats.in_use == expected_capacity);
+
+    pool_allocator_destroy(&pool);
+    return TRUE;
+}
+
+static b8 check_pool_allocator_growth_linear() {
+    return pool_check_growth(POOL_GROWTH_LINEAR, POOL_CHECK_COUNT);
+}
+
+static b8 check_pool_allocator_growth_double() {
+    return pool_check_growth(POOL_GROWTH_DOUBLE, POOL_CHECK_COUNT * 4);
+}
+
+void bench_register_checks(bench_suite* suite) {
+    bench_suite_add_check(suite, (bench_check){"ring_queue", "st_batch", check_ring_queue_st_batch});
+    bench_suite_add_check(suite, (bench_check){"ring_queue", "spsc_batch", check_ring_queue_spsc_batch});
+    bench_suite_add_check(suite, (bench_check){"ring_queue", "mpmc_batch", check_ring_queue_mpmc_batch});
+    bench_suite_add_check(suite, (bench_check){"ring_queue", "mpmc_batch_threaded", check_ring_queue_mpmc_threaded});
+    bench_suite_add_check(suite, (bench_check){"hashtable", "churn", check_hashtable_churn});
+    bench_suite_add_check(suite, (bench_check){"pool_allocator", "exhaustion", check_pool_allocator_exhaustion});
+    bench_suite_add_check(suite, (bench_check){"pool_allocator", "growth_linear", check_pool_allocator_growth_linear});
+    bench_suite_add_check(suite, (bench_check){"pool_allocator", "growth_double", check_pool_allocator_growth_double});
+}
@@ -0,0 +1,223 @@
+/**
+ * @file bench_containers.c
+ * @brief This file contains the container benchmarks.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "bench.h"
+
+#include <containers/darray.h>
+#include <containers/hashtable.h>
+#include <containers/ring_queue.h>
+#include <core/kmemory.h>
+
+#include <stdio.h>
+
+/** @brief The number of elements moved per call by the batch cases. */
+#define CONTAINER_BENCH_BATCH 64
+
+/** @brief The longest key name used by the hashtable cases. */
+#define CONTAINER_BENCH_NAME_LENGTH 32
+
+/**
+ * @struct container_bench_state
+ * @brief The state shared by the container benchmarks.
+ */
+typedef struct container_bench_state {
+    /** @brief The element or entry count the case works on. */
+    u64 count;
+
+    /** @brief The darray of the darray cases. */
+    u64* array;
+
+    /** @brief The table of the hashtable cases. */
+    hashtable table;
+
+    /** @brief The names inserted into the table, `count` of them. */
+    char (*names)[CONTAINER_BENCH_NAME_LENGTH];
+
+    /** @brief The queue of the ring_queue cases. */
+    ring_queue queue;
+
+    /** @brief Source and destination elements of the batch cases. */
+    u64 batch[CONTAINER_BENCH_BATCH];
+} container_bench_state;
+
+static container_bench_state* container_bench_state_create(u64 count) {
+    // Aligned, as the ring_queue positions are cache-line aligned.
+    container_bench_state* state = kallocate_aligned(sizeof(container_bench_state), KCACHE_LINE_SIZE, MEMORY_TAG_APPLICATION);
+    state->count = count;
+    return state;
+}
+
+static void container_bench_state_destroy(container_bench_state* state) {
+    kfree_aligned(state, sizeof(container_bench_state), KCACHE_LINE_SIZE, MEMORY_TAG_APPLICATION);
+}
+
+// darray
+
+static void* darray_bench_setup(u64 count) {
+    container_bench_state* state = container_bench_state_create(count);
+    state->array = darray_create(u64);
+    return state;
+}
+
+static void darray_bench_teardown(void* user_data) {
+    container_bench_state* state = user_data;
+    darray_destroy(state->array);
+    container_bench_state_destroy(state);
+}
+
+static void bench_darray_push(void* user_data, u64 iterations) {
+    container_bench_state* state = user_data;
+    for (u64 i = 0; i < iterations; ++i) {
+        darray_push(state->array, i);
+        if (darray_length(state->array) == state->count) {
+            darray_clear(state->array);
+        }
+    }
+}
+
+static void bench_darray_push_n(void* user_data, u64 iterations) {
+    container_bench_state* state = user_data;
+    for (u64 i = 0; i < iterations; ++i) {
+        darray_push_n(state->array, state->batch, CONTAINER_BENCH_BATCH);
+        if (darray_length(state->array) >= state->count) {
+            darray_clear(state->array);
+        }
+    }
+}
+
+static void* darray_filled_bench_setup(u64 count) {
+    container_bench_state* state = darray_bench_setup(count);
+    for (u64 i = 0; i < count; ++i) {
+        darray_push(state->array, i);
+    }
+    return state;
+}
+
+static void bench_darray_insert_pop_front(void* user_data, u64 iterations) {
+    container_bench_state* state = user_data;
+    for (u64 i = 0; i < iterations; ++i) {
+        u64 value;
+        darray_insert_at(state->array, 0, i);
+        darray_pop_at(state->array, 0, &value);
+        bench_do_not_optimize(&value);
+    }
+}
+
+// hashtable
+
+static void* hashtable_bench_setup(u64 count) {
+    container_bench_state* state = container_bench_state_create(count);
+    // Sized at half load, as a table is typically created with headroom.
+    hashtable_create(sizeof(u64), (u32)(count * 2), 0, FALSE, &state->table);
+    state->names = kallocate(count * CONTAINER_BENCH_NAME_LENGTH, MEMORY_TAG_APPLICATION);
+    for (u64 i = 0; i < count; ++i) {
+        snprintf(state->names[i], CONTAINER_BENCH_NAME_LENGTH, "entity_%llu", i);
+        hashtable_set(&state->table, state->names[i], &i);
+    }
+    return state;
+}
+
+static void hashtable_bench_teardown(void* user_data) {
+    container_bench_state* state = user_data;
+    kfree(state->names, state->count * CONTAINER_BENCH_NAME_LENGTH, MEMORY_TAG_APPLICATION);
+    hashtable_destroy(&state->table);
+    container_bench_state_destroy(state);
+}
+
+static void bench_hashtable_get_hit(void* user_data, u64 iterations) {
+    container_bench_state* state = user_data;
+    for (u64 i = 0; i < iterations; ++i) {
+        u64 value;
+        hashtable_get(&state->table, state->names[i % state->count], &value);
+        bench_do_not_optimize(&value);
+    }
+}
+
+static void bench_hashtable_get_miss(void* user_data, u64 iterations) {
+    container_bench_state* state = user_data;
+    for (u64 i = 0; i < iterations; ++i) {
+        // Same length as the stored names, so hashing costs the same as a hit.
+        char name[CONTAINER_BENCH_NAME_LENGTH];
+        kcopy_memory(name, state->names[i % state->count], CONTAINER_BENCH_NAME_LENGTH);
+        name[0] = 'x';
+        bench_do_not_optimize(hashtable_get_ref(&state->table, name));
+    }
+}
+
+static void bench_hashtable_set_remove(void* user_data, u64 iterations) {
+    container_bench_state* state = user_data;
+    for (u64 i = 0; i < iterations; ++i) {
+        const char* name = state->names[i % state->count];
+        hashtable_remove(&state->table, name);
+        hashtable_set(&state->table, name, &i);
+    }
+}
+
+// ring_queue
+
+static void* ring_queue_bench_setup(ring_queue_type type, u64 count) {
+    container_bench_state* state = container_bench_state_create(count);
+    ring_queue_create(type, sizeof(u64), count, 0, &state->queue);
+    return state;
+}
+
+static void* ring_queue_st_bench_setup(u64 count) {
+    return ring_queue_bench_setup(RING_QUEUE_TYPE_SINGLE_THREADED, count);
+}
+
+static void* ring_queue_spsc_bench_setup(u64 count) {
+    return ring_queue_bench_setup(RING_QUEUE_TYPE_SPSC, count);
+}
+
+static void* ring_queue_mpmc_bench_setup(u64 count) {
+    return ring_queue_bench_setup(RING_QUEUE_TYPE_MPMC, count);
+}
+
+static void ring_queue_bench_teardown(void* user_data) {
+    container_bench_state* state = user_data;
+    ring_queue_destroy(&state->queue);
+    container_bench_state_destroy(state);
+}
+
+static void bench_ring_queue_enqueue_dequeue(void* user_data, u64 iterations) {
+    container_bench_state* state = user_data;
+    for (u64 i = 0; i < iterations; ++i) {
+        u64 value = i;
+        ring_queue_enqueue(&state->queue, &value);
+        ring_queue_dequeue(&state->queue, &value);
+        bench_do_not_optimize(&value);
+    }
+}
+
+static void bench_ring_queue_batch(void* user_data, u64 iterations) {
+    container_bench_state* state = user_data;
+    for (u64 i = 0; i < iterations; ++i) {
+        ring_queue_enqueue_batch(&state->queue, state->batch, CONTAINER_BENCH_BATCH);
+        ring_queue_dequeue_batch(&state->queue, state->batch, CONTAINER_BENCH_BATCH);
+    }
+}
+
+void bench_register_containers(bench_suite* suite) {
+    bench_suite_add(suite, (bench_case){"darray", "push", 4096, 0, darray_bench_setup, bench_darray_push, darray_bench_teardown});
+    bench_suite_add(suite, (bench_case){"darray", "push_n_64", 4096, 0, darray_bench_setup, bench_darray_push_n, darray_bench_teardown});
+    bench_suite_add(suite, (bench_case){"darray", "insert_pop_front", 1024, 0, darray_filled_bench_setup, bench_darray_insert_pop_front, darray_bench_teardown});
+
+    const u64 table_sizes[] = {1024, 65536};
+    for (u32 i = 0; i < sizeof(table_sizes) / sizeof(table_sizes[0]); ++i) {
+        u64 count = table_sizes[i];
+        bench_suite_add(suite, (bench_case){"hashtable", "get_hit", count, 0, hashtable_bench_setup, bench_hashtable_get_hit, hashtable_bench_teardown});
+        bench_suite_add(suite, (bench_case){"hashtable", "get_miss", count, 0, hashtable_bench_setup, bench_hashtable_get_miss, hashtable_bench_teardown});
+        bench_suite_add(suite, (bench_case){"hashtable", "set_remove", count, 0, hashtable_bench_setup, bench_hashtable_set_remove, hashtable_bench_teardown});
+    }
+
+    // Single-threaded round trips, so the cases compare the cost of each variant's synchronization.
+    bench_suite_add(suite, (bench_case){"ring_queue", "st_enqueue_dequeue", 1024, 0, ring_queue_st_bench_setup, bench_ring_queue_enqueue_dequeue, ring_queue_bench_teardown});
+    bench_suite_add(suite, (bench_case){"ring_queue", "spsc_enqueue_dequeue", 1024, 0, ring_queue_spsc_bench_setup, bench_ring_queue_enqueue_dequeue, ring_queue_bench_teardown});
+    bench_suite_add(suite, (bench_case){"ring_queue", "mpmc_enqueue_dequeue", 1024, 0, ring_queue_mpmc_bench_setup, bench_ring_queue_enqueue_dequeue, ring_queue_bench_teardown});
+    bench_suite_add(suite, (bench_case){"ring_queue", "st_batch_64", 1024, 0, ring_queue_st_bench_setup, bench_ring_queue_batch, ring_queue_bench_teardown});
+    bench_suite_add(suite, (bench_case){"ring_queue", "spsc_batch_64", 1024, 0, ring_queue_spsc_bench_setup, bench_ring_queue_batch, ring_queue_bench_teardown});
+    bench_suite_add(suite, (bench_case){"ring_queue", "mpmc_batch_64", 1024, 0, ring_queue_mpmc_bench_setup, bench_ring_queue_batch, ring_queue_bench_teardown});
+}
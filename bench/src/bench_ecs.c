@@ -0,0 +1,136 @@
+/**
+ * @file bench_ecs.c
+ * @brief This file contains the entity component system and transform hierarchy benchmarks.
+ *
+ * @details One operation is one entity (or transform) processed, so the numbers compare
+ * directly across entity counts and against the parallel variants.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "bench.h"
+
+#include <core/job_system.h>
+#include <core/kmemory.h>
+#include <core/kstring.h>
+#include <ecs/ecs.h>
+#include <ecs/transform.h>
+#include <math/kmath.h>
+
+/** @brief A component written by the query benchmarks. */
+typedef struct bench_position {
+    f32 x, y, z;
+} bench_position;
+
+/** @brief A component read by the query benchmarks. */
+typedef struct bench_velocity {
+    f32 x, y, z;
+} bench_velocity;
+
+/**
+ * @struct ecs_bench_state
+ * @brief The world and hierarchy the benchmarks run on.
+ */
+typedef struct ecs_bench_state {
+    /** @brief The world, with every entity having a position and a velocity. */
+    ecs_world world;
+
+    /** @brief The position and velocity query. */
+    ecs_query query;
+
+    /** @brief A hierarchy of one transform per entity, four levels deep. */
+    transform_hierarchy hierarchy;
+
+    /** @brief The roots of the hierarchy. */
+    entity* roots;
+
+    /** @brief The number of entities. */
+    u64 count;
+} ecs_bench_state;
+
+static ecs_bench_state bench_state;
+
+static void* ecs_bench_setup(u64 count) {
+    // The parallel case needs workers; with a single core it measures the sequential fallback.
+    job_system_initialize(0);
+    kname_system_initialize();
+    ecs_world_create((u32)count, &bench_state.world);
+    ecs_component_id position = ECS_COMPONENT_REGISTER(&bench_state.world, bench_position);
+    ecs_component_id velocity = ECS_COMPONENT_REGISTER(&bench_state.world, bench_velocity);
+    ecs_component_id components[] = {position, velocity};
+    ecs_query_create(components, 2, 0, &bench_state.query);
+
+    transform_hierarchy_create((u32)count, &bench_state.hierarchy);
+    bench_state.roots = kallocate(sizeof(entity) * (count / 4 + 1), MEMORY_TAG_GAME);
+    entity parents[4] = {ENTITY_INVALID};
+    for (u64 i = 0; i < count; ++i) {
+        entity e = ecs_entity_create(&bench_state.world);
+        ((bench_velocity*)ecs_component_add(&bench_state.world, e, velocity))->x = 1.0f;
+        ecs_component_add(&bench_state.world, e, position);
+
+        // Every fourth entity is a root; the rest chain below it.
+        u32 depth = (u32)(i % 4);
+        transform_add(&bench_state.hierarchy, e, depth ? parents[depth - 1] : ENTITY_INVALID);
+        parents[depth] = e;
+        if (depth == 0) {
+            bench_state.roots[i / 4] = e;
+        }
+    }
+    transform_hierarchy_update(&bench_state.hierarchy);
+    bench_state.count = count;
+    return &bench_state;
+}
+
+static void ecs_bench_teardown(void* user_data) {
+    kfree(bench_state.roots, sizeof(entity) * (bench_state.count / 4 + 1), MEMORY_TAG_GAME);
+    transform_hierarchy_destroy(&bench_state.hierarchy);
+    ecs_world_destroy(&bench_state.world);
+    kname_system_shutdown();
+    job_system_shutdown();
+}
+
+/** @brief Integrates velocity into position for every row of a view. */
+static void bench_integrate(const ecs_view* view, void* data) {
+    bench_position* positions = view->columns[0];
+    const bench_velocity* velocities = view->columns[1];
+    for (u32 i = 0; i < view->count; ++i) {
+        positions[i].x += velocities[i].x * 0.016f;
+        positions[i].y += velocities[i].y * 0.016f;
+        positions[i].z += velocities[i].z * 0.016f;
+    }
+}
+
+static void bench_ecs_query(void* user_data, u64 iterations) {
+    ecs_bench_state* state = user_data;
+    for (u64 i = 0; i < iterations; i += state->count) {
+        ecs_query_run(&state->world, &state->query, bench_integrate, 0);
+    }
+}
+
+static void bench_ecs_query_parallel(void* user_data, u64 iterations) {
+    ecs_bench_state* state = user_data;
+    for (u64 i = 0; i < iterations; i += state->count) {
+        ecs_query_run_parallel(&state->world, &state->query, 0, bench_integrate, 0);
+    }
+}
+
+static void bench_transform_update_all(void* user_data, u64 iterations) {
+    ecs_bench_state* state = user_data;
+    for (u64 i = 0; i < iterations; i += state->count) {
+        // Dirtying the roots propagates to every transform below them.
+        for (u64 root = 0; root < (state->count + 3) / 4; ++root) {
+            transform_set_local(&state->hierarchy, state->roots[root], vec3_create((f32)i, 0.0f, 0.0f), quat_identity(), vec3_one());
+        }
+        transform_hierarchy_update(&state->hierarchy);
+    }
+}
+
+void bench_register_ecs(bench_suite* suite) {
+    const u64 counts[] = {1024, 65536};
+    for (u32 i = 0; i < sizeof(counts) / sizeof(counts[0]); ++i) {
+        u64 count = counts[i];
+        // Each run processes `count` entities, so samples are whole multiples of it.
+        bench_suite_add(suite, (bench_case){"ecs", "query", count, count * 16, ecs_bench_setup, bench_ecs_query, ecs_bench_teardown});
+        bench_suite_add(suite, (bench_case){"ecs", "query_parallel", count, count * 16, ecs_bench_setup, bench_ecs_query_parallel, ecs_bench_teardown});
+        bench_suite_add(suite, (bench_case){"ecs", "transform_update", count, count * 4, ecs_bench_setup, bench_transform_update_all, ecs_bench_teardown});
+    }
+}
@@ -0,0 +1,77 @@
+/**
+ * @file bench_event.c
+ * @brief This file contains the event system benchmarks.
+ *
+ * @details The platform half of the event pump needs a window and real OS input, so these
+ * measure the engine half: translating into the queue (event_post) and dispatching it to
+ * listeners, which is what every platform event costs once it has been read from the OS.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "bench.h"
+
+#include <core/event.h>
+
+/** @brief A listener that lets every event through to the next one. */
+static b8 bench_on_event(const event* e, void* listener_inst) {
+    bench_do_not_optimize(e);
+    return FALSE;
+}
+
+static void* event_bench_setup(u64 listener_count) {
+    event_system_initialize();
+
+    // Listeners are told apart by their instance pointer, so use the index as one.
+    for (u64 i = 0; i < listener_count; ++i) {
+        event_register(EVENT_CODE_KEY_PRESSED, (void*)(i + 1), bench_on_event);
+        event_register(EVENT_CODE_MOUSE_MOVED, (void*)(i + 1), bench_on_event);
+    }
+    return 0;
+}
+
+static void event_bench_teardown(void* user_data) {
+    event_system_shutdown();
+}
+
+static void bench_event_fire(void* user_data, u64 iterations) {
+    event e = {0};
+    e.code = EVENT_CODE_KEY_PRESSED;
+    for (u64 i = 0; i < iterations; ++i) {
+        e.key.key = (keys)(i & 0xFF);
+        event_fire(&e);
+    }
+}
+
+static void bench_event_post_dispatch(void* user_data, u64 iterations) {
+    event e = {0};
+    e.code = EVENT_CODE_KEY_PRESSED;
+    for (u64 i = 0; i < iterations; ++i) {
+        e.key.key = (keys)(i & 0xFF);
+        event_post(&e);
+        event_dispatch_queued();
+    }
+}
+
+static void bench_event_motion_frame(void* user_data, u64 iterations) {
+    // A frame's worth of raw mouse motion, which coalesces into a single dispatched event.
+    event e = {0};
+    e.code = EVENT_CODE_MOUSE_MOVED;
+    for (u64 i = 0; i < iterations; ++i) {
+        for (i16 j = 0; j < 32; ++j) {
+            e.mouse_move.x = j;
+            e.mouse_move.y = j;
+            event_post(&e);
+        }
+        event_dispatch_queued();
+    }
+}
+
+void bench_register_event(bench_suite* suite) {
+    const u64 listener_counts[] = {1, 8};
+    for (u32 i = 0; i < sizeof(listener_counts) / sizeof(listener_counts[0]); ++i) {
+        u64 count = listener_counts[i];
+        bench_suite_add(suite, (bench_case){"event", "fire", count, 0, event_bench_setup, bench_event_fire, event_bench_teardown});
+        bench_suite_add(suite, (bench_case){"event", "post_dispatch", count, 0, event_bench_setup, bench_event_post_dispatch, event_bench_teardown});
+        bench_suite_add(suite, (bench_case){"event", "motion_frame_32", count, 0, event_bench_setup, bench_event_motion_frame, event_bench_teardown});
+    }
+}
@@ -0,0 +1,98 @@
+/**
+ * @file bench_kstring.c
+ * @brief This file contains the string and name interning benchmarks.
+ *
+ * @details Interning is meant to be paid once per name, so the interesting costs are the
+ * repeat paths: interning a name that already exists, looking one up, and turning an ID back
+ * into its string. Arena formatting is measured against the frame-allocator use it replaces.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "bench.h"
+
+#include <core/kstring.h>
+#include <core/linear_allocator.h>
+
+#include <stdio.h>
+
+/** @brief The number of distinct names interned before each case. */
+#define BENCH_KSTRING_NAME_COUNT 1024
+
+/**
+ * @struct kstring_bench_state
+ * @brief The names the benchmarks cycle through.
+ */
+typedef struct kstring_bench_state {
+    /** @brief The backing storage of `names`. */
+    char storage[BENCH_KSTRING_NAME_COUNT][48];
+
+    /** @brief Views of the names in `storage`. */
+    kstring names[BENCH_KSTRING_NAME_COUNT];
+
+    /** @brief The interned IDs of `names`. */
+    kname ids[BENCH_KSTRING_NAME_COUNT];
+
+    /** @brief The arena the format benchmark allocates from. */
+    linear_allocator arena;
+} kstring_bench_state;
+
+static kstring_bench_state bench_state;
+
+static void* kstring_bench_setup(u64 param) {
+    kname_system_initialize();
+    for (u32 i = 0; i < BENCH_KSTRING_NAME_COUNT; ++i) {
+        i32 length = snprintf(bench_state.storage[i], sizeof(bench_state.storage[i]), "assets/textures/material_%u.kta", i);
+        bench_state.names[i] = (kstring){bench_state.storage[i], (u64)length};
+        bench_state.ids[i] = kname_intern(bench_state.names[i]);
+    }
+    linear_allocator_create(64 * 1024, 0, &bench_state.arena);
+    return &bench_state;
+}
+
+static void kstring_bench_teardown(void* user_data) {
+    linear_allocator_destroy(&bench_state.arena);
+    kname_system_shutdown();
+}
+
+static void bench_kname_intern_existing(void* user_data, u64 iterations) {
+    kstring_bench_state* state = user_data;
+    for (u64 i = 0; i < iterations; ++i) {
+        kname id = kname_intern(state->names[i % BENCH_KSTRING_NAME_COUNT]);
+        bench_do_not_optimize(&id);
+    }
+}
+
+static void bench_kname_find(void* user_data, u64 iterations) {
+    kstring_bench_state* state = user_data;
+    for (u64 i = 0; i < iterations; ++i) {
+        kname id = kname_find(state->names[i % BENCH_KSTRING_NAME_COUNT]);
+        bench_do_not_optimize(&id);
+    }
+}
+
+static void bench_kname_get_string(void* user_data, u64 iterations) {
+    kstring_bench_state* state = user_data;
+    for (u64 i = 0; i < iterations; ++i) {
+        kstring str = kname_get_string(state->ids[i % BENCH_KSTRING_NAME_COUNT]);
+        bench_do_not_optimize(str.data);
+    }
+}
+
+static void bench_kstring_format(void* user_data, u64 iterations) {
+    kstring_bench_state* state = user_data;
+    for (u64 i = 0; i < iterations; ++i) {
+        // Reset like the frame arena is, so every iteration formats into fresh space.
+        if (state->arena.allocated > state->arena.total_size / 2) {
+            linear_allocator_free_all(&state->arena);
+        }
+        kstring str = kstring_format(&state->arena, "%s#%llu", state->storage[i % BENCH_KSTRING_NAME_COUNT], i);
+        bench_do_not_optimize(str.data);
+    }
+}
+
+void bench_register_kstring(bench_suite* suite) {
+    bench_suite_add(suite, (bench_case){"kstring", "intern_existing", BENCH_KSTRING_NAME_COUNT, 0, kstring_bench_setup, bench_kname_intern_existing, kstring_bench_teardown});
+    bench_suite_add(suite, (bench_case){"kstring", "find", BENCH_KSTRING_NAME_COUNT, 0, kstring_bench_setup, bench_kname_find, kstring_bench_teardown});
+    bench_suite_add(suite, (bench_case){"kstring", "get_string", BENCH_KSTRING_NAME_COUNT, 0, kstring_bench_setup, bench_kname_get_string, kstring_bench_teardown});
+    bench_suite_add(suite, (bench_case){"kstring", "format_arena", BENCH_KSTRING_NAME_COUNT, 0, kstring_bench_setup, bench_kstring_format, kstring_bench_teardown});
+}
@@ -0,0 +1,59 @@
+/**
+ * @file bench_logger.c
+ * @brief This file contains the logging benchmarks.
+ *
+ * @details Console output is disabled while these run, so they measure the logger and its
+ * file sink rather than the terminal. Latency cases time single calls on the logging thread.
+ * Throughput cases run long enough to fill the queue, so they also include the writer's pace.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "bench.h"
+
+#include <core/logger.h>
+
+static void* logger_bench_setup(u64 param) {
+    log_set_console_enabled(FALSE);
+    return 0;
+}
+
+static void logger_bench_teardown(void* user_data) {
+    // Let the writer finish the queued entries while the console is still off.
+    log_flush();
+    log_set_console_enabled(TRUE);
+}
+
+static void bench_log_output(void* user_data, u64 iterations) {
+    for (u64 i = 0; i < iterations; ++i) {
+        log_output(LOG_LEVEL_INFO, "bench entry %llu value %f name %s", i, 1.5, "logger");
+    }
+}
+
+static void bench_log_output_deferred(void* user_data, u64 iterations) {
+    for (u64 i = 0; i < iterations; ++i) {
+        log_output_deferred(LOG_LEVEL_INFO, "bench entry %llu value %f name %s", i, 1.5, "logger");
+    }
+}
+
+static void* suppressed_bench_setup(u64 param) {
+    log_set_level(LOG_LEVEL_INFO);
+    return 0;
+}
+
+static void suppressed_bench_teardown(void* user_data) {
+    log_set_level(LOG_LEVEL_TRACE);
+}
+
+static void bench_log_output_suppressed(void* user_data, u64 iterations) {
+    for (u64 i = 0; i < iterations; ++i) {
+        log_output(LOG_LEVEL_TRACE, "bench entry %llu value %f name %s", i, 1.5, "logger");
+    }
+}
+
+void bench_register_logger(bench_suite* suite) {
+    bench_suite_add(suite, (bench_case){"logger", "log_output_latency", 0, 1, logger_bench_setup, bench_log_output, logger_bench_teardown});
+    bench_suite_add(suite, (bench_case){"logger", "log_output_throughput", 0, 0, logger_bench_setup, bench_log_output, logger_bench_teardown});
+    bench_suite_add(suite, (bench_case){"logger", "log_output_deferred_latency", 0, 1, logger_bench_setup, bench_log_output_deferred, logger_bench_teardown});
+    bench_suite_add(suite, (bench_case){"logger", "log_output_deferred_throughput", 0, 0, logger_bench_setup, bench_log_output_deferred, logger_bench_teardown});
+    bench_suite_add(suite, (bench_case){"logger", "log_output_suppressed", 0, 0, suppressed_bench_setup, bench_log_output_suppressed, suppressed_bench_teardown});
+}
@@ -0,0 +1,128 @@
+/**
+ * @file bench_math.c
+ * @brief This file contains the math batch kernel benchmarks.
+ *
+ * @details One operation is one point or matrix processed. The "_loop" cases run the
+ * single-value inline functions in a loop, as code without the batch kernels would, so
+ * the difference is what batching and the wider SIMD path buy.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "bench.h"
+
+#include <core/kmemory.h>
+#include <math/kmath.h>
+
+/**
+ * @struct math_bench_state
+ * @brief The arrays the benchmarks run over.
+ */
+typedef struct math_bench_state {
+    /** @brief The points to transform. */
+    vec3_soa points;
+
+    /** @brief The left-hand matrices. */
+    mat4* a;
+
+    /** @brief The right-hand matrices. */
+    mat4* b;
+
+    /** @brief The products. */
+    mat4* out;
+
+    /** @brief The transform applied to the points and premultiplied to the matrices. */
+    mat4 transform;
+
+    /** @brief The number of points, and of matrices in each array. */
+    u32 count;
+} math_bench_state;
+
+static math_bench_state bench_state;
+
+static void* math_bench_setup(u64 count) {
+    bench_state.count = (u32)count;
+    vec3_soa_create(bench_state.count, &bench_state.points);
+    bench_state.points.count = bench_state.count;
+    bench_state.a = kallocate_aligned(sizeof(mat4) * count, 16, MEMORY_TAG_ARRAY);
+    bench_state.b = kallocate_aligned(sizeof(mat4) * count, 16, MEMORY_TAG_ARRAY);
+    bench_state.out = kallocate_aligned(sizeof(mat4) * count, 16, MEMORY_TAG_ARRAY);
+
+    quat rotation = quat_from_axis_angle(vec3_up(), 0.5f);
+    bench_state.transform = mat4_from_trs(vec3_create(1.0f, 2.0f, 3.0f), rotation, vec3_one());
+    for (u32 i = 0; i < bench_state.count; ++i) {
+        bench_state.points.x[i] = (f32)i;
+        bench_state.points.y[i] = (f32)(i & 255);
+        bench_state.points.z[i] = -(f32)i;
+        bench_state.a[i] = mat4_from_trs(vec3_create((f32)i, 0.0f, 0.0f), rotation, vec3_one());
+        bench_state.b[i] = mat4_translation(vec3_create(0.0f, (f32)i, 0.0f));
+    }
+    return &bench_state;
+}
+
+static void math_bench_teardown(void* user_data) {
+    kfree_aligned(bench_state.out, sizeof(mat4) * bench_state.count, 16, MEMORY_TAG_ARRAY);
+    kfree_aligned(bench_state.b, sizeof(mat4) * bench_state.count, 16, MEMORY_TAG_ARRAY);
+    kfree_aligned(bench_state.a, sizeof(mat4) * bench_state.count, 16, MEMORY_TAG_ARRAY);
+    vec3_soa_destroy(&bench_state.points);
+}
+
+static void bench_transform_points(void* user_data, u64 iterations) {
+    math_bench_state* state = user_data;
+    for (u64 i = 0; i < iterations; i += state->count) {
+        kmath_transform_points(&state->transform, &state->points, &state->points);
+    }
+    bench_do_not_optimize(state->points.x);
+}
+
+static void bench_transform_points_loop(void* user_data, u64 iterations) {
+    math_bench_state* state = user_data;
+    vec3_soa* points = &state->points;
+    for (u64 i = 0; i < iterations; i += state->count) {
+        for (u32 p = 0; p < points->count; ++p) {
+            vec3 result = mat4_transform_point(&state->transform, vec3_create(points->x[p], points->y[p], points->z[p]));
+            points->x[p] = result.x;
+            points->y[p] = result.y;
+            points->z[p] = result.z;
+        }
+    }
+    bench_do_not_optimize(points->x);
+}
+
+static void bench_mat4_mul_batch(void* user_data, u64 iterations) {
+    math_bench_state* state = user_data;
+    for (u64 i = 0; i < iterations; i += state->count) {
+        kmath_mat4_mul_batch(state->a, state->b, state->out, state->count);
+    }
+    bench_do_not_optimize(state->out);
+}
+
+static void bench_mat4_premul_batch(void* user_data, u64 iterations) {
+    math_bench_state* state = user_data;
+    for (u64 i = 0; i < iterations; i += state->count) {
+        kmath_mat4_premul_batch(&state->transform, state->a, state->out, state->count);
+    }
+    bench_do_not_optimize(state->out);
+}
+
+static void bench_mat4_mul_loop(void* user_data, u64 iterations) {
+    math_bench_state* state = user_data;
+    for (u64 i = 0; i < iterations; i += state->count) {
+        for (u32 m = 0; m < state->count; ++m) {
+            state->out[m] = mat4_mul(&state->a[m], &state->b[m]);
+        }
+    }
+    bench_do_not_optimize(state->out);
+}
+
+void bench_register_math(bench_suite* suite) {
+    const u64 counts[] = {1024, 65536};
+    for (u32 i = 0; i < sizeof(counts) / sizeof(counts[0]); ++i) {
+        u64 count = counts[i];
+        // Each run processes `count` points or matrices, so samples are whole multiples of it.
+        bench_suite_add(suite, (bench_case){"math", "transform_points", count, count * 64, math_bench_setup, bench_transform_points, math_bench_teardown});
+        bench_suite_add(suite, (bench_case){"math", "transform_points_loop", count, count * 64, math_bench_setup, bench_transform_points_loop, math_bench_teardown});
+        bench_suite_add(suite, (bench_case){"math", "mat4_mul_batch", count, count * 16, math_bench_setup, bench_mat4_mul_batch, math_bench_teardown});
+        bench_suite_add(suite, (bench_case){"math", "mat4_premul_batch", count, count * 16, math_bench_setup, bench_mat4_premul_batch, math_bench_teardown});
+        bench_suite_add(suite, (bench_case){"math", "mat4_mul_loop", count, count * 16, math_bench_setup, bench_mat4_mul_loop, math_bench_teardown});
+    }
+}
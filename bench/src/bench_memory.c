@@ -0,0 +1,178 @@
+/**
+ * @file bench_memory.c
+ * @brief This file contains the allocator and bulk memory benchmarks.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "bench.h"
+
+#include <core/kmemory.h>
+#include <core/linear_allocator.h>
+#include <core/pool_allocator.h>
+
+/**
+ * @struct memory_bench_state
+ * @brief The state shared by the memory benchmarks.
+ */
+typedef struct memory_bench_state {
+    /** @brief The block size the case works on. */
+    u64 size;
+
+    /** @brief The arena of the linear allocator cases. */
+    linear_allocator arena;
+
+    /** @brief The pool of the pool allocator cases. */
+    pool_allocator pool;
+
+    /** @brief The source block of the bulk memory cases. */
+    void* src;
+
+    /** @brief The destination block of the bulk memory cases. */
+    void* dest;
+} memory_bench_state;
+
+static void* memory_bench_setup(u64 size) {
+    memory_bench_state* state = kallocate(sizeof(memory_bench_state), MEMORY_TAG_APPLICATION);
+    state->size = size;
+    return state;
+}
+
+static void memory_bench_teardown(void* user_data) {
+    kfree(user_data, sizeof(memory_bench_state), MEMORY_TAG_APPLICATION);
+}
+
+static void bench_kallocate_kfree(void* user_data, u64 iterations) {
+    u64 size = ((memory_bench_state*)user_data)->size;
+    for (u64 i = 0; i < iterations; ++i) {
+        void* block = kallocate(size, MEMORY_TAG_APPLICATION);
+        bench_do_not_optimize(block);
+        kfree(block, size, MEMORY_TAG_APPLICATION);
+    }
+}
+
+static void bench_kallocate_uninit_kfree(void* user_data, u64 iterations) {
+    u64 size = ((memory_bench_state*)user_data)->size;
+    for (u64 i = 0; i < iterations; ++i) {
+        void* block = kallocate_uninit(size, MEMORY_TAG_APPLICATION);
+        bench_do_not_optimize(block);
+        kfree(block, size, MEMORY_TAG_APPLICATION);
+    }
+}
+
+static void* linear_bench_setup(u64 size) {
+    memory_bench_state* state = memory_bench_setup(size);
+    linear_allocator_create(1024 * 1024, 0, &state->arena);
+    return state;
+}
+
+static void linear_bench_teardown(void* user_data) {
+    linear_allocator_destroy(&((memory_bench_state*)user_data)->arena);
+    memory_bench_teardown(user_data);
+}
+
+static void bench_linear_allocate(void* user_data, u64 iterations) {
+    memory_bench_state* state = user_data;
+    for (u64 i = 0; i < iterations; ++i) {
+        void* block = linear_allocator_allocate(&state->arena, state->size);
+        if (!block) {
+            // The arena is used up; reset it, as a frame allocator would.
+            linear_allocator_free_all(&state->arena);
+            block = linear_allocator_allocate(&state->arena, state->size);
+        }
+        bench_do_not_optimize(block);
+    }
+}
+
+static void* pool_bench_setup(u64 size) {
+    memory_bench_state* state = memory_bench_setup(size);
+    pool_allocator_config config = {0};
+    config.element_size = size;
+    config.element_count = 1024;
+    config.growth = POOL_GROWTH_NONE;
+    config.tag = MEMORY_TAG_APPLICATION;
+    pool_allocator_create(&config, &state->pool);
+    return state;
+}
+
+static void pool_bench_teardown(void* user_data) {
+    pool_allocator_destroy(&((memory_bench_state*)user_data)->pool);
+    memory_bench_teardown(user_data);
+}
+
+static void bench_pool_allocate_free(void* user_data, u64 iterations) {
+    memory_bench_state* state = user_data;
+    for (u64 i = 0; i < iterations; ++i) {
+        void* block = pool_allocator_allocate(&state->pool);
+        bench_do_not_optimize(block);
+        pool_allocator_free(&state->pool, block);
+    }
+}
+
+static void* bulk_bench_setup(u64 size) {
+    memory_bench_state* state = memory_bench_setup(size);
+    state->src = kallocate(size, MEMORY_TAG_APPLICATION);
+    state->dest = kallocate(size, MEMORY_TAG_APPLICATION);
+    kset_memory(state->src, 0x5A, size);
+    return state;
+}
+
+static void bulk_bench_teardown(void* user_data) {
+    memory_bench_state* state = user_data;
+    kfree(state->src, state->size, MEMORY_TAG_APPLICATION);
+    kfree(state->dest, state->size, MEMORY_TAG_APPLICATION);
+    memory_bench_teardown(user_data);
+}
+
+static void bench_kcopy_memory(void* user_data, u64 iterations) {
+    memory_bench_state* state = user_data;
+    for (u64 i = 0; i < iterations; ++i) {
+        kcopy_memory(state->dest, state->src, state->size);
+        bench_do_not_optimize(state->dest);
+    }
+}
+
+static void bench_kmemory_stream_copy(void* user_data, u64 iterations) {
+    memory_bench_state* state = user_data;
+    for (u64 i = 0; i < iterations; ++i) {
+        kmemory_stream_copy(state->dest, state->src, state->size);
+        bench_do_not_optimize(state->dest);
+    }
+}
+
+static void bench_kset_memory(void* user_data, u64 iterations) {
+    memory_bench_state* state = user_data;
+    for (u64 i = 0; i < iterations; ++i) {
+        kset_memory(state->dest, (i32)i, state->size);
+        bench_do_not_optimize(state->dest);
+    }
+}
+
+static void bench_kmemory_stream_set(void* user_data, u64 iterations) {
+    memory_bench_state* state = user_data;
+    for (u64 i = 0; i < iterations; ++i) {
+        kmemory_stream_set(state->dest, (i32)i, state->size);
+        bench_do_not_optimize(state->dest);
+    }
+}
+
+void bench_register_memory(bench_suite* suite) {
+    const u64 allocation_sizes[] = {64, 4096};
+    for (u32 i = 0; i < sizeof(allocation_sizes) / sizeof(allocation_sizes[0]); ++i) {
+        u64 size = allocation_sizes[i];
+        bench_suite_add(suite, (bench_case){"memory", "kallocate_kfree", size, 0, memory_bench_setup, bench_kallocate_kfree, memory_bench_teardown});
+        bench_suite_add(suite, (bench_case){"memory", "kallocate_uninit_kfree", size, 0, memory_bench_setup, bench_kallocate_uninit_kfree, memory_bench_teardown});
+        bench_suite_add(suite, (bench_case){"memory", "linear_allocate", size, 0, linear_bench_setup, bench_linear_allocate, linear_bench_teardown});
+        bench_suite_add(suite, (bench_case){"memory", "pool_allocate_free", size, 0, pool_bench_setup, bench_pool_allocate_free, pool_bench_teardown});
+    }
+
+    // From cache-resident blocks up to blocks far larger than the last-level cache,
+    // to show where streaming stores start to win over libc.
+    const u64 bulk_sizes[] = {4096, 64 * 1024, 1024 * 1024, 16 * 1024 * 1024, 64 * 1024 * 1024};
+    for (u32 i = 0; i < sizeof(bulk_sizes) / sizeof(bulk_sizes[0]); ++i) {
+        u64 size = bulk_sizes[i];
+        bench_suite_add(suite, (bench_case){"memory", "kcopy_memory", size, 0, bulk_bench_setup, bench_kcopy_memory, bulk_bench_teardown});
+        bench_suite_add(suite, (bench_case){"memory", "kmemory_stream_copy", size, 0, bulk_bench_setup, bench_kmemory_stream_copy, bulk_bench_teardown});
+        bench_suite_add(suite, (bench_case){"memory", "kset_memory", size, 0, bulk_bench_setup, bench_kset_memory, bulk_bench_teardown});
+        bench_suite_add(suite, (bench_case){"memory", "kmemory_stream_set", size, 0, bulk_bench_setup, bench_kmemory_stream_set, bulk_bench_teardown});
+    }
+}
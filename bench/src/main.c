@@ -0,0 +1,114 @@
+/**
+ * @file main.c
+ * @brief This file contains the entry point of the microbenchmark suite.
+ *
+ * @details Usage: bench [--check] [--filter text] [--samples n] [--warmup n] [--csv path] [--json path]
+ *
+ * Every registered case whose "group/name" contains the filter text is run and printed as a
+ * table row. With --csv or --json, the results are also written to the given file. With --check,
+ * the matching checks are run instead of the cases, and the exit code is 1 if any of them fails.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "bench.h"
+
+#include <core/kmemory.h>
+#include <core/logger.h>
+#include <math/kmath.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** @brief The default number of recorded samples per case. */
+#define BENCH_DEFAULT_SAMPLES 100
+
+/** @brief The default number of unrecorded warmup samples per case. */
+#define BENCH_DEFAULT_WARMUP_SAMPLES 10
+
+/** @brief The default minimum duration of a calibrated sample, in seconds. */
+#define BENCH_DEFAULT_MIN_SAMPLE_SECONDS 0.001
+
+static void print_usage() {
+    printf("Usage: bench [--check] [--filter text] [--samples n] [--warmup n] [--csv path] [--json path]\n");
+}
+
+int main(int argc, char** argv) {
+    bench_config config = {0};
+    config.warmup_samples = BENCH_DEFAULT_WARMUP_SAMPLES;
+    config.samples = BENCH_DEFAULT_SAMPLES;
+    config.min_sample_seconds = BENCH_DEFAULT_MIN_SAMPLE_SECONDS;
+
+    const char* csv_path = 0;
+    const char* json_path = 0;
+    b8 run_checks = FALSE;
+    for (int i = 1; i < argc; ++i) {
+        b8 has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--check") == 0) {
+            run_checks = TRUE;
+        } else if (strcmp(argv[i], "--filter") == 0 && has_value) {
+            config.filter = argv[++i];
+        } else if (strcmp(argv[i], "--samples") == 0 && has_value) {
+            config.samples = (u32)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--warmup") == 0 && has_value) {
+            config.warmup_samples = (u32)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--csv") == 0 && has_value) {
+            csv_path = argv[++i];
+        } else if (strcmp(argv[i], "--json") == 0 && has_value) {
+            json_path = argv[++i];
+        } else {
+            print_usage();
+            return 1;
+        }
+    }
+
+    initialize_memory();
+    initialize_logging();
+    KINFO("Streaming memory path: %s", kmemory_stream_path_name());
+    KINFO("Math batch kernel path: %s", kmath_simd_path_name());
+
+    static bench_suite suite;
+    bench_register_memory(&suite);
+    bench_register_logger(&suite);
+    bench_register_event(&suite);
+    bench_register_containers(&suite);
+    bench_register_kstring(&suite);
+    bench_register_ecs(&suite);
+    bench_register_math(&suite);
+    bench_register_checks(&suite);
+
+    if (run_checks) {
+        b8 passed = bench_run_checks(&config, &suite);
+        shutdown_logging();
+        shutdown_memory();
+        return passed ? 0 : 1;
+    }
+
+    static bench_result results[BENCH_MAX_CASES];
+    u32 result_count = 0;
+
+    bench_print_header();
+    for (u32 i = 0; i < suite.count; ++i) {
+        const bench_case* bench = &suite.cases[i];
+        if (!bench_matches(&config, bench)) {
+            continue;
+        }
+        if (bench_run(&config, bench, &results[result_count])) {
+            bench_print_result(&results[result_count]);
+            fflush(stdout);
+            result_count++;
+        }
+    }
+
+    b8 written = TRUE;
+    if (csv_path) {
+        written &= bench_write_csv(csv_path, results, result_count);
+    }
+    if (json_path) {
+        written &= bench_write_json(json_path, results, result_count);
+    }
+
+    shutdown_logging();
+    shutdown_memory();
+    return written ? 0 : 1;
+}
@@ -21,8 +21,8 @@ ECHO Building everything...
 
 REM Define a space-separated list of components (assemblies) to build.
 REM The order is critical: 'engine' must be built before 'testbed' because
-REM testbed depends on the library file (engine.lib) created by the engine build.
-SET assemblies=engine testbed
+REM testbed, bench and packer depend on the library file (engine.lib) created by the engine build.
+SET assemblies=engine testbed bench packer
 
 REM Enable delayed expansion to correctly read the ERRORLEVEL variable inside the loop.
 SETLOCAL ENABLEDELAYEDEXPANSION
@@ -22,8 +22,8 @@ echo "Building everything..."
 
 # Define an array of components (assemblies) to build.
 # The order is critical: 'engine' must be built before 'testbed' because
-# testbed depends on the shared object (libengine.so) created by the engine build.
-assemblies=("engine" "testbed")
+# testbed, bench and packer depend on the shared object (libengine.so) created by the engine build.
+assemblies=("engine" "testbed" "bench" "packer")
 
 # Loop through each assembly defined in the 'assemblies' array.
 for assembly in "${assemblies[@]}"; do
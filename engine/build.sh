@@ -54,12 +54,14 @@ includeFlags="-Isrc -I$VULKAN_SDK/include"
 # -I$VULKAN_SDK/include     : Search for headers in the Vulkan SDK's 'include' directory.
 
 # Libraries and their directories for the linker.
-linkerFlags="-L$VULKAN_SDK/lib -L/usr/lib/x86_64-linux-gnu -lvulkan -lxcb -lX11 -lX11-xcb -lxkbcommon"
+linkerFlags="-L$VULKAN_SDK/lib -L/usr/lib/x86_64-linux-gnu -lvulkan -lxcb -lX11 -lX11-xcb -lxkbcommon -lpthread -lm"
 # -lvulkan                      : Link against the Vulkan library.
 # -lxcb                         : Link against the XCB library (X protocol C-language Binding).
 # -lX11                         : Link against the main X11 library (Xlib, high-level interface to X11 protocol)
 # -lX11-xcb                     : Link against the X11-XCB integration library.
 # -lxkbcommon-x11               : Link against the XKB common library for advanced keyboard handling.
+# -lpthread                     : Link against POSIX threads (threads and semaphores in the platform layer).
+# -lm                           : Link against the C math library (trigonometry in kmath.c).
 # -L$VULKAN_SDK/lib             : Add the Vulkan SDK 'lib' directory to the linker's search paths.
 # -L/usr/lib/x86_64-linux-gnu   : Add standard 64-bit Linux lib directory to linker's search path.
 
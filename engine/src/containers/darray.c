@@ -0,0 +1,261 @@
+/**
+ * @file darray.c
+ * @brief This file contains the implementation of the engine's generic dynamic array.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "containers/darray.h"
+
+#include "core/kmemory.h"
+#include "core/logger.h"
+#include "core/linear_allocator.h"
+
+/** @brief The smallest growth factor accepted. Anything lower would make growth too frequent. */
+#define DARRAY_MIN_GROWTH_FACTOR 1.1f
+
+/**
+ * @struct darray_header
+ * @brief The bookkeeping stored directly in front of a darray's first element.
+ */
+typedef struct darray_header {
+    /** @brief The number of elements the storage can hold. */
+    u64 capacity;
+
+    /** @brief The number of elements in use. */
+    u64 length;
+
+    /** @brief The size of a single element in bytes. */
+    u64 stride;
+
+    /** @brief The linear allocator the storage came from, or 0 if it came from kallocate. */
+    struct linear_allocator* allocator;
+
+    /** @brief The factor the capacity is multiplied by when the array runs out of space. */
+    f32 growth_factor;
+
+    /** @brief Pads the header to a multiple of 16 bytes, so the elements keep the allocation's alignment. */
+    u8 padding[12];
+} darray_header;
+
+STATIC_ASSERT(sizeof(darray_header) % 16 == 0, "darray_header must keep elements 16-byte aligned");
+
+/** @brief Gets the header of a darray. */
+static darray_header* darray_get_header(const void* array) {
+    return ((darray_header*)array) - 1;
+}
+
+/** @brief Gets the size of the whole allocation backing a darray of the given capacity. */
+static u64 darray_allocation_size(u64 capacity, u64 stride) {
+    return sizeof(darray_header) + capacity * stride;
+}
+
+/**
+ * @brief Allocates storage for a darray with the given header fields.
+ * @return A pointer to the new header, or 0 on failure.
+ */
+static darray_header* darray_allocate(u64 capacity, u64 stride, struct linear_allocator* allocator) {
+    u64 size = darray_allocation_size(capacity, stride);
+
+    // The elements are uninitialized until pushed, so skip the zeroing pass.
+    darray_header* header = allocator ? linear_allocator_allocate(allocator, size) : kallocate_uninit(size, MEMORY_TAG_DARRAY);
+    if (!header) {
+        return 0;
+    }
+
+    header->capacity = capacity;
+    header->length = 0;
+    header->stride = stride;
+    header->allocator = allocator;
+    header->growth_factor = DARRAY_DEFAULT_GROWTH_FACTOR;
+    return header;
+}
+
+/**
+ * @brief Releases a darray's storage. Storage from a linear allocator is reclaimed on the allocator's reset instead.
+ */
+static void darray_release(darray_header* header) {
+    if (!header->allocator) {
+        kfree(header, darray_allocation_size(header->capacity, header->stride), MEMORY_TAG_DARRAY);
+    }
+}
+
+void* _darray_create(u64 capacity, u64 stride, struct linear_allocator* allocator) {
+    if (stride == 0) {
+        KERROR("_darray_create - stride must be greater than 0.");
+        return 0;
+    }
+
+    darray_header* header = darray_allocate(capacity ? capacity : DARRAY_DEFAULT_CAPACITY, stride, allocator);
+    if (!header) {
+        KERROR("_darray_create - failed to allocate storage for %llu elements of %llu bytes.", capacity, stride);
+        return 0;
+    }
+
+    return header + 1;
+}
+
+void _darray_destroy(void* array) {
+    if (array) {
+        darray_release(darray_get_header(array));
+    }
+}
+
+u64 _darray_capacity(const void* array) {
+    return darray_get_header(array)->capacity;
+}
+
+u64 _darray_length(const void* array) {
+    return darray_get_header(array)->length;
+}
+
+u64 _darray_stride(const void* array) {
+    return darray_get_header(array)->stride;
+}
+
+void _darray_length_set(void* array, u64 length) {
+    darray_header* header = darray_get_header(array);
+    if (length > header->capacity) {
+        KERROR("_darray_length_set - length %llu exceeds capacity %llu.", length, header->capacity);
+        return;
+    }
+    header->length = length;
+}
+
+void _darray_growth_factor_set(void* array, f32 growth_factor) {
+    darray_get_header(array)->growth_factor = growth_factor < DARRAY_MIN_GROWTH_FACTOR ? DARRAY_MIN_GROWTH_FACTOR : growth_factor;
+}
+
+/**
+ * @brief Moves the array into new storage of exactly `capacity` elements.
+ * @return The moved array, or 0 on failure (the original array is left intact).
+ */
+static void* darray_resize(void* array, u64 capacity) {
+    darray_header* header = darray_get_header(array);
+    darray_header* new_header = darray_allocate(capacity, header->stride, header->allocator);
+    if (!new_header) {
+        KERROR("darray_resize - failed to grow to %llu elements.", capacity);
+        return 0;
+    }
+
+    new_header->length = header->length;
+    new_header->growth_factor = header->growth_factor;
+    kcopy_memory(new_header + 1, array, header->length * header->stride);
+
+    darray_release(header);
+    return new_header + 1;
+}
+
+void* _darray_reserve(void* array, u64 capacity) {
+    if (capacity <= darray_get_header(array)->capacity) {
+        return array;
+    }
+    return darray_resize(array, capacity);
+}
+
+/**
+ * @brief Makes room for at least `additional` more elements, growing by the growth factor.
+ * @return The array, which may have moved, or 0 on failure.
+ */
+static void* darray_grow_for(void* array, u64 additional) {
+    darray_header* header = darray_get_header(array);
+    u64 required = header->length + additional;
+    if (required <= header->capacity) {
+        return array;
+    }
+
+    // Grow geometrically so repeated pushes stay amortized O(1), but never below what is needed now.
+    u64 grown = (u64)((f32)header->capacity * header->growth_factor) + 1;
+    return darray_resize(array, grown > required ? grown : required);
+}
+
+void* _darray_push_n(void* array, const void* values, u64 count) {
+    void* grown = darray_grow_for(array, count);
+    if (!grown) {
+        KERROR("_darray_push_n - %llu elements were not appended.", count);
+        return 0;
+    }
+
+    darray_header* header = darray_get_header(grown);
+    kcopy_memory((u8*)grown + header->length * header->stride, values, count * header->stride);
+    header->length += count;
+    return grown;
+}
+
+void* _darray_insert_range(void* array, u64 index, const void* values, u64 count) {
+    u64 length = darray_get_header(array)->length;
+    if (index > length) {
+        KERROR("_darray_insert_range - index %llu is out of bounds (length %llu).", index, length);
+        return 0;
+    }
+
+    void* grown = darray_grow_for(array, count);
+    if (!grown) {
+        KERROR("_darray_insert_range - %llu elements were not inserted.", count);
+        return 0;
+    }
+
+    darray_header* header = darray_get_header(grown);
+    u8* base = (u8*)grown;
+    u64 stride = header->stride;
+
+    // Shift the tail up in one move, then copy the new elements into the gap.
+    if (index < length) {
+        kmove_memory(base + (index + count) * stride, base + index * stride, (length - index) * stride);
+    }
+    kcopy_memory(base + index * stride, values, count * stride);
+    header->length += count;
+    return grown;
+}
+
+void _darray_pop(void* array, void* dest) {
+    darray_header* header = darray_get_header(array);
+    if (header->length == 0) {
+        KWARN("_darray_pop called on an empty array.");
+        return;
+    }
+
+    header->length--;
+    if (dest) {
+        kcopy_memory(dest, (u8*)array + header->length * header->stride, header->stride);
+    }
+}
+
+void _darray_pop_at(void* array, u64 index, void* dest) {
+    darray_header* header = darray_get_header(array);
+    if (index >= header->length) {
+        KERROR("_darray_pop_at - index %llu is out of bounds (length %llu).", index, header->length);
+        return;
+    }
+
+    u8* base = (u8*)array;
+    u64 stride = header->stride;
+    if (dest) {
+        kcopy_memory(dest, base + index * stride, stride);
+    }
+
+    // Shift the tail down in one move to close the gap.
+    if (index < header->length - 1) {
+        kmove_memory(base + index * stride, base + (index + 1) * stride, (header->length - index - 1) * stride);
+    }
+    header->length--;
+}
+
+void _darray_swap_remove(void* array, u64 index, void* dest) {
+    darray_header* header = darray_get_header(array);
+    if (index >= header->length) {
+        KERROR("_darray_swap_remove - index %llu is out of bounds (length %llu).", index, header->length);
+        return;
+    }
+
+    u8* base = (u8*)array;
+    u64 stride = header->stride;
+    if (dest) {
+        kcopy_memory(dest, base + index * stride, stride);
+    }
+
+    u64 last = header->length - 1;
+    if (index != last) {
+        kcopy_memory(base + index * stride, base + last * stride, stride);
+    }
+    header->length--;
+}
@@ -0,0 +1,192 @@
+#pragma once
+
+/**
+ * @file darray.h
+ * @brief This file contains the engine's generic dynamic array.
+ *
+ * @details A darray is a plain, contiguous C array of any element type, so it can be
+ * indexed with `array[i]` and walked linearly. A small header holding the capacity,
+ * length, stride and growth policy is stored directly in front of the first element.
+ * Because operations that grow the array may move it, every macro that can grow takes
+ * the array variable itself and reassigns it. If growing fails, the variable keeps
+ * pointing at the untouched original array and the macro evaluates to FALSE.
+ *
+ * Storage comes from kallocate under MEMORY_TAG_DARRAY, or optionally from a linear
+ * allocator for arrays that live no longer than the arena (e.g. per-frame lists).
+ *
+ * @code
+ * entity* entities = darray_create(entity);
+ * darray_push(entities, new_entity);
+ * for (u64 i = 0; i < darray_length(entities); ++i) { update(&entities[i]); }
+ * darray_destroy(entities);
+ * @endcode
+ * @copyright Copyright (c) 2025
+ */
+
+#include "defines.h"
+
+struct linear_allocator;
+
+/** @brief The capacity of a darray created without an explicit one. */
+#define DARRAY_DEFAULT_CAPACITY 1
+
+/** @brief The factor the capacity is multiplied by when a darray runs out of space. */
+#define DARRAY_DEFAULT_GROWTH_FACTOR 2.0f
+
+
+/**
+ * @brief Creates a darray. Prefer the darray_create / darray_reserve macros.
+ * @param capacity The number of elements to reserve space for.
+ * @param stride The size of a single element in bytes.
+ * @param allocator An optional linear allocator to take storage from, or 0 to use kallocate.
+ * @return A pointer to the first element of the new, empty array, or 0 on failure.
+ */
+KAPI void* _darray_create(u64 capacity, u64 stride, struct linear_allocator* allocator);
+
+/**
+ * @brief Destroys a darray and releases its storage (unless it came from a linear allocator).
+ * @param array The array to destroy. May be 0.
+ */
+KAPI void _darray_destroy(void* array);
+
+/** @brief Gets the number of elements the array can hold without growing. */
+KAPI u64 _darray_capacity(const void* array);
+
+/** @brief Gets the number of elements in the array. */
+KAPI u64 _darray_length(const void* array);
+
+/** @brief Gets the size of a single element in bytes. */
+KAPI u64 _darray_stride(const void* array);
+
+/**
+ * @brief Sets the number of elements in the array. The new length must not exceed the capacity.
+ * @details Useful after writing directly into reserved space.
+ */
+KAPI void _darray_length_set(void* array, u64 length);
+
+/**
+ * @brief Sets the factor the capacity is multiplied by when the array runs out of space.
+ * @param growth_factor The new factor. Values below 1.1 are raised to 1.1, so growth stays amortized O(1).
+ */
+KAPI void _darray_growth_factor_set(void* array, f32 growth_factor);
+
+/**
+ * @brief Ensures the array can hold at least `capacity` elements without growing again.
+ * @return The array, which may have moved, or 0 on failure (the original array is left intact).
+ */
+KAPI void* _darray_reserve(void* array, u64 capacity);
+
+/**
+ * @brief Appends `count` elements from `values` to the end of the array.
+ * @return The array, which may have moved, or 0 on failure (the original array is left unchanged).
+ */
+KAPI void* _darray_push_n(void* array, const void* values, u64 count);
+
+/**
+ * @brief Inserts `count` elements from `values` before `index`, shifting the elements behind it.
+ * @return The array, which may have moved, or 0 on failure (the original array is left unchanged).
+ */
+KAPI void* _darray_insert_range(void* array, u64 index, const void* values, u64 count);
+
+/**
+ * @brief Removes the last element, copying it to `dest` if it is not 0.
+ */
+KAPI void _darray_pop(void* array, void* dest);
+
+/**
+ * @brief Removes the element at `index`, shifting the elements behind it down to keep their order.
+ * @param dest If not 0, receives a copy of the removed element.
+ */
+KAPI void _darray_pop_at(void* array, u64 index, void* dest);
+
+/**
+ * @brief Removes the element at `index` by moving the last element into its place. O(1), but does not keep order.
+ * @param dest If not 0, receives a copy of the removed element.
+ */
+KAPI void _darray_swap_remove(void* array, u64 index, void* dest);
+
+
+/** @brief Creates an empty darray of the given element type. */
+#define darray_create(type) \
+    _darray_create(DARRAY_DEFAULT_CAPACITY, sizeof(type), 0)
+
+/** @brief Creates an empty darray of the given element type with space for `capacity` elements. */
+#define darray_reserve(type, capacity) \
+    _darray_create(capacity, sizeof(type), 0)
+
+/**
+ * @brief Creates an empty darray whose storage comes from a linear allocator.
+ * Storage given up by growing is only reclaimed when the allocator is reset, so reserve
+ * a realistic capacity up front.
+ */
+#define darray_create_with_allocator(type, capacity, allocator) \
+    _darray_create(capacity, sizeof(type), allocator)
+
+/** @brief Destroys a darray. */
+#define darray_destroy(array) _darray_destroy(array)
+
+/**
+ * @brief Reassigns `array` to `result` unless it is 0, i.e. the operation failed.
+ * Evaluates to `b8 TRUE` on success, otherwise `b8 FALSE`.
+ */
+#define _darray_assign(array, result)            \
+    ({                                           \
+        void* darray_result = (result);          \
+        if (darray_result) {                     \
+            array = darray_result;               \
+        }                                        \
+        (b8)(darray_result != 0);                \
+    })
+
+/** @brief Ensures the array can hold `capacity` elements. Reassigns `array`. Evaluates to `b8 FALSE` on failure. */
+#define darray_reserve_capacity(array, capacity) \
+    _darray_assign(array, _darray_reserve(array, capacity))
+
+/** @brief Appends a single value. Reassigns `array`. Evaluates to `b8 FALSE` on failure. */
+#define darray_push(array, value)                                        \
+    ({                                                                   \
+        __typeof__(value) darray_temp = value;                           \
+        _darray_assign(array, _darray_push_n(array, &darray_temp, 1));   \
+    })
+
+/** @brief Appends `count` values from the pointer `values`. Reassigns `array`. Evaluates to `b8 FALSE` on failure. */
+#define darray_push_n(array, values, count) \
+    _darray_assign(array, _darray_push_n(array, values, count))
+
+/** @brief Inserts a single value before `index`. Reassigns `array`. Evaluates to `b8 FALSE` on failure. */
+#define darray_insert_at(array, index, value)                                        \
+    ({                                                                               \
+        __typeof__(value) darray_temp = value;                                       \
+        _darray_assign(array, _darray_insert_range(array, index, &darray_temp, 1));  \
+    })
+
+/** @brief Inserts `count` values from the pointer `values` before `index`. Reassigns `array`. Evaluates to `b8 FALSE` on failure. */
+#define darray_insert_range(array, index, values, count) \
+    _darray_assign(array, _darray_insert_range(array, index, values, count))
+
+/** @brief Removes the last element into `value_ptr` (may be 0). */
+#define darray_pop(array, value_ptr) _darray_pop(array, value_ptr)
+
+/** @brief Removes the element at `index` into `value_ptr` (may be 0), keeping order. */
+#define darray_pop_at(array, index, value_ptr) _darray_pop_at(array, index, value_ptr)
+
+/** @brief Removes the element at `index` into `value_ptr` (may be 0) in O(1), without keeping order. */
+#define darray_swap_remove(array, index, value_ptr) _darray_swap_remove(array, index, value_ptr)
+
+/** @brief Removes every element, keeping the storage. */
+#define darray_clear(array) _darray_length_set(array, 0)
+
+/** @brief Gets the number of elements. */
+#define darray_length(array) _darray_length(array)
+
+/** @brief Gets the capacity in elements. */
+#define darray_capacity(array) _darray_capacity(array)
+
+/** @brief Gets the element size in bytes. */
+#define darray_stride(array) _darray_stride(array)
+
+/** @brief Sets the number of elements. */
+#define darray_length_set(array, length) _darray_length_set(array, length)
+
+/** @brief Sets the growth factor. */
+#define darray_growth_factor_set(array, growth_factor) _darray_growth_factor_set(array, growth_factor)
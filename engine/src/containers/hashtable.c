@@ -0,0 +1,422 @@
+/**
+ * @file hashtable.c
+ * @brief This file contains the implementation of the engine's open-addressing hash table.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "containers/hashtable.h"
+
+#include "core/kmemory.h"
+#include "core/logger.h"
+
+#include <string.h>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+    #include <intrin.h>
+#endif
+
+/** @brief The control byte of a slot that never held an entry. Ends a probe. */
+#define CTRL_EMPTY 0x80
+
+/** @brief The control byte of a slot whose entry was removed. Does not end a probe. */
+#define CTRL_DELETED 0xFE
+
+/** @brief The low bit of every byte in a group word. */
+#define GROUP_LSBS 0x0101010101010101ULL
+
+/** @brief The high bit of every byte in a group word. */
+#define GROUP_MSBS 0x8080808080808080ULL
+
+/**
+ * @brief Loads the 8 control bytes of a group, with slot `i` in byte `i` (counting from the low end)
+ * regardless of the host's byte order. Compiles to a single load on little-endian targets.
+ */
+static inline u64 group_load(const u8* control) {
+    return (u64)control[0] | ((u64)control[1] << 8) | ((u64)control[2] << 16) | ((u64)control[3] << 24) |
+           ((u64)control[4] << 32) | ((u64)control[5] << 40) | ((u64)control[6] << 48) | ((u64)control[7] << 56);
+}
+
+/**
+ * @brief Gets a mask with the high bit set in every byte equal to `h2`.
+ * @details May also flag a full byte directly above a real match. Matches are always
+ * confirmed against the full key, so such false positives only cost a compare.
+ */
+static inline u64 group_match(u64 group, u8 h2) {
+    u64 x = group ^ (GROUP_LSBS * h2);
+    return (x - GROUP_LSBS) & ~x & GROUP_MSBS;
+}
+
+/** @brief Gets a mask with the high bit set in every empty byte. Only CTRL_EMPTY has bit 7 set and bit 1 clear. */
+static inline u64 group_match_empty(u64 group) {
+    return group & ~(group << 6) & GROUP_MSBS;
+}
+
+/** @brief Gets a mask with the high bit set in every empty or deleted byte. */
+static inline u64 group_match_free(u64 group) {
+    return group & GROUP_MSBS;
+}
+
+/** @brief Gets the index of the lowest byte flagged in a non-zero match mask. */
+static inline u32 group_first(u64 mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward64(&index, mask);
+    return (u32)index >> 3;
+#else
+    return (u32)__builtin_ctzll(mask) >> 3;
+#endif
+}
+
+/** @brief Gets the 7 hash bits stored in a full slot's control byte. */
+static inline u8 hash_h2(u64 hash) {
+    return (u8)(hash >> 57);
+}
+
+/** @brief Loads 8 bytes in little-endian order from a possibly unaligned address. */
+static inline u64 hash_load(const u8* p) {
+    return group_load(p);
+}
+
+/** @brief Mixes the bits of a 64-bit value so every input bit affects every output bit. */
+static inline u64 hash_mix(u64 h) {
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+u64 hashtable_hash(const void* data, u64 size) {
+    const u8* p = (const u8*)data;
+    u64 h = 0x9E3779B97F4A7C15ULL ^ (size * 0x87C37B91114253D5ULL);
+
+    for (; size >= 8; size -= 8, p += 8) {
+        u64 k = hash_load(p) * 0x87C37B91114253D5ULL;
+        k = (k << 31) | (k >> 33);
+        h ^= k * 0x4CF5AD432745937FULL;
+        h = ((h << 27) | (h >> 37)) * 5 + 0x52DCE729;
+    }
+
+    // Fold the remaining 0-7 bytes into one final word.
+    u64 tail = 0;
+    for (u64 i = 0; i < size; ++i) {
+        tail |= (u64)p[i] << (i * 8);
+    }
+    h ^= tail * 0x4CF5AD432745937FULL;
+
+    return hash_mix(h);
+}
+
+/** @brief Hashes a key name. */
+static inline u64 hashtable_hash_name(const char* name) {
+    return hashtable_hash(name, strlen(name));
+}
+
+/** @brief Rounds a requested slot count up to a valid capacity. */
+static u32 hashtable_round_capacity(u32 element_count) {
+    u32 capacity = HASHTABLE_GROUP_WIDTH;
+    while (capacity < element_count && capacity < 0x80000000u) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+/** @brief Gets the offset of the value array inside the memory block. */
+static u64 hashtable_values_offset(u32 capacity) {
+    // Control bytes first, then the keys (8-byte aligned, as the capacity is a multiple of 8), then the values.
+    return KALIGN_UP((u64)capacity * (1 + sizeof(u64)), 16);
+}
+
+/** @brief Gets the number of full plus deleted slots above which no more entries are accepted. */
+static u32 hashtable_max_load(u32 capacity) {
+    // Keeping at least 1/8 of the slots empty keeps probe sequences short.
+    return capacity - capacity / 8;
+}
+
+u64 hashtable_memory_requirement(u64 element_size, u32 element_count) {
+    u32 capacity = hashtable_round_capacity(element_count);
+    return hashtable_values_offset(capacity) + (u64)capacity * element_size;
+}
+
+b8 hashtable_create(u64 element_size, u32 element_count, void* memory, b8 is_pointer_type, hashtable* out_table) {
+    if (!out_table) {
+        KERROR("hashtable_create requires a valid pointer to a hashtable.");
+        return FALSE;
+    }
+    if (is_pointer_type) {
+        element_size = sizeof(void*);
+    }
+    if (element_size == 0) {
+        KERROR("hashtable_create - element_size must be greater than 0.");
+        return FALSE;
+    }
+
+    u32 capacity = hashtable_round_capacity(element_count);
+    u64 size = hashtable_memory_requirement(element_size, capacity);
+
+    out_table->owns_memory = memory == 0;
+    if (!memory) {
+        memory = kallocate_uninit(size, MEMORY_TAG_DICT);
+        if (!memory) {
+            KERROR("hashtable_create - failed to allocate %llu bytes.", size);
+            return FALSE;
+        }
+    }
+
+    out_table->element_size = element_size;
+    out_table->capacity = capacity;
+    out_table->is_pointer_type = is_pointer_type;
+    out_table->memory = memory;
+    out_table->control = (u8*)memory;
+    out_table->keys = (u64*)((u8*)memory + capacity);
+    out_table->values = (u8*)memory + hashtable_values_offset(capacity);
+    hashtable_clear(out_table);
+    return TRUE;
+}
+
+void hashtable_destroy(hashtable* table) {
+    if (!table) {
+        return;
+    }
+    if (table->owns_memory && table->memory) {
+        kfree(table->memory, hashtable_memory_requirement(table->element_size, table->capacity), MEMORY_TAG_DICT);
+    }
+    kzero_memory(table, sizeof(hashtable));
+}
+
+void hashtable_clear(hashtable* table) {
+    kset_memory(table->control, CTRL_EMPTY, table->capacity);
+    table->count = 0;
+    table->tombstones = 0;
+}
+
+/**
+ * @brief Finds the slot holding the key with the given hash.
+ * @return The slot index, or -1 if the key does not exist.
+ */
+static i64 hashtable_find(const hashtable* table, u64 hash) {
+    u8 h2 = hash_h2(hash);
+    u32 group_mask = table->capacity / HASHTABLE_GROUP_WIDTH - 1;
+    u32 group = (u32)hash & group_mask;
+
+    // Triangular probing visits every group exactly once for power-of-two group counts.
+    for (u32 probe = 0; probe <= group_mask; ++probe) {
+        u32 base = group * HASHTABLE_GROUP_WIDTH;
+        u64 control = group_load(table->control + base);
+
+        for (u64 match = group_match(control, h2); match; match &= match - 1) {
+            u32 slot = base + group_first(match);
+            if (table->keys[slot] == hash) {
+                return slot;
+            }
+        }
+
+        // An empty slot means the key was never pushed further down the sequence.
+        if (group_match_empty(control)) {
+            return -1;
+        }
+        group = (group + probe + 1) & group_mask;
+    }
+
+    return -1;
+}
+
+/**
+ * @brief Finds the first empty or deleted slot along the key's probe sequence.
+ * @note The load limit guarantees such a slot exists.
+ */
+static u32 hashtable_find_free(const hashtable* table, u64 hash) {
+    u32 group_mask = table->capacity / HASHTABLE_GROUP_WIDTH - 1;
+    u32 group = (u32)hash & group_mask;
+
+    for (u32 probe = 0;; ++probe) {
+        u32 base = group * HASHTABLE_GROUP_WIDTH;
+        u64 free = group_match_free(group_load(table->control + base));
+        if (free) {
+            return base + group_first(free);
+        }
+        group = (group + probe + 1) & group_mask;
+    }
+}
+
+/** @brief Swaps the keys and values of two slots. */
+static void hashtable_swap_slots(hashtable* table, u32 a, u32 b) {
+    u64 key = table->keys[a];
+    table->keys[a] = table->keys[b];
+    table->keys[b] = key;
+
+    // Values may be large, so swap them through a small buffer.
+    u8 buffer[64];
+    u8* value_a = table->values + (u64)a * table->element_size;
+    u8* value_b = table->values + (u64)b * table->element_size;
+    for (u64 offset = 0; offset < table->element_size; offset += sizeof(buffer)) {
+        u64 chunk = table->element_size - offset < sizeof(buffer) ? table->element_size - offset : sizeof(buffer);
+        kcopy_memory(buffer, value_a + offset, chunk);
+        kcopy_memory(value_a + offset, value_b + offset, chunk);
+        kcopy_memory(value_b + offset, buffer, chunk);
+    }
+}
+
+/**
+ * @brief Reclaims every deleted slot by re-placing all entries in place, without extra memory.
+ */
+static void hashtable_drop_tombstones(hashtable* table) {
+    // Deleted slots become empty and full slots become deleted, meaning "not yet re-placed".
+    for (u32 i = 0; i < table->capacity; ++i) {
+        table->control[i] = table->control[i] & 0x80 ? CTRL_EMPTY : CTRL_DELETED;
+    }
+
+    for (u32 i = 0; i < table->capacity; ++i) {
+        if (table->control[i] != CTRL_DELETED) {
+            continue;
+        }
+
+        u64 hash = table->keys[i];
+        u32 target = hashtable_find_free(table, hash);
+
+        if (target / HASHTABLE_GROUP_WIDTH == i / HASHTABLE_GROUP_WIDTH) {
+            // Already in the first group with room along its sequence. Keep it in place.
+            table->control[i] = hash_h2(hash);
+        } else if (table->control[target] == CTRL_EMPTY) {
+            table->control[target] = hash_h2(hash);
+            table->keys[target] = hash;
+            kcopy_memory(table->values + (u64)target * table->element_size, table->values + (u64)i * table->element_size, table->element_size);
+            table->control[i] = CTRL_EMPTY;
+        } else {
+            // The target holds another entry waiting to be re-placed. Swap them and re-place that one next.
+            table->control[target] = hash_h2(hash);
+            hashtable_swap_slots(table, i, target);
+            --i;
+        }
+    }
+
+    table->tombstones = 0;
+}
+
+/**
+ * @brief Finds or creates the slot for the key with the given hash.
+ * @return A pointer to the slot's value, or 0 if the table is full.
+ */
+static void* hashtable_insert(hashtable* table, u64 hash) {
+    i64 existing = hashtable_find(table, hash);
+    if (existing >= 0) {
+        return table->values + (u64)existing * table->element_size;
+    }
+
+    u32 max_load = hashtable_max_load(table->capacity);
+    if (table->count >= max_load) {
+        KERROR("hashtable_insert - table is full (%u entries). Create it with more slots.", table->count);
+        return 0;
+    }
+    if (table->count + table->tombstones >= max_load) {
+        hashtable_drop_tombstones(table);
+    }
+
+    u32 slot = hashtable_find_free(table, hash);
+    if (table->control[slot] == CTRL_DELETED) {
+        table->tombstones--;
+    }
+    table->control[slot] = hash_h2(hash);
+    table->keys[slot] = hash;
+    table->count++;
+    return table->values + (u64)slot * table->element_size;
+}
+
+/** @brief Removes the entry in the given slot. */
+static void hashtable_erase(hashtable* table, u32 slot) {
+    // If the slot's group already has an empty slot, no probe ever continued past this group,
+    // so the slot can become empty again instead of leaving a tombstone.
+    u32 base = slot & ~(u32)(HASHTABLE_GROUP_WIDTH - 1);
+    if (group_match_empty(group_load(table->control + base))) {
+        table->control[slot] = CTRL_EMPTY;
+    } else {
+        table->control[slot] = CTRL_DELETED;
+        table->tombstones++;
+    }
+    table->count--;
+}
+
+b8 hashtable_set(hashtable* table, const char* name, const void* value) {
+    if (!table || !name || !value || table->is_pointer_type) {
+        KERROR("hashtable_set requires a non-pointer table, a name and a value. Use hashtable_set_ptr for pointer tables.");
+        return FALSE;
+    }
+
+    void* slot = hashtable_insert(table, hashtable_hash_name(name));
+    if (!slot) {
+        return FALSE;
+    }
+    kcopy_memory(slot, value, table->element_size);
+    return TRUE;
+}
+
+b8 hashtable_get(const hashtable* table, const char* name, void* out_value) {
+    if (!table || !name || !out_value || table->is_pointer_type) {
+        KERROR("hashtable_get requires a non-pointer table, a name and an output. Use hashtable_get_ptr for pointer tables.");
+        return FALSE;
+    }
+
+    void* slot = hashtable_get_ref(table, name);
+    if (!slot) {
+        return FALSE;
+    }
+    kcopy_memory(out_value, slot, table->element_size);
+    return TRUE;
+}
+
+void* hashtable_get_ref(const hashtable* table, const char* name) {
+    if (!table || !name) {
+        return 0;
+    }
+
+    i64 slot = hashtable_find(table, hashtable_hash_name(name));
+    return slot >= 0 ? table->values + (u64)slot * table->element_size : 0;
+}
+
+b8 hashtable_set_ptr(hashtable* table, const char* name, void* value) {
+    if (!table || !name || !table->is_pointer_type) {
+        KERROR("hashtable_set_ptr requires a pointer table and a name. Use hashtable_set for non-pointer tables.");
+        return FALSE;
+    }
+
+    u64 hash = hashtable_hash_name(name);
+    if (!value) {
+        i64 slot = hashtable_find(table, hash);
+        if (slot >= 0) {
+            hashtable_erase(table, (u32)slot);
+        }
+        return TRUE;
+    }
+
+    void** slot = hashtable_insert(table, hash);
+    if (!slot) {
+        return FALSE;
+    }
+    *slot = value;
+    return TRUE;
+}
+
+b8 hashtable_get_ptr(const hashtable* table, const char* name, void** out_value) {
+    if (!table || !name || !out_value || !table->is_pointer_type) {
+        KERROR("hashtable_get_ptr requires a pointer table, a name and an output. Use hashtable_get for non-pointer tables.");
+        return FALSE;
+    }
+
+    void** slot = hashtable_get_ref(table, name);
+    *out_value = slot ? *slot : 0;
+    return slot != 0;
+}
+
+b8 hashtable_remove(hashtable* table, const char* name) {
+    if (!table || !name) {
+        return FALSE;
+    }
+
+    i64 slot = hashtable_find(table, hashtable_hash_name(name));
+    if (slot < 0) {
+        return FALSE;
+    }
+    hashtable_erase(table, (u32)slot);
+    return TRUE;
+}
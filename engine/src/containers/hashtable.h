@@ -0,0 +1,171 @@
+#pragma once
+
+/**
+ * @file hashtable.h
+ * @brief This file contains the engine's open-addressing hash table.
+ *
+ * @details The table maps string names to fixed-size values stored inline. It uses
+ * Swiss-table style open addressing: every slot has a one-byte control entry holding 7 bits
+ * of the key's hash (or an empty/deleted marker), and control bytes are scanned 8 at a time
+ * with a few word-sized bit operations. A lookup therefore reads one group of control bytes,
+ * and only touches the key and value arrays of slots whose 7 bits already match, so a hit
+ * costs about one cache miss on the value itself and there is no pointer chasing.
+ *
+ * Control bytes, keys and values live in separate arrays (SoA) inside a single block that is
+ * either supplied by the caller or allocated once under MEMORY_TAG_DICT. The capacity is fixed
+ * at creation, so inserting never allocates.
+ *
+ * Keys are identified by their full 64-bit hash; the name itself is not stored. Two different
+ * names only collide if their 64-bit hashes are equal, which is negligible for the table sizes
+ * an engine uses, but callers that cannot accept it must verify the value they get back.
+ *
+ * A pointer variant (`is_pointer_type`) stores `void*` values for tables that reference
+ * objects owned elsewhere.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "defines.h"
+
+/** @brief The number of control bytes examined at once. Capacities are multiples of it. */
+#define HASHTABLE_GROUP_WIDTH 8
+
+/**
+ * @struct hashtable
+ * @brief Holds the state of a single hash table.
+ */
+typedef struct hashtable {
+    /** @brief The size of a single value in bytes. */
+    u64 element_size;
+
+    /** @brief The number of slots. Always a power of two and at least HASHTABLE_GROUP_WIDTH. */
+    u32 capacity;
+
+    /** @brief The number of live entries. */
+    u32 count;
+
+    /** @brief The number of deleted slots still marked as such. */
+    u32 tombstones;
+
+    /** @brief Indicates if the values are pointers, set and retrieved by the _ptr functions. */
+    b8 is_pointer_type;
+
+    /** @brief Indicates if the table allocated `memory` itself (and must free it on destroy). */
+    b8 owns_memory;
+
+    /** @brief The block holding all of the arrays below. */
+    void* memory;
+
+    /** @brief One control byte per slot: 7 hash bits when full, or an empty or deleted marker. */
+    u8* control;
+
+    /** @brief The full 64-bit hash of each slot's key. */
+    u64* keys;
+
+    /** @brief The values, `element_size` bytes per slot. */
+    u8* values;
+} hashtable;
+
+
+/**
+ * @brief Hashes a block of memory with the engine's fast, non-cryptographic hash.
+ * @details Processes 8 bytes per step. Suitable for hash tables, not for security.
+ * @param data The data to hash.
+ * @param size The size of the data in bytes.
+ * @return The 64-bit hash.
+ */
+KAPI u64 hashtable_hash(const void* data, u64 size);
+
+
+/**
+ * @brief Gets the size of the memory block a table with the given layout needs.
+ * @param element_size The size of a single value in bytes.
+ * @param element_count The number of slots. Rounded up to a power of two of at least HASHTABLE_GROUP_WIDTH.
+ * @return The required size in bytes.
+ */
+KAPI u64 hashtable_memory_requirement(u64 element_size, u32 element_count);
+
+
+/**
+ * @brief Creates a hash table. Inserts fail once the table is 7/8 full, so size `element_count` with headroom.
+ * @param element_size The size of a single value in bytes. Ignored (set to a pointer's size) for pointer tables.
+ * @param element_count The number of slots. Rounded up to a power of two of at least HASHTABLE_GROUP_WIDTH.
+ * @param memory An optional, pre-allocated block of at least hashtable_memory_requirement bytes, aligned to
+ * 16 bytes. If 0, the table allocates its own block once under MEMORY_TAG_DICT and releases it on destroy.
+ * @param is_pointer_type Indicates if the table stores pointers.
+ * @param out_table A pointer to the hashtable to be initialized.
+ * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+ */
+KAPI b8 hashtable_create(u64 element_size, u32 element_count, void* memory, b8 is_pointer_type, hashtable* out_table);
+
+
+/**
+ * @brief Destroys the given hash table, freeing its memory block if it owns it.
+ * @param table A pointer to the table to be destroyed.
+ */
+KAPI void hashtable_destroy(hashtable* table);
+
+
+/**
+ * @brief Inserts or overwrites the value stored under `name`.
+ * @param table A pointer to a non-pointer table.
+ * @param name The key.
+ * @param value A pointer to `element_size` bytes to copy into the table.
+ * @return `b8 TRUE` on success, `b8 FALSE` if the table is full or is a pointer table.
+ */
+KAPI b8 hashtable_set(hashtable* table, const char* name, const void* value);
+
+
+/**
+ * @brief Copies the value stored under `name` to `out_value`.
+ * @param table A pointer to a non-pointer table.
+ * @param name The key.
+ * @param out_value A pointer to receive `element_size` bytes.
+ * @return `b8 TRUE` if the key exists, otherwise `b8 FALSE`.
+ */
+KAPI b8 hashtable_get(const hashtable* table, const char* name, void* out_value);
+
+
+/**
+ * @brief Gets a pointer to the value stored inline under `name`, without copying it.
+ * @note The pointer stays valid until the entry is removed or the table is cleared or destroyed.
+ * @param table A pointer to the table.
+ * @param name The key.
+ * @return A pointer to the value, or 0 if the key does not exist.
+ */
+KAPI void* hashtable_get_ref(const hashtable* table, const char* name);
+
+
+/**
+ * @brief Inserts or overwrites the pointer stored under `name`. Passing a 0 value removes the entry.
+ * @param table A pointer to a pointer table.
+ * @param name The key.
+ * @param value The pointer to store.
+ * @return `b8 TRUE` on success, `b8 FALSE` if the table is full or is not a pointer table.
+ */
+KAPI b8 hashtable_set_ptr(hashtable* table, const char* name, void* value);
+
+
+/**
+ * @brief Gets the pointer stored under `name`.
+ * @param table A pointer to a pointer table.
+ * @param name The key.
+ * @param out_value A pointer to receive the stored pointer, or 0 if the key does not exist.
+ * @return `b8 TRUE` if the key exists, otherwise `b8 FALSE`.
+ */
+KAPI b8 hashtable_get_ptr(const hashtable* table, const char* name, void** out_value);
+
+
+/**
+ * @brief Removes the entry stored under `name`.
+ * @param table A pointer to the table.
+ * @param name The key.
+ * @return `b8 TRUE` if the key existed, otherwise `b8 FALSE`.
+ */
+KAPI b8 hashtable_remove(hashtable* table, const char* name);
+
+
+/**
+ * @brief Removes every entry, keeping the memory block.
+ * @param table A pointer to the table.
+ */
+KAPI void hashtable_clear(hashtable* table);
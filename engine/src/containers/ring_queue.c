@@ -0,0 +1,343 @@
+/**
+ * @file ring_queue.c
+ * @brief This file contains the implementation of the engine's bounded ring queue.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "containers/ring_queue.h"
+
+#include "core/katomic.h"
+#include "core/kmemory.h"
+#include "core/logger.h"
+
+/** @brief Gets a pointer to the cell a position maps to. */
+static inline u8* ring_queue_cell(const ring_queue* queue, u64 position) {
+    return queue->elements + (position & queue->mask) * queue->stride;
+}
+
+/**
+ * @brief Copies `count` elements into the queue starting at `position`, wrapping at the end of the block.
+ */
+static void ring_queue_copy_in(ring_queue* queue, u64 position, const void* values, u64 count) {
+    u64 index = position & queue->mask;
+    u64 first = queue->capacity - index < count ? queue->capacity - index : count;
+    kcopy_memory(queue->elements + index * queue->stride, values, first * queue->stride);
+    if (first < count) {
+        kcopy_memory(queue->elements, (const u8*)values + first * queue->stride, (count - first) * queue->stride);
+    }
+}
+
+/**
+ * @brief Copies `count` elements out of the queue starting at `position`, wrapping at the end of the block.
+ */
+static void ring_queue_copy_out(const ring_queue* queue, u64 position, void* out_values, u64 count) {
+    u64 index = position & queue->mask;
+    u64 first = queue->capacity - index < count ? queue->capacity - index : count;
+    kcopy_memory(out_values, queue->elements + index * queue->stride, first * queue->stride);
+    if (first < count) {
+        kcopy_memory((u8*)out_values + first * queue->stride, queue->elements, (count - first) * queue->stride);
+    }
+}
+
+b8 ring_queue_create(ring_queue_type type, u64 stride, u64 capacity, void* memory, ring_queue* out_queue) {
+    if (!out_queue) {
+        KERROR("ring_queue_create requires a valid pointer to a ring_queue.");
+        return FALSE;
+    }
+    if (stride == 0 || !KIS_POWER_OF_TWO(capacity)) {
+        KERROR("ring_queue_create - stride must be greater than 0 and capacity a power of two (got %llu).", capacity);
+        return FALSE;
+    }
+
+    u64 size = RING_QUEUE_MEMORY_REQUIREMENT(type, stride, capacity);
+    b8 owns_memory = memory == 0;
+    if (!memory) {
+        memory = kallocate_uninit(size, MEMORY_TAG_RING_QUEUE);
+        if (!memory) {
+            KERROR("ring_queue_create - failed to allocate %llu bytes.", size);
+            return FALSE;
+        }
+    }
+
+    kzero_memory(out_queue, sizeof(ring_queue));
+    out_queue->type = type;
+    out_queue->owns_memory = owns_memory;
+    out_queue->stride = stride;
+    out_queue->capacity = capacity;
+    out_queue->mask = capacity - 1;
+    out_queue->memory = memory;
+
+    if (type == RING_QUEUE_TYPE_MPMC) {
+        // The sequences come first, so the elements keep the block's alignment.
+        out_queue->sequences = (u64*)memory;
+        out_queue->elements = (u8*)memory + capacity * sizeof(u64);
+
+        // Every cell starts out free for the first lap.
+        for (u64 i = 0; i < capacity; ++i) {
+            out_queue->sequences[i] = i;
+        }
+    } else {
+        out_queue->elements = (u8*)memory;
+    }
+
+    // Publish the initialized state to whichever threads the queue is handed to.
+    katomic_thread_fence(KATOMIC_RELEASE);
+    return TRUE;
+}
+
+void ring_queue_destroy(ring_queue* queue) {
+    if (!queue) {
+        return;
+    }
+    if (queue->owns_memory && queue->memory) {
+        kfree(queue->memory, RING_QUEUE_MEMORY_REQUIREMENT(queue->type, queue->stride, queue->capacity), MEMORY_TAG_RING_QUEUE);
+    }
+    kzero_memory(queue, sizeof(ring_queue));
+}
+
+/**
+ * @brief Gets the number of cells a single or SPSC producer can claim, refreshing its cached
+ * tail only when the cached value says the queue is full.
+ */
+static inline u64 ring_queue_producer_space(ring_queue* queue) {
+    u64 used = queue->head - queue->cached_tail;
+    if (used >= queue->capacity) {
+        queue->cached_tail = queue->type == RING_QUEUE_TYPE_SPSC ? katomic_load(&queue->tail, KATOMIC_ACQUIRE) : queue->tail;
+        used = queue->head - queue->cached_tail;
+    }
+    return queue->capacity - used;
+}
+
+/**
+ * @brief Gets the number of cells a single or SPSC consumer can read, refreshing its cached
+ * head only when the cached value says the queue is empty.
+ */
+static inline u64 ring_queue_consumer_available(ring_queue* queue) {
+    u64 available = queue->cached_head - queue->tail;
+    if (available == 0) {
+        queue->cached_head = queue->type == RING_QUEUE_TYPE_SPSC ? katomic_load(&queue->head, KATOMIC_ACQUIRE) : queue->head;
+        available = queue->cached_head - queue->tail;
+    }
+    return available;
+}
+
+/** @brief Publishes a new head for a single or SPSC producer. */
+static inline void ring_queue_producer_publish(ring_queue* queue, u64 head) {
+    if (queue->type == RING_QUEUE_TYPE_SPSC) {
+        katomic_store(&queue->head, head, KATOMIC_RELEASE);
+    } else {
+        queue->head = head;
+    }
+}
+
+/** @brief Publishes a new tail for a single or SPSC consumer. */
+static inline void ring_queue_consumer_publish(ring_queue* queue, u64 tail) {
+    if (queue->type == RING_QUEUE_TYPE_SPSC) {
+        katomic_store(&queue->tail, tail, KATOMIC_RELEASE);
+    } else {
+        queue->tail = tail;
+    }
+}
+
+void* ring_queue_begin_enqueue(ring_queue* queue, u64* out_ticket) {
+    if (queue->type != RING_QUEUE_TYPE_MPMC) {
+        if (ring_queue_producer_space(queue) == 0) {
+            return 0;
+        }
+        *out_ticket = queue->head;
+        return ring_queue_cell(queue, queue->head);
+    }
+
+    u64 position = katomic_load(&queue->head, KATOMIC_RELAXED);
+    for (;;) {
+        u64 sequence = katomic_load(&queue->sequences[position & queue->mask], KATOMIC_ACQUIRE);
+        i64 difference = (i64)(sequence - position);
+
+        if (difference == 0) {
+            // The cell is free for this lap; try to claim the position.
+            if (katomic_compare_exchange_weak(&queue->head, &position, position + 1, KATOMIC_RELAXED, KATOMIC_RELAXED)) {
+                *out_ticket = position;
+                return ring_queue_cell(queue, position);
+            }
+        } else if (difference < 0) {
+            // The cell still holds last lap's element: the queue is full.
+            return 0;
+        } else {
+            // Another producer claimed this position first.
+            position = katomic_load(&queue->head, KATOMIC_RELAXED);
+        }
+    }
+}
+
+void ring_queue_end_enqueue(ring_queue* queue, u64 ticket) {
+    if (queue->type == RING_QUEUE_TYPE_MPMC) {
+        katomic_store(&queue->sequences[ticket & queue->mask], ticket + 1, KATOMIC_RELEASE);
+    } else {
+        ring_queue_producer_publish(queue, ticket + 1);
+    }
+}
+
+void* ring_queue_begin_dequeue(ring_queue* queue, u64* out_ticket) {
+    if (queue->type != RING_QUEUE_TYPE_MPMC) {
+        if (ring_queue_consumer_available(queue) == 0) {
+            return 0;
+        }
+        *out_ticket = queue->tail;
+        return ring_queue_cell(queue, queue->tail);
+    }
+
+    u64 position = katomic_load(&queue->tail, KATOMIC_RELAXED);
+    for (;;) {
+        u64 sequence = katomic_load(&queue->sequences[position & queue->mask], KATOMIC_ACQUIRE);
+        i64 difference = (i64)(sequence - (position + 1));
+
+        if (difference == 0) {
+            // The cell is published for this lap; try to claim the position.
+            if (katomic_compare_exchange_weak(&queue->tail, &position, position + 1, KATOMIC_RELAXED, KATOMIC_RELAXED)) {
+                *out_ticket = position;
+                return ring_queue_cell(queue, position);
+            }
+        } else if (difference < 0) {
+            // Nothing published at this position yet: the queue is empty.
+            return 0;
+        } else {
+            // Another consumer claimed this position first.
+            position = katomic_load(&queue->tail, KATOMIC_RELAXED);
+        }
+    }
+}
+
+void ring_queue_end_dequeue(ring_queue* queue, u64 ticket) {
+    if (queue->type == RING_QUEUE_TYPE_MPMC) {
+        // Hand the cell back to producers for the next lap around the ring.
+        katomic_store(&queue->sequences[ticket & queue->mask], ticket + queue->capacity, KATOMIC_RELEASE);
+    } else {
+        ring_queue_consumer_publish(queue, ticket + 1);
+    }
+}
+
+b8 ring_queue_enqueue(ring_queue* queue, const void* value) {
+    u64 ticket;
+    void* cell = ring_queue_begin_enqueue(queue, &ticket);
+    if (!cell) {
+        return FALSE;
+    }
+    kcopy_memory(cell, value, queue->stride);
+    ring_queue_end_enqueue(queue, ticket);
+    return TRUE;
+}
+
+b8 ring_queue_dequeue(ring_queue* queue, void* out_value) {
+    u64 ticket;
+    void* cell = ring_queue_begin_dequeue(queue, &ticket);
+    if (!cell) {
+        return FALSE;
+    }
+    kcopy_memory(out_value, cell, queue->stride);
+    ring_queue_end_dequeue(queue, ticket);
+    return TRUE;
+}
+
+u64 ring_queue_enqueue_batch(ring_queue* queue, const void* values, u64 count) {
+    if (count == 0) {
+        return 0;
+    }
+
+    if (queue->type != RING_QUEUE_TYPE_MPMC) {
+        u64 space = ring_queue_producer_space(queue);
+        u64 n = count < space ? count : space;
+        if (n) {
+            // At most two copies, however many elements; then one publish for all of them.
+            ring_queue_copy_in(queue, queue->head, values, n);
+            ring_queue_producer_publish(queue, queue->head + n);
+        }
+        return n;
+    }
+
+    u64 position = katomic_load(&queue->head, KATOMIC_RELAXED);
+    for (;;) {
+        u64 sequence = katomic_load(&queue->sequences[position & queue->mask], KATOMIC_ACQUIRE);
+        i64 difference = (i64)(sequence - position);
+        if (difference < 0) {
+            return 0;
+        }
+        if (difference > 0) {
+            position = katomic_load(&queue->head, KATOMIC_RELAXED);
+            continue;
+        }
+
+        // Count the run of cells free for this lap. Nobody else can claim them while `head` is
+        // still `position`, so they stay free once the compare-exchange below succeeds.
+        u64 n = 1;
+        while (n < count && katomic_load(&queue->sequences[(position + n) & queue->mask], KATOMIC_ACQUIRE) == position + n) {
+            n++;
+        }
+
+        if (katomic_compare_exchange_weak(&queue->head, &position, position + n, KATOMIC_RELAXED, KATOMIC_RELAXED)) {
+            ring_queue_copy_in(queue, position, values, n);
+            for (u64 i = 0; i < n; ++i) {
+                katomic_store(&queue->sequences[(position + i) & queue->mask], position + i + 1, KATOMIC_RELEASE);
+            }
+            return n;
+        }
+    }
+}
+
+u64 ring_queue_dequeue_batch(ring_queue* queue, void* out_values, u64 max_count) {
+    if (max_count == 0) {
+        return 0;
+    }
+
+    if (queue->type != RING_QUEUE_TYPE_MPMC) {
+        u64 available = ring_queue_consumer_available(queue);
+        u64 n = max_count < available ? max_count : available;
+        if (n) {
+            ring_queue_copy_out(queue, queue->tail, out_values, n);
+            ring_queue_consumer_publish(queue, queue->tail + n);
+        }
+        return n;
+    }
+
+    u64 position = katomic_load(&queue->tail, KATOMIC_RELAXED);
+    for (;;) {
+        u64 sequence = katomic_load(&queue->sequences[position & queue->mask], KATOMIC_ACQUIRE);
+        i64 difference = (i64)(sequence - (position + 1));
+        if (difference < 0) {
+            return 0;
+        }
+        if (difference > 0) {
+            position = katomic_load(&queue->tail, KATOMIC_RELAXED);
+            continue;
+        }
+
+        // Count the run of published cells, then claim them all at once.
+        u64 n = 1;
+        while (n < max_count && katomic_load(&queue->sequences[(position + n) & queue->mask], KATOMIC_ACQUIRE) == position + n + 1) {
+            n++;
+        }
+
+        if (katomic_compare_exchange_weak(&queue->tail, &position, position + n, KATOMIC_RELAXED, KATOMIC_RELAXED)) {
+            ring_queue_copy_out(queue, position, out_values, n);
+            for (u64 i = 0; i < n; ++i) {
+                katomic_store(&queue->sequences[(position + i) & queue->mask], position + i + queue->capacity, KATOMIC_RELEASE);
+            }
+            return n;
+        }
+    }
+}
+
+u64 ring_queue_count(const ring_queue* queue) {
+    if (queue->type == RING_QUEUE_TYPE_SINGLE_THREADED) {
+        return queue->head - queue->tail;
+    }
+
+    // Load the tail first: the head only grows, so it is never behind the tail read before it.
+    u64 tail = katomic_load(&queue->tail, KATOMIC_ACQUIRE);
+    u64 head = katomic_load(&queue->head, KATOMIC_ACQUIRE);
+    u64 count = head - tail;
+    return count > queue->capacity ? queue->capacity : count;
+}
+
+u64 ring_queue_total_enqueued(const ring_queue* queue) {
+    return queue->type == RING_QUEUE_TYPE_SINGLE_THREADED ? queue->head : katomic_load(&queue->head, KATOMIC_ACQUIRE);
+}
@@ -0,0 +1,211 @@
+#pragma once
+
+/**
+ * @file ring_queue.h
+ * @brief This file contains the engine's bounded ring queue.
+ *
+ * @details A ring_queue is a fixed-capacity FIFO of fixed-size elements, stored in a single
+ * power-of-two sized block so positions wrap with a mask. One implementation serves three
+ * threading models, chosen at creation:
+ *
+ * - RING_QUEUE_TYPE_SINGLE_THREADED: no atomics at all, for queues owned by one thread.
+ * - RING_QUEUE_TYPE_SPSC: lock-free, one producer thread and one consumer thread. Each side
+ *   caches the other side's position, so the shared cache line is only read when the cached
+ *   value says the queue looks full (or empty).
+ * - RING_QUEUE_TYPE_MPMC: lock-free, any number of producers and consumers (Vyukov-style).
+ *   Every cell carries a sequence number that hands it between producers and consumers, so
+ *   each operation costs one compare-exchange on the shared position.
+ *
+ * The producer and consumer positions sit on their own cache lines. Besides copying
+ * enqueue/dequeue (single and batched), the begin/end functions expose a cell in place, so
+ * large elements can be written or read without an intermediate copy.
+ *
+ * All operations are non-blocking: they fail (or transfer fewer elements) instead of waiting.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "defines.h"
+
+/**
+ * @enum ring_queue_type
+ * @brief The threading model a ring_queue is created for.
+ */
+typedef enum ring_queue_type {
+    /** @brief Used from a single thread only. */
+    RING_QUEUE_TYPE_SINGLE_THREADED,
+
+    /** @brief One producer thread and one consumer thread. */
+    RING_QUEUE_TYPE_SPSC,
+
+    /** @brief Any number of producer and consumer threads. */
+    RING_QUEUE_TYPE_MPMC
+} ring_queue_type;
+
+/**
+ * @brief Gets the size of the memory block a ring_queue needs. Usable in constant expressions,
+ * so static storage can be reserved for a queue.
+ */
+#define RING_QUEUE_MEMORY_REQUIREMENT(type, stride, capacity) \
+    ((u64)(capacity) * (stride) + ((type) == RING_QUEUE_TYPE_MPMC ? (u64)(capacity) * sizeof(u64) : 0))
+
+/**
+ * @struct ring_queue
+ * @brief Holds the state of a single ring queue.
+ */
+typedef struct ring_queue {
+    /** @brief The total number of elements ever claimed by producers. The write index is `head & mask`. */
+    KALIGN(KCACHE_LINE_SIZE) u64 head;
+
+    /** @brief SPSC only: the producer's last seen value of `tail`. */
+    u64 cached_tail;
+
+    /** @brief The total number of elements ever claimed by consumers. The read index is `tail & mask`. */
+    KALIGN(KCACHE_LINE_SIZE) u64 tail;
+
+    /** @brief SPSC only: the consumer's last seen value of `head`. */
+    u64 cached_head;
+
+    /** @brief The threading model. */
+    KALIGN(KCACHE_LINE_SIZE) ring_queue_type type;
+
+    /** @brief Indicates if the queue allocated `memory` itself (and must free it on destroy). */
+    b8 owns_memory;
+
+    /** @brief The size of a single element in bytes. */
+    u64 stride;
+
+    /** @brief The number of elements the queue holds. Always a power of two. */
+    u64 capacity;
+
+    /** @brief `capacity - 1`, to turn a position into an index. */
+    u64 mask;
+
+    /** @brief MPMC only: one sequence number per cell. */
+    u64* sequences;
+
+    /** @brief The elements, `stride` bytes each. */
+    u8* elements;
+
+    /** @brief The block holding the arrays above. */
+    void* memory;
+} ring_queue;
+
+
+/**
+ * @brief Creates a ring queue.
+ * @param type The threading model.
+ * @param stride The size of a single element in bytes.
+ * @param capacity The number of elements. Must be a power of two.
+ * @param memory An optional, pre-allocated block of at least RING_QUEUE_MEMORY_REQUIREMENT bytes, aligned
+ * to 16 bytes. If 0, the queue allocates its own block once under MEMORY_TAG_RING_QUEUE and releases it
+ * on destroy.
+ * @param out_queue A pointer to the ring_queue to be initialized.
+ * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+ */
+KAPI b8 ring_queue_create(ring_queue_type type, u64 stride, u64 capacity, void* memory, ring_queue* out_queue);
+
+
+/**
+ * @brief Destroys the given ring queue, freeing its memory block if it owns it.
+ * @note No other thread may be using the queue.
+ * @param queue A pointer to the queue to be destroyed.
+ */
+KAPI void ring_queue_destroy(ring_queue* queue);
+
+
+/**
+ * @brief Copies one element to the back of the queue.
+ * @param queue A pointer to the queue.
+ * @param value A pointer to `stride` bytes.
+ * @return `b8 TRUE` on success, `b8 FALSE` if the queue is full.
+ */
+KAPI b8 ring_queue_enqueue(ring_queue* queue, const void* value);
+
+
+/**
+ * @brief Copies the element at the front of the queue to `out_value` and removes it.
+ * @param queue A pointer to the queue.
+ * @param out_value A pointer to receive `stride` bytes.
+ * @return `b8 TRUE` on success, `b8 FALSE` if the queue is empty.
+ */
+KAPI b8 ring_queue_dequeue(ring_queue* queue, void* out_value);
+
+
+/**
+ * @brief Copies up to `count` consecutive elements to the back of the queue in one operation.
+ * @details The elements are claimed with a single position update, so they stay contiguous in
+ * the queue even with concurrent producers.
+ * @param queue A pointer to the queue.
+ * @param values A pointer to `count` elements.
+ * @param count The number of elements to enqueue.
+ * @return The number of elements enqueued, from the front of `values`. Less than `count` if the queue filled up.
+ */
+KAPI u64 ring_queue_enqueue_batch(ring_queue* queue, const void* values, u64 count);
+
+
+/**
+ * @brief Removes up to `max_count` elements from the front of the queue in one operation.
+ * @param queue A pointer to the queue.
+ * @param out_values A pointer to room for `max_count` elements.
+ * @param max_count The maximum number of elements to dequeue.
+ * @return The number of elements dequeued.
+ */
+KAPI u64 ring_queue_dequeue_batch(ring_queue* queue, void* out_values, u64 max_count);
+
+
+/**
+ * @brief Claims the back cell of the queue so it can be written in place.
+ * @details The element becomes visible to consumers once it is passed to ring_queue_end_enqueue,
+ * which must be called exactly once for every successful claim.
+ * @param queue A pointer to the queue.
+ * @param out_ticket A pointer to receive the ticket to pass to ring_queue_end_enqueue.
+ * @return A pointer to the claimed cell, or 0 if the queue is full.
+ */
+KAPI void* ring_queue_begin_enqueue(ring_queue* queue, u64* out_ticket);
+
+
+/**
+ * @brief Publishes a cell claimed with ring_queue_begin_enqueue.
+ * @param queue A pointer to the queue.
+ * @param ticket The ticket received from ring_queue_begin_enqueue.
+ */
+KAPI void ring_queue_end_enqueue(ring_queue* queue, u64 ticket);
+
+
+/**
+ * @brief Claims the front cell of the queue so it can be read in place.
+ * @details The cell is handed back to producers once it is passed to ring_queue_end_dequeue,
+ * which must be called exactly once for every successful claim. With the single-threaded and SPSC
+ * types, only one dequeue may be in progress at a time.
+ * @param queue A pointer to the queue.
+ * @param out_ticket A pointer to receive the ticket to pass to ring_queue_end_dequeue.
+ * @return A pointer to the claimed cell, or 0 if the queue is empty.
+ */
+KAPI void* ring_queue_begin_dequeue(ring_queue* queue, u64* out_ticket);
+
+
+/**
+ * @brief Releases a cell claimed with ring_queue_begin_dequeue.
+ * @param queue A pointer to the queue.
+ * @param ticket The ticket received from ring_queue_begin_dequeue.
+ */
+KAPI void ring_queue_end_dequeue(ring_queue* queue, u64 ticket);
+
+
+/**
+ * @brief Gets the number of elements in the queue.
+ * @note With concurrent producers or consumers the value is a snapshot and may be stale immediately.
+ * Claimed cells that are not yet published (or released) are counted.
+ * @param queue A pointer to the queue.
+ * @return The number of elements.
+ */
+KAPI u64 ring_queue_count(const ring_queue* queue);
+
+
+/**
+ * @brief Gets the total number of elements ever claimed for enqueueing.
+ * @details Useful for waiting until a consumer has caught up with everything enqueued so far.
+ * @param queue A pointer to the queue.
+ * @return The number of claimed elements since creation.
+ */
+KAPI u64 ring_queue_total_enqueued(const ring_queue* queue);
@@ -15,6 +15,45 @@
 
 #include "platform/platform.h"
 #include "core/kmemory.h"
+#include "core/linear_allocator.h"
+#include "core/clock.h"
+#include "core/katomic.h"
+#include "core/profiler.h"
+#include "core/job_system.h"
+#include "core/async_io.h"
+#include "core/kstring.h"
+#include "core/frame_pipeline.h"
+#include "core/event.h"
+#include "core/input.h"
+#include "renderer/renderer_frontend.h"
+
+/** @brief The size of the per-frame scratch arena, reserved once at startup. */
+#define FRAME_ALLOCATOR_SIZE (64 * 1024 * 1024)
+
+/**
+ * @brief The longest frame time fed into the simulation, in seconds.
+ * Longer frames (e.g. after a breakpoint or a window drag) are clamped so a fixed
+ * step loop does not try to catch up on seconds of simulation at once.
+ */
+#define MAX_FRAME_DELTA 0.25
+
+/** @brief The maximum number of fixed simulation steps run in a single frame. */
+#define MAX_FIXED_STEPS_PER_FRAME 8
+
+/**
+ * @brief How long before a frame's deadline the limiter stops sleeping and starts spinning, in seconds.
+ * OS sleeps routinely overshoot by around a millisecond; spinning the tail keeps pacing accurate.
+ */
+#define FRAME_LIMITER_SPIN_WINDOW 0.002
+
+/**
+ * @brief How long the loop blocks waiting for OS messages while suspended or idle, in milliseconds.
+ * Bounded so the loop still ticks occasionally (e.g. to notice a resumed window) without input.
+ */
+#define IDLE_WAIT_TIMEOUT_MS 100
+
+/** @brief The path the profiler's Chrome trace is written to on shutdown. */
+#define PROFILER_TRACE_PATH "profile.json"
 
 /**
  * @struct application_state
@@ -64,6 +103,37 @@ typedef struct application_state {
      * `f64` (64-bit float) provides the high precision needed for accurate timing.
      */
     f64 last_time;
+
+
+    /** @brief The clock measuring time since the main loop started. */
+    kclock clock;
+
+
+    /** @brief Simulation time not yet consumed by fixed update steps, in seconds.
+     * Only used when a fixed update rate is configured.
+     */
+    f64 accumulator;
+
+
+    /** @brief How far the current frame is between the last two fixed steps, in [0, 1].
+     * Used by the renderer to interpolate between simulation states.
+     */
+    f32 interpolation_alpha;
+
+
+    /** @brief The per-frame scratch arena.
+     * Reset at the top of every loop iteration, so anything allocated from it
+     * only lives until the end of the current frame.
+     */
+    linear_allocator frame_allocator;
+
+
+    /** @brief Indicates if rendering runs pipelined on the render thread. */
+    b8 is_pipelined;
+
+
+    /** @brief The pipeline handing frame packets to the render thread, when pipelined. */
+    frame_pipeline pipeline;
 } application_state;
 
 
@@ -74,6 +144,62 @@ static b8 initialized = FALSE;
 static application_state app_state;
 
 
+/**
+ * @brief Handles application-level events (quit and resize).
+ */
+static b8 application_on_event(const event* e, void* listener_inst) {
+    // Registered without a listener instance.
+    (void)listener_inst;
+    switch (e->code) {
+        case EVENT_CODE_APPLICATION_QUIT:
+            KINFO("EVENT_CODE_APPLICATION_QUIT received, shutting down.");
+            app_state.is_running = FALSE;
+            return TRUE;
+
+        case EVENT_CODE_RESIZED: {
+            u16 width = e->resize.width;
+            u16 height = e->resize.height;
+            if (width == app_state.width && height == app_state.height) {
+                return FALSE;
+            }
+
+            app_state.width = (i16)width;
+            app_state.height = (i16)height;
+            renderer_on_resized(width, height);
+
+            // A zero-sized window is minimized. Suspend until it comes back.
+            if (width == 0 || height == 0) {
+                KINFO("Window minimized, suspending application.");
+                app_state.is_suspended = TRUE;
+                return FALSE;
+            }
+
+            if (app_state.is_suspended) {
+                KINFO("Window restored, resuming application.");
+                app_state.is_suspended = FALSE;
+            }
+            app_state.game_inst->on_resize(app_state.game_inst, width, height);
+        } return FALSE;
+    }
+
+    return FALSE;
+}
+
+
+/**
+ * @brief Renders a frame packet on the render thread. Consume callback of the frame pipeline.
+ */
+static b8 application_render_frame_packet(void* user_data, const void* packet, f32 delta_time) {
+    game* game_inst = user_data;
+    if (!game_inst->render_frame_packet(game_inst, packet, delta_time)) {
+        return FALSE;
+    }
+
+    render_packet render = {.delta_time = delta_time, .record_count = 0, .record_batch_size = 0, .record = 0, .record_data = 0};
+    return renderer_draw_frame(&render);
+}
+
+
 /**
  * @brief Creates the main application.
  * @param game_inst A pointer to the game instance. `game*` is used to provide the
@@ -93,17 +219,51 @@ b8 application_create(game* game_inst) {
     // Initialize core subsystems.
     initialize_logging();
 
-    // TODO: Remove these test logs.
-    KFATAL("A test message: %f", 3.14f);
-    KERROR("A test message: %f", 3.14f);
-    KWARN("A test message: %f", 3.14f);
-    KINFO("A test message: %f", 3.14f);
-    KDEBUG("A test message: %f", 3.14f);
-    KTRACE("A test message: %f", 3.14f);
+#if KPROFILER_ENABLED == 1
+    if (!profiler_initialize()) {
+        KERROR("Profiler failed to initialize. Continuing without it.");
+    }
+#endif
+
+    // Reserve the per-frame scratch arena once. Per-frame allocations never hit the heap.
+    linear_allocator_create(FRAME_ALLOCATOR_SIZE, 0, &app_state.frame_allocator);
+
+    // Names can be interned from any system (and any thread) from here on.
+    if (!kname_system_initialize()) {
+        KFATAL("Name system failed to initialize.");
+        return FALSE;
+    }
+
+    // Start the job system with one worker per additional core.
+    if (!job_system_initialize(0)) {
+        KFATAL("Job system failed to initialize.");
+        return FALSE;
+    }
+
+    // Streaming reads complete to the job system, so this comes right after it.
+    if (!async_io_initialize(0)) {
+        KFATAL("Async I/O failed to initialize.");
+        return FALSE;
+    }
 
     // Set initial application state.
     app_state.is_running = TRUE;
     app_state.is_suspended = FALSE;
+    app_state.width = game_inst->app_config.start_width;
+    app_state.height = game_inst->app_config.start_height;
+
+    // The event system must be up before the platform layer starts posting window events.
+    if (!event_system_initialize()) {
+        KFATAL("Event system failed to initialize.");
+        return FALSE;
+    }
+    event_register(EVENT_CODE_APPLICATION_QUIT, 0, application_on_event);
+    event_register(EVENT_CODE_RESIZED, 0, application_on_event);
+
+    if (!input_system_initialize()) {
+        KFATAL("Input system failed to initialize.");
+        return FALSE;
+    }
 
     // Initialize the platform layer (e.g., create a window).
     if (!platform_startup(
@@ -117,6 +277,16 @@ b8 application_create(game* game_inst) {
         return FALSE;
     }
 
+    // The renderer presents to the window, so it comes right after the platform layer.
+    // Without a Vulkan device there is nothing to fall back to, unless the game asked to run headless.
+    if (game_inst->app_config.headless) {
+        KINFO("Running headless, the renderer is not initialized.");
+    } else if (!renderer_system_initialize(game_inst->app_config.name, &app_state.platform, game_inst->app_config.frames_in_flight)) {
+        KFATAL("Renderer failed to initialize. Set application_config.headless to run without one.");
+        return FALSE;
+    }
+    renderer_on_resized(game_inst->app_config.start_width, game_inst->app_config.start_height);
+
     // Allow the game to initialize itself.
     if (!game_inst->initilize(game_inst)) {
         KFATAL("Game failed to initialize.");
@@ -126,6 +296,17 @@ b8 application_create(game* game_inst) {
     // Call the game's initial resize handler.
     game_inst->on_resize(game_inst, game_inst->app_config.start_width, game_inst->app_config.start_height);
 
+    // Start the render thread if the game asked for pipelined rendering.
+    if (game_inst->app_config.pipelined_rendering) {
+        if (!game_inst->frame_packet_size || !game_inst->write_frame_packet || !game_inst->render_frame_packet) {
+            KERROR("Pipelined rendering requires frame_packet_size, write_frame_packet and render_frame_packet. Rendering on the main thread.");
+        } else if (!frame_pipeline_create(game_inst->frame_packet_size, application_render_frame_packet, game_inst, &app_state.pipeline)) {
+            KERROR("Failed to create the frame pipeline. Rendering on the main thread.");
+        } else {
+            app_state.is_pipelined = TRUE;
+        }
+    }
+
     initialized = TRUE;
 
     return TRUE;
@@ -138,42 +319,236 @@ b8 application_create(game* game_inst) {
  */
 b8 application_run() {
     // Log memory usage at the start of the main loop for debugging.
-    KINFO(get_memory_usage_str());
+    // Formatted into a stack buffer, so this does not allocate (or leak).
+    memory_stats_snapshot memory_stats;
+    kmemory_get_stats(&memory_stats);
+    char memory_report[8000];
+    kmemory_format_stats(&memory_stats, memory_report, sizeof(memory_report));
+    KINFO("%s", memory_report);
+
+    // Timing for the main loop.
+    clock_start(&app_state.clock);
+    clock_update(&app_state.clock);
+    app_state.last_time = app_state.clock.elapsed;
+    app_state.accumulator = 0;
+    app_state.interpolation_alpha = 1.0f;
+
+    const u16 fixed_update_rate = app_state.game_inst->app_config.fixed_update_rate;
+    const u16 target_fps = app_state.game_inst->app_config.target_fps;
 
     // Main game loop.
     while (app_state.is_running) {
+        KPROFILE_FRAME_BEGIN();
+
+        // Measure the time since the last frame. Sampled once, before any of the frame's work,
+        // so the frame limiter's deadline covers the whole frame.
+        clock_update(&app_state.clock);
+        f64 current_time = app_state.clock.elapsed;
+        f64 delta = current_time - app_state.last_time;
+        f64 frame_start_time = app_state.clock.start_time + current_time;
+        app_state.last_time = current_time;
+
+        // Clamp long frames so the simulation does not try to catch up on seconds at once.
+        if (delta > MAX_FRAME_DELTA) {
+            delta = MAX_FRAME_DELTA;
+        }
+
+        // Release everything allocated from the frame arena during the previous frame.
+        linear_allocator_free_all(&app_state.frame_allocator);
+
+        // With nothing to do until the next input, sleep on the OS message queue instead of spinning.
+        if (app_state.is_suspended || (app_state.game_inst->is_idle && app_state.game_inst->is_idle(app_state.game_inst))) {
+            KPROFILE_ZONE_BEGIN("platform_wait_messages");
+            platform_wait_messages(&app_state.platform, IDLE_WAIT_TIMEOUT_MS);
+            KPROFILE_ZONE_END();
+        }
 
         // Process OS messages (e.g., input, window events).
-        if(!platform_pump_messages(&app_state.platform)) {
+        KPROFILE_ZONE_BEGIN("platform_pump_messages");
+        b8 pumped = platform_pump_messages(&app_state.platform);
+        KPROFILE_ZONE_END();
+        if (!pumped) {
             app_state.is_running = FALSE;
         }
 
+        // Dispatch the events the pump translated, in order.
+        KPROFILE_ZONE_BEGIN("event_dispatch_queued");
+        event_dispatch_queued();
+        KPROFILE_ZONE_END();
+
+        // Publish this frame's input snapshot. Everything in update reads from it.
+        input_update();
+
+        // Hand finished streaming reads to their callbacks and issue the next ones.
+        async_io_update();
+
         // If the application is not suspended, run the game's logic.
         if (!app_state.is_suspended) {
 
-            // Call the game's update routine.
-            // TODO: Pass a proper delta time.
-            if (!app_state.game_inst->update(app_state.game_inst, (f32)0)) {
-                KFATAL("Game update failed.");
-                app_state.is_running = FALSE;
-                break;
+            if (fixed_update_rate > 0) {
+                // Fixed timestep: consume the elapsed time in steps of exactly 1/rate seconds.
+                const f64 step = 1.0 / fixed_update_rate;
+                app_state.accumulator += delta;
+
+                u32 steps = 0;
+                while (app_state.accumulator >= step && steps < MAX_FIXED_STEPS_PER_FRAME) {
+                    KPROFILE_ZONE_BEGIN("game_update");
+                    b8 updated = app_state.game_inst->update(app_state.game_inst, (f32)step);
+                    KPROFILE_ZONE_END();
+                    if (!updated) {
+                        KFATAL("Game update failed.");
+                        app_state.is_running = FALSE;
+                        break;
+                    }
+                    app_state.accumulator -= step;
+                    steps++;
+                }
+
+                // Drop time we could not catch up on rather than spiralling.
+                if (app_state.accumulator >= step) {
+                    app_state.accumulator = 0;
+                }
+
+                // The leftover fraction of a step is used to interpolate rendering.
+                app_state.interpolation_alpha = (f32)(app_state.accumulator / step);
+            } else {
+                // Variable timestep: one update per frame with the real frame time.
+                KPROFILE_ZONE_BEGIN("game_update");
+                b8 updated = app_state.game_inst->update(app_state.game_inst, (f32)delta);
+                KPROFILE_ZONE_END();
+                if (!updated) {
+                    KFATAL("Game update failed.");
+                    app_state.is_running = FALSE;
+                }
+                app_state.interpolation_alpha = 1.0f;
             }
 
-            // Call the game's render routine.
-            // TODO: Pass a proper delta time.
-            if (!app_state.game_inst->render(app_state.game_inst, (f32)0)) {
-                KFATAL("Game update failed, shutting down.");
-                app_state.is_running = FALSE;
+            if (!app_state.is_running) {
                 break;
             }
+
+            if (app_state.is_pipelined) {
+                // Hand this frame to the render thread. Only blocks if it is a full pipeline behind.
+                void* packet = frame_pipeline_acquire(&app_state.pipeline);
+                if (!packet) {
+                    KFATAL("Render thread failed, shutting down.");
+                    app_state.is_running = FALSE;
+                    break;
+                }
+
+                KPROFILE_ZONE_BEGIN("game_write_frame_packet");
+                b8 written = app_state.game_inst->write_frame_packet(app_state.game_inst, packet);
+                KPROFILE_ZONE_END();
+                if (!written) {
+                    frame_pipeline_cancel(&app_state.pipeline);
+                    KFATAL("Game failed to write the frame packet, shutting down.");
+                    app_state.is_running = FALSE;
+                    break;
+                }
+                frame_pipeline_submit(&app_state.pipeline, (f32)delta);
+            } else {
+                // Call the game's render routine.
+                KPROFILE_ZONE_BEGIN("game_render");
+                b8 rendered = app_state.game_inst->render(app_state.game_inst, (f32)delta);
+                KPROFILE_ZONE_END();
+                if (!rendered) {
+                    KFATAL("Game update failed, shutting down.");
+                    app_state.is_running = FALSE;
+                    break;
+                }
+
+                render_packet packet = {.delta_time = (f32)delta, .record_count = 0, .record_batch_size = 0, .record = 0, .record_data = 0};
+                if (!renderer_draw_frame(&packet)) {
+                    KFATAL("Renderer failed to draw the frame, shutting down.");
+                    app_state.is_running = FALSE;
+                    break;
+                }
+            }
         }
+
+        // Frame limiter: give the remaining frame time back to the OS.
+        if (target_fps > 0) {
+            KPROFILE_SCOPE("frame_limiter");
+            const f64 target_frame_time = 1.0 / target_fps;
+            const f64 deadline = frame_start_time + target_frame_time;
+            f64 remaining = deadline - platform_get_absolute_time();
+
+            // Sleep for the bulk of the remaining time...
+            if (remaining > FRAME_LIMITER_SPIN_WINDOW) {
+                u64 sleep_ms = (u64)((remaining - FRAME_LIMITER_SPIN_WINDOW) * 1000.0);
+                if (sleep_ms > 0) {
+                    platform_sleep(sleep_ms);
+                }
+            }
+
+            // ...then spin-wait the short tail for an accurate frame boundary.
+            while (platform_get_absolute_time() < deadline) {
+                kcpu_relax();
+            }
+        }
+
+        KPROFILE_FRAME_END();
     }
 
     // Ensure the state is set to not running before shutdown.
     app_state.is_running = FALSE;
 
+    // Stop the render thread before anything it might use goes away.
+    if (app_state.is_pipelined) {
+        frame_pipeline_destroy(&app_state.pipeline);
+        app_state.is_pipelined = FALSE;
+    }
+
+    // The renderer's surface belongs to the window, so it goes first.
+    renderer_system_shutdown();
+
     // Shut down the platform layer and release its resources.
     platform_shutdown(&app_state.platform);
 
+    input_system_shutdown();
+    event_unregister(EVENT_CODE_APPLICATION_QUIT, 0, application_on_event);
+    event_unregister(EVENT_CODE_RESIZED, 0, application_on_event);
+    event_system_shutdown();
+
+    // Let outstanding reads and their callbacks finish while the job workers are still up.
+    async_io_shutdown();
+
+    // Stop and join the job workers.
+    job_system_shutdown();
+
+    // Release the frame arena's block.
+    linear_allocator_destroy(&app_state.frame_allocator);
+
+    // Interned names stay valid until here, after every system that may hold one.
+    kname_system_shutdown();
+
+#if KPROFILER_ENABLED == 1
+    // Dump the most recent zones for chrome://tracing before the profiler goes away.
+    profiler_write_chrome_trace(PROFILER_TRACE_PATH);
+    profiler_shutdown();
+#endif
+
+    // Flush queued log entries and stop the log writer thread.
+    shutdown_logging();
+
     return TRUE;
+}
+
+
+/**
+ * @brief Allocates scratch memory that is valid until the start of the next frame.
+ * @param size The number of bytes to allocate.
+ * @return A pointer to the allocated (non-zeroed) block, or 0 if the frame arena is exhausted.
+ */
+void* application_frame_allocate(u64 size) {
+    return linear_allocator_allocate(&app_state.frame_allocator, size);
+}
+
+
+/**
+ * @brief Gets the interpolation factor between the last two fixed simulation steps.
+ * @return A value in [0, 1]. Always 1 when no fixed update rate is configured.
+ */
+f32 application_get_interpolation_alpha() {
+    return app_state.interpolation_alpha;
 }
\ No newline at end of file
@@ -53,6 +53,44 @@ typedef struct application_config {
      * portability and simplicity across different platforms.
      */
     char* name;
+
+
+    /** * @brief The frame rate the main loop is limited to, or 0 for no limit.
+     * The limiter sleeps for most of the spare frame time and spin-waits the
+     * last moments for accuracy, so an idle game no longer burns a full core.
+     */
+    u16 target_fps;
+
+
+    /** * @brief The rate of the fixed simulation step in updates per second, or 0 for a variable step.
+     * When set, `update` is called with a constant delta time as many times as needed to
+     * catch up with real time, and the leftover fraction is exposed through
+     * application_get_interpolation_alpha for rendering.
+     */
+    u16 fixed_update_rate;
+
+
+    /** * @brief Enables pipelined rendering, where frame N is updated while frame N-1 is rendered.
+     * Requires the game to provide frame_packet_size, write_frame_packet and render_frame_packet.
+     * Rendering then runs on a dedicated render thread and `render` is not called.
+     * `b8` is used as a memory-efficient boolean.
+     */
+    b8 pipelined_rendering;
+
+
+    /** * @brief The number of frames the CPU may record ahead of the GPU: 2 or 3, or 0 for the default of 2.
+     * A third frame hides more GPU stalls at the cost of another frame of input latency
+     * and another set of per-frame resources.
+     */
+    u8 frames_in_flight;
+
+
+    /** * @brief Runs without a renderer, e.g. for servers and tools on machines without a Vulkan device.
+     * The window is still created, but no Vulkan instance or device is, and frames are not drawn.
+     * When FALSE, a missing Vulkan 1.1 device or window surface makes application_create fail.
+     * `b8` is used as a memory-efficient boolean.
+     */
+    b8 headless;
 } application_config;
 
 
@@ -71,4 +109,23 @@ KAPI b8 application_create(struct game* game_inst);
  * This function will block until the application is signaled to quit.
  * @return `b8 TRUE` on a graceful shutdown, or `b8 FALSE` if an error occurs.
  */
-KAPI b8 application_run();
\ No newline at end of file
+KAPI b8 application_run();
+
+
+/**
+ * @brief Allocates scratch memory from the application's per-frame arena.
+ * The arena is reset at the top of every main loop iteration, so the returned
+ * memory is only valid until the end of the current frame. Each call is a
+ * pointer bump and never touches the system heap.
+ * @param size The number of bytes to allocate. `u64` supports large allocations.
+ * @return A pointer to the allocated (non-zeroed) block, or 0 if the frame arena is exhausted.
+ */
+KAPI void* application_frame_allocate(u64 size);
+
+
+/**
+ * @brief Gets how far the current frame is between the last two fixed simulation steps.
+ * Renderers can use this to interpolate between the previous and current simulation state.
+ * @return An `f32` in [0, 1]. Always 1 when no fixed update rate is configured.
+ */
+KAPI f32 application_get_interpolation_alpha();
\ No newline at end of file
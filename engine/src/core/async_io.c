@@ -0,0 +1,199 @@
+/**
+ * @file async_io.c
+ * @brief This file contains the implementation of the engine's asynchronous file reads.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "async_io.h"
+
+#include "containers/darray.h"
+#include "core/job_system.h"
+#include "core/katomic.h"
+#include "core/logger.h"
+#include "core/profiler.h"
+
+/** @brief The number of reads in flight when async_io_initialize is given 0. */
+#define ASYNC_IO_DEFAULT_MAX_IN_FLIGHT 256
+
+/** @brief The number of completions taken from the platform queue at once. */
+#define ASYNC_IO_POLL_BATCH 64
+
+/**
+ * @struct async_io_state
+ * @brief The global state of the async I/O system.
+ */
+typedef struct async_io_state {
+    /** @brief Indicates if the system is initialized. */
+    b8 initialized;
+
+    /** @brief The platform queue the reads are issued on. */
+    platform_io_queue queue;
+
+    /** @brief A darray of submitted requests that did not fit in the queue yet, oldest first. */
+    async_io_request** backlog;
+
+    /** @brief The index of the oldest request in `backlog` that has not been issued. */
+    u64 backlog_head;
+
+    /** @brief Counts the callback jobs that have not finished. */
+    job_counter callbacks;
+} async_io_state;
+
+// Static so the state needs no allocation and is private to this file.
+static async_io_state state;
+
+/**
+ * @brief Runs a finished request's callback, then publishes its final status.
+ * @param data The async_io_request.
+ */
+static void async_io_finish(void* data) {
+    async_io_request* request = data;
+    if (request->callback) {
+        request->callback(request);
+    }
+
+    // Release, so whoever sees the final status also sees the data and the callback's writes.
+    u32 status = request->succeeded ? ASYNC_IO_STATUS_COMPLETE : ASYNC_IO_STATUS_FAILED;
+    katomic_store(&request->status, status, KATOMIC_RELEASE);
+}
+
+/**
+ * @brief Issues backlogged requests until the platform queue is full, then submits them together.
+ */
+static void async_io_issue_backlog() {
+    u64 length = darray_length(state.backlog);
+    while (state.backlog_head < length) {
+        async_io_request* request = state.backlog[state.backlog_head];
+        if (!request->file || !request->file->is_valid) {
+            KERROR("async_io_submit - request for an invalid file.");
+            request->succeeded = FALSE;
+            async_io_finish(request);
+        } else if (!platform_io_queue_read(&state.queue, request->file, request->offset, request->buffer, request->size, request)) {
+            // The queue is full. The rest is issued as reads finish.
+            break;
+        }
+        state.backlog_head++;
+    }
+
+    if (state.backlog_head == length) {
+        darray_clear(state.backlog);
+        state.backlog_head = 0;
+    }
+
+    platform_io_queue_submit(&state.queue);
+}
+
+/**
+ * @brief Takes one batch of finished reads off the platform queue and dispatches them.
+ * @param wait If TRUE and reads are in flight, blocks until at least one has finished.
+ * @return The number of reads that finished.
+ */
+static u32 async_io_process(b8 wait) {
+    platform_io_completion completions[ASYNC_IO_POLL_BATCH];
+    u32 count = platform_io_queue_poll(&state.queue, completions, ASYNC_IO_POLL_BATCH, wait);
+
+    job_desc jobs[ASYNC_IO_POLL_BATCH];
+    u32 job_count = 0;
+    // With no workers, queued jobs would only run when the main thread waits on something.
+    b8 inline_callbacks = job_system_thread_count() == 1;
+    for (u32 i = 0; i < count; ++i) {
+        async_io_request* request = completions[i].user_data;
+        request->bytes_read = completions[i].bytes_read;
+        request->succeeded = completions[i].success;
+        if (request->callback && !inline_callbacks) {
+            jobs[job_count].entry = async_io_finish;
+            jobs[job_count].data = request;
+            job_count++;
+        } else {
+            async_io_finish(request);
+        }
+    }
+
+    if (job_count > 0) {
+        job_system_submit(jobs, job_count, &state.callbacks);
+    }
+    return count;
+}
+
+b8 async_io_initialize(u32 max_in_flight) {
+    if (state.initialized) {
+        KERROR("async_io_initialize called more than once.");
+        return FALSE;
+    }
+
+    if (max_in_flight == 0) {
+        max_in_flight = ASYNC_IO_DEFAULT_MAX_IN_FLIGHT;
+    }
+    if (!platform_io_queue_create(max_in_flight, PLATFORM_IO_BACKEND_DEFAULT, &state.queue)) {
+        KERROR("async_io_initialize - failed to create the I/O queue.");
+        return FALSE;
+    }
+
+    state.backlog = darray_create(async_io_request*);
+    state.backlog_head = 0;
+    state.callbacks.value = 0;
+    state.initialized = TRUE;
+
+    KINFO("Async I/O started on %s with %u reads in flight.", platform_io_queue_backend_name(&state.queue), max_in_flight);
+    return TRUE;
+}
+
+void async_io_shutdown() {
+    if (!state.initialized) {
+        return;
+    }
+
+    // Run everything to completion; the requests' owners may still be waiting on them.
+    while (state.backlog_head < darray_length(state.backlog) || platform_io_queue_in_flight(&state.queue) > 0) {
+        async_io_process(TRUE);
+        async_io_issue_backlog();
+    }
+    job_system_wait(&state.callbacks);
+
+    platform_io_queue_destroy(&state.queue);
+    darray_destroy(state.backlog);
+    state.backlog = 0;
+    state.initialized = FALSE;
+}
+
+void async_io_submit(async_io_request* requests, u32 count) {
+    for (u32 i = 0; i < count; ++i) {
+        requests[i].bytes_read = 0;
+        requests[i].succeeded = FALSE;
+        katomic_store(&requests[i].status, ASYNC_IO_STATUS_PENDING, KATOMIC_RELAXED);
+        darray_push(state.backlog, &requests[i]);
+    }
+    async_io_issue_backlog();
+}
+
+void async_io_update() {
+    if (!state.initialized) {
+        return;
+    }
+
+    KPROFILE_SCOPE("async_io_update");
+    // Each batch frees room in the queue, so keep going until nothing more has finished.
+    while (async_io_process(FALSE) > 0) {
+        async_io_issue_backlog();
+    }
+}
+
+async_io_status async_io_get_status(const async_io_request* request) {
+    return (async_io_status)katomic_load(&request->status, KATOMIC_ACQUIRE);
+}
+
+async_io_status async_io_wait(async_io_request* request) {
+    KPROFILE_SCOPE("async_io_wait");
+
+    async_io_status status;
+    while ((status = async_io_get_status(request)) == ASYNC_IO_STATUS_PENDING) {
+        if (platform_io_queue_in_flight(&state.queue) > 0) {
+            async_io_process(TRUE);
+            async_io_issue_backlog();
+        } else {
+            // The read has finished, so only its callback job is left.
+            job_system_wait(&state.callbacks);
+        }
+    }
+    return status;
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+/**
+ * @file async_io.h
+ * @brief This file contains the declarations for the engine's asynchronous file reads.
+ *
+ * @details Callers describe reads with async_io_request structures they own, submit any number
+ * of them at once, and either poll each request's status or have a callback run when it
+ * finishes. Reads are handed to the platform I/O queue (io_uring or an I/O thread pool on
+ * Linux, overlapped I/O on an IOCP on Win32) in batches, so the main loop never blocks on
+ * the disk. Requests beyond the queue's capacity wait in a backlog and are issued as earlier
+ * reads finish.
+ *
+ * Completions are collected by async_io_update, which the application calls once per frame.
+ * Callbacks run as jobs on the job system, so decoding the loaded data happens off the main
+ * thread. Without worker threads, they run inline in async_io_update instead.
+ *
+ * The API must be used from the main thread only. Callbacks may run on any thread.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "defines.h"
+#include "platform/platform.h"
+
+/**
+ * @enum async_io_status
+ * @brief The state of an async_io_request.
+ */
+typedef enum async_io_status {
+    /** @brief The read has been submitted and has not finished yet (or its callback is still running). */
+    ASYNC_IO_STATUS_PENDING,
+
+    /** @brief The read succeeded, and its callback (if any) has returned. */
+    ASYNC_IO_STATUS_COMPLETE,
+
+    /** @brief The read failed, and its callback (if any) has returned. */
+    ASYNC_IO_STATUS_FAILED
+} async_io_status;
+
+struct async_io_request;
+
+/**
+ * @brief The signature of a read's completion callback.
+ * @param request The finished request. Its status is still ASYNC_IO_STATUS_PENDING while the
+ * callback runs; check `succeeded` instead.
+ */
+typedef void (*async_io_callback)(struct async_io_request* request);
+
+/**
+ * @struct async_io_request
+ * @brief Describes a single read. Owned by the caller, and must stay valid until it has finished.
+ */
+typedef struct async_io_request {
+    /** @brief The file to read from, opened with PLATFORM_FILE_MODE_READ | PLATFORM_FILE_MODE_ASYNC. */
+    platform_file* file;
+
+    /** @brief The position in the file to read from. */
+    u64 offset;
+
+    /** @brief The buffer receiving the data, at least `size` bytes. */
+    void* buffer;
+
+    /** @brief The number of bytes to read. */
+    u32 size;
+
+    /** @brief An optional callback run as a job once the read has finished. */
+    async_io_callback callback;
+
+    /** @brief User data for the callback. */
+    void* user_data;
+
+    /** @brief Output: the number of bytes read. Less than `size` if the read hit the end of the file. */
+    u32 bytes_read;
+
+    /** @brief Output: indicates if the read succeeded. Valid from the moment the callback runs. */
+    b8 succeeded;
+
+    /** @brief Output: the async_io_status of the request. Read it with async_io_get_status. */
+    u32 status;
+} async_io_request;
+
+
+/**
+ * @brief Initializes the async I/O system. The job system must already be running.
+ * @param max_in_flight The maximum number of reads handed to the OS at once. 0 uses a default of 256.
+ * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+ */
+KAPI b8 async_io_initialize(u32 max_in_flight);
+
+
+/**
+ * @brief Waits for every submitted read and callback to finish, then shuts the async I/O system down.
+ */
+KAPI void async_io_shutdown();
+
+
+/**
+ * @brief Submits a batch of reads.
+ * @details Every request is set to ASYNC_IO_STATUS_PENDING. As many as fit are handed to the OS
+ * with a single submission; the rest are issued from async_io_update as room frees up.
+ * @param requests An array of `count` requests, each of which must stay valid until it has finished.
+ * @param count The number of requests in `requests`.
+ */
+KAPI void async_io_submit(async_io_request* requests, u32 count);
+
+
+/**
+ * @brief Collects finished reads, dispatches their callbacks and issues reads from the backlog.
+ * Never blocks. Called by the application once per frame.
+ */
+KAPI void async_io_update();
+
+
+/**
+ * @brief Gets the status of a request. Safe to call from any thread.
+ * @param request The request.
+ * @return The async_io_status of the request.
+ */
+KAPI async_io_status async_io_get_status(const async_io_request* request);
+
+
+/**
+ * @brief Blocks until a request has finished, including its callback.
+ * @details Meant for loads that cannot proceed without the data. Other reads are processed
+ * in the meantime, and the calling thread runs jobs while it waits for callbacks.
+ * @param request The request to wait on.
+ * @return The final async_io_status of the request.
+ */
+KAPI async_io_status async_io_wait(async_io_request* request);
@@ -0,0 +1,24 @@
+/**
+ * @file clock.c
+ * @brief Implementation of the clock.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "clock.h"
+
+#include "platform/platform.h"
+
+void clock_update(kclock* clock) {
+    if (clock->start_time != 0) {
+        clock->elapsed = platform_get_absolute_time() - clock->start_time;
+    }
+}
+
+void clock_start(kclock* clock) {
+    clock->start_time = platform_get_absolute_time();
+    clock->elapsed = 0;
+}
+
+void clock_stop(kclock* clock) {
+    clock->start_time = 0;
+}
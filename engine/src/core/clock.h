@@ -0,0 +1,43 @@
+#pragma once
+
+/**
+ * @file clock.h
+ * @brief Contains a simple clock used to measure elapsed time.
+ *
+ * A clock is started, then updated whenever the elapsed time is needed (e.g. once
+ * per frame). It is built on platform_get_absolute_time, so it shares its precision.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "defines.h"
+
+/**
+ * @struct kclock
+ * @brief Holds the state of a single clock.
+ * Named `kclock` to avoid clashing with the C standard library's clock().
+ */
+typedef struct kclock {
+    /** @brief The absolute time the clock was started, or 0 if it is stopped. */
+    f64 start_time;
+
+    /** @brief The seconds elapsed since the clock was started, as of the last clock_update. */
+    f64 elapsed;
+} kclock;
+
+/**
+ * @brief Updates the clock's elapsed time. Has no effect on a stopped clock.
+ * @param clock A pointer to the clock to update.
+ */
+KAPI void clock_update(kclock* clock);
+
+/**
+ * @brief Starts (or restarts) the clock, resetting its elapsed time.
+ * @param clock A pointer to the clock to start.
+ */
+KAPI void clock_start(kclock* clock);
+
+/**
+ * @brief Stops the clock. Its elapsed time is kept until it is started again.
+ * @param clock A pointer to the clock to stop.
+ */
+KAPI void clock_stop(kclock* clock);
@@ -0,0 +1,192 @@
+/**
+ * @file event.c
+ * @brief This file contains the implementation of the engine's event system.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "event.h"
+
+#include "core/logger.h"
+#include "core/kmemory.h"
+#include "containers/ring_queue.h"
+
+/** @brief The number of events the queue holds. Must be a power of two. */
+#define EVENT_QUEUE_CAPACITY 256
+
+/**
+ * @struct registered_listener
+ * @brief A single listener registration.
+ */
+typedef struct registered_listener {
+    /** @brief The instance pointer passed back to the callback. */
+    void* listener;
+
+    /** @brief The callback. */
+    PFN_on_event callback;
+} registered_listener;
+
+/**
+ * @struct event_code_entry
+ * @brief The listeners of a single event code, stored contiguously so dispatch is a linear walk.
+ */
+typedef struct event_code_entry {
+    /** @brief The number of registered listeners. */
+    u32 count;
+
+    /** @brief The listeners, in registration order. */
+    registered_listener listeners[MAX_LISTENERS_PER_EVENT_CODE];
+} event_code_entry;
+
+/**
+ * @struct event_system_state
+ * @brief The global state of the event system.
+ */
+typedef struct event_system_state {
+    /** @brief Indicates if the event system is initialized. */
+    b8 initialized;
+
+    /** @brief The queued, not yet dispatched mouse motion event (a cell of `queue`), or 0 if there is none. */
+    event* pending_motion;
+
+    /** @brief The queue of posted events. Single-threaded, as only the main thread posts and dispatches. */
+    ring_queue queue;
+
+    /** @brief The storage of the queue. */
+    KALIGN(16) u8 queue_memory[RING_QUEUE_MEMORY_REQUIREMENT(RING_QUEUE_TYPE_SINGLE_THREADED, sizeof(event), EVENT_QUEUE_CAPACITY)];
+
+    /** @brief The listeners of every event code, indexed by code. */
+    event_code_entry registered[MAX_EVENT_CODES];
+} event_system_state;
+
+// Static so no allocation is needed and the state is private to this file.
+static event_system_state state;
+
+b8 event_system_initialize() {
+    if (state.initialized) {
+        KERROR("event_system_initialize called more than once.");
+        return FALSE;
+    }
+
+    kzero_memory(&state, sizeof(event_system_state));
+    if (!ring_queue_create(RING_QUEUE_TYPE_SINGLE_THREADED, sizeof(event), EVENT_QUEUE_CAPACITY, state.queue_memory, &state.queue)) {
+        KERROR("event_system_initialize - failed to create the event queue.");
+        return FALSE;
+    }
+    state.initialized = TRUE;
+    return TRUE;
+}
+
+void event_system_shutdown() {
+    ring_queue_destroy(&state.queue);
+    kzero_memory(&state, sizeof(event_system_state));
+}
+
+b8 event_register(u16 code, void* listener_inst, PFN_on_event on_event) {
+    if (!state.initialized || code >= MAX_EVENT_CODES || !on_event) {
+        KERROR("event_register - invalid event code %u, missing callback or event system not initialized.", code);
+        return FALSE;
+    }
+
+    event_code_entry* entry = &state.registered[code];
+    for (u32 i = 0; i < entry->count; ++i) {
+        if (entry->listeners[i].listener == listener_inst && entry->listeners[i].callback == on_event) {
+            KWARN("event_register - listener already registered for event code %u.", code);
+            return FALSE;
+        }
+    }
+
+    if (entry->count == MAX_LISTENERS_PER_EVENT_CODE) {
+        KERROR("event_register - event code %u already has the maximum of %u listeners.", code, MAX_LISTENERS_PER_EVENT_CODE);
+        return FALSE;
+    }
+
+    entry->listeners[entry->count].listener = listener_inst;
+    entry->listeners[entry->count].callback = on_event;
+    entry->count++;
+    return TRUE;
+}
+
+b8 event_unregister(u16 code, void* listener_inst, PFN_on_event on_event) {
+    if (!state.initialized || code >= MAX_EVENT_CODES) {
+        return FALSE;
+    }
+
+    event_code_entry* entry = &state.registered[code];
+    for (u32 i = 0; i < entry->count; ++i) {
+        if (entry->listeners[i].listener == listener_inst && entry->listeners[i].callback == on_event) {
+            // Shift the rest down to keep listeners in registration order.
+            u32 remaining = entry->count - i - 1;
+            if (remaining > 0) {
+                kmove_memory(&entry->listeners[i], &entry->listeners[i + 1], sizeof(registered_listener) * remaining);
+            }
+            entry->count--;
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+b8 event_fire(const event* e) {
+    if (!state.initialized || e->code >= MAX_EVENT_CODES) {
+        return FALSE;
+    }
+
+    const event_code_entry* entry = &state.registered[e->code];
+    for (u32 i = 0; i < entry->count; ++i) {
+        const registered_listener* registration = &entry->listeners[i];
+        if (registration->callback(e, registration->listener)) {
+            // Handled. Do not pass it on.
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+b8 event_post(const event* e) {
+    if (!state.initialized) {
+        return FALSE;
+    }
+
+    // Any number of motion events per frame collapse into the first one's queue slot.
+    if (e->code == EVENT_CODE_MOUSE_MOVED && state.pending_motion) {
+        *state.pending_motion = *e;
+        return TRUE;
+    }
+
+    u64 ticket;
+    event* slot = ring_queue_begin_enqueue(&state.queue, &ticket);
+    if (!slot) {
+        KWARN("event_post - event queue full, dropping event with code %u.", e->code);
+        return FALSE;
+    }
+
+    *slot = *e;
+    ring_queue_end_enqueue(&state.queue, ticket);
+    if (e->code == EVENT_CODE_MOUSE_MOVED) {
+        state.pending_motion = slot;
+    }
+    return TRUE;
+}
+
+void event_dispatch_queued() {
+    if (!state.initialized) {
+        return;
+    }
+
+    // Events posted by listeners during dispatch are left for the next call.
+    u64 count = ring_queue_count(&state.queue);
+    for (u64 i = 0; i < count; ++i) {
+        u64 ticket;
+        event* slot = ring_queue_begin_dequeue(&state.queue, &ticket);
+        if (slot == state.pending_motion) {
+            state.pending_motion = 0;
+        }
+
+        // Copied out, so listeners may post while it is being dispatched.
+        event e = *slot;
+        ring_queue_end_dequeue(&state.queue, ticket);
+        event_fire(&e);
+    }
+}
@@ -0,0 +1,188 @@
+#pragma once
+
+/**
+ * @file event.h
+ * @brief This file contains the engine's event system.
+ *
+ * @details Events are small, typed, fixed-size structs. The platform layer translates OS
+ * messages into events and posts them into a preallocated ring, which the application
+ * dispatches once per frame with event_dispatch_queued. Mouse motion is coalesced, so at
+ * most one EVENT_CODE_MOUSE_MOVED is dispatched per frame no matter how many the OS sends.
+ *
+ * Listeners are kept in a flat, fixed-capacity array per event code. Neither posting,
+ * dispatching nor registering ever allocates.
+ *
+ * The event system is single-threaded: all functions must be called on the main thread.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "defines.h"
+#include "core/keys.h"
+
+/** @brief The number of distinct event codes. System codes are below 0xFF; the rest are free for the game. */
+#define MAX_EVENT_CODES 512
+
+/** @brief The maximum number of listeners registered for a single event code. */
+#define MAX_LISTENERS_PER_EVENT_CODE 32
+
+/**
+ * @enum system_event_code
+ * @brief The event codes used by the engine. Game-defined codes should start above 0xFF.
+ */
+typedef enum system_event_code {
+    /** @brief The application should shut down on the next frame. */
+    EVENT_CODE_APPLICATION_QUIT = 0x01,
+
+    /** @brief A key was pressed. Data: `key`. */
+    EVENT_CODE_KEY_PRESSED = 0x02,
+
+    /** @brief A key was released. Data: `key`. */
+    EVENT_CODE_KEY_RELEASED = 0x03,
+
+    /** @brief A mouse button was pressed. Data: `button`. */
+    EVENT_CODE_BUTTON_PRESSED = 0x04,
+
+    /** @brief A mouse button was released. Data: `button`. */
+    EVENT_CODE_BUTTON_RELEASED = 0x05,
+
+    /** @brief The mouse moved. Coalesced to one per frame. Data: `mouse_move`. */
+    EVENT_CODE_MOUSE_MOVED = 0x06,
+
+    /** @brief The mouse wheel moved. Data: `mouse_wheel`. */
+    EVENT_CODE_MOUSE_WHEEL = 0x07,
+
+    /** @brief The window's client area was resized. Data: `resize`. */
+    EVENT_CODE_RESIZED = 0x08,
+
+    /** @brief The highest system event code. */
+    MAX_SYSTEM_EVENT_CODE = 0xFF
+} system_event_code;
+
+/** @brief The data of key events. */
+typedef struct event_key {
+    /** @brief The key that changed. */
+    keys key;
+} event_key;
+
+/** @brief The data of mouse button events. */
+typedef struct event_button {
+    /** @brief The button that changed. */
+    buttons button;
+
+    /** @brief The cursor position in window coordinates when the button changed. */
+    i16 x;
+    i16 y;
+} event_button;
+
+/** @brief The data of mouse motion events. */
+typedef struct event_mouse_move {
+    /** @brief The cursor position in window coordinates. `i16` is enough for any window and allows off-window positions. */
+    i16 x;
+    i16 y;
+} event_mouse_move;
+
+/** @brief The data of mouse wheel events. */
+typedef struct event_mouse_wheel {
+    /** @brief The scroll direction, flattened to -1 (down) or 1 (up). */
+    i8 z_delta;
+} event_mouse_wheel;
+
+/** @brief The data of resize events. */
+typedef struct event_resize {
+    /** @brief The new width of the client area in pixels. */
+    u16 width;
+
+    /** @brief The new height of the client area in pixels. */
+    u16 height;
+} event_resize;
+
+/**
+ * @struct event
+ * @brief A single event. 24 bytes, so hundreds fit in a few cache lines.
+ */
+typedef struct event {
+    /** @brief The event code, which determines which member of the union is valid. */
+    u16 code;
+
+    /** @brief The event data. */
+    union {
+        event_key key;
+        event_button button;
+        event_mouse_move mouse_move;
+        event_mouse_wheel mouse_wheel;
+        event_resize resize;
+
+        /** @brief Raw storage for game-defined events. */
+        u8 u8[16];
+        u16 u16[8];
+        u32 u32[4];
+        i32 i32[4];
+        f32 f32[4];
+        u64 u64[2];
+        f64 f64[2];
+    };
+} event;
+
+/**
+ * @brief The signature of an event listener.
+ * @param e The event being dispatched.
+ * @param listener_inst The listener instance given at registration.
+ * @return `b8 TRUE` if the event was handled and must not be passed to further listeners, otherwise `b8 FALSE`.
+ */
+typedef b8 (*PFN_on_event)(const event* e, void* listener_inst);
+
+
+/**
+ * @brief Initializes the event system.
+ * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+ */
+KAPI b8 event_system_initialize();
+
+
+/**
+ * @brief Shuts down the event system, dropping queued events and all listeners.
+ */
+KAPI void event_system_shutdown();
+
+
+/**
+ * @brief Registers a listener for an event code.
+ * @param code The event code to listen for.
+ * @param listener_inst An instance pointer passed back to the callback. May be 0.
+ * @param on_event The callback.
+ * @return `b8 TRUE` on success, `b8 FALSE` if the registration already exists or the code's listeners are full.
+ */
+KAPI b8 event_register(u16 code, void* listener_inst, PFN_on_event on_event);
+
+
+/**
+ * @brief Unregisters a listener previously registered with event_register.
+ * @param code The event code.
+ * @param listener_inst The instance pointer given at registration.
+ * @param on_event The callback given at registration.
+ * @return `b8 TRUE` if the registration was found and removed, otherwise `b8 FALSE`.
+ */
+KAPI b8 event_unregister(u16 code, void* listener_inst, PFN_on_event on_event);
+
+
+/**
+ * @brief Dispatches an event to its listeners immediately.
+ * @param e The event to fire.
+ * @return `b8 TRUE` if a listener handled the event, otherwise `b8 FALSE`.
+ */
+KAPI b8 event_fire(const event* e);
+
+
+/**
+ * @brief Queues an event to be dispatched by the next event_dispatch_queued.
+ * Mouse motion replaces any motion event already queued this frame.
+ * @param e The event to queue. Copied.
+ * @return `b8 TRUE` on success, `b8 FALSE` if the queue is full and the event was dropped.
+ */
+KAPI b8 event_post(const event* e);
+
+
+/**
+ * @brief Dispatches every queued event in the order it was posted and empties the queue.
+ */
+KAPI void event_dispatch_queued();
@@ -0,0 +1,153 @@
+/**
+ * @file frame_pipeline.c
+ * @brief This file contains the implementation of the frame pipeline.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "frame_pipeline.h"
+
+#include "core/logger.h"
+#include "core/kmemory.h"
+#include "core/katomic.h"
+#include "core/profiler.h"
+
+/**
+ * @brief The entry point of the consumer (render) thread.
+ */
+static u32 frame_pipeline_thread_main(void* params) {
+    frame_pipeline* pipeline = params;
+
+    while (TRUE) {
+        platform_semaphore_wait(&pipeline->ready_packets, PLATFORM_WAIT_INFINITE);
+        if (katomic_load(&pipeline->stopping, KATOMIC_ACQUIRE)) {
+            break;
+        }
+
+        // Packets are submitted and consumed in the same order, so the indices stay in step.
+        u32 index = pipeline->read_index;
+        pipeline->read_index = (index + 1) % FRAME_PIPELINE_PACKET_COUNT;
+
+        KPROFILE_ZONE_BEGIN("frame_pipeline_consume");
+        b8 consumed = pipeline->consume(pipeline->user_data, pipeline->packets + index * pipeline->packet_stride, pipeline->delta_times[index]);
+        KPROFILE_ZONE_END();
+
+        if (!consumed) {
+            // Mark the failure before releasing the packet, so a producer woken by it sees the flag.
+            KERROR("Frame pipeline consumer failed. Stopping the pipeline.");
+            katomic_store(&pipeline->failed, TRUE, KATOMIC_RELEASE);
+            platform_semaphore_signal(&pipeline->free_packets);
+            break;
+        }
+
+        platform_semaphore_signal(&pipeline->free_packets);
+    }
+
+    return 0;
+}
+
+b8 frame_pipeline_create(u64 packet_size, frame_pipeline_consume consume, void* user_data, frame_pipeline* out_pipeline) {
+    if (!out_pipeline || !consume || packet_size == 0) {
+        KERROR("frame_pipeline_create requires a non-zero packet_size, a consume function and a valid out_pipeline.");
+        return FALSE;
+    }
+
+    kzero_memory(out_pipeline, sizeof(frame_pipeline));
+    out_pipeline->packet_size = packet_size;
+    out_pipeline->packet_stride = KALIGN_UP(packet_size, KCACHE_LINE_SIZE);
+    out_pipeline->consume = consume;
+    out_pipeline->user_data = user_data;
+
+    // Packets are zeroed once, so the first frames never see garbage.
+    u64 storage_size = out_pipeline->packet_stride * FRAME_PIPELINE_PACKET_COUNT;
+    out_pipeline->packets = kallocate_aligned(storage_size, KCACHE_LINE_SIZE, MEMORY_TAG_RENDERER);
+    if (!out_pipeline->packets) {
+        KERROR("frame_pipeline_create - failed to allocate the frame packets.");
+        return FALSE;
+    }
+    kzero_memory(out_pipeline->packets, storage_size);
+
+    if (!platform_semaphore_create(FRAME_PIPELINE_PACKET_COUNT, &out_pipeline->free_packets)) {
+        KERROR("frame_pipeline_create - failed to create the free packet semaphore.");
+        kfree_aligned(out_pipeline->packets, storage_size, KCACHE_LINE_SIZE, MEMORY_TAG_RENDERER);
+        return FALSE;
+    }
+
+    if (!platform_semaphore_create(0, &out_pipeline->ready_packets)) {
+        KERROR("frame_pipeline_create - failed to create the ready packet semaphore.");
+        platform_semaphore_destroy(&out_pipeline->free_packets);
+        kfree_aligned(out_pipeline->packets, storage_size, KCACHE_LINE_SIZE, MEMORY_TAG_RENDERER);
+        return FALSE;
+    }
+
+    if (!platform_thread_create(frame_pipeline_thread_main, out_pipeline, &out_pipeline->thread)) {
+        KERROR("frame_pipeline_create - failed to start the render thread.");
+        platform_semaphore_destroy(&out_pipeline->ready_packets);
+        platform_semaphore_destroy(&out_pipeline->free_packets);
+        kfree_aligned(out_pipeline->packets, storage_size, KCACHE_LINE_SIZE, MEMORY_TAG_RENDERER);
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+void frame_pipeline_destroy(frame_pipeline* pipeline) {
+    if (!pipeline || !pipeline->packets) {
+        return;
+    }
+
+    // Wake the consumer with the stop flag set. It exits without touching further packets.
+    katomic_store(&pipeline->stopping, TRUE, KATOMIC_RELEASE);
+    platform_semaphore_signal(&pipeline->ready_packets);
+    platform_thread_join(&pipeline->thread);
+
+    platform_semaphore_destroy(&pipeline->ready_packets);
+    platform_semaphore_destroy(&pipeline->free_packets);
+    kfree_aligned(pipeline->packets, pipeline->packet_stride * FRAME_PIPELINE_PACKET_COUNT, KCACHE_LINE_SIZE, MEMORY_TAG_RENDERER);
+    kzero_memory(pipeline, sizeof(frame_pipeline));
+}
+
+void* frame_pipeline_acquire(frame_pipeline* pipeline) {
+    if (katomic_load(&pipeline->failed, KATOMIC_ACQUIRE)) {
+        return 0;
+    }
+
+    if (!pipeline->acquired) {
+        // Blocks only when the render thread is a full pipeline behind.
+        KPROFILE_ZONE_BEGIN("frame_pipeline_acquire");
+        platform_semaphore_wait(&pipeline->free_packets, PLATFORM_WAIT_INFINITE);
+        KPROFILE_ZONE_END();
+
+        if (katomic_load(&pipeline->failed, KATOMIC_ACQUIRE)) {
+            platform_semaphore_signal(&pipeline->free_packets);
+            return 0;
+        }
+        pipeline->acquired = TRUE;
+    }
+
+    return pipeline->packets + pipeline->write_index * pipeline->packet_stride;
+}
+
+void frame_pipeline_submit(frame_pipeline* pipeline, f32 delta_time) {
+    if (!pipeline->acquired) {
+        KWARN("frame_pipeline_submit called without an acquired packet.");
+        return;
+    }
+
+    pipeline->delta_times[pipeline->write_index] = delta_time;
+    pipeline->write_index = (pipeline->write_index + 1) % FRAME_PIPELINE_PACKET_COUNT;
+    pipeline->acquired = FALSE;
+
+    // The semaphore orders the packet writes before the consumer's reads.
+    platform_semaphore_signal(&pipeline->ready_packets);
+}
+
+void frame_pipeline_cancel(frame_pipeline* pipeline) {
+    if (pipeline->acquired) {
+        pipeline->acquired = FALSE;
+        platform_semaphore_signal(&pipeline->free_packets);
+    }
+}
+
+b8 frame_pipeline_failed(frame_pipeline* pipeline) {
+    return katomic_load(&pipeline->failed, KATOMIC_ACQUIRE);
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+/**
+ * @file frame_pipeline.h
+ * @brief This file contains the declarations for the frame pipeline, which hands frame
+ * packets from the update thread to a dedicated render thread.
+ *
+ * @details The pipeline owns FRAME_PIPELINE_PACKET_COUNT fixed-size packets and a
+ * consumer thread. The producer (the main thread) acquires a free packet, fills it with
+ * everything rendering needs for one frame and submits it. The consumer thread renders
+ * submitted packets strictly in order and then returns them to the free set. With three
+ * packets, one can be rendered, one can wait queued and one can be written at the same
+ * time, so the simulation of frame N overlaps the rendering of frame N-1 without either
+ * side touching the other's data.
+ *
+ * @copyright Copyright (c) 2025
+ */
+
+#include "defines.h"
+#include "platform/platform.h"
+
+/** @brief The number of packets in flight: one being written, one queued, one being rendered. */
+#define FRAME_PIPELINE_PACKET_COUNT 3
+
+/**
+ * @brief The signature of the function that consumes a packet on the render thread.
+ * @param user_data The user data given to frame_pipeline_create.
+ * @param packet The packet to consume. Read-only, and only valid for the duration of the call.
+ * @param delta_time The delta time the packet was submitted with.
+ * @return `b8 TRUE` on success. `b8 FALSE` stops the pipeline and marks it failed.
+ */
+typedef b8 (*frame_pipeline_consume)(void* user_data, const void* packet, f32 delta_time);
+
+/**
+ * @struct frame_pipeline
+ * @brief Holds the state of a frame pipeline.
+ */
+typedef struct frame_pipeline {
+    /** @brief The size of a single packet in bytes, as requested. */
+    u64 packet_size;
+
+    /** @brief The distance between two packets in `packets`. Cache-line aligned so packets never share a line. */
+    u64 packet_stride;
+
+    /** @brief The storage of all packets. */
+    u8* packets;
+
+    /** @brief The delta time each packet was submitted with. */
+    f32 delta_times[FRAME_PIPELINE_PACKET_COUNT];
+
+    /** @brief The index of the next packet the producer writes. Producer only. */
+    u32 write_index;
+
+    /** @brief The index of the next packet the consumer reads. Consumer only. */
+    u32 read_index;
+
+    /** @brief Indicates if the producer currently holds an acquired packet. Producer only. */
+    b8 acquired;
+
+    /** @brief Set to stop the consumer thread. */
+    b8 stopping;
+
+    /** @brief Set by the consumer thread when `consume` fails. */
+    b8 failed;
+
+    /** @brief Counts the free packets. The producer waits on it before writing. */
+    platform_semaphore free_packets;
+
+    /** @brief Counts the submitted packets. The consumer waits on it before reading. */
+    platform_semaphore ready_packets;
+
+    /** @brief The consumer thread. */
+    platform_thread thread;
+
+    /** @brief The function consuming packets. */
+    frame_pipeline_consume consume;
+
+    /** @brief The user data passed to `consume`. */
+    void* user_data;
+} frame_pipeline;
+
+
+/**
+ * @brief Creates a frame pipeline and starts its consumer thread.
+ * @param packet_size The size of a single frame packet in bytes.
+ * @param consume The function called on the consumer thread for every submitted packet.
+ * @param user_data User data passed to `consume`.
+ * @param out_pipeline A pointer to the pipeline to be initialized. Must stay at the same address until destroyed.
+ * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+ */
+KAPI b8 frame_pipeline_create(u64 packet_size, frame_pipeline_consume consume, void* user_data, frame_pipeline* out_pipeline);
+
+
+/**
+ * @brief Stops and joins the consumer thread and releases the packets.
+ * @note Packets still queued at this point are dropped without being consumed.
+ * @param pipeline A pointer to the pipeline to destroy.
+ */
+KAPI void frame_pipeline_destroy(frame_pipeline* pipeline);
+
+
+/**
+ * @brief Acquires the next packet for writing, blocking while every packet is in flight.
+ * @param pipeline A pointer to the pipeline.
+ * @return A pointer to `packet_size` bytes of packet memory, or 0 if the pipeline has failed.
+ * The contents are whatever was written into this packet FRAME_PIPELINE_PACKET_COUNT frames ago.
+ */
+KAPI void* frame_pipeline_acquire(frame_pipeline* pipeline);
+
+
+/**
+ * @brief Submits the packet acquired with frame_pipeline_acquire to the consumer.
+ * @param pipeline A pointer to the pipeline.
+ * @param delta_time The delta time passed to the consumer along with the packet.
+ */
+KAPI void frame_pipeline_submit(frame_pipeline* pipeline, f32 delta_time);
+
+
+/**
+ * @brief Returns a packet acquired with frame_pipeline_acquire without submitting it.
+ * @param pipeline A pointer to the pipeline.
+ */
+KAPI void frame_pipeline_cancel(frame_pipeline* pipeline);
+
+
+/**
+ * @brief Checks if the consumer has failed and stopped.
+ * @param pipeline A pointer to the pipeline.
+ * @return `b8 TRUE` if the consumer has failed, otherwise `b8 FALSE`.
+ */
+KAPI b8 frame_pipeline_failed(frame_pipeline* pipeline);
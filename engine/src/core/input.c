@@ -0,0 +1,201 @@
+/**
+ * @file input.c
+ * @brief This file contains the implementation of the engine's input state system.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "input.h"
+
+#include "core/event.h"
+#include "core/logger.h"
+#include "core/kmemory.h"
+#include "core/katomic.h"
+
+/**
+ * @struct input_system_state
+ * @brief The global state of the input system.
+ */
+typedef struct input_system_state {
+    /** @brief Indicates if the input system is initialized. */
+    b8 initialized;
+
+    /** @brief The state being built up from this frame's events. Main thread only. */
+    input_state live;
+
+    /** @brief The published frames. Only the one not at `published` is ever written. */
+    input_frame frames[2];
+
+    /** @brief The index of the most recently published frame. Accessed atomically. */
+    u32 published;
+} input_system_state;
+
+// Static so no allocation is needed and the state is private to this file.
+static input_system_state state;
+
+/**
+ * @brief Sets or clears a key's bit in the live state.
+ */
+static void input_set_key(keys key, b8 pressed) {
+    u64 mask = 1ULL << (key & 63);
+    if (pressed) {
+        state.live.keys[key >> 6] |= mask;
+    } else {
+        state.live.keys[key >> 6] &= ~mask;
+    }
+}
+
+/**
+ * @brief Handles the input events dispatched by the event system.
+ */
+static b8 input_on_event(const event* e, void* listener_inst) {
+    // Registered without a listener instance.
+    (void)listener_inst;
+    switch (e->code) {
+        case EVENT_CODE_KEY_PRESSED:
+        case EVENT_CODE_KEY_RELEASED: {
+            keys key = e->key.key;
+            input_set_key(key, e->code == EVENT_CODE_KEY_PRESSED);
+
+            // Keep the generic modifier keys in sync with their left/right variants,
+            // so the generic code works on every platform.
+            if (key == KEY_LSHIFT || key == KEY_RSHIFT) {
+                input_set_key(KEY_SHIFT, input_state_key_down(&state.live, KEY_LSHIFT) | input_state_key_down(&state.live, KEY_RSHIFT));
+            } else if (key == KEY_LCONTROL || key == KEY_RCONTROL) {
+                input_set_key(KEY_CONTROL, input_state_key_down(&state.live, KEY_LCONTROL) | input_state_key_down(&state.live, KEY_RCONTROL));
+            } else if (key == KEY_LALT || key == KEY_RALT) {
+                input_set_key(KEY_ALT, input_state_key_down(&state.live, KEY_LALT) | input_state_key_down(&state.live, KEY_RALT));
+            }
+        } break;
+
+        case EVENT_CODE_BUTTON_PRESSED:
+        case EVENT_CODE_BUTTON_RELEASED: {
+            if (e->button.button < BUTTON_MAX_BUTTONS) {
+                u8 mask = (u8)(1u << e->button.button);
+                if (e->code == EVENT_CODE_BUTTON_PRESSED) {
+                    state.live.buttons |= mask;
+                } else {
+                    state.live.buttons &= (u8)~mask;
+                }
+            }
+        } break;
+
+        case EVENT_CODE_MOUSE_MOVED:
+            state.live.mouse_x = e->mouse_move.x;
+            state.live.mouse_y = e->mouse_move.y;
+            break;
+
+        case EVENT_CODE_MOUSE_WHEEL: {
+            // Saturate instead of wrapping on absurd scroll rates.
+            i32 wheel = state.live.wheel + e->mouse_wheel.z_delta;
+            state.live.wheel = (i8)(wheel > 127 ? 127 : (wheel < -128 ? -128 : wheel));
+        } break;
+    }
+
+    // Never consume input events, so other listeners see them too.
+    return FALSE;
+}
+
+b8 input_system_initialize() {
+    if (state.initialized) {
+        KERROR("input_system_initialize called more than once.");
+        return FALSE;
+    }
+
+    kzero_memory(&state, sizeof(input_system_state));
+
+    b8 registered = event_register(EVENT_CODE_KEY_PRESSED, 0, input_on_event);
+    registered &= event_register(EVENT_CODE_KEY_RELEASED, 0, input_on_event);
+    registered &= event_register(EVENT_CODE_BUTTON_PRESSED, 0, input_on_event);
+    registered &= event_register(EVENT_CODE_BUTTON_RELEASED, 0, input_on_event);
+    registered &= event_register(EVENT_CODE_MOUSE_MOVED, 0, input_on_event);
+    registered &= event_register(EVENT_CODE_MOUSE_WHEEL, 0, input_on_event);
+    if (!registered) {
+        KERROR("input_system_initialize - failed to register with the event system.");
+        input_system_shutdown();
+        return FALSE;
+    }
+
+    state.initialized = TRUE;
+    return TRUE;
+}
+
+void input_system_shutdown() {
+    event_unregister(EVENT_CODE_KEY_PRESSED, 0, input_on_event);
+    event_unregister(EVENT_CODE_KEY_RELEASED, 0, input_on_event);
+    event_unregister(EVENT_CODE_BUTTON_PRESSED, 0, input_on_event);
+    event_unregister(EVENT_CODE_BUTTON_RELEASED, 0, input_on_event);
+    event_unregister(EVENT_CODE_MOUSE_MOVED, 0, input_on_event);
+    event_unregister(EVENT_CODE_MOUSE_WHEEL, 0, input_on_event);
+    state.initialized = FALSE;
+}
+
+void input_update() {
+    u32 published = katomic_load(&state.published, KATOMIC_RELAXED);
+    u32 next = published ^ 1;
+
+    // Fill the unpublished frame, then publish it with a single store.
+    state.frames[next].previous = state.frames[published].current;
+    state.frames[next].current = state.live;
+    katomic_store(&state.published, next, KATOMIC_RELEASE);
+
+    // The wheel reports per-frame movement, not a held state.
+    state.live.wheel = 0;
+}
+
+const input_frame* input_get_frame() {
+    return &state.frames[katomic_load(&state.published, KATOMIC_ACQUIRE)];
+}
+
+b8 input_is_key_down(keys key) {
+    return input_frame_key_down(input_get_frame(), key);
+}
+
+b8 input_is_key_up(keys key) {
+    return !input_frame_key_down(input_get_frame(), key);
+}
+
+b8 input_was_key_down(keys key) {
+    return input_state_key_down(&input_get_frame()->previous, key);
+}
+
+b8 input_was_key_pressed(keys key) {
+    return input_frame_key_pressed(input_get_frame(), key);
+}
+
+b8 input_was_key_released(keys key) {
+    return input_frame_key_released(input_get_frame(), key);
+}
+
+b8 input_is_button_down(buttons button) {
+    return input_state_button_down(&input_get_frame()->current, button);
+}
+
+b8 input_was_button_down(buttons button) {
+    return input_state_button_down(&input_get_frame()->previous, button);
+}
+
+b8 input_was_button_pressed(buttons button) {
+    const input_frame* frame = input_get_frame();
+    return (b8)(((frame->current.buttons & ~frame->previous.buttons) >> button) & 1);
+}
+
+b8 input_was_button_released(buttons button) {
+    const input_frame* frame = input_get_frame();
+    return (b8)(((~frame->current.buttons & frame->previous.buttons) >> button) & 1);
+}
+
+void input_get_mouse_position(i32* x, i32* y) {
+    const input_frame* frame = input_get_frame();
+    *x = frame->current.mouse_x;
+    *y = frame->current.mouse_y;
+}
+
+void input_get_previous_mouse_position(i32* x, i32* y) {
+    const input_frame* frame = input_get_frame();
+    *x = frame->previous.mouse_x;
+    *y = frame->previous.mouse_y;
+}
+
+i8 input_get_mouse_wheel() {
+    return input_get_frame()->current.wheel;
+}
@@ -0,0 +1,199 @@
+#pragma once
+
+/**
+ * @file input.h
+ * @brief This file contains the engine's input state system.
+ *
+ * @details The input system listens for the key, button, motion and wheel events posted
+ * by the platform layer and folds them into a live input state. Once per frame,
+ * input_update publishes that state as an immutable input_frame holding both the current
+ * and the previous frame's state. Keys and buttons are stored as bitsets, so every query
+ * is a single bit test without branches on event history.
+ *
+ * Frames are double-buffered and published with a single atomic store. A published frame
+ * is never written again until two input_update calls later, so jobs started during a
+ * frame's update can read it from any thread without locking.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "defines.h"
+#include "core/keys.h"
+
+/** @brief The number of 64-bit words needed to hold one bit per key. */
+#define INPUT_KEY_WORDS (KEYS_MAX_KEYS / 64)
+
+/**
+ * @struct input_state
+ * @brief The keyboard and mouse state at one point in time. 40 bytes.
+ */
+typedef struct input_state {
+    /** @brief One bit per key, set while the key is held. */
+    u64 keys[INPUT_KEY_WORDS];
+
+    /** @brief One bit per mouse button, set while the button is held. */
+    u8 buttons;
+
+    /** @brief The mouse wheel movement accumulated during the frame. Positive is up. */
+    i8 wheel;
+
+    /** @brief The cursor position in window coordinates. */
+    i16 mouse_x;
+    i16 mouse_y;
+} input_state;
+
+/**
+ * @struct input_frame
+ * @brief The input snapshot of one frame: its state and the state of the frame before it.
+ */
+typedef struct input_frame {
+    /** @brief The state at the end of the frame's event processing. */
+    input_state current;
+
+    /** @brief The state one frame earlier. */
+    input_state previous;
+} input_frame;
+
+
+/**
+ * @brief Initializes the input system and registers it with the event system.
+ * @note The event system must be initialized first.
+ * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+ */
+KAPI b8 input_system_initialize();
+
+
+/**
+ * @brief Unregisters the input system from the event system.
+ */
+KAPI void input_system_shutdown();
+
+
+/**
+ * @brief Publishes the input gathered since the last call as the new input frame.
+ * @note Call once per frame on the main thread, after the frame's events were dispatched.
+ */
+KAPI void input_update();
+
+
+/**
+ * @brief Gets the most recently published input frame.
+ * @details Safe to call from any thread. The returned frame stays unchanged until the second
+ * input_update after this call, so it can be used for the whole of a frame's update.
+ * @return A pointer to the current input frame.
+ */
+KAPI const input_frame* input_get_frame();
+
+
+/** @brief Tests a key in an input state. */
+static inline b8 input_state_key_down(const input_state* state, keys key) {
+    return (b8)((state->keys[key >> 6] >> (key & 63)) & 1);
+}
+
+/** @brief Tests a mouse button in an input state. */
+static inline b8 input_state_button_down(const input_state* state, buttons button) {
+    return (b8)((state->buttons >> button) & 1);
+}
+
+
+/** @brief Returns TRUE if the key is held in the given frame. */
+static inline b8 input_frame_key_down(const input_frame* frame, keys key) {
+    return input_state_key_down(&frame->current, key);
+}
+
+/** @brief Returns TRUE if the key went down during the given frame. */
+static inline b8 input_frame_key_pressed(const input_frame* frame, keys key) {
+    u64 word = frame->current.keys[key >> 6] & ~frame->previous.keys[key >> 6];
+    return (b8)((word >> (key & 63)) & 1);
+}
+
+/** @brief Returns TRUE if the key went up during the given frame. */
+static inline b8 input_frame_key_released(const input_frame* frame, keys key) {
+    u64 word = ~frame->current.keys[key >> 6] & frame->previous.keys[key >> 6];
+    return (b8)((word >> (key & 63)) & 1);
+}
+
+
+/**
+ * @brief Checks if a key is held this frame.
+ * @param key The key to check.
+ * @return `b8 TRUE` if the key is down, otherwise `b8 FALSE`.
+ */
+KAPI b8 input_is_key_down(keys key);
+
+/**
+ * @brief Checks if a key is not held this frame.
+ * @param key The key to check.
+ * @return `b8 TRUE` if the key is up, otherwise `b8 FALSE`.
+ */
+KAPI b8 input_is_key_up(keys key);
+
+/**
+ * @brief Checks if a key was held the previous frame.
+ * @param key The key to check.
+ * @return `b8 TRUE` if the key was down, otherwise `b8 FALSE`.
+ */
+KAPI b8 input_was_key_down(keys key);
+
+/**
+ * @brief Checks if a key went down this frame.
+ * @param key The key to check.
+ * @return `b8 TRUE` if the key is down now and was up the previous frame, otherwise `b8 FALSE`.
+ */
+KAPI b8 input_was_key_pressed(keys key);
+
+/**
+ * @brief Checks if a key went up this frame.
+ * @param key The key to check.
+ * @return `b8 TRUE` if the key is up now and was down the previous frame, otherwise `b8 FALSE`.
+ */
+KAPI b8 input_was_key_released(keys key);
+
+
+/**
+ * @brief Checks if a mouse button is held this frame.
+ * @param button The button to check.
+ * @return `b8 TRUE` if the button is down, otherwise `b8 FALSE`.
+ */
+KAPI b8 input_is_button_down(buttons button);
+
+/**
+ * @brief Checks if a mouse button was held the previous frame.
+ * @param button The button to check.
+ * @return `b8 TRUE` if the button was down, otherwise `b8 FALSE`.
+ */
+KAPI b8 input_was_button_down(buttons button);
+
+/**
+ * @brief Checks if a mouse button went down this frame.
+ * @param button The button to check.
+ * @return `b8 TRUE` if the button is down now and was up the previous frame, otherwise `b8 FALSE`.
+ */
+KAPI b8 input_was_button_pressed(buttons button);
+
+/**
+ * @brief Checks if a mouse button went up this frame.
+ * @param button The button to check.
+ * @return `b8 TRUE` if the button is up now and was down the previous frame, otherwise `b8 FALSE`.
+ */
+KAPI b8 input_was_button_released(buttons button);
+
+
+/**
+ * @brief Gets the cursor position this frame.
+ * @param x A pointer to receive the horizontal position in window coordinates.
+ * @param y A pointer to receive the vertical position in window coordinates.
+ */
+KAPI void input_get_mouse_position(i32* x, i32* y);
+
+/**
+ * @brief Gets the cursor position the previous frame.
+ * @param x A pointer to receive the horizontal position in window coordinates.
+ * @param y A pointer to receive the vertical position in window coordinates.
+ */
+KAPI void input_get_previous_mouse_position(i32* x, i32* y);
+
+/**
+ * @brief Gets the mouse wheel movement of this frame.
+ * @return The accumulated wheel movement. Positive is up, 0 if the wheel did not move.
+ */
+KAPI i8 input_get_mouse_wheel();
@@ -0,0 +1,442 @@
+/**
+ * @file job_system.c
+ * @brief This file contains the implementation of the engine's work-stealing job system.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "job_system.h"
+
+#include "core/logger.h"
+#include "core/kmemory.h"
+#include "core/katomic.h"
+#include "core/profiler.h"
+#include "platform/platform.h"
+
+/** @brief The maximum number of worker threads. */
+#define JOB_MAX_WORKERS 63
+
+/** @brief The number of jobs each thread's deque holds. Must be a power of two. */
+#define JOB_DEQUE_CAPACITY 4096
+
+/** @brief How many times an idle worker looks for work before going to sleep. */
+#define JOB_WORKER_SPIN_COUNT 256
+
+/** @brief The number of batches per thread job_system_parallel_for aims for when no batch size is given. */
+#define JOB_BATCHES_PER_THREAD 4
+
+/**
+ * @struct job_item
+ * @brief A job as stored in a deque. Either `entry` or `range_entry` is set.
+ */
+typedef struct job_item {
+    /** @brief The entry point of a plain job. */
+    job_entry entry;
+
+    /** @brief The entry point of a parallel-for batch. */
+    job_range_entry range_entry;
+
+    /** @brief The user data passed to the entry point. */
+    void* data;
+
+    /** @brief The counter to decrement when the job finishes, or 0. */
+    job_counter* counter;
+
+    /** @brief The first index of a parallel-for batch. */
+    u32 start;
+
+    /** @brief One past the last index of a parallel-for batch. */
+    u32 end;
+} job_item;
+
+/**
+ * @struct job_deque
+ * @brief A Chase-Lev work-stealing deque of fixed capacity.
+ * @details The owner pushes and pops at `bottom`; thieves take from `top`. Only the
+ * last remaining job is contended, and that race is settled with a single CAS on `top`.
+ * The two indices live on separate cache lines, as they are written by different threads.
+ */
+typedef struct job_deque {
+    /** @brief The index thieves steal from. Only ever increases. */
+    KALIGN(KCACHE_LINE_SIZE) i64 top;
+
+    /** @brief The index the owner pushes to. */
+    KALIGN(KCACHE_LINE_SIZE) i64 bottom;
+
+    /** @brief The job storage, JOB_DEQUE_CAPACITY entries. */
+    job_item* items;
+} job_deque;
+
+/**
+ * @struct job_worker_params
+ * @brief The start parameter of a worker thread.
+ */
+typedef struct job_worker_params {
+    /** @brief The index of the worker's deque. */
+    u32 index;
+} job_worker_params;
+
+/**
+ * @struct job_system_state
+ * @brief The global state of the job system.
+ */
+typedef struct job_system_state {
+    /** @brief Indicates if the job system is initialized. */
+    b8 initialized;
+
+    /** @brief Cleared to tell the workers to exit. */
+    b8 running;
+
+    /** @brief The number of participating threads: the main thread plus the workers. */
+    u32 thread_count;
+
+    /** @brief The number of deques reserved in `item_memory`. */
+    u32 deque_count;
+
+    /** @brief The number of workers currently sleeping on `wake`. */
+    KALIGN(KCACHE_LINE_SIZE) u32 sleeping;
+
+    /** @brief Signalled to wake sleeping workers when jobs are submitted. */
+    platform_semaphore wake;
+
+    /** @brief The deques. Index 0 belongs to the main thread, index i to worker i. */
+    job_deque deques[JOB_MAX_WORKERS + 1];
+
+    /** @brief The worker threads. Index 0 is unused. */
+    platform_thread threads[JOB_MAX_WORKERS + 1];
+
+    /** @brief The start parameters of the workers. */
+    job_worker_params params[JOB_MAX_WORKERS + 1];
+
+    /** @brief The single block backing every deque's storage. */
+    job_item* item_memory;
+} job_system_state;
+
+// Static so the state needs no allocation and is private to this file.
+static job_system_state state;
+
+// The index of the calling thread's deque, or -1 if the thread does not belong to the job system.
+static KTHREAD_LOCAL i32 thread_index = -1;
+
+// The state of the calling thread's victim selection.
+static KTHREAD_LOCAL u32 steal_seed = 0;
+
+/**
+ * @brief Pushes a job onto the bottom of a deque. Owner only.
+ * @return `b8 TRUE` on success, `b8 FALSE` if the deque is full.
+ */
+static b8 job_deque_push(job_deque* deque, const job_item* item) {
+    i64 bottom = katomic_load(&deque->bottom, KATOMIC_RELAXED);
+    i64 top = katomic_load(&deque->top, KATOMIC_ACQUIRE);
+    if (bottom - top >= JOB_DEQUE_CAPACITY) {
+        return FALSE;
+    }
+
+    deque->items[bottom & (JOB_DEQUE_CAPACITY - 1)] = *item;
+
+    // Publish the job before making it visible through bottom.
+    katomic_store(&deque->bottom, bottom + 1, KATOMIC_RELEASE);
+    return TRUE;
+}
+
+/**
+ * @brief Pops the most recently pushed job from the bottom of a deque. Owner only.
+ * @return `b8 TRUE` if a job was taken, otherwise `b8 FALSE`.
+ */
+static b8 job_deque_pop(job_deque* deque, job_item* out_item) {
+    i64 bottom = katomic_load(&deque->bottom, KATOMIC_RELAXED) - 1;
+    katomic_store(&deque->bottom, bottom, KATOMIC_RELAXED);
+
+    // The store to bottom must be visible before top is read, or a thief could take the same job.
+    katomic_thread_fence(KATOMIC_SEQ_CST);
+    i64 top = katomic_load(&deque->top, KATOMIC_RELAXED);
+
+    if (top > bottom) {
+        // Empty. Restore bottom.
+        katomic_store(&deque->bottom, bottom + 1, KATOMIC_RELAXED);
+        return FALSE;
+    }
+
+    *out_item = deque->items[bottom & (JOB_DEQUE_CAPACITY - 1)];
+    if (top != bottom) {
+        // More than one job left, so no thief can be racing for this one.
+        return TRUE;
+    }
+
+    // Last job: race the thieves for it.
+    b8 taken = katomic_compare_exchange(&deque->top, &top, top + 1, KATOMIC_SEQ_CST, KATOMIC_RELAXED);
+    katomic_store(&deque->bottom, bottom + 1, KATOMIC_RELAXED);
+    return taken;
+}
+
+/**
+ * @brief Steals the oldest job from the top of a deque. Any thread.
+ * @return `b8 TRUE` if a job was taken, otherwise `b8 FALSE`.
+ */
+static b8 job_deque_steal(job_deque* deque, job_item* out_item) {
+    i64 top = katomic_load(&deque->top, KATOMIC_ACQUIRE);
+    katomic_thread_fence(KATOMIC_SEQ_CST);
+    i64 bottom = katomic_load(&deque->bottom, KATOMIC_ACQUIRE);
+
+    if (top >= bottom) {
+        return FALSE;
+    }
+
+    // Copy before claiming. The owner never overwrites this slot while top still points at it.
+    *out_item = deque->items[top & (JOB_DEQUE_CAPACITY - 1)];
+    return katomic_compare_exchange(&deque->top, &top, top + 1, KATOMIC_SEQ_CST, KATOMIC_RELAXED);
+}
+
+/**
+ * @brief Runs a job and signals its counter.
+ */
+static void job_execute(const job_item* item) {
+    KPROFILE_ZONE_BEGIN("job");
+    if (item->range_entry) {
+        item->range_entry(item->start, item->end, item->data);
+    } else {
+        item->entry(item->data);
+    }
+    KPROFILE_ZONE_END();
+
+    if (item->counter) {
+        // Release, so the job's writes are visible to whoever sees the counter reach zero.
+        katomic_fetch_sub(&item->counter->value, 1, KATOMIC_RELEASE);
+    }
+}
+
+/**
+ * @brief Takes a job from the calling thread's deque, or steals one from another thread.
+ * @return `b8 TRUE` if a job was found, otherwise `b8 FALSE`.
+ */
+static b8 job_find(job_item* out_item) {
+    if (job_deque_pop(&state.deques[thread_index], out_item)) {
+        return TRUE;
+    }
+
+    // Start at a pseudo-random victim so thieves spread out instead of all hitting deque 0.
+    steal_seed = steal_seed * 1664525u + 1013904223u;
+    u32 count = state.thread_count;
+    u32 start = steal_seed % count;
+    for (u32 i = 0; i < count; ++i) {
+        u32 victim = (start + i) % count;
+        if (victim != (u32)thread_index && job_deque_steal(&state.deques[victim], out_item)) {
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+/**
+ * @brief Wakes up to `count` sleeping workers.
+ */
+static void job_wake_workers(u32 count) {
+    // Pairs with the fence in job_worker_main: either the worker sees the new jobs, or we see it sleeping.
+    katomic_thread_fence(KATOMIC_SEQ_CST);
+    u32 sleeping = katomic_load(&state.sleeping, KATOMIC_SEQ_CST);
+    u32 wake = count < sleeping ? count : sleeping;
+    for (u32 i = 0; i < wake; ++i) {
+        platform_semaphore_signal(&state.wake);
+    }
+}
+
+/**
+ * @brief The entry point of every worker thread.
+ */
+static u32 job_worker_main(void* params) {
+    job_worker_params* worker = params;
+    thread_index = (i32)worker->index;
+    steal_seed = worker->index;
+
+    job_item item;
+    while (katomic_load(&state.running, KATOMIC_ACQUIRE)) {
+        b8 found = FALSE;
+        for (u32 spin = 0; spin < JOB_WORKER_SPIN_COUNT; ++spin) {
+            if (job_find(&item)) {
+                found = TRUE;
+                break;
+            }
+            kcpu_relax();
+        }
+
+        if (found) {
+            job_execute(&item);
+            continue;
+        }
+
+        // Announce the sleep, then look once more, so a submit racing with us is not missed.
+        // Every submit signals a sleeping worker, and shutdown signals them all, so the wait needs no timeout.
+        katomic_fetch_add(&state.sleeping, 1, KATOMIC_SEQ_CST);
+        katomic_thread_fence(KATOMIC_SEQ_CST);
+        if (job_find(&item)) {
+            katomic_fetch_sub(&state.sleeping, 1, KATOMIC_SEQ_CST);
+            job_execute(&item);
+            continue;
+        }
+
+        platform_semaphore_wait(&state.wake, PLATFORM_WAIT_INFINITE);
+        katomic_fetch_sub(&state.sleeping, 1, KATOMIC_SEQ_CST);
+    }
+
+    return 0;
+}
+
+b8 job_system_initialize(u32 worker_count) {
+    if (state.initialized) {
+        KERROR("job_system_initialize called more than once.");
+        return FALSE;
+    }
+
+    if (worker_count == 0) {
+        u32 processors = platform_get_processor_count();
+        worker_count = processors > 1 ? processors - 1 : 0;
+    }
+    if (worker_count > JOB_MAX_WORKERS) {
+        worker_count = JOB_MAX_WORKERS;
+    }
+
+    state.thread_count = worker_count + 1;
+    state.deque_count = state.thread_count;
+    state.sleeping = 0;
+
+    // One block for every deque. Slots are always written before they are read, so skip zeroing.
+    state.item_memory = kallocate_uninit(sizeof(job_item) * JOB_DEQUE_CAPACITY * state.deque_count, MEMORY_TAG_JOB);
+    if (!state.item_memory) {
+        KERROR("job_system_initialize - failed to reserve the job deques.");
+        return FALSE;
+    }
+
+    for (u32 i = 0; i < state.thread_count; ++i) {
+        state.deques[i].top = 0;
+        state.deques[i].bottom = 0;
+        state.deques[i].items = state.item_memory + (u64)i * JOB_DEQUE_CAPACITY;
+    }
+
+    if (!platform_semaphore_create(0, &state.wake)) {
+        KERROR("job_system_initialize - failed to create the wake semaphore.");
+        kfree(state.item_memory, sizeof(job_item) * JOB_DEQUE_CAPACITY * state.deque_count, MEMORY_TAG_JOB);
+        return FALSE;
+    }
+
+    // The initializing thread becomes the main thread of the job system.
+    thread_index = 0;
+    state.running = TRUE;
+    state.initialized = TRUE;
+
+    for (u32 i = 1; i < state.thread_count; ++i) {
+        state.params[i].index = i;
+        if (!platform_thread_create(job_worker_main, &state.params[i], &state.threads[i])) {
+            KERROR("job_system_initialize - failed to start worker %u. Continuing with %u workers.", i, i - 1);
+            state.thread_count = i;
+            break;
+        }
+    }
+
+    KINFO("Job system started with %u worker threads.", state.thread_count - 1);
+    return TRUE;
+}
+
+void job_system_shutdown() {
+    if (!state.initialized) {
+        return;
+    }
+
+    // Stop the workers and wake every sleeping one so it sees the flag.
+    katomic_store(&state.running, FALSE, KATOMIC_RELEASE);
+    for (u32 i = 1; i < state.thread_count; ++i) {
+        platform_semaphore_signal(&state.wake);
+    }
+    for (u32 i = 1; i < state.thread_count; ++i) {
+        platform_thread_join(&state.threads[i]);
+    }
+
+    platform_semaphore_destroy(&state.wake);
+
+    kfree(state.item_memory, sizeof(job_item) * JOB_DEQUE_CAPACITY * state.deque_count, MEMORY_TAG_JOB);
+    kzero_memory(&state, sizeof(job_system_state));
+    thread_index = -1;
+}
+
+u32 job_system_thread_count() {
+    return state.initialized ? state.thread_count : 1;
+}
+
+i32 job_system_thread_index() {
+    return thread_index;
+}
+
+/**
+ * @brief Submits a single job item, running it immediately if it cannot be queued.
+ * @return `b8 TRUE` if the job was queued, `b8 FALSE` if it ran immediately.
+ */
+static b8 job_submit_item(const job_item* item) {
+    if (!state.initialized || thread_index < 0 || !job_deque_push(&state.deques[thread_index], item)) {
+        job_execute(item);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+void job_system_submit(const job_desc* jobs, u32 count, job_counter* counter) {
+    if (counter) {
+        katomic_fetch_add(&counter->value, count, KATOMIC_RELAXED);
+    }
+
+    u32 queued = 0;
+    for (u32 i = 0; i < count; ++i) {
+        job_item item = {0};
+        item.entry = jobs[i].entry;
+        item.data = jobs[i].data;
+        item.counter = counter;
+        queued += job_submit_item(&item);
+    }
+
+    if (queued > 0) {
+        job_wake_workers(queued);
+    }
+}
+
+void job_system_parallel_for(u32 count, u32 batch_size, job_range_entry entry, void* data, job_counter* counter) {
+    if (count == 0) {
+        return;
+    }
+
+    if (batch_size == 0) {
+        u32 batches = job_system_thread_count() * JOB_BATCHES_PER_THREAD;
+        batch_size = (count + batches - 1) / batches;
+    }
+
+    u32 batch_count = (count + batch_size - 1) / batch_size;
+    if (counter) {
+        katomic_fetch_add(&counter->value, batch_count, KATOMIC_RELAXED);
+    }
+
+    u32 queued = 0;
+    for (u32 start = 0; start < count; start += batch_size) {
+        job_item item = {0};
+        item.range_entry = entry;
+        item.data = data;
+        item.counter = counter;
+        item.start = start;
+        item.end = count - start < batch_size ? count : start + batch_size;
+        queued += job_submit_item(&item);
+    }
+
+    if (queued > 0) {
+        job_wake_workers(queued);
+    }
+}
+
+void job_system_wait(job_counter* counter) {
+    KPROFILE_SCOPE("job_system_wait");
+
+    job_item item;
+    while (katomic_load(&counter->value, KATOMIC_ACQUIRE) > 0) {
+        // Help out instead of blocking. This is what makes nested fork-join safe.
+        if (state.initialized && thread_index >= 0 && job_find(&item)) {
+            job_execute(&item);
+        } else {
+            kcpu_relax();
+        }
+    }
+}
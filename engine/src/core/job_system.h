@@ -0,0 +1,115 @@
+#pragma once
+
+/**
+ * @file job_system.h
+ * @brief This file contains the declarations for the engine's work-stealing job system.
+ *
+ * @details The job system runs one worker thread per additional core. Every participating
+ * thread (the main thread and each worker) owns a Chase-Lev deque: it pushes and pops
+ * jobs at the bottom of its own deque without locks, while idle threads steal from the
+ * top of other deques. Jobs are tracked with a job_counter, which is incremented on submit
+ * and decremented when each job finishes, so a caller can fork work out and join on it
+ * with job_system_wait. A waiting thread keeps executing other jobs instead of blocking,
+ * which makes nested fork-join (jobs that submit and wait on jobs) safe.
+ *
+ * @copyright Copyright (c) 2025
+ */
+
+#include "defines.h"
+
+/**
+ * @brief The signature of a job's entry point.
+ * @param data The user data supplied with the job.
+ */
+typedef void (*job_entry)(void* data);
+
+/**
+ * @brief The signature of a parallel-for batch's entry point.
+ * @param start The index of the first element of the batch.
+ * @param end One past the index of the last element of the batch.
+ * @param data The user data supplied to job_system_parallel_for.
+ */
+typedef void (*job_range_entry)(u32 start, u32 end, void* data);
+
+/**
+ * @struct job_desc
+ * @brief Describes a single job to be submitted.
+ */
+typedef struct job_desc {
+    /** @brief The function the job runs. */
+    job_entry entry;
+
+    /** @brief The user data passed to `entry`. Must stay valid until the job has run. */
+    void* data;
+} job_desc;
+
+/**
+ * @struct job_counter
+ * @brief Counts the unfinished jobs of a batch. Zero-initialize before first use.
+ * @details A counter may be reused for several submissions and waited on once for all of them.
+ */
+typedef struct job_counter {
+    /** @brief The number of submitted jobs that have not finished yet. Accessed atomically. */
+    u32 value;
+} job_counter;
+
+
+/**
+ * @brief Initializes the job system and starts its worker threads.
+ * @param worker_count The number of worker threads to start. 0 uses one per logical processor minus one
+ * (the main thread also runs jobs while it waits).
+ * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+ */
+KAPI b8 job_system_initialize(u32 worker_count);
+
+
+/**
+ * @brief Stops and joins every worker thread and releases the job system's memory.
+ * @note All submitted jobs must have been waited on before shutdown.
+ */
+KAPI void job_system_shutdown();
+
+
+/**
+ * @brief Gets the number of threads running jobs, including the main thread.
+ * @return The number of participating threads, or 1 if the job system is not initialized.
+ */
+KAPI u32 job_system_thread_count();
+
+
+/**
+ * @brief Gets the index of the calling thread among the threads running jobs.
+ * @details Lets jobs use per-thread resources without locking, e.g. arrays of job_system_thread_count entries.
+ * @return 0 for the main thread, 1 to job_system_thread_count() - 1 for the workers, or -1 for a
+ * thread that does not belong to the job system.
+ */
+KAPI i32 job_system_thread_index();
+
+
+/**
+ * @brief Submits jobs to the calling thread's deque, from where they are run or stolen.
+ * @details The calling thread must be the main thread or a worker. Any other thread runs the
+ * jobs immediately instead. If the deque is full, the overflowing jobs also run immediately.
+ * @param jobs An array of `count` job descriptions. Copied, so it does not need to outlive the call.
+ * @param count The number of jobs in `jobs`.
+ * @param counter An optional counter incremented by `count` now and decremented as each job finishes.
+ */
+KAPI void job_system_submit(const job_desc* jobs, u32 count, job_counter* counter);
+
+
+/**
+ * @brief Splits the range [0, count) into batches and submits one job per batch.
+ * @param count The number of elements to process.
+ * @param batch_size The maximum number of elements per batch. 0 picks a size that gives every thread a few batches.
+ * @param entry The function each batch runs.
+ * @param data The user data passed to `entry`.
+ * @param counter An optional counter to track completion with.
+ */
+KAPI void job_system_parallel_for(u32 count, u32 batch_size, job_range_entry entry, void* data, job_counter* counter);
+
+
+/**
+ * @brief Waits until the counter reaches zero, running other jobs in the meantime.
+ * @param counter The counter to wait on.
+ */
+KAPI void job_system_wait(job_counter* counter);
@@ -0,0 +1,71 @@
+#pragma once
+
+/**
+ * @file katomic.h
+ * @brief Contains the engine's atomic operation macros.
+ *
+ * This file wraps the compiler's atomic builtins behind engine-named macros, so
+ * lock-free code throughout the engine reads the same way and can be retargeted
+ * from a single place. Clang is the supported compiler, which provides the
+ * `__atomic` builtins on every platform the engine targets.
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "defines.h"
+
+/**
+ * @name Memory Orders
+ * @brief The memory orderings accepted by the atomic macros.
+ * @{
+ */
+#define KATOMIC_RELAXED __ATOMIC_RELAXED /**< No ordering, only atomicity. */
+#define KATOMIC_ACQUIRE __ATOMIC_ACQUIRE /**< Later reads/writes cannot move before this load. */
+#define KATOMIC_RELEASE __ATOMIC_RELEASE /**< Earlier reads/writes cannot move after this store. */
+#define KATOMIC_ACQ_REL __ATOMIC_ACQ_REL /**< Both acquire and release (read-modify-write). */
+#define KATOMIC_SEQ_CST __ATOMIC_SEQ_CST /**< A single total order across all threads. */
+/** @} */
+
+/** @brief Atomically loads the value at `ptr`. */
+#define katomic_load(ptr, order) __atomic_load_n((ptr), (order))
+
+/** @brief Atomically stores `value` at `ptr`. */
+#define katomic_store(ptr, value, order) __atomic_store_n((ptr), (value), (order))
+
+/** @brief Atomically adds `value` to `*ptr` and returns the previous value. */
+#define katomic_fetch_add(ptr, value, order) __atomic_fetch_add((ptr), (value), (order))
+
+/** @brief Atomically subtracts `value` from `*ptr` and returns the previous value. */
+#define katomic_fetch_sub(ptr, value, order) __atomic_fetch_sub((ptr), (value), (order))
+
+/** @brief Atomically replaces `*ptr` with `value` and returns the previous value. */
+#define katomic_exchange(ptr, value, order) __atomic_exchange_n((ptr), (value), (order))
+
+/**
+ * @brief Atomically replaces `*ptr` with `desired` if it equals `*expected`.
+ * On failure, `*expected` receives the current value. Evaluates to TRUE on success.
+ */
+#define katomic_compare_exchange(ptr, expected, desired, success_order, failure_order) \
+    __atomic_compare_exchange_n((ptr), (expected), (desired), FALSE, (success_order), (failure_order))
+
+/**
+ * @brief Like katomic_compare_exchange, but may fail spuriously. Cheaper inside retry loops.
+ */
+#define katomic_compare_exchange_weak(ptr, expected, desired, success_order, failure_order) \
+    __atomic_compare_exchange_n((ptr), (expected), (desired), TRUE, (success_order), (failure_order))
+
+/** @brief Issues a memory fence with the given ordering. */
+#define katomic_thread_fence(order) __atomic_thread_fence(order)
+
+/**
+ * @brief Hints to the CPU that the calling thread is spin-waiting.
+ * Reduces power use and frees pipeline resources for a sibling hyper-thread.
+ */
+#if defined(__x86_64__) || defined(_M_X64)
+    #define kcpu_relax() __builtin_ia32_pause()
+#elif defined(__aarch64__) || defined(__arm__)
+    #define kcpu_relax() __asm__ __volatile__("yield")
+#else
+    #define kcpu_relax()
+#endif
@@ -0,0 +1,228 @@
+/**
+ * @file kcompress.c
+ * @brief This file contains the implementation of the engine's LZ4 compression.
+ *
+ * @details An LZ4 block is a series of sequences. Each starts with a token byte whose high
+ * nibble is the literal count and low nibble the match length minus 4; a nibble of 15 is
+ * continued by extra bytes that are added until one is not 255. The token is followed by the
+ * literals, then a 16-bit little-endian offset back to the match. The last sequence has
+ * literals only. The format requires the last 5 bytes to be literals and the last match to
+ * start at least 12 bytes before the end of the block.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "kcompress.h"
+
+#include "core/kmemory.h"
+
+/** @brief The shortest match the format can encode. */
+#define LZ4_MIN_MATCH 4
+
+/** @brief The number of bytes at the end of a block that are always literals. */
+#define LZ4_LAST_LITERALS 5
+
+/** @brief How far before the end of a block the last match must start. */
+#define LZ4_MATCH_FIND_LIMIT 12
+
+/** @brief The largest offset a match can refer back. */
+#define LZ4_MAX_OFFSET 65535
+
+/** @brief The log2 of the number of entries in the compressor's match table. */
+#define LZ4_HASH_BITS 12
+
+/** @brief After this many misses in a row, the compressor starts skipping ahead faster. */
+#define LZ4_SKIP_TRIGGER 6
+
+/** @brief Loads 4 bytes from a possibly unaligned address. Compiles to a single load on little-endian targets. */
+static inline u32 lz4_read32(const u8* p) {
+    return (u32)p[0] | ((u32)p[1] << 8) | ((u32)p[2] << 16) | ((u32)p[3] << 24);
+}
+
+/** @brief Hashes the 4 bytes at the start of a potential match into a match table index. */
+static inline u32 lz4_hash(u32 sequence) {
+    return (sequence * 2654435761u) >> (32 - LZ4_HASH_BITS);
+}
+
+/** @brief Writes the continuation bytes of a length whose nibble is 15. */
+static inline u8* lz4_write_length(u8* op, u64 length) {
+    for (; length >= 255; length -= 255) {
+        *op++ = 255;
+    }
+    *op++ = (u8)length;
+    return op;
+}
+
+/**
+ * @brief Writes one sequence (or, with `match_length` 0, the final literals).
+ * @return A pointer past the written sequence, or 0 if it does not fit before `oend`.
+ */
+static u8* lz4_write_sequence(u8* op, u8* oend, const u8* literals, u64 literal_length, u16 offset, u64 match_length) {
+    // Worst case: token, literal length bytes, literals, offset, match length bytes.
+    u64 needed = 1 + literal_length / 255 + 1 + literal_length + 2 + match_length / 255 + 1;
+    if ((u64)(oend - op) < needed) {
+        return 0;
+    }
+
+    u8* token = op++;
+    *token = (u8)((literal_length < 15 ? literal_length : 15) << 4);
+    if (literal_length >= 15) {
+        op = lz4_write_length(op, literal_length - 15);
+    }
+    kcopy_memory(op, literals, literal_length);
+    op += literal_length;
+
+    if (match_length > 0) {
+        op[0] = (u8)(offset & 0xFF);
+        op[1] = (u8)(offset >> 8);
+        op += 2;
+
+        u64 length = match_length - LZ4_MIN_MATCH;
+        *token |= (u8)(length < 15 ? length : 15);
+        if (length >= 15) {
+            op = lz4_write_length(op, length - 15);
+        }
+    }
+    return op;
+}
+
+u64 kcompress_lz4_bound(u64 size) {
+    return size + size / 255 + 16;
+}
+
+u64 kcompress_lz4(const void* source, u64 source_size, void* destination, u64 destination_capacity) {
+    if (source_size > 0xFFFFFFFFull) {
+        // Match table positions are 32-bit.
+        return 0;
+    }
+
+    const u8* src = source;
+    const u8* ip = src;
+    const u8* anchor = src;
+    const u8* end = src + source_size;
+    u8* op = destination;
+    u8* oend = op + destination_capacity;
+
+    // Blocks too short to hold a match are all literals.
+    if (source_size > LZ4_MATCH_FIND_LIMIT) {
+        const u8* match_find_limit = end - LZ4_MATCH_FIND_LIMIT;
+        const u8* match_limit = end - LZ4_LAST_LITERALS;
+
+        // Positions relative to `src`. Zero-filled entries point at `src`, which the compare below rejects when wrong.
+        u32 table[1 << LZ4_HASH_BITS];
+        kzero_memory(table, sizeof(table));
+
+        u32 misses = 0;
+        while (ip <= match_find_limit) {
+            u32 sequence = lz4_read32(ip);
+            u32 hash = lz4_hash(sequence);
+            const u8* ref = src + table[hash];
+            table[hash] = (u32)(ip - src);
+
+            if (ref >= ip || ip - ref > LZ4_MAX_OFFSET || lz4_read32(ref) != sequence) {
+                // Step further the longer the data stays incompressible.
+                ip += 1 + (misses++ >> LZ4_SKIP_TRIGGER);
+                continue;
+            }
+            misses = 0;
+
+            // Extend the match backwards over literals that also match...
+            while (ip > anchor && ref > src && ip[-1] == ref[-1]) {
+                ip--;
+                ref--;
+            }
+
+            // ...and forwards, stopping short of the trailing literals.
+            u64 length = LZ4_MIN_MATCH;
+            while (ip + length < match_limit && ip[length] == ref[length]) {
+                length++;
+            }
+
+            op = lz4_write_sequence(op, oend, anchor, (u64)(ip - anchor), (u16)(ip - ref), length);
+            if (!op) {
+                return 0;
+            }
+            ip += length;
+            anchor = ip;
+        }
+    }
+
+    op = lz4_write_sequence(op, oend, anchor, (u64)(end - anchor), 0, 0);
+    if (!op) {
+        return 0;
+    }
+    return (u64)(op - (u8*)destination);
+}
+
+b8 kdecompress_lz4(const void* source, u64 source_size, void* destination, u64 destination_capacity, u64* out_size) {
+    const u8* ip = source;
+    const u8* iend = ip + source_size;
+    u8* dst = destination;
+    u8* op = dst;
+    u8* oend = op + destination_capacity;
+
+    while (ip < iend) {
+        u8 token = *ip++;
+
+        u64 literal_length = token >> 4;
+        if (literal_length == 15) {
+            u8 byte;
+            do {
+                if (ip == iend) {
+                    return FALSE;
+                }
+                byte = *ip++;
+                literal_length += byte;
+            } while (byte == 255);
+        }
+        if (literal_length > (u64)(iend - ip) || literal_length > (u64)(oend - op)) {
+            return FALSE;
+        }
+        kcopy_memory(op, ip, literal_length);
+        ip += literal_length;
+        op += literal_length;
+
+        // The last sequence stops after its literals.
+        if (ip == iend) {
+            break;
+        }
+
+        if (iend - ip < 2) {
+            return FALSE;
+        }
+        u64 offset = (u64)ip[0] | ((u64)ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > (u64)(op - dst)) {
+            return FALSE;
+        }
+
+        u64 match_length = token & 0x0F;
+        if (match_length == 15) {
+            u8 byte;
+            do {
+                if (ip == iend) {
+                    return FALSE;
+                }
+                byte = *ip++;
+                match_length += byte;
+            } while (byte == 255);
+        }
+        match_length += LZ4_MIN_MATCH;
+        if (match_length > (u64)(oend - op)) {
+            return FALSE;
+        }
+
+        const u8* match = op - offset;
+        if (offset >= match_length) {
+            kcopy_memory(op, match, match_length);
+        } else {
+            // Overlapping: the match repeats bytes it is itself producing, so copy forwards one at a time.
+            for (u64 i = 0; i < match_length; ++i) {
+                op[i] = match[i];
+            }
+        }
+        op += match_length;
+    }
+
+    *out_size = (u64)(op - dst);
+    return TRUE;
+}
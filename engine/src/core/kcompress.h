@@ -0,0 +1,45 @@
+#pragma once
+
+/**
+ * @file kcompress.h
+ * @brief This file contains the engine's LZ4 compression.
+ *
+ * @details Data is stored in the LZ4 block format (no frame header, no checksums), so blocks
+ * written here can be read by any LZ4 implementation and vice versa. The compressor is a
+ * simple greedy matcher meant for offline tools; the decompressor is the one run at load
+ * time and validates every length and offset, so a corrupt block fails instead of writing
+ * out of bounds.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "defines.h"
+
+/**
+ * @brief Gets the largest size a block of `size` bytes can compress to.
+ * @param size The size of the uncompressed data.
+ * @return The worst-case size of the compressed block.
+ */
+KAPI u64 kcompress_lz4_bound(u64 size);
+
+
+/**
+ * @brief Compresses data into an LZ4 block.
+ * @param source The data to compress. At most 4 GiB.
+ * @param source_size The size of `source` in bytes.
+ * @param destination The buffer receiving the compressed block.
+ * @param destination_capacity The size of `destination`. kcompress_lz4_bound(source_size) always suffices.
+ * @return The size of the compressed block, or 0 if it does not fit in `destination`.
+ */
+KAPI u64 kcompress_lz4(const void* source, u64 source_size, void* destination, u64 destination_capacity);
+
+
+/**
+ * @brief Decompresses an LZ4 block.
+ * @param source The compressed block.
+ * @param source_size The size of the compressed block in bytes.
+ * @param destination The buffer receiving the decompressed data.
+ * @param destination_capacity The size of `destination`.
+ * @param out_size A pointer receiving the size of the decompressed data.
+ * @return `b8 TRUE` on success, `b8 FALSE` if the block is malformed or does not fit in `destination`.
+ */
+KAPI b8 kdecompress_lz4(const void* source, u64 source_size, void* destination, u64 destination_capacity, u64* out_size);
@@ -0,0 +1,69 @@
+/**
+ * @file kcpu.c
+ * @brief This file contains the implementation of the engine's CPU feature detection.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "kcpu.h"
+
+#include "core/katomic.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+    #include <cpuid.h>
+#endif
+
+/** @brief Marks the cached features as detected, so a CPU without any feature is not re-detected. */
+#define KCPU_FEATURES_DETECTED 0x80000000u
+
+// Detection is idempotent, so threads racing on the first call just store the same value.
+static u32 cached_features = 0;
+
+/**
+ * @brief Queries the CPU for its features.
+ */
+static u32 kcpu_detect_features() {
+    u32 features = 0;
+
+#if defined(__x86_64__) || defined(_M_X64)
+    unsigned int eax, ebx, ecx, edx;
+    features |= KCPU_FEATURE_SSE2;
+
+    if (__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+        if (ecx & bit_SSE4_1) {
+            features |= KCPU_FEATURE_SSE41;
+        }
+
+        // AVX is only usable if the OS saves the YMM state on context switches (XCR0 bits 1 and 2).
+        if ((ecx & bit_OSXSAVE) && (ecx & bit_AVX)) {
+            unsigned int xcr0_low, xcr0_high;
+            __asm__ __volatile__("xgetbv" : "=a"(xcr0_low), "=d"(xcr0_high) : "c"(0));
+            if ((xcr0_low & 0x6) == 0x6) {
+                features |= KCPU_FEATURE_AVX;
+                if (ecx & bit_FMA) {
+                    features |= KCPU_FEATURE_FMA;
+                }
+                if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) && (ebx & bit_AVX2)) {
+                    features |= KCPU_FEATURE_AVX2;
+                }
+            }
+        }
+    }
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    features |= KCPU_FEATURE_NEON;
+#endif
+
+    return features;
+}
+
+u32 kcpu_get_features() {
+    u32 features = katomic_load(&cached_features, KATOMIC_RELAXED);
+    if (!features) {
+        features = kcpu_detect_features() | KCPU_FEATURES_DETECTED;
+        katomic_store(&cached_features, features, KATOMIC_RELAXED);
+    }
+    return features & ~KCPU_FEATURES_DETECTED;
+}
+
+b8 kcpu_has_feature(kcpu_feature feature) {
+    return (kcpu_get_features() & feature) == (u32)feature;
+}
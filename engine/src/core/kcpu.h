@@ -0,0 +1,53 @@
+#pragma once
+
+/**
+ * @file kcpu.h
+ * @brief This file contains the engine's CPU feature detection.
+ *
+ * @details Code paths that use instruction set extensions beyond the build's baseline
+ * (e.g. AVX2 on x86-64) are compiled in alongside the baseline path and picked at runtime
+ * by querying these flags, so one binary runs on every supported CPU.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "defines.h"
+
+/**
+ * @enum kcpu_feature
+ * @brief The CPU features the engine knows how to use. Combined as bit flags.
+ */
+typedef enum kcpu_feature {
+    /** @brief SSE2. Always present on x86-64. */
+    KCPU_FEATURE_SSE2 = 0x01,
+
+    /** @brief SSE4.1. */
+    KCPU_FEATURE_SSE41 = 0x02,
+
+    /** @brief AVX, with the operating system saving the YMM registers. */
+    KCPU_FEATURE_AVX = 0x04,
+
+    /** @brief AVX2, with the operating system saving the YMM registers. */
+    KCPU_FEATURE_AVX2 = 0x08,
+
+    /** @brief Fused multiply-add (FMA3). */
+    KCPU_FEATURE_FMA = 0x10,
+
+    /** @brief ARM NEON (Advanced SIMD). Always present on AArch64. */
+    KCPU_FEATURE_NEON = 0x20
+} kcpu_feature;
+
+
+/**
+ * @brief Gets the features of the CPU the engine is running on.
+ * @details Detected on the first call and cached. Safe to call from any thread.
+ * @return A combination of kcpu_feature flags.
+ */
+KAPI u32 kcpu_get_features();
+
+
+/**
+ * @brief Checks if the CPU supports a given feature.
+ * @param feature The feature to check.
+ * @return `b8 TRUE` if the feature is supported, otherwise `b8 FALSE`.
+ */
+KAPI b8 kcpu_has_feature(kcpu_feature feature);
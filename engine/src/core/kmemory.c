@@ -10,28 +10,99 @@
 #include "kmemory.h"
 
 #include "core/logger.h"
+#include "core/katomic.h"
+#include "core/kcpu.h"
+#include "core/kstring.h"
 #include "platform/platform.h"
 
-// TODO: Replace with a custom string library
-#include <string.h>
-#include <stdio.h>
+#if defined(__x86_64__) || defined(_M_X64)
+    #include <immintrin.h>
+    #define KMEMORY_STREAM_X86 1
+#elif defined(__aarch64__) && defined(__clang__)
+    #define KMEMORY_STREAM_NEON 1
+#endif
 
 
+/**
+ * @brief The number of per-thread statistics slots.
+ * Each thread is assigned a slot the first time it allocates. If there are more
+ * threads than slots, threads share slots; updates are atomic, so this stays correct.
+ */
+#define MEMORY_STAT_SLOT_COUNT 16
+
+/**
+ * @struct memory_stat_slot
+ * @brief The allocation counters written by a single thread.
+ * @details Each slot is cache-line aligned so threads never write to the same line.
+ * A block may be freed on a different thread (and therefore slot) than the one that
+ * allocated it, so only the sums over all slots are meaningful.
+ */
+typedef struct KALIGN(KCACHE_LINE_SIZE) memory_stat_slot {
+    /** @brief The number of allocations made per tag by the threads using this slot. */
+    u64 tagged_allocation_counts[MEMORY_TAG_MAX_TAGS];
+
+    /** @brief The number of frees made per tag by the threads using this slot. */
+    u64 tagged_free_counts[MEMORY_TAG_MAX_TAGS];
+} memory_stat_slot;
+
+/**
+ * @struct memory_byte_counter
+ * @brief The live bytes of a tag (or of all tags) and their high-water mark.
+ * @details Shared by every thread, so each counter has a cache line to itself. A high-water
+ * mark cannot be summed from per-thread slots, since a slot's net bytes keep growing when
+ * another thread frees what it allocated.
+ */
+typedef struct KALIGN(KCACHE_LINE_SIZE) memory_byte_counter {
+    /** @brief The number of bytes currently allocated. */
+    u64 live;
+
+    /** @brief The highest `live` has been. Raised on the allocation path. */
+    u64 peak;
+} memory_byte_counter;
+
 /**
  * @struct memory_stats
  * @brief A private structure to hold all memory allocation statistics.
  */
 struct memory_stats {
-    /** @brief The total number of bytes allocated across the entire application. */
-    u64 total_allocated;
+    /** @brief The per-thread counter slots. These are summed lazily when stats are queried. */
+    memory_stat_slot slots[MEMORY_STAT_SLOT_COUNT];
+
+    /** @brief The live and peak bytes per tag. */
+    memory_byte_counter tagged_bytes[MEMORY_TAG_MAX_TAGS];
+
+    /** @brief The live and peak bytes across all tags. */
+    memory_byte_counter total_bytes;
 
-    /** @brief An array holding the number of bytes allocated per tag. */
-    u64 tagged_allocations[MEMORY_TAG_MAX_TAGS];
+    /** @brief The number of slots handed out so far. Used to assign slots round-robin. */
+    u32 next_slot;
 };
 
+/**
+ * @enum kmemory_stream_path
+ * @brief The instruction set used by the streaming copy and set functions.
+ */
+typedef enum kmemory_stream_path {
+    /** @brief No streaming stores; forward to the platform's copy and set. */
+    KMEMORY_STREAM_PATH_LIBC,
+
+    /** @brief 16-byte SSE2 streaming stores. */
+    KMEMORY_STREAM_PATH_SSE2,
+
+    /** @brief 32-byte AVX2 streaming stores. */
+    KMEMORY_STREAM_PATH_AVX2,
+
+    /** @brief 16-byte NEON non-temporal stores. */
+    KMEMORY_STREAM_PATH_NEON
+} kmemory_stream_path;
+
+// The streaming path picked for this CPU by initialize_memory.
+static kmemory_stream_path stream_path = KMEMORY_STREAM_PATH_LIBC;
+
 // A static array of strings providing human-readable names for each memory tag.
 static const char* memory_tag_strings[MEMORY_TAG_MAX_TAGS] = {
     "UNKNOWN    ",
+    "LINEAR_ALLC",
     "ARRAY      ",
     "DARRAY     ",
     "DICT       ",
@@ -47,15 +118,105 @@ static const char* memory_tag_strings[MEMORY_TAG_MAX_TAGS] = {
     "TRANSFORM  ",
     "ENTITY     ",
     "ENTITY_NODE",
-    "SCENE      "};
+    "SCENE      ",
+    "PROFILER   "};
 
 
 // Holds the global state for the memory subsystem. Static to keep it private to this file.
 static struct memory_stats stats;
 
+// The index of the stats slot used by the calling thread, or -1 if none is assigned yet.
+static KTHREAD_LOCAL i32 thread_slot_index = -1;
+
+/**
+ * @brief Gets the stats slot owned by the calling thread, assigning one on first use.
+ */
+static memory_stat_slot* memory_stats_thread_slot() {
+    if (thread_slot_index < 0) {
+        u32 index = katomic_fetch_add(&stats.next_slot, 1, KATOMIC_RELAXED);
+        thread_slot_index = (i32)(index % MEMORY_STAT_SLOT_COUNT);
+    }
+    return &stats.slots[thread_slot_index];
+}
+
+/**
+ * @brief Adds `size` bytes to a byte counter and raises its peak if the new value beats it.
+ * @details The compare-exchange only runs while the counter is at a new high, so the usual
+ * cost is one relaxed add and one relaxed load.
+ */
+static void memory_byte_counter_add(memory_byte_counter* counter, u64 size) {
+    u64 live = katomic_fetch_add(&counter->live, size, KATOMIC_RELAXED) + size;
+    u64 peak = katomic_load(&counter->peak, KATOMIC_RELAXED);
+    while (live > peak) {
+        if (katomic_compare_exchange_weak(&counter->peak, &peak, live, KATOMIC_RELAXED, KATOMIC_RELAXED)) {
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Records an allocation of `size` bytes under `tag`.
+ * @details The allocation count is a relaxed atomic on a cache line owned by this thread, so it
+ * is uncontended in the common case and stays correct when slots are shared. The byte counters
+ * are shared, which is what lets them track a true high-water mark.
+ */
+static void memory_stats_record_allocation(memory_tag tag, u64 size) {
+    memory_stat_slot* slot = memory_stats_thread_slot();
+    katomic_fetch_add(&slot->tagged_allocation_counts[tag], 1, KATOMIC_RELAXED);
+    memory_byte_counter_add(&stats.tagged_bytes[tag], size);
+    memory_byte_counter_add(&stats.total_bytes, size);
+}
+
+/**
+ * @brief Records a free of `size` bytes under `tag`.
+ */
+static void memory_stats_record_free(memory_tag tag, u64 size) {
+    memory_stat_slot* slot = memory_stats_thread_slot();
+    katomic_fetch_add(&slot->tagged_free_counts[tag], 1, KATOMIC_RELAXED);
+    katomic_fetch_sub(&stats.tagged_bytes[tag].live, size, KATOMIC_RELAXED);
+    katomic_fetch_sub(&stats.total_bytes.live, size, KATOMIC_RELAXED);
+}
+
+/**
+ * @brief Sums every slot into per-tag live allocation counts.
+ * @details This is the only place slots are read, so the allocation path never pays for it.
+ * @param out_counts An array of MEMORY_TAG_MAX_TAGS entries receiving the live allocation count per tag.
+ */
+static void memory_stats_gather_counts(u64* out_counts) {
+    for (u32 tag = 0; tag < MEMORY_TAG_MAX_TAGS; ++tag) {
+        u64 allocations = 0;
+        u64 frees = 0;
+        for (u32 s = 0; s < MEMORY_STAT_SLOT_COUNT; ++s) {
+            allocations += katomic_load(&stats.slots[s].tagged_allocation_counts[tag], KATOMIC_RELAXED);
+            frees += katomic_load(&stats.slots[s].tagged_free_counts[tag], KATOMIC_RELAXED);
+        }
+
+        // Slots are read while other threads may still be writing, so frees can briefly outnumber allocations.
+        out_counts[tag] = allocations > frees ? allocations - frees : 0;
+    }
+}
+
 void initialize_memory() {
     // Zero out the entire stats structure to ensure a clean state at startup.
     platform_zero_memory(&stats, sizeof(stats));
+
+    // Pick the widest streaming path this CPU supports.
+    u32 features = kcpu_get_features();
+    if (features & KCPU_FEATURE_AVX2) {
+        stream_path = KMEMORY_STREAM_PATH_AVX2;
+    } else if (features & KCPU_FEATURE_SSE2) {
+        stream_path = KMEMORY_STREAM_PATH_SSE2;
+    } else if (features & KCPU_FEATURE_NEON) {
+        stream_path = KMEMORY_STREAM_PATH_NEON;
+    } else {
+        stream_path = KMEMORY_STREAM_PATH_LIBC;
+    }
+#if !defined(KMEMORY_STREAM_NEON)
+    if (stream_path == KMEMORY_STREAM_PATH_NEON) {
+        // The NEON path needs clang's non-temporal store builtin.
+        stream_path = KMEMORY_STREAM_PATH_LIBC;
+    }
+#endif
 }
 
 void shutdown_memory() {
@@ -68,20 +229,29 @@ void* kallocate(u64 size, memory_tag tag) {
         KWARN("kallocate called using MEMORY_TAG_UNKOWN. Re-class this allocation.");
     }
 
-    // Increment the total and tagged allocation counters.
-    stats.total_allocated += size;
-    stats.tagged_allocations[tag] += size;
+    // Increment the tagged allocation counters.
+    memory_stats_record_allocation(tag, size);
 
-    // TODO: Implement memory alignment.
     // Call the platform layer to perform the actual allocation.
-    void* block = platform_allocate(size, FALSE);
-
-    // Zero the memory before returning it to prevent using uninitialized data.
-    platform_zero_memory(block, size);
+    // Callers that need a specific alignment should use kallocate_aligned instead.
+    // The memory is zeroed to prevent using uninitialized data. Asking the platform for zeroed
+    // memory (instead of zeroing it here) lets large blocks use pages the OS already zeroed.
+    void* block = platform_allocate_zeroed(size);
 
     return block;
 }
 
+void* kallocate_uninit(u64 size, memory_tag tag) {
+    if (tag == MEMORY_TAG_UNKOWN) {
+        KWARN("kallocate_uninit called using MEMORY_TAG_UNKOWN. Re-class this allocation.");
+    }
+
+    memory_stats_record_allocation(tag, size);
+
+    // No zeroing pass; the caller is expected to overwrite the whole block.
+    return platform_allocate(size, FALSE);
+}
+
 void kfree(void* block, u64 size, memory_tag tag) {
 
     // Warn if the 'UNKNOWN' tag is used.
@@ -89,15 +259,49 @@ void kfree(void* block, u64 size, memory_tag tag) {
         KWARN("kfree called using MEMORY_TAG_UNKOWN. Re-class this allocation.");
     }
 
-    // Decrement the total and tagged allocation counters.
-    stats.total_allocated -= size;
-    stats.tagged_allocations[tag] -= size;
+    // Decrement the tagged allocation counters.
+    memory_stats_record_free(tag, size);
 
-    // TODO: Implement memory alignment.
     // Call the platform layer to free the memory.
     platform_free(block, FALSE);
 }
 
+void* kallocate_aligned(u64 size, u16 alignment, memory_tag tag) {
+    if (tag == MEMORY_TAG_UNKOWN) {
+        KWARN("kallocate_aligned called using MEMORY_TAG_UNKOWN. Re-class this allocation.");
+    }
+
+    if (!KIS_POWER_OF_TWO(alignment)) {
+        KERROR("kallocate_aligned called with alignment %u, which is not a power of two.", alignment);
+        return 0;
+    }
+
+    void* block = platform_allocate_aligned(size, alignment);
+    if (!block) {
+        KERROR("kallocate_aligned failed to allocate %llu bytes aligned to %u.", size, alignment);
+        return 0;
+    }
+
+    // Track the aligned footprint, as that is what the allocation really occupies.
+    u64 footprint = KALIGN_UP(size, alignment);
+    memory_stats_record_allocation(tag, footprint);
+
+    platform_zero_memory(block, size);
+
+    return block;
+}
+
+void kfree_aligned(void* block, u64 size, u16 alignment, memory_tag tag) {
+    if (tag == MEMORY_TAG_UNKOWN) {
+        KWARN("kfree_aligned called using MEMORY_TAG_UNKOWN. Re-class this allocation.");
+    }
+
+    u64 footprint = KALIGN_UP(size, alignment);
+    memory_stats_record_free(tag, footprint);
+
+    platform_free_aligned(block);
+}
+
 void* kzero_memory(void* block, u64 size) {
     // A simple pass-through to the platform-specific implementation.
     return platform_zero_memory(block, size);    
@@ -109,52 +313,258 @@ void* kcopy_memory(void* dest, const void* src, u64 size) {
 }
 
 
+void* kmove_memory(void* dest, const void* src, u64 size) {
+    return platform_move_memory(dest, src, size);
+}
+
+
 void* kset_memory(void* dest, i32 value, u64 size) {
     // A simple pass-through to the platform-specific implementation.
     return platform_set_memory(dest, value, size);
 }
 
-char* get_memory_usage_str() {
+/**
+ * @brief Gets the number of bytes that must be copied normally before `dest` reaches the given alignment.
+ */
+static inline u64 kmemory_stream_head(const void* dest, u64 alignment) {
+    return (alignment - ((u64)dest & (alignment - 1))) & (alignment - 1);
+}
+
+#if defined(KMEMORY_STREAM_X86)
+
+/**
+ * @brief Streams `size` bytes with AVX2, 128 bytes per iteration. `dest` must be 32-byte aligned.
+ * @return The number of bytes streamed. The remainder is left to the caller.
+ */
+__attribute__((target("avx2"))) static u64 kmemory_stream_copy_avx2(u8* dest, const u8* src, u64 size) {
+    u64 streamed = size & ~(u64)127;
+    for (u64 i = 0; i < streamed; i += 128) {
+        __m256i a = _mm256_loadu_si256((const __m256i*)(src + i));
+        __m256i b = _mm256_loadu_si256((const __m256i*)(src + i + 32));
+        __m256i c = _mm256_loadu_si256((const __m256i*)(src + i + 64));
+        __m256i d = _mm256_loadu_si256((const __m256i*)(src + i + 96));
+        _mm256_stream_si256((__m256i*)(dest + i), a);
+        _mm256_stream_si256((__m256i*)(dest + i + 32), b);
+        _mm256_stream_si256((__m256i*)(dest + i + 64), c);
+        _mm256_stream_si256((__m256i*)(dest + i + 96), d);
+    }
+    return streamed;
+}
+
+/** @brief Fills `size` bytes with AVX2 streaming stores. `dest` must be 32-byte aligned. */
+__attribute__((target("avx2"))) static u64 kmemory_stream_set_avx2(u8* dest, u8 value, u64 size) {
+    __m256i v = _mm256_set1_epi8((char)value);
+    u64 streamed = size & ~(u64)127;
+    for (u64 i = 0; i < streamed; i += 128) {
+        _mm256_stream_si256((__m256i*)(dest + i), v);
+        _mm256_stream_si256((__m256i*)(dest + i + 32), v);
+        _mm256_stream_si256((__m256i*)(dest + i + 64), v);
+        _mm256_stream_si256((__m256i*)(dest + i + 96), v);
+    }
+    return streamed;
+}
+
+/** @brief Streams `size` bytes with SSE2, 64 bytes per iteration. `dest` must be 16-byte aligned. */
+static u64 kmemory_stream_copy_sse2(u8* dest, const u8* src, u64 size) {
+    u64 streamed = size & ~(u64)63;
+    for (u64 i = 0; i < streamed; i += 64) {
+        __m128i a = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i b = _mm_loadu_si128((const __m128i*)(src + i + 16));
+        __m128i c = _mm_loadu_si128((const __m128i*)(src + i + 32));
+        __m128i d = _mm_loadu_si128((const __m128i*)(src + i + 48));
+        _mm_stream_si128((__m128i*)(dest + i), a);
+        _mm_stream_si128((__m128i*)(dest + i + 16), b);
+        _mm_stream_si128((__m128i*)(dest + i + 32), c);
+        _mm_stream_si128((__m128i*)(dest + i + 48), d);
+    }
+    return streamed;
+}
+
+/** @brief Fills `size` bytes with SSE2 streaming stores. `dest` must be 16-byte aligned. */
+static u64 kmemory_stream_set_sse2(u8* dest, u8 value, u64 size) {
+    __m128i v = _mm_set1_epi8((char)value);
+    u64 streamed = size & ~(u64)63;
+    for (u64 i = 0; i < streamed; i += 64) {
+        _mm_stream_si128((__m128i*)(dest + i), v);
+        _mm_stream_si128((__m128i*)(dest + i + 16), v);
+        _mm_stream_si128((__m128i*)(dest + i + 32), v);
+        _mm_stream_si128((__m128i*)(dest + i + 48), v);
+    }
+    return streamed;
+}
+
+#endif
+
+#if defined(KMEMORY_STREAM_NEON)
+
+/** @brief A 16-byte NEON register's worth of bytes. */
+typedef u8 kmemory_vec16 __attribute__((vector_size(16)));
+
+/** @brief Streams `size` bytes with NEON non-temporal stores. `dest` must be 16-byte aligned. */
+static u64 kmemory_stream_copy_neon(u8* dest, const u8* src, u64 size) {
+    u64 streamed = size & ~(u64)63;
+    for (u64 i = 0; i < streamed; i += 16) {
+        kmemory_vec16 v;
+        __builtin_memcpy(&v, src + i, sizeof(v));
+        __builtin_nontemporal_store(v, (kmemory_vec16*)(dest + i));
+    }
+    return streamed;
+}
+
+/** @brief Fills `size` bytes with NEON non-temporal stores. `dest` must be 16-byte aligned. */
+static u64 kmemory_stream_set_neon(u8* dest, u8 value, u64 size) {
+    kmemory_vec16 v;
+    __builtin_memset(&v, value, sizeof(v));
+    u64 streamed = size & ~(u64)63;
+    for (u64 i = 0; i < streamed; i += 16) {
+        __builtin_nontemporal_store(v, (kmemory_vec16*)(dest + i));
+    }
+    return streamed;
+}
+
+#endif
+
+/**
+ * @brief Makes the streaming stores issued so far visible before any later store.
+ * Streaming stores are weakly ordered, so without this another thread could observe them late.
+ */
+static inline void kmemory_stream_fence() {
+#if defined(KMEMORY_STREAM_X86)
+    _mm_sfence();
+#else
+    katomic_thread_fence(KATOMIC_SEQ_CST);
+#endif
+}
+
+void* kmemory_stream_copy(void* dest, const void* src, u64 size) {
+    if (size < KMEMORY_STREAM_MIN_SIZE || stream_path == KMEMORY_STREAM_PATH_LIBC) {
+        return kcopy_memory(dest, src, size);
+    }
+
+    u8* d = (u8*)dest;
+    const u8* s = (const u8*)src;
+    u64 alignment = stream_path == KMEMORY_STREAM_PATH_AVX2 ? 32 : 16;
+
+    // Copy up to the first aligned address normally, stream the bulk, then copy the tail normally.
+    u64 head = kmemory_stream_head(d, alignment);
+    kcopy_memory(d, s, head);
+    d += head;
+    s += head;
+    size -= head;
+
+    u64 streamed = 0;
+    switch (stream_path) {
+#if defined(KMEMORY_STREAM_X86)
+        case KMEMORY_STREAM_PATH_AVX2: streamed = kmemory_stream_copy_avx2(d, s, size); break;
+        case KMEMORY_STREAM_PATH_SSE2: streamed = kmemory_stream_copy_sse2(d, s, size); break;
+#endif
+#if defined(KMEMORY_STREAM_NEON)
+        case KMEMORY_STREAM_PATH_NEON: streamed = kmemory_stream_copy_neon(d, s, size); break;
+#endif
+        default: break;
+    }
+    kmemory_stream_fence();
+
+    kcopy_memory(d + streamed, s + streamed, size - streamed);
+    return dest;
+}
+
+void* kmemory_stream_set(void* dest, i32 value, u64 size) {
+    if (size < KMEMORY_STREAM_MIN_SIZE || stream_path == KMEMORY_STREAM_PATH_LIBC) {
+        return kset_memory(dest, value, size);
+    }
+
+    u8* d = (u8*)dest;
+    u64 alignment = stream_path == KMEMORY_STREAM_PATH_AVX2 ? 32 : 16;
+
+    u64 head = kmemory_stream_head(d, alignment);
+    kset_memory(d, value, head);
+    d += head;
+    size -= head;
+
+    u64 streamed = 0;
+    switch (stream_path) {
+#if defined(KMEMORY_STREAM_X86)
+        case KMEMORY_STREAM_PATH_AVX2: streamed = kmemory_stream_set_avx2(d, (u8)value, size); break;
+        case KMEMORY_STREAM_PATH_SSE2: streamed = kmemory_stream_set_sse2(d, (u8)value, size); break;
+#endif
+#if defined(KMEMORY_STREAM_NEON)
+        case KMEMORY_STREAM_PATH_NEON: streamed = kmemory_stream_set_neon(d, (u8)value, size); break;
+#endif
+        default: break;
+    }
+    kmemory_stream_fence();
+
+    kset_memory(d + streamed, value, size - streamed);
+    return dest;
+}
+
+const char* kmemory_stream_path_name() {
+    static const char* names[] = {"libc", "SSE2", "AVX2", "NEON"};
+    return names[stream_path];
+}
+
+/**
+ * @brief Converts a byte count into an amount in the most appropriate unit.
+ * @param bytes The number of bytes.
+ * @param unit A 4-character buffer receiving the unit string (e.g. "KiB", or "B").
+ * @return The amount expressed in `unit`.
+ */
+static f32 memory_amount_in_unit(u64 bytes, char unit[4]) {
     // Define constants for converting bytes to human-readable units.
     const u64 gib = 1024 * 1024 * 1024;
     const u64 mib = 1024 * 1024;
     const u64 kib = 1024;
 
-    enum { msg_length = 8000 };
-    char buffer[msg_length] = "System memory use (tagged):\n";
-    u64 offset = strlen(buffer);
+    unit[1] = 'i';
+    unit[2] = 'B';
+    unit[3] = 0;
+
+    // Determine the most appropriate unit for the current size.
+    if (bytes >= gib) {
+        unit[0] = 'G';
+        return bytes / (f32) gib;
+    } else if (bytes >= mib) {
+        unit[0] = 'M';
+        return bytes / (f32) mib;
+    } else if (bytes >= kib) {
+        unit[0] = 'K';
+        return bytes / (f32) kib;
+    }
+
+    unit[0] = 'B';
+    unit[1] =  0; // Null-terminate to just show 'B' for bytes.
+    return (f32) bytes;
+}
+
+void kmemory_get_stats(memory_stats_snapshot* out_snapshot) {
+    memory_stats_gather_counts(out_snapshot->tagged_allocation_counts);
 
-    // Iterate through each memory tag and format its usage information.
+    out_snapshot->total_allocated = katomic_load(&stats.total_bytes.live, KATOMIC_RELAXED);
+    out_snapshot->peak_total_allocated = katomic_load(&stats.total_bytes.peak, KATOMIC_RELAXED);
     for (u32 i = 0; i < MEMORY_TAG_MAX_TAGS; ++i) {
-        char unit[4] = "XiB"; // A template for the memory unit (e.g., KiB, MiB).
-        float amount = 1.0f;
-        
-        // Determine the most appropriate unit for the current size.
-        if (stats.tagged_allocations[i] >= gib) {
-            unit[0] = 'G';
-            amount = stats.tagged_allocations[i] / (float) gib;
-        } else if (stats.tagged_allocations[i] >= mib) {
-            unit[0] = 'M';
-            amount = stats.tagged_allocations[i] / (float) mib;
-        } else if (stats.tagged_allocations[i] >= kib) {
-            unit[0] = 'K';
-            amount = stats.tagged_allocations[i] / (float) kib;
-        } else {
-            unit[0] = 'B';
-            unit[1] =  0; // Null-terminate to just show 'B' for bytes.
-            amount = (float) stats.tagged_allocations[i];
-        }
+        out_snapshot->tagged_allocations[i] = katomic_load(&stats.tagged_bytes[i].live, KATOMIC_RELAXED);
+        out_snapshot->peak_tagged_allocations[i] = katomic_load(&stats.tagged_bytes[i].peak, KATOMIC_RELAXED);
+    }
+}
 
-        // Write the formatted string for the current tag into the buffer.
-        i32 length = snprintf(buffer + offset, msg_length - offset, "  %s: %.2f%s\n", memory_tag_strings[i], amount, unit);
+u64 kmemory_format_stats(const memory_stats_snapshot* snapshot, char* buffer, u64 buffer_size) {
+    if (!buffer || buffer_size == 0) {
+        return 0;
+    }
+
+    u64 offset = kstring_format_into(buffer, buffer_size, "System memory use (tagged):\n");
 
-        // Clamp the length to prevent buffer overflow issues.
-        length = CLAMP(length, 0, msg_length - offset - 1);
-        offset += length;
+    // Iterate through each memory tag and append its usage information.
+    for (u32 i = 0; i < MEMORY_TAG_MAX_TAGS && offset < buffer_size - 1; ++i) {
+        char unit[4];
+        char peak_unit[4];
+        f32 amount = memory_amount_in_unit(snapshot->tagged_allocations[i], unit);
+        f32 peak_amount = memory_amount_in_unit(snapshot->peak_tagged_allocations[i], peak_unit);
+
+        offset += kstring_format_into(buffer + offset, buffer_size - offset, "  %s: %.2f%s (peak %.2f%s, %llu live)\n",
+                                      memory_tag_strings[i], amount, unit, peak_amount, peak_unit, snapshot->tagged_allocation_counts[i]);
     }
 
-    // Duplicate the stack-allocated buffer to a new heap-allocated string.
-    // The caller is responsible for freeing this memory.
-    char* out_string = _strdup(buffer);
-    return out_string;
-}
\ No newline at end of file
+    return offset;
+}
@@ -24,6 +24,7 @@
 typedef enum memory_tag {
     // For temporary use. Should be assigned a proper tag.
     MEMORY_TAG_UNKOWN,
+    MEMORY_TAG_LINEAR_ALLOCATOR,
     MEMORY_TAG_ARRAY,
     MEMORY_TAG_DARRAY,
     MEMORY_TAG_DICT,
@@ -40,35 +41,71 @@ typedef enum memory_tag {
     MEMORY_TAG_ENTITY,
     MEMORY_TAG_ENTTY_NODE,
     MEMORY_TAG_SCENE,
+    MEMORY_TAG_PROFILER,
 
     // The maximum number of tags. This should always be the last entry.
     MEMORY_TAG_MAX_TAGS
 } memory_tag;
 
+/**
+ * @struct memory_stats_snapshot
+ * @brief A point-in-time copy of the memory subsystem's statistics.
+ * @details Filled out by kmemory_get_stats. Taking a snapshot only copies counters,
+ * so it is cheap enough to sample every frame (e.g. for a telemetry overlay).
+ */
+typedef struct memory_stats_snapshot {
+    /** @brief The total number of bytes currently allocated across all tags. */
+    u64 total_allocated;
+
+    /** @brief The high-water mark of `total_allocated`, tracked on every allocation. */
+    u64 peak_total_allocated;
+
+    /** @brief The number of bytes currently allocated per tag. */
+    u64 tagged_allocations[MEMORY_TAG_MAX_TAGS];
+
+    /** @brief The high-water mark of the number of bytes allocated per tag, tracked on every allocation. */
+    u64 peak_tagged_allocations[MEMORY_TAG_MAX_TAGS];
+
+    /** @brief The number of live (not yet freed) allocations per tag. */
+    u64 tagged_allocation_counts[MEMORY_TAG_MAX_TAGS];
+} memory_stats_snapshot;
+
 /**
  * @brief Initializes the memory subsystem.
  * @details This must be called before any other memory function. It sets up the internal
  * state for tracking allocations.
  */
-void initialize_memory();
+KAPI void initialize_memory();
 
 
 /**
  * @brief Shuts down the memory subsystem.
  * @details Performs cleanup and logs final memory usage statistics.
  */
-void shutdown_memory();
+KAPI void shutdown_memory();
 
 
 /**
  * @brief Allocates a block of memory.
  * @param size The size of the block to allocate in bytes. Type `u64` is used to support large allocations on 64-bit systems.
  * @param tag The `memory_tag` to classify this allocation for tracking.
- * @return A `void*` pointer to the allocated memory block. This generic pointer can be cast to any data type.
+ * @return A `void*` pointer to the allocated, zeroed memory block. This generic pointer can be cast to any data type.
  */
 KAPI void* kallocate(u64 size, memory_tag tag);
 
 
+/**
+ * @brief Allocates a block of memory without zeroing it.
+ * @details Use this for buffers that are about to be completely overwritten (e.g. filled
+ * from disk or GPU readback), where zeroing would be a wasted write pass. The block is
+ * freed with kfree as usual.
+ * @param size The size of the block to allocate in bytes.
+ * @param tag The `memory_tag` to classify this allocation for tracking.
+ * @return A `void*` pointer to the allocated, uninitialized memory block.
+ */
+KAPI void* kallocate_uninit(u64 size, memory_tag tag);
+
+
 /**
  * @brief Frees a previously allocated block of memory.
  * @param block A pointer to the memory block to free. `void*` is used to accept any pointer type.
@@ -78,6 +115,28 @@ KAPI void* kallocate(u64 size, memory_tag tag);
 KAPI void kfree(void* block, u64 size, memory_tag tag);
 
 
+/**
+ * @brief Allocates a block of memory aligned to the given boundary.
+ * @details Use this for SIMD data (16/32-byte) or data shared between threads (cache-line, 64-byte).
+ * The block is tracked under `tag` with its aligned footprint (size rounded up to `alignment`).
+ * @param size The size of the block to allocate in bytes.
+ * @param alignment The required alignment in bytes. Must be a power of two. `u16` covers every practical alignment.
+ * @param tag The `memory_tag` to classify this allocation for tracking.
+ * @return A `void*` pointer to the allocated, zeroed memory block, or 0 on failure.
+ */
+KAPI void* kallocate_aligned(u64 size, u16 alignment, memory_tag tag);
+
+
+/**
+ * @brief Frees a block of memory that was allocated with kallocate_aligned.
+ * @param block A pointer to the memory block to free.
+ * @param size The size of the block being freed. Must match the size provided during allocation.
+ * @param alignment The alignment of the block. Must match the alignment provided during allocation.
+ * @param tag The `memory_tag` that was used when the block was allocated.
+ */
+KAPI void kfree_aligned(void* block, u64 size, u16 alignment, memory_tag tag);
+
+
 /**
  * @brief Zeros out a block of memory.
  * @param block A pointer to the memory block. `void*` makes the function generic.
@@ -97,6 +156,17 @@ KAPI void* kzero_memory(void* block, u64 size);
 KAPI void* kcopy_memory(void* dest, const void* src, u64 size);
 
 
+/**
+ * @brief Copies memory from a source to a destination, where the two blocks may overlap.
+ * Use this instead of kcopy_memory when shifting elements within the same buffer.
+ * @param dest A pointer to the destination memory block.
+ * @param src A pointer to the source memory block.
+ * @param size The number of bytes to copy.
+ * @return A pointer to the destination memory block (`dest`).
+ */
+KAPI void* kmove_memory(void* dest, const void* src, u64 size);
+
+
 /**
  * @brief Sets a block of memory to a specific value.
  * @param dest A pointer to the destination memory block.
@@ -108,8 +178,60 @@ KAPI void* kset_memory(void* dest, i32 value, u64 size);
 
 
 /**
- * @brief Generates and returns a string with detailed memory usage statistics.
- * @details This is a debug utility. The returned string is dynamically allocated and must be freed by the caller.
- * @return A `char*` pointer to a new string containing formatted memory usage info.
+ * @brief The size below which the stream functions just forward to kcopy_memory / kset_memory.
+ * Streaming stores only pay off once a block is much larger than a few cache lines.
+ */
+#define KMEMORY_STREAM_MIN_SIZE 4096
+
+
+/**
+ * @brief Copies memory using non-temporal (streaming) stores that bypass the cache.
+ * @details Meant for large blocks that will not be read again soon by this core, such as texture
+ * or mesh data on its way to an upload buffer: a regular copy would evict the working set to make
+ * room for data nobody reads. Uses AVX2, SSE2 or NEON, picked at runtime by CPU feature detection.
+ * Blocks smaller than KMEMORY_STREAM_MIN_SIZE use kcopy_memory.
+ * @note The blocks must not overlap. The copy is complete and visible to other threads when this returns.
+ * @param dest A pointer to the destination memory block.
+ * @param src A pointer to the source memory block.
+ * @param size The number of bytes to copy.
+ * @return A pointer to the destination memory block (`dest`).
+ */
+KAPI void* kmemory_stream_copy(void* dest, const void* src, u64 size);
+
+
+/**
+ * @brief Sets a block of memory to a specific value using non-temporal (streaming) stores.
+ * @details The kset_memory counterpart of kmemory_stream_copy, e.g. for clearing large buffers.
+ * Blocks smaller than KMEMORY_STREAM_MIN_SIZE use kset_memory.
+ * @param dest A pointer to the destination memory block.
+ * @param value The value to set each byte to. Only its lowest 8 bits are used.
+ * @param size The number of bytes to set.
+ * @return A pointer to the destination memory block (`dest`).
+ */
+KAPI void* kmemory_stream_set(void* dest, i32 value, u64 size);
+
+
+/**
+ * @brief Gets the name of the instruction set the stream functions use on this CPU.
+ * @return "AVX2", "SSE2", "NEON", or "libc" if no streaming path is available.
+ */
+KAPI const char* kmemory_stream_path_name();
+
+
+/**
+ * @brief Copies the current memory statistics into a caller-provided snapshot.
+ * @details No memory is allocated. Safe to call every frame.
+ * @param out_snapshot A pointer to the snapshot to be filled out.
+ */
+KAPI void kmemory_get_stats(memory_stats_snapshot* out_snapshot);
+
+
+/**
+ * @brief Formats a memory statistics snapshot as a human-readable report into a caller-provided buffer.
+ * @details No memory is allocated. The output is always null-terminated and truncated to fit.
+ * @param snapshot A pointer to the snapshot to format. Typically filled by kmemory_get_stats.
+ * @param buffer The buffer to write the report into.
+ * @param buffer_size The size of `buffer` in bytes.
+ * @return The number of characters written, not including the null terminator.
  */
-KAPI char* get_memory_usage_str();
\ No newline at end of file
+KAPI u64 kmemory_format_stats(const memory_stats_snapshot* snapshot, char* buffer, u64 buffer_size);
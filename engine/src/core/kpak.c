@@ -0,0 +1,187 @@
+/**
+ * @file kpak.c
+ * @brief This file contains the implementation of the engine's packed asset archive reader.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "kpak.h"
+
+#include "containers/hashtable.h"
+#include "core/kcompress.h"
+#include "core/kmemory.h"
+#include "core/logger.h"
+
+#include <string.h>
+
+/**
+ * @brief Checks that a section of `size` bytes at `offset` lies within a file of `file_size` bytes.
+ */
+static b8 kpak_section_valid(u64 offset, u64 size, u64 file_size) {
+    return offset <= file_size && size <= file_size - offset;
+}
+
+/**
+ * @brief Validates everything the reader later relies on, so lookups need no bounds checks.
+ * @return `b8 TRUE` if the archive is valid, otherwise `b8 FALSE`.
+ */
+static b8 kpak_validate(const kpak* pak, const char* path) {
+    const kpak_header* header = pak->header;
+    u64 file_size = pak->mapping.size;
+
+    if (header->magic != KPAK_MAGIC || header->version != KPAK_VERSION) {
+        KERROR("kpak_open - '%s' is not a version %u archive.", path, KPAK_VERSION);
+        return FALSE;
+    }
+    if (header->file_size != file_size) {
+        KERROR("kpak_open - '%s' is %llu bytes but its header expects %llu. Is it truncated?", path, file_size, header->file_size);
+        return FALSE;
+    }
+
+    // Checked before the shift below, which is undefined for 64 or more bits.
+    if (header->bucket_bits > KPAK_MAX_BUCKET_BITS) {
+        KERROR("kpak_open - '%s' has a malformed header.", path);
+        return FALSE;
+    }
+
+    u64 bucket_count = 1ull << header->bucket_bits;
+    if (!KIS_POWER_OF_TWO(header->alignment) ||
+        header->entries_offset % sizeof(u64) != 0 ||
+        header->buckets_offset % sizeof(u32) != 0 ||
+        !kpak_section_valid(header->entries_offset, (u64)header->entry_count * sizeof(kpak_entry), file_size) ||
+        !kpak_section_valid(header->buckets_offset, (bucket_count + 1) * sizeof(u32), file_size) ||
+        !kpak_section_valid(header->names_offset, header->names_size, file_size)) {
+        KERROR("kpak_open - '%s' has a malformed header.", path);
+        return FALSE;
+    }
+
+    // The buckets must partition the entries in order.
+    if (pak->buckets[0] != 0 || pak->buckets[bucket_count] != header->entry_count) {
+        KERROR("kpak_open - '%s' has a malformed bucket table.", path);
+        return FALSE;
+    }
+    for (u64 b = 0; b < bucket_count; ++b) {
+        if (pak->buckets[b] > pak->buckets[b + 1]) {
+            KERROR("kpak_open - '%s' has a malformed bucket table.", path);
+            return FALSE;
+        }
+    }
+
+    for (u32 i = 0; i < header->entry_count; ++i) {
+        const kpak_entry* entry = &pak->entries[i];
+        if (!kpak_section_valid(entry->offset, entry->stored_size, file_size) ||
+            !kpak_section_valid(entry->name_offset, entry->name_length, header->names_size) ||
+            (!(entry->flags & KPAK_ENTRY_FLAG_LZ4) && entry->stored_size != entry->size)) {
+            KERROR("kpak_open - '%s' has a malformed entry at index %u.", path, i);
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
+/**
+ * @brief Fills out an asset description from its entry.
+ */
+static void kpak_describe(const kpak* pak, const kpak_entry* entry, kpak_asset* out_asset) {
+    out_asset->name = pak->names + entry->name_offset;
+    out_asset->name_length = entry->name_length;
+    out_asset->is_compressed = (entry->flags & KPAK_ENTRY_FLAG_LZ4) != 0;
+    out_asset->data = (const u8*)pak->mapping.data + entry->offset;
+    out_asset->stored_size = entry->stored_size;
+    out_asset->size = entry->size;
+}
+
+b8 kpak_open(const char* path, kpak* out_pak) {
+    kzero_memory(out_pak, sizeof(kpak));
+
+    // Assets are read in whatever order the game asks for them, so don't read ahead.
+    if (!platform_file_map(path, PLATFORM_FILE_MAP_HINT_RANDOM, &out_pak->mapping)) {
+        KERROR("kpak_open - failed to map '%s'.", path);
+        return FALSE;
+    }
+    if (out_pak->mapping.size < sizeof(kpak_header)) {
+        KERROR("kpak_open - '%s' is too small to be an archive.", path);
+        platform_file_unmap(&out_pak->mapping);
+        return FALSE;
+    }
+
+    const u8* base = out_pak->mapping.data;
+    out_pak->header = (const kpak_header*)base;
+
+    // Every lookup goes through the index, so page all of it in at once.
+    // Clamped to the file by the prefetch, so it is safe before validation.
+    u64 index_end = out_pak->header->names_offset + out_pak->header->names_size;
+    platform_file_map_prefetch(&out_pak->mapping, 0, index_end);
+
+    out_pak->entries = (const kpak_entry*)(base + out_pak->header->entries_offset);
+    out_pak->buckets = (const u32*)(base + out_pak->header->buckets_offset);
+    out_pak->names = (const char*)(base + out_pak->header->names_offset);
+    if (!kpak_validate(out_pak, path)) {
+        kpak_close(out_pak);
+        return FALSE;
+    }
+
+    KDEBUG("Opened archive '%s' with %u assets.", path, out_pak->header->entry_count);
+    return TRUE;
+}
+
+void kpak_close(kpak* pak) {
+    if (pak) {
+        platform_file_unmap(&pak->mapping);
+        kzero_memory(pak, sizeof(kpak));
+    }
+}
+
+u32 kpak_count(const kpak* pak) {
+    return pak->header ? pak->header->entry_count : 0;
+}
+
+b8 kpak_find(const kpak* pak, const char* name, kpak_asset* out_asset) {
+    if (!pak->header) {
+        return FALSE;
+    }
+
+    u64 length = strlen(name);
+    u64 hash = hashtable_hash(name, length);
+    u32 bucket = kpak_bucket(hash, pak->header->bucket_bits);
+
+    // The bucket's entries are sorted by hash, so stop at the first larger one.
+    for (u32 i = pak->buckets[bucket]; i < pak->buckets[bucket + 1]; ++i) {
+        const kpak_entry* entry = &pak->entries[i];
+        if (entry->name_hash > hash) {
+            break;
+        }
+        if (entry->name_hash == hash && entry->name_length == length && memcmp(pak->names + entry->name_offset, name, length) == 0) {
+            kpak_describe(pak, entry, out_asset);
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+b8 kpak_get(const kpak* pak, u32 index, kpak_asset* out_asset) {
+    if (index >= kpak_count(pak)) {
+        return FALSE;
+    }
+    kpak_describe(pak, &pak->entries[index], out_asset);
+    return TRUE;
+}
+
+b8 kpak_read(const kpak_asset* asset, void* buffer, u64 buffer_size) {
+    if (buffer_size < asset->size) {
+        KERROR("kpak_read - buffer of %llu bytes is too small for an asset of %llu bytes.", buffer_size, asset->size);
+        return FALSE;
+    }
+
+    if (!asset->is_compressed) {
+        kcopy_memory(buffer, asset->data, asset->size);
+        return TRUE;
+    }
+
+    u64 size = 0;
+    if (!kdecompress_lz4(asset->data, asset->stored_size, buffer, asset->size, &size) || size != asset->size) {
+        KERROR("kpak_read - asset '%.*s' is corrupt.", asset->name_length, asset->name);
+        return FALSE;
+    }
+    return TRUE;
+}
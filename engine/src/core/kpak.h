@@ -0,0 +1,235 @@
+#pragma once
+
+/**
+ * @file kpak.h
+ * @brief This file contains the engine's packed asset archive format and its reader.
+ *
+ * @details A kpak archive holds many assets in one file, so startup opens a single file instead
+ * of walking directories and opening every asset. The layout is:
+ *
+ * | Section  | Contents                                                                         |
+ * |----------|----------------------------------------------------------------------------------|
+ * | header   | A kpak_header.                                                                   |
+ * | entries  | `entry_count` kpak_entry records, sorted by the hash of their name.              |
+ * | buckets  | `(1 << bucket_bits) + 1` u32 entry indices. Bucket `b` holds the entries whose   |
+ * |          | hash has `b` as its top `bucket_bits` bits: `entries[buckets[b]..buckets[b+1])`. |
+ * | names    | The asset names, not terminated, referenced by offset and length.                |
+ * | data     | The asset blobs, each starting at a multiple of `alignment`.                     |
+ *
+ * Names are hashed with hashtable_hash. As there are about as many buckets as entries, a
+ * lookup inspects one or two entries regardless of the archive's size, and the name stored
+ * in the archive confirms the match. Everything before the data is the index; it is small
+ * and contiguous, so paging it in at open costs a few reads.
+ *
+ * The reader maps the archive with platform_file_map. Uncompressed assets are used in place,
+ * straight from the page cache; LZ4-compressed ones are decompressed with kpak_read. Blobs
+ * are aligned (to the page size by default), so uncompressed data can be handed to the GPU
+ * or parsed with aligned loads. All values are little-endian. Archives are written by the
+ * packer tool.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "defines.h"
+#include "platform/platform.h"
+
+/** @brief The magic number at the start of every archive: "KPAK" in file order. */
+#define KPAK_MAGIC 0x4B41504Bu
+
+/** @brief The version of the format described here. */
+#define KPAK_VERSION 1
+
+/** @brief The blob alignment the packer uses by default: the common page size. */
+#define KPAK_DEFAULT_ALIGNMENT 4096
+
+/** @brief The largest number of bucket bits an archive may use. */
+#define KPAK_MAX_BUCKET_BITS 24
+
+/**
+ * @enum kpak_entry_flags
+ * @brief Flags describing how an asset is stored.
+ */
+typedef enum kpak_entry_flags {
+    /** @brief The blob is a single LZ4 block. */
+    KPAK_ENTRY_FLAG_LZ4 = 0x1
+} kpak_entry_flags;
+
+/**
+ * @struct kpak_header
+ * @brief The header at the start of an archive.
+ */
+typedef struct kpak_header {
+    /** @brief KPAK_MAGIC. */
+    u32 magic;
+
+    /** @brief KPAK_VERSION. */
+    u32 version;
+
+    /** @brief The number of entries. */
+    u32 entry_count;
+
+    /** @brief The log2 of the number of buckets. At most KPAK_MAX_BUCKET_BITS. */
+    u32 bucket_bits;
+
+    /** @brief The alignment of every blob, a power of two. */
+    u64 alignment;
+
+    /** @brief The offset of the entries from the start of the file. */
+    u64 entries_offset;
+
+    /** @brief The offset of the buckets from the start of the file. */
+    u64 buckets_offset;
+
+    /** @brief The offset of the names from the start of the file. */
+    u64 names_offset;
+
+    /** @brief The size of the names section in bytes. */
+    u64 names_size;
+
+    /** @brief The size of the whole archive in bytes, to detect truncated files. */
+    u64 file_size;
+} kpak_header;
+
+/**
+ * @struct kpak_entry
+ * @brief An entry of the archive's index, describing one asset.
+ */
+typedef struct kpak_entry {
+    /** @brief The hashtable_hash of the asset's name. The entries are sorted by this value. */
+    u64 name_hash;
+
+    /** @brief The offset of the asset's blob from the start of the file. */
+    u64 offset;
+
+    /** @brief The size of the blob as stored. */
+    u64 stored_size;
+
+    /** @brief The size of the asset once decompressed. Equals `stored_size` for uncompressed assets. */
+    u64 size;
+
+    /** @brief The offset of the name from the start of the names section. */
+    u32 name_offset;
+
+    /** @brief The length of the name in bytes. */
+    u32 name_length;
+
+    /** @brief A combination of kpak_entry_flags. */
+    u32 flags;
+
+    /** @brief Unused. Always 0. */
+    u32 reserved;
+} kpak_entry;
+
+STATIC_ASSERT(sizeof(kpak_header) == 64, "kpak_header is part of the file format and must be 64 bytes.");
+STATIC_ASSERT(sizeof(kpak_entry) == 48, "kpak_entry is part of the file format and must be 48 bytes.");
+
+/**
+ * @struct kpak
+ * @brief Holds an open archive.
+ */
+typedef struct kpak {
+    /** @brief The mapping of the whole archive. */
+    platform_file_mapping mapping;
+
+    /** @brief The archive's header, inside the mapping. */
+    const kpak_header* header;
+
+    /** @brief The archive's entries, inside the mapping. */
+    const kpak_entry* entries;
+
+    /** @brief The archive's buckets, inside the mapping. */
+    const u32* buckets;
+
+    /** @brief The archive's names, inside the mapping. */
+    const char* names;
+} kpak;
+
+/**
+ * @struct kpak_asset
+ * @brief Describes an asset found in an archive.
+ */
+typedef struct kpak_asset {
+    /** @brief The name of the asset, inside the mapping. Not terminated. */
+    const char* name;
+
+    /** @brief The length of the name in bytes. */
+    u32 name_length;
+
+    /** @brief Indicates if the data is LZ4-compressed. If not, `data` is the asset and can be used in place. */
+    b8 is_compressed;
+
+    /** @brief The blob of the asset as stored, inside the mapping. Valid until the archive is closed. */
+    const void* data;
+
+    /** @brief The size of the blob as stored. */
+    u64 stored_size;
+
+    /** @brief The size of the asset once decompressed. */
+    u64 size;
+} kpak_asset;
+
+
+/**
+ * @brief Opens an archive, mapping it into memory and validating its index.
+ * @param path The path of the archive.
+ * @param out_pak A pointer to the archive to be filled out.
+ * @return `b8 TRUE` on success, `b8 FALSE` if the file cannot be mapped or is not a valid archive.
+ */
+KAPI b8 kpak_open(const char* path, kpak* out_pak);
+
+
+/**
+ * @brief Closes an archive. Asset data found in it becomes invalid.
+ * @param pak A pointer to the archive to close.
+ */
+KAPI void kpak_close(kpak* pak);
+
+
+/**
+ * @brief Gets the number of assets in an archive.
+ * @param pak A pointer to the archive.
+ * @return The number of assets.
+ */
+KAPI u32 kpak_count(const kpak* pak);
+
+
+/**
+ * @brief Looks up an asset by name.
+ * @param pak A pointer to the archive.
+ * @param name The name of the asset, as given to the packer.
+ * @param out_asset A pointer to the asset description to be filled out.
+ * @return `b8 TRUE` if the asset exists, otherwise `b8 FALSE`.
+ */
+KAPI b8 kpak_find(const kpak* pak, const char* name, kpak_asset* out_asset);
+
+
+/**
+ * @brief Gets the asset at an index, for walking every asset of an archive.
+ * @param pak A pointer to the archive.
+ * @param index The index of the asset, less than kpak_count.
+ * @param out_asset A pointer to the asset description to be filled out.
+ * @return `b8 TRUE` on success, `b8 FALSE` if the index is out of range.
+ */
+KAPI b8 kpak_get(const kpak* pak, u32 index, kpak_asset* out_asset);
+
+
+/**
+ * @brief Copies or decompresses an asset into a buffer.
+ * @details Uncompressed assets are better used in place through `data`; this is for assets
+ * that must be decompressed, or whose data must outlive the archive.
+ * @param asset The asset to read.
+ * @param buffer The buffer receiving the asset. At least `asset->size` bytes.
+ * @param buffer_size The size of `buffer`.
+ * @return `b8 TRUE` on success, `b8 FALSE` if the buffer is too small or the blob is corrupt.
+ */
+KAPI b8 kpak_read(const kpak_asset* asset, void* buffer, u64 buffer_size);
+
+
+/**
+ * @brief Gets the bucket an asset name hash belongs to.
+ * @param name_hash The hashtable_hash of the name.
+ * @param bucket_bits The log2 of the number of buckets.
+ * @return The index of the bucket.
+ */
+static inline u32 kpak_bucket(u64 name_hash, u32 bucket_bits) {
+    return bucket_bits ? (u32)(name_hash >> (64 - bucket_bits)) : 0;
+}
@@ -0,0 +1,335 @@
+/**
+ * @file kstring.c
+ * @brief This file contains the implementation of the engine's string utilities and string interning.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "kstring.h"
+
+#include "containers/darray.h"
+#include "containers/hashtable.h"
+#include "core/katomic.h"
+#include "core/kmemory.h"
+#include "core/linear_allocator.h"
+#include "core/logger.h"
+
+// vsnprintf does the actual formatting.
+#include <stdio.h>
+#include <string.h>
+
+/** @brief The size of each block of the arena holding interned strings. */
+#define KNAME_BLOCK_SIZE (64 * 1024)
+
+/** @brief The number of entries per chunk of the ID-to-string table. */
+#define KNAME_CHUNK_CAPACITY 4096
+
+/** @brief The maximum number of chunks, which bounds the number of names to 4M. */
+#define KNAME_MAX_CHUNKS 1024
+
+/** @brief The initial number of slots of the lookup table. Must be a power of two. */
+#define KNAME_INITIAL_SLOTS 1024
+
+/**
+ * @struct kname_entry
+ * @brief An interned string and its hash, kept to grow the lookup table without rehashing strings.
+ */
+typedef struct kname_entry {
+    /** @brief The interned string, inside the arena. */
+    kstring string;
+
+    /** @brief The kstring_hash of the string. */
+    u64 hash;
+} kname_entry;
+
+/**
+ * @struct kname_state
+ * @brief The global state of the name system.
+ */
+typedef struct kname_state {
+    /** @brief Indicates if the system is initialized. */
+    b8 initialized;
+
+    /** @brief Taken by every operation that reads the lookup table or adds names. 1 while held. */
+    u32 lock;
+
+    /** @brief The number of names. The ID of the newest one. Published with release ordering. */
+    u32 count;
+
+    /**
+     * @brief The entries, by ID - 1, in fixed-size chunks. Chunks never move once allocated,
+     * which is what makes kname_get_string lock-free.
+     */
+    kname_entry* chunks[KNAME_MAX_CHUNKS];
+
+    /** @brief The open-addressed lookup table of IDs (KNAME_NONE when empty), probed linearly. */
+    u32* slots;
+
+    /** @brief The number of slots. A power of two, kept at least twice `count`. */
+    u32 slot_count;
+
+    /** @brief A darray of the blocks of the arena holding the strings. Only the newest is allocated from. */
+    linear_allocator* blocks;
+} kname_state;
+
+// Static so the state needs no allocation and is private to this file.
+static kname_state state;
+
+kstring kstring_from_cstr(const char* str) {
+    kstring result = {"", 0};
+    if (str) {
+        result.data = str;
+        result.length = strlen(str);
+    }
+    return result;
+}
+
+b8 kstring_equal(kstring a, kstring b) {
+    return a.length == b.length && (a.data == b.data || memcmp(a.data, b.data, a.length) == 0);
+}
+
+u64 kstring_hash(kstring str) {
+    return hashtable_hash(str.data, str.length);
+}
+
+kstring kstring_copy(linear_allocator* arena, kstring str) {
+    char* data = linear_allocator_allocate(arena, str.length + 1);
+    if (!data) {
+        return KSTRING("");
+    }
+    kcopy_memory(data, str.data, str.length);
+    data[str.length] = 0;
+    return (kstring){data, str.length};
+}
+
+kstring kstring_format_v(linear_allocator* arena, const char* format, __builtin_va_list args) {
+    // Measure first, so the arena gives up exactly the bytes the string needs.
+    __builtin_va_list measure_args;
+    __builtin_va_copy(measure_args, args);
+    i32 length = vsnprintf(0, 0, format, measure_args);
+    __builtin_va_end(measure_args);
+    if (length < 0) {
+        return KSTRING("");
+    }
+
+    char* data = linear_allocator_allocate(arena, (u64)length + 1);
+    if (!data) {
+        return KSTRING("");
+    }
+    vsnprintf(data, (u64)length + 1, format, args);
+    return (kstring){data, (u64)length};
+}
+
+kstring kstring_format(linear_allocator* arena, const char* format, ...) {
+    __builtin_va_list args;
+    __builtin_va_start(args, format);
+    kstring result = kstring_format_v(arena, format, args);
+    __builtin_va_end(args);
+    return result;
+}
+
+u64 kstring_format_into(char* buffer, u64 buffer_size, const char* format, ...) {
+    if (!buffer || buffer_size == 0) {
+        return 0;
+    }
+
+    __builtin_va_list args;
+    __builtin_va_start(args, format);
+    i32 length = vsnprintf(buffer, buffer_size, format, args);
+    __builtin_va_end(args);
+
+    // snprintf returns the untruncated length; report what actually landed in the buffer.
+    if (length < 0) {
+        buffer[0] = 0;
+        return 0;
+    }
+    return (u64)length < buffer_size ? (u64)length : buffer_size - 1;
+}
+
+/** @brief Takes the name system's lock. */
+static void kname_lock() {
+    while (katomic_exchange(&state.lock, 1, KATOMIC_ACQUIRE) != 0) {
+        while (katomic_load(&state.lock, KATOMIC_RELAXED) != 0) {
+            kcpu_relax();
+        }
+    }
+}
+
+/** @brief Releases the name system's lock. */
+static void kname_unlock() {
+    katomic_store(&state.lock, 0, KATOMIC_RELEASE);
+}
+
+/** @brief Gets the entry of a valid ID. */
+static inline kname_entry* kname_entry_get(kname name) {
+    u32 index = name - 1;
+    return &state.chunks[index / KNAME_CHUNK_CAPACITY][index % KNAME_CHUNK_CAPACITY];
+}
+
+/**
+ * @brief Finds the slot holding a string, or the empty slot it would go in. Lock held.
+ * @return The index of the slot.
+ */
+static u32 kname_probe(kstring str, u64 hash) {
+    u32 mask = state.slot_count - 1;
+    for (u32 slot = (u32)hash & mask;; slot = (slot + 1) & mask) {
+        kname name = state.slots[slot];
+        if (name == KNAME_NONE) {
+            return slot;
+        }
+        const kname_entry* entry = kname_entry_get(name);
+        if (entry->hash == hash && kstring_equal(entry->string, str)) {
+            return slot;
+        }
+    }
+}
+
+/**
+ * @brief Doubles the lookup table, re-inserting every ID by its stored hash. Lock held.
+ */
+static void kname_grow_slots() {
+    u32 old_count = state.slot_count;
+    u32* old_slots = state.slots;
+
+    state.slot_count = old_count * 2;
+    state.slots = kallocate(sizeof(u32) * state.slot_count, MEMORY_TAG_STRING);
+    u32 mask = state.slot_count - 1;
+    for (u32 i = 0; i < old_count; ++i) {
+        kname name = old_slots[i];
+        if (name != KNAME_NONE) {
+            u32 slot = (u32)kname_entry_get(name)->hash & mask;
+            while (state.slots[slot] != KNAME_NONE) {
+                slot = (slot + 1) & mask;
+            }
+            state.slots[slot] = name;
+        }
+    }
+
+    kfree(old_slots, sizeof(u32) * old_count, MEMORY_TAG_STRING);
+}
+
+/**
+ * @brief Copies a string into the names arena, starting a new block when the newest is full. Lock held.
+ */
+static kstring kname_store(kstring str) {
+    linear_allocator* block = &state.blocks[darray_length(state.blocks) - 1];
+    if (block->allocated + str.length + 1 + 16 > block->total_size) {
+        // Strings larger than a block get a block of their own.
+        u64 size = str.length + 1 > KNAME_BLOCK_SIZE ? str.length + 1 : KNAME_BLOCK_SIZE;
+        linear_allocator new_block;
+        linear_allocator_create(size, 0, &new_block);
+        darray_push(state.blocks, new_block);
+        block = &state.blocks[darray_length(state.blocks) - 1];
+    }
+    return kstring_copy(block, str);
+}
+
+b8 kname_system_initialize() {
+    if (state.initialized) {
+        KERROR("kname_system_initialize called more than once.");
+        return FALSE;
+    }
+
+    state.lock = 0;
+    state.count = 0;
+    state.slot_count = KNAME_INITIAL_SLOTS;
+    state.slots = kallocate(sizeof(u32) * state.slot_count, MEMORY_TAG_STRING);
+    state.blocks = darray_create(linear_allocator);
+    linear_allocator first_block;
+    linear_allocator_create(KNAME_BLOCK_SIZE, 0, &first_block);
+    darray_push(state.blocks, first_block);
+
+    state.initialized = TRUE;
+    return TRUE;
+}
+
+void kname_system_shutdown() {
+    if (!state.initialized) {
+        return;
+    }
+
+    for (u32 i = 0; i < KNAME_MAX_CHUNKS && state.chunks[i]; ++i) {
+        kfree(state.chunks[i], sizeof(kname_entry) * KNAME_CHUNK_CAPACITY, MEMORY_TAG_STRING);
+        state.chunks[i] = 0;
+    }
+    kfree(state.slots, sizeof(u32) * state.slot_count, MEMORY_TAG_STRING);
+    for (u64 i = 0; i < darray_length(state.blocks); ++i) {
+        linear_allocator_destroy(&state.blocks[i]);
+    }
+    darray_destroy(state.blocks);
+
+    state.slots = 0;
+    state.blocks = 0;
+    state.count = 0;
+    state.initialized = FALSE;
+}
+
+kname kname_intern(kstring str) {
+    if (!state.initialized || str.length == 0) {
+        return KNAME_NONE;
+    }
+
+    u64 hash = kstring_hash(str);
+    kname_lock();
+
+    u32 slot = kname_probe(str, hash);
+    kname name = state.slots[slot];
+    if (name != KNAME_NONE) {
+        kname_unlock();
+        return name;
+    }
+
+    u32 index = state.count;
+    if (index == KNAME_CHUNK_CAPACITY * KNAME_MAX_CHUNKS) {
+        kname_unlock();
+        KERROR("kname_intern - the name table is full.");
+        return KNAME_NONE;
+    }
+    u32 chunk = index / KNAME_CHUNK_CAPACITY;
+    if (!state.chunks[chunk]) {
+        state.chunks[chunk] = kallocate(sizeof(kname_entry) * KNAME_CHUNK_CAPACITY, MEMORY_TAG_STRING);
+    }
+
+    kname_entry* entry = &state.chunks[chunk][index % KNAME_CHUNK_CAPACITY];
+    entry->string = kname_store(str);
+    entry->hash = hash;
+    name = index + 1;
+    state.slots[slot] = name;
+
+    // Release, so a thread that sees the new count in kname_get_string also sees the entry.
+    katomic_store(&state.count, name, KATOMIC_RELEASE);
+
+    // Keep at most half of the slots in use, so probes stay short.
+    if (state.count * 2 > state.slot_count) {
+        kname_grow_slots();
+    }
+
+    kname_unlock();
+    return name;
+}
+
+kname kname_intern_cstr(const char* str) {
+    return kname_intern(kstring_from_cstr(str));
+}
+
+kname kname_find(kstring str) {
+    if (!state.initialized || str.length == 0) {
+        return KNAME_NONE;
+    }
+
+    u64 hash = kstring_hash(str);
+    kname_lock();
+    kname name = state.slots[kname_probe(str, hash)];
+    kname_unlock();
+    return name;
+}
+
+kstring kname_get_string(kname name) {
+    if (name == KNAME_NONE || name > katomic_load(&state.count, KATOMIC_ACQUIRE)) {
+        return KSTRING("");
+    }
+    return kname_entry_get(name)->string;
+}
+
+u32 kname_count() {
+    return katomic_load(&state.count, KATOMIC_RELAXED);
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+/**
+ * @file kstring.h
+ * @brief This file contains the engine's string utilities and string interning.
+ *
+ * @details A kstring is a view: a pointer and a length. Passing the length along means
+ * comparisons and copies never scan for the terminator, and substrings need no copy. Strings
+ * created by this module (copies and formatted strings) are allocated from a caller-provided
+ * linear_allocator and are also NUL-terminated, so `data` can be handed to C APIs directly.
+ * Allocating from an arena (typically the per-frame arena, see application_frame_allocate)
+ * replaces the pattern of heap-allocating a string per call and freeing it later.
+ *
+ * Names are interned strings: kname_intern maps every distinct string to a small integer ID,
+ * once, so names used as keys (asset names, tags) compare and hash as integers afterwards.
+ * Interned strings live in an append-only arena for the lifetime of the name system, and
+ * kname_get_string turns an ID back into its string without taking a lock.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "defines.h"
+
+struct linear_allocator;
+
+/**
+ * @struct kstring
+ * @brief A view of a string: `length` bytes at `data`, not necessarily NUL-terminated.
+ */
+typedef struct kstring {
+    /** @brief The characters of the string. */
+    const char* data;
+
+    /** @brief The length of the string in bytes, not counting any terminator. */
+    u64 length;
+} kstring;
+
+/** @brief Makes a kstring from a string literal without measuring it at runtime. */
+#define KSTRING(literal) ((kstring){(literal), sizeof(literal) - 1})
+
+/**
+ * @brief An interned string's ID. Equal IDs mean equal strings.
+ */
+typedef u32 kname;
+
+/** @brief The ID of no name. Never returned by kname_intern. */
+#define KNAME_NONE 0
+
+
+/**
+ * @brief Makes a kstring view of a NUL-terminated string.
+ * @param str The string. May be 0, which gives an empty string.
+ * @return A view of `str`.
+ */
+KAPI kstring kstring_from_cstr(const char* str);
+
+
+/**
+ * @brief Checks if two strings have the same contents.
+ * @param a The first string.
+ * @param b The second string.
+ * @return `b8 TRUE` if the strings are equal, otherwise `b8 FALSE`.
+ */
+KAPI b8 kstring_equal(kstring a, kstring b);
+
+
+/**
+ * @brief Hashes a string. Equal strings always hash equal, across runs and platforms.
+ * @param str The string.
+ * @return The 64-bit hash of the string.
+ */
+KAPI u64 kstring_hash(kstring str);
+
+
+/**
+ * @brief Copies a string into an arena.
+ * @param arena The arena to allocate the copy from.
+ * @param str The string to copy.
+ * @return The NUL-terminated copy, or an empty string if the arena is full.
+ */
+KAPI kstring kstring_copy(struct linear_allocator* arena, kstring str);
+
+
+/**
+ * @brief Formats a string into an arena, printf-style.
+ * @param arena The arena to allocate the string from. Exactly the formatted length plus the terminator is used.
+ * @param format The printf-style format string.
+ * @return The NUL-terminated string, or an empty string if the arena is full.
+ */
+KAPI kstring kstring_format(struct linear_allocator* arena, const char* format, ...);
+
+
+/**
+ * @brief Formats a string into an arena, with the arguments given as a va_list.
+ * @param arena The arena to allocate the string from.
+ * @param format The printf-style format string.
+ * @param args The arguments for `format`.
+ * @return The NUL-terminated string, or an empty string if the arena is full.
+ */
+KAPI kstring kstring_format_v(struct linear_allocator* arena, const char* format, __builtin_va_list args);
+
+
+/**
+ * @brief Formats a string into a fixed buffer, printf-style, truncating if needed.
+ * @details Unlike snprintf, the result is the length actually written, so results can be
+ * appended to one another without clamping.
+ * @param buffer The buffer receiving the string. Always NUL-terminated if `buffer_size` is not 0.
+ * @param buffer_size The size of `buffer`.
+ * @param format The printf-style format string.
+ * @return The length of the string written, not counting the terminator.
+ */
+KAPI u64 kstring_format_into(char* buffer, u64 buffer_size, const char* format, ...);
+
+
+/**
+ * @brief Initializes the name system.
+ * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+ */
+KAPI b8 kname_system_initialize();
+
+
+/**
+ * @brief Shuts the name system down, releasing every interned string. IDs become invalid.
+ */
+KAPI void kname_system_shutdown();
+
+
+/**
+ * @brief Interns a string, returning its ID. Safe to call from any thread.
+ * @param str The string to intern. Copied, so it does not need to outlive the call.
+ * @return The ID of the string, or KNAME_NONE for an empty string (or if the system is not initialized).
+ */
+KAPI kname kname_intern(kstring str);
+
+
+/**
+ * @brief Interns a NUL-terminated string, returning its ID. Safe to call from any thread.
+ * @param str The string to intern.
+ * @return The ID of the string, or KNAME_NONE for an empty string.
+ */
+KAPI kname kname_intern_cstr(const char* str);
+
+
+/**
+ * @brief Looks up the ID of a string without interning it. Safe to call from any thread.
+ * @param str The string to look up.
+ * @return The ID of the string, or KNAME_NONE if it has not been interned.
+ */
+KAPI kname kname_find(kstring str);
+
+
+/**
+ * @brief Gets the string of an ID. Lock-free; safe to call from any thread.
+ * @param name The ID of the string.
+ * @return The interned, NUL-terminated string. Valid until kname_system_shutdown. Empty for KNAME_NONE or unknown IDs.
+ */
+KAPI kstring kname_get_string(kname name);
+
+
+/**
+ * @brief Gets the number of interned strings.
+ * @return The number of interned strings.
+ */
+KAPI u32 kname_count();
@@ -0,0 +1,79 @@
+/**
+ * @file linear_allocator.c
+ * @brief This file contains the implementation of the engine's linear allocator.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "linear_allocator.h"
+
+#include "core/kmemory.h"
+#include "core/logger.h"
+
+/**
+ * @brief The alignment every allocation offset is rounded up to.
+ * Matches the guarantee of the system allocator so arena memory can be used
+ * interchangeably with kallocate'd memory.
+ */
+#define LINEAR_ALLOCATOR_ALIGNMENT 16
+
+void linear_allocator_create(u64 total_size, void* memory, linear_allocator* out_allocator) {
+    if (!out_allocator) {
+        KERROR("linear_allocator_create requires a valid pointer to out_allocator.");
+        return;
+    }
+
+    out_allocator->total_size = total_size;
+    out_allocator->allocated = 0;
+    out_allocator->owns_memory = memory == 0;
+
+    if (memory) {
+        out_allocator->memory = memory;
+    } else {
+        // Reserve the whole block once. Every later allocation is a pointer bump into it.
+        // Arena memory is documented as uninitialized, so skip the zeroing pass.
+        out_allocator->memory = kallocate_uninit(total_size, MEMORY_TAG_LINEAR_ALLOCATOR);
+    }
+}
+
+void linear_allocator_destroy(linear_allocator* allocator) {
+    if (!allocator) {
+        return;
+    }
+
+    // Only release the block if it was reserved by the allocator itself.
+    if (allocator->owns_memory && allocator->memory) {
+        kfree(allocator->memory, allocator->total_size, MEMORY_TAG_LINEAR_ALLOCATOR);
+    }
+
+    allocator->memory = 0;
+    allocator->total_size = 0;
+    allocator->allocated = 0;
+    allocator->owns_memory = FALSE;
+}
+
+void* linear_allocator_allocate(linear_allocator* allocator, u64 size) {
+    if (!allocator || !allocator->memory) {
+        KERROR("linear_allocator_allocate - allocator not initialized.");
+        return 0;
+    }
+
+    // Round the current offset up to the next aligned boundary.
+    u64 offset = KALIGN_UP(allocator->allocated, LINEAR_ALLOCATOR_ALIGNMENT);
+
+    if (offset + size > allocator->total_size) {
+        u64 remaining = allocator->total_size - allocator->allocated;
+        KERROR("linear_allocator_allocate - Tried to allocate %lluB, only %lluB remaining.", size, remaining);
+        return 0;
+    }
+
+    void* block = ((u8*)allocator->memory) + offset;
+    allocator->allocated = offset + size;
+    return block;
+}
+
+void linear_allocator_free_all(linear_allocator* allocator) {
+    if (allocator && allocator->memory) {
+        // Just rewind the offset. The block is kept and reused as-is.
+        allocator->allocated = 0;
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+/**
+ * @file linear_allocator.h
+ * @brief This file contains the declarations for the engine's linear allocator.
+ *
+ * @details A linear allocator (also known as an arena or bump allocator) reserves a
+ * single block of memory up front and hands out sub-ranges of it by simply advancing
+ * an offset. Individual allocations cannot be freed; instead, the entire allocator is
+ * reset at once with linear_allocator_free_all. This makes each allocation cost a
+ * pointer bump with no heap calls, which is ideal for short-lived (e.g. per-frame) data.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "defines.h"
+
+/**
+ * @struct linear_allocator
+ * @brief Holds the state of a single linear allocator.
+ */
+typedef struct linear_allocator {
+    /** @brief The total size of the memory block in bytes. `u64` supports very large arenas. */
+    u64 total_size;
+
+    /** @brief The number of bytes currently handed out from the block. */
+    u64 allocated;
+
+    /** @brief A pointer to the start of the memory block. */
+    void* memory;
+
+    /** @brief Indicates if the allocator reserved `memory` itself (and must free it on destroy). */
+    b8 owns_memory;
+} linear_allocator;
+
+
+/**
+ * @brief Creates a linear allocator of the given size.
+ * @param total_size The total size of the arena in bytes.
+ * @param memory An optional, pre-allocated block of at least `total_size` bytes. If 0, the
+ * allocator reserves its own block once via kallocate and releases it on destroy.
+ * @param out_allocator A pointer to the linear_allocator to be initialized.
+ */
+KAPI void linear_allocator_create(u64 total_size, void* memory, linear_allocator* out_allocator);
+
+
+/**
+ * @brief Destroys the given linear allocator, freeing its memory block if it owns it.
+ * @param allocator A pointer to the allocator to be destroyed.
+ */
+KAPI void linear_allocator_destroy(linear_allocator* allocator);
+
+
+/**
+ * @brief Allocates a block of memory from the linear allocator.
+ * @note The returned memory is NOT zeroed. Callers are responsible for initializing it.
+ * @param allocator A pointer to the allocator to allocate from.
+ * @param size The number of bytes to allocate.
+ * @return A pointer to the allocated block, or 0 if the allocator does not have enough space left.
+ */
+KAPI void* linear_allocator_allocate(linear_allocator* allocator, u64 size);
+
+
+/**
+ * @brief Releases every allocation made from the allocator at once by resetting its offset.
+ * @details The memory block itself is kept, so this is a constant-time operation.
+ * @param allocator A pointer to the allocator to reset.
+ */
+KAPI void linear_allocator_free_all(linear_allocator* allocator);
@@ -7,6 +7,9 @@
 
 #include "logger.h"
 #include "asserts.h"
+#include "core/katomic.h"
+#include "core/kmemory.h"
+#include "containers/ring_queue.h"
 #include "platform/platform.h"
 
 // TODO: These standard library includes are temporary and will be replaced
@@ -16,21 +19,732 @@
 #include <stdarg.h>
 
 /**
- * @brief Initializes the logging system.
- * @note Currently a stub. Future implementations will handle file I/O.
+ * @brief The number of records the log queue can hold. Must be a power of two.
+ */
+#define LOG_QUEUE_CAPACITY 1024
+
+/**
+ * @brief The maximum length of a single formatted log entry (including the level prefix).
+ * Longer entries are truncated.
+ */
+#define LOG_RECORD_MESSAGE_SIZE 2048
+
+/**
+ * @brief How long the writer thread sleeps at most before re-checking the queue, in milliseconds.
+ */
+#define LOG_WRITER_WAIT_MS 100
+
+/** @brief The path of the log file, relative to the working directory. */
+#define LOG_FILE_PATH "console.log"
+
+/** @brief The size of the file sink's buffer. Entries are written to disk in batches of up to this size. */
+#define LOG_FILE_BUFFER_SIZE (64 * 1024)
+
+/** @brief The maximum time buffered entries wait before being written to disk, in seconds. */
+#define LOG_FILE_FLUSH_INTERVAL 1.0
+
+/** @brief The size at which the log file is rotated. */
+#define LOG_FILE_MAX_SIZE (8 * 1024 * 1024)
+
+/** @brief The number of rotated log files kept (console.log.1 ... console.log.N). */
+#define LOG_FILE_MAX_BACKUPS 3
+
+/**
+ * @enum log_record_type
+ * @brief Describes how the payload of a log record is encoded.
+ */
+typedef enum log_record_type {
+    /** @brief The payload is the fully formatted entry. */
+    LOG_RECORD_TYPE_TEXT,
+
+    /** @brief The payload holds the raw arguments for `format`, which the writer thread formats. */
+    LOG_RECORD_TYPE_DEFERRED
+} log_record_type;
+
+/**
+ * @struct log_record
+ * @brief A single log entry waiting in the queue.
+ */
+typedef struct log_record {
+    /** @brief The time the entry was logged, from platform_get_absolute_time. */
+    f64 timestamp;
+
+    /** @brief The format string of a deferred entry. Must outlive the entry (i.e. be a literal). */
+    const char* format;
+
+    /** @brief How `message` is encoded. */
+    log_record_type type;
+
+    /** @brief The level of the entry. Selects the console colour and output stream. */
+    log_level level;
+
+    /** @brief The number of bytes used in `message` (for text, excluding the null terminator). */
+    u32 length;
+
+    /**
+     * @brief The payload. For text records, the fully formatted entry including the level
+     * prefix and trailing newline. For deferred records, the encoded arguments.
+     */
+    char message[LOG_RECORD_MESSAGE_SIZE];
+} log_record;
+
+/**
+ * @enum log_arg_kind
+ * @brief The C type a conversion specifier consumes from the argument list.
+ * Deferred records store each argument as a kind byte followed by its raw value,
+ * so the writer can hand snprintf exactly the type the caller passed.
+ */
+typedef enum log_arg_kind {
+    LOG_ARG_NONE,        /**< No argument (e.g. "%%"). */
+    LOG_ARG_INT,         /**< int (also char/short, which are promoted). */
+    LOG_ARG_LONG,        /**< long */
+    LOG_ARG_LONG_LONG,   /**< long long */
+    LOG_ARG_SIZE,        /**< size_t (the 'z', 'j' and 't' length modifiers). */
+    LOG_ARG_DOUBLE,      /**< double (float is promoted). */
+    LOG_ARG_LONG_DOUBLE, /**< long double */
+    LOG_ARG_POINTER,     /**< void* */
+    LOG_ARG_STRING,      /**< const char*, copied into the record. */
+    LOG_ARG_UNSUPPORTED  /**< A specifier that cannot be deferred (e.g. "%n"). */
+} log_arg_kind;
+
+/**
+ * @struct log_format_spec
+ * @brief A single parsed conversion specifier.
+ */
+typedef struct log_format_spec {
+    /** @brief The type of the specifier's value argument. */
+    log_arg_kind kind;
+
+    /** @brief The number of '*' width/precision arguments (each an int) preceding the value. */
+    u8 star_count;
+
+    /** @brief Set if the precision is a '*' argument (always the last of the star arguments). */
+    b8 precision_star;
+
+    /** @brief The explicit precision, or -1 if there is none (or it is a '*' argument). */
+    i32 precision;
+
+    /** @brief The length of the specifier text, including the '%'. */
+    u8 length;
+} log_format_spec;
+
+/**
+ * @struct logger_state
+ * @brief Holds the state of the asynchronous logging backend.
+ * @details The queue is a bounded MPMC ring_queue: any thread may enqueue, and only the
+ * writer thread dequeues. Records are formatted and written out in place in the queue's cells.
+ */
+typedef struct logger_state {
+    /** @brief The queue of records waiting to be written out. */
+    ring_queue queue;
+
+    /** @brief The number of records the writer has written out. Used by flushes to wait for completion. */
+    u64 written_count;
+
+    /** @brief Set by the writer right before it sleeps, so producers know to wake it. */
+    KALIGN(KCACHE_LINE_SIZE) u32 writer_sleeping;
+
+    /** @brief Indicates if the writer thread should keep running. */
+    b8 running;
+
+    /** @brief Indicates if the asynchronous backend is up. Until then, entries are written synchronously. */
+    b8 initialized;
+
+    /** @brief Signalled to wake the writer thread when entries arrive. */
+    platform_semaphore wake;
+
+    /** @brief The background writer thread. */
+    platform_thread writer;
+
+    /** @brief The log file. Only touched by the writer thread once it is running. */
+    platform_file log_file;
+
+    /** @brief The number of bytes in `file_buffer` waiting to be written. */
+    u64 file_buffer_used;
+
+    /** @brief The current size of the log file on disk. Used to decide when to rotate. */
+    u64 file_size;
+
+    /** @brief The time the file buffer was last written to disk. */
+    f64 last_file_flush;
+
+    /** @brief Entries waiting to be written to the log file in one batch. */
+    char file_buffer[LOG_FILE_BUFFER_SIZE];
+
+    /** @brief The storage of the queue. Static, so logging never depends on the memory system. */
+    KALIGN(16) u8 queue_memory[RING_QUEUE_MEMORY_REQUIREMENT(RING_QUEUE_TYPE_MPMC, sizeof(log_record), LOG_QUEUE_CAPACITY)];
+} logger_state;
+
+// The one and only logger state. Static storage, so logging never depends on the memory system.
+static logger_state state;
+
+// The most verbose level that is output at runtime. Entries above it are dropped before formatting.
+static log_level runtime_level = LOG_LEVEL_TRACE;
+
+// Indicates if entries are written to the console. The file sink does not depend on it.
+static b8 console_enabled = TRUE;
+
+/**
+ * @brief Opens (or creates) the log file for appending.
+ */
+static b8 logger_file_open() {
+    if (!platform_file_open(LOG_FILE_PATH, PLATFORM_FILE_MODE_WRITE | PLATFORM_FILE_MODE_APPEND, &state.log_file)) {
+        return FALSE;
+    }
+    if (!platform_file_size(&state.log_file, &state.file_size)) {
+        state.file_size = 0;
+    }
+    return TRUE;
+}
+
+/**
+ * @brief Shifts console.log -> console.log.1 -> ... -> console.log.N and starts a fresh file.
+ */
+static void logger_file_rotate() {
+    platform_file_close(&state.log_file);
+
+    char from[64];
+    char to[64];
+    for (i32 i = LOG_FILE_MAX_BACKUPS - 1; i > 0; --i) {
+        snprintf(from, sizeof(from), "%s.%d", LOG_FILE_PATH, i);
+        snprintf(to, sizeof(to), "%s.%d", LOG_FILE_PATH, i + 1);
+        if (platform_file_exists(from)) {
+            platform_file_rename(from, to);
+        }
+    }
+    snprintf(to, sizeof(to), "%s.1", LOG_FILE_PATH);
+    platform_file_rename(LOG_FILE_PATH, to);
+
+    logger_file_open();
+}
+
+/**
+ * @brief Writes the buffered entries to the log file in a single write, rotating it if it grew too large.
+ */
+static void logger_file_flush() {
+    state.last_file_flush = platform_get_absolute_time();
+    if (!state.log_file.is_valid || state.file_buffer_used == 0) {
+        return;
+    }
+
+    u64 written = 0;
+    platform_file_write(&state.log_file, state.file_buffer, state.file_buffer_used, &written);
+    state.file_size += written;
+    state.file_buffer_used = 0;
+
+    if (state.file_size >= LOG_FILE_MAX_SIZE) {
+        logger_file_rotate();
+    }
+}
+
+/**
+ * @brief Appends a formatted entry (prefixed with its timestamp) to the file buffer.
+ */
+static void logger_file_append(f64 timestamp, const char* message, u32 length) {
+    if (!state.log_file.is_valid) {
+        return;
+    }
+
+    // Leave room for the timestamp prefix; flush first if the entry would not fit.
+    const u32 prefix_room = 32;
+    if (state.file_buffer_used + prefix_room + length > LOG_FILE_BUFFER_SIZE) {
+        logger_file_flush();
+    }
+
+    char* out = state.file_buffer + state.file_buffer_used;
+    i32 prefix = snprintf(out, prefix_room, "[%.6f]", timestamp);
+    prefix = CLAMP(prefix, 0, (i32)prefix_room - 1);
+    kcopy_memory(out + prefix, message, length);
+    state.file_buffer_used += prefix + length;
+}
+
+/**
+ * @brief Writes a formatted entry to the platform console.
+ */
+static void logger_write(log_level level, const char* message) {
+    if (!katomic_load(&console_enabled, KATOMIC_RELAXED)) {
+        return;
+    }
+
+    // Platform-specific output
+    if (level < LOG_LEVEL_WARN) {
+        platform_console_write_error(message, level);
+    } else {
+        platform_console_write(message, level);
+    }
+}
+
+/**
+ * @brief Parses the conversion specifier starting at `spec` (which points at a '%').
+ * @param spec A pointer to the '%' that starts the specifier.
+ * @param out_spec A pointer to the parsed result.
+ */
+static void logger_parse_spec(const char* spec, log_format_spec* out_spec) {
+    const char* p = spec + 1;
+    out_spec->star_count = 0;
+    out_spec->precision_star = FALSE;
+    out_spec->precision = -1;
+    out_spec->kind = LOG_ARG_UNSUPPORTED;
+
+    // Flags.
+    while (*p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '0') {
+        p++;
+    }
+
+    // Width.
+    if (*p == '*') {
+        out_spec->star_count++;
+        p++;
+    } else {
+        while (*p >= '0' && *p <= '9') {
+            p++;
+        }
+    }
+
+    // Precision.
+    if (*p == '.') {
+        p++;
+        if (*p == '*') {
+            out_spec->star_count++;
+            out_spec->precision_star = TRUE;
+            p++;
+        } else {
+            // A lone '.' is a precision of 0.
+            out_spec->precision = 0;
+            while (*p >= '0' && *p <= '9') {
+                out_spec->precision = out_spec->precision * 10 + (*p - '0');
+                p++;
+            }
+        }
+    }
+
+    // Length modifier.
+    u8 longs = 0;
+    b8 is_size = FALSE;
+    b8 is_long_double = FALSE;
+    for (;;) {
+        if (*p == 'l') {
+            longs++;
+        } else if (*p == 'z' || *p == 'j' || *p == 't') {
+            is_size = TRUE;
+        } else if (*p == 'L') {
+            is_long_double = TRUE;
+        } else if (*p != 'h') {
+            break;
+        }
+        p++;
+    }
+
+    // Conversion.
+    switch (*p) {
+        case 'd': case 'i': case 'u': case 'x': case 'X': case 'o': case 'c':
+            out_spec->kind = is_size ? LOG_ARG_SIZE : longs >= 2 ? LOG_ARG_LONG_LONG : longs == 1 ? LOG_ARG_LONG : LOG_ARG_INT;
+            break;
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+            out_spec->kind = is_long_double ? LOG_ARG_LONG_DOUBLE : LOG_ARG_DOUBLE;
+            break;
+        case 'p':
+            out_spec->kind = LOG_ARG_POINTER;
+            break;
+        case 's':
+            out_spec->kind = LOG_ARG_STRING;
+            break;
+        case '%':
+            out_spec->kind = LOG_ARG_NONE;
+            break;
+        default:
+            break;
+    }
+
+    if (*p) {
+        p++;
+    }
+    out_spec->length = (u8)(p - spec);
+}
+
+/**
+ * @brief Gets the number of bytes a value of the given kind occupies in a deferred payload.
+ */
+static u32 logger_arg_size(log_arg_kind kind) {
+    switch (kind) {
+        case LOG_ARG_INT: return sizeof(int);
+        case LOG_ARG_LONG: return sizeof(long);
+        case LOG_ARG_LONG_LONG: return sizeof(long long);
+        case LOG_ARG_SIZE: return sizeof(size_t);
+        case LOG_ARG_DOUBLE: return sizeof(double);
+        case LOG_ARG_LONG_DOUBLE: return sizeof(long double);
+        case LOG_ARG_POINTER: return sizeof(void*);
+        default: return 0;
+    }
+}
+
+/**
+ * @brief Encodes the arguments for `format` into the payload of a deferred record.
+ * @details Only the format string is scanned; no formatting takes place. Strings are copied,
+ * since the caller's buffer may be gone by the time the writer formats the entry. Encoding
+ * stops early (and the entry is truncated) if the payload fills up.
+ * @return The number of payload bytes used.
+ */
+static u32 logger_encode_args(char* payload, u32 payload_size, const char* format, __builtin_va_list args) {
+    u32 offset = 0;
+    for (const char* p = format; *p; ++p) {
+        if (*p != '%') {
+            continue;
+        }
+
+        log_format_spec spec;
+        logger_parse_spec(p, &spec);
+        p += spec.length - 1;
+        if (spec.kind == LOG_ARG_NONE) {
+            continue;
+        }
+        if (spec.kind == LOG_ARG_UNSUPPORTED) {
+            break;
+        }
+
+        // Width/precision arguments are always ints.
+        i32 precision = spec.precision;
+        for (u8 i = 0; i < spec.star_count; ++i) {
+            int star = va_arg(args, int);
+            if (offset + sizeof(int) > payload_size) {
+                return offset;
+            }
+            memcpy(payload + offset, &star, sizeof(int));
+            offset += sizeof(int);
+            if (spec.precision_star && i == spec.star_count - 1) {
+                // A negative precision is taken as if it were omitted.
+                precision = star < 0 ? -1 : star;
+            }
+        }
+
+        if (spec.kind == LOG_ARG_STRING) {
+            const char* str = va_arg(args, const char*);
+            if (!str) {
+                str = "(null)";
+            }
+            // Strings are stored as a u32 length followed by the characters (without a terminator).
+            // A precision bounds the read too, as "%.*s" strings need not be terminated.
+            u32 length = precision >= 0 ? (u32)strnlen(str, (size_t)precision) : (u32)strlen(str);
+            if (offset + sizeof(u32) > payload_size) {
+                return offset;
+            }
+            u32 available = payload_size - offset - sizeof(u32);
+            length = length > available ? available : length;
+            memcpy(payload + offset, &length, sizeof(u32));
+            memcpy(payload + offset + sizeof(u32), str, length);
+            offset += sizeof(u32) + length;
+            continue;
+        }
+
+        u32 size = logger_arg_size(spec.kind);
+        if (offset + size > payload_size) {
+            return offset;
+        }
+
+        // Pull each argument as the exact type the caller passed.
+        switch (spec.kind) {
+            case LOG_ARG_INT: { int v = va_arg(args, int); memcpy(payload + offset, &v, size); } break;
+            case LOG_ARG_LONG: { long v = va_arg(args, long); memcpy(payload + offset, &v, size); } break;
+            case LOG_ARG_LONG_LONG: { long long v = va_arg(args, long long); memcpy(payload + offset, &v, size); } break;
+            case LOG_ARG_SIZE: { size_t v = va_arg(args, size_t); memcpy(payload + offset, &v, size); } break;
+            case LOG_ARG_DOUBLE: { double v = va_arg(args, double); memcpy(payload + offset, &v, size); } break;
+            case LOG_ARG_LONG_DOUBLE: { long double v = va_arg(args, long double); memcpy(payload + offset, &v, size); } break;
+            case LOG_ARG_POINTER: { void* v = va_arg(args, void*); memcpy(payload + offset, &v, size); } break;
+            default: break;
+        }
+        offset += size;
+    }
+    return offset;
+}
+
+/**
+ * @brief Formats a deferred record into `buffer`, producing the same text log_output would have.
+ * @return The length of the formatted entry.
+ */
+static u32 logger_decode(const log_record* record, char* buffer, u32 buffer_size) {
+    const char* level_strings[6] = {"[FATAL]: ", "[ERROR]: ", "[WARN]: ", "[INFO]: ", "[DEBUG]: ", "[TRACE]: "};
+    i32 written = snprintf(buffer, buffer_size, "%s", level_strings[record->level]);
+    u32 offset = CLAMP(written, 0, (i32)buffer_size - 2);
+
+    const char* payload = record->message;
+    u32 read = 0;
+    for (const char* p = record->format; *p && offset < buffer_size - 2;) {
+        if (*p != '%') {
+            buffer[offset++] = *p++;
+            continue;
+        }
+
+        log_format_spec spec;
+        logger_parse_spec(p, &spec);
+        if (spec.kind == LOG_ARG_NONE) {
+            buffer[offset++] = '%';
+            p += spec.length;
+            continue;
+        }
+
+        u32 value_size = spec.kind == LOG_ARG_STRING ? sizeof(u32) : logger_arg_size(spec.kind);
+        if (spec.kind == LOG_ARG_UNSUPPORTED || read + spec.star_count * sizeof(int) + value_size > record->length) {
+            // The payload was truncated (or the specifier cannot be deferred); stop here.
+            break;
+        }
+
+        // Copy the specifier on its own so snprintf formats exactly one value.
+        char spec_text[64];
+        u8 spec_length = spec.length < sizeof(spec_text) ? spec.length : sizeof(spec_text) - 1;
+        memcpy(spec_text, p, spec_length);
+        spec_text[spec_length] = 0;
+        p += spec.length;
+
+        int stars[2] = {0, 0};
+        for (u8 i = 0; i < spec.star_count; ++i) {
+            memcpy(&stars[i], payload + read, sizeof(int));
+            read += sizeof(int);
+        }
+
+        char* out = buffer + offset;
+        u32 remaining = buffer_size - 1 - offset;
+
+        // Dispatches a single snprintf with the right number of '*' arguments.
+#define LOG_DECODE_FORMAT(value)                                                            \
+        (spec.star_count == 0 ? snprintf(out, remaining, spec_text, value) :                \
+         spec.star_count == 1 ? snprintf(out, remaining, spec_text, stars[0], value) :      \
+                                snprintf(out, remaining, spec_text, stars[0], stars[1], value))
+
+        i32 length = 0;
+        switch (spec.kind) {
+            case LOG_ARG_INT: { int v; memcpy(&v, payload + read, sizeof(v)); length = LOG_DECODE_FORMAT(v); } break;
+            case LOG_ARG_LONG: { long v; memcpy(&v, payload + read, sizeof(v)); length = LOG_DECODE_FORMAT(v); } break;
+            case LOG_ARG_LONG_LONG: { long long v; memcpy(&v, payload + read, sizeof(v)); length = LOG_DECODE_FORMAT(v); } break;
+            case LOG_ARG_SIZE: { size_t v; memcpy(&v, payload + read, sizeof(v)); length = LOG_DECODE_FORMAT(v); } break;
+            case LOG_ARG_DOUBLE: { double v; memcpy(&v, payload + read, sizeof(v)); length = LOG_DECODE_FORMAT(v); } break;
+            case LOG_ARG_LONG_DOUBLE: { long double v; memcpy(&v, payload + read, sizeof(v)); length = LOG_DECODE_FORMAT(v); } break;
+            case LOG_ARG_POINTER: { void* v; memcpy(&v, payload + read, sizeof(v)); length = LOG_DECODE_FORMAT(v); } break;
+            case LOG_ARG_STRING: {
+                u32 string_length;
+                memcpy(&string_length, payload + read, sizeof(u32));
+                read += sizeof(u32);
+                // The string was stored without a terminator, so bound it with a precision of at
+                // most the stored length: "%-10s" -> "%-10.*s", "%*.5s" -> "%*.*s".
+                const char* dot = memchr(spec_text, '.', spec_length);
+                u8 prefix_length = dot ? (u8)(dot - spec_text) : spec_length - 1;
+                i32 precision = spec.precision_star ? stars[spec.star_count - 1] : dot ? spec.precision : (i32)string_length;
+                precision = precision < 0 || (u32)precision > string_length ? (i32)string_length : precision;
+
+                char string_spec[80];
+                snprintf(string_spec, sizeof(string_spec), "%.*s.*s", (int)prefix_length, spec_text);
+                b8 has_width_star = memchr(spec_text, '*', prefix_length) != 0;
+                length = has_width_star ? snprintf(out, remaining, string_spec, stars[0], precision, payload + read)
+                                        : snprintf(out, remaining, string_spec, precision, payload + read);
+                read += string_length;
+            } break;
+            default: break;
+        }
+#undef LOG_DECODE_FORMAT
+
+        read += spec.kind == LOG_ARG_STRING ? 0 : value_size;
+        offset += CLAMP(length, 0, (i32)remaining - 1);
+    }
+
+    // Ensure the message is properly null-terminated and has a newline.
+    offset = offset > buffer_size - 2 ? buffer_size - 2 : offset;
+    buffer[offset] = '\n';
+    buffer[offset + 1] = '\0';
+    return offset + 1;
+}
+
+/**
+ * @brief Writes out every record that is currently ready. Only called from the writer thread.
+ * @return The number of records written.
+ */
+static u64 logger_drain() {
+    u64 count = 0;
+    for (;;) {
+        u64 ticket;
+        log_record* record = ring_queue_begin_dequeue(&state.queue, &ticket);
+        if (!record) {
+            // The next record has not been published yet.
+            break;
+        }
+
+        if (record->type == LOG_RECORD_TYPE_DEFERRED) {
+            // Deferred entries are formatted here, off the logging thread.
+            char formatted[LOG_RECORD_MESSAGE_SIZE];
+            u32 length = logger_decode(record, formatted, sizeof(formatted));
+            logger_write(record->level, formatted);
+            logger_file_append(record->timestamp, formatted, length);
+        } else {
+            logger_write(record->level, record->message);
+            logger_file_append(record->timestamp, record->message, record->length);
+        }
+
+        // Fatal entries go to disk right away; the application is about to go down.
+        if (record->level == LOG_LEVEL_FATAL) {
+            logger_file_flush();
+        }
+
+        // Hand the cell back to producers.
+        ring_queue_end_dequeue(&state.queue, ticket);
+        count++;
+    }
+
+    if (count) {
+        katomic_fetch_add(&state.written_count, count, KATOMIC_RELEASE);
+    }
+    return count;
+}
+
+/**
+ * @brief The entry point of the background writer thread.
+ */
+static u32 logger_writer_thread(void* params) {
+    (void)params;
+    while (katomic_load(&state.running, KATOMIC_ACQUIRE)) {
+        u64 drained = logger_drain();
+
+        // Buffered file entries are written once the buffer fills, or after the flush interval.
+        if (state.file_buffer_used && platform_get_absolute_time() - state.last_file_flush >= LOG_FILE_FLUSH_INTERVAL) {
+            logger_file_flush();
+        }
+
+        if (drained) {
+            continue;
+        }
+
+        // Announce that we are about to sleep, then check once more so a record
+        // published in between is not missed.
+        katomic_store(&state.writer_sleeping, 1, KATOMIC_SEQ_CST);
+        if (logger_drain() == 0) {
+            platform_semaphore_wait(&state.wake, LOG_WRITER_WAIT_MS);
+        }
+        katomic_store(&state.writer_sleeping, 0, KATOMIC_RELAXED);
+    }
+
+    // Write out whatever is left before exiting.
+    logger_drain();
+    logger_file_flush();
+    platform_file_close(&state.log_file);
+    return 0;
+}
+
+/**
+ * @brief Wakes the writer thread if it is asleep.
+ */
+static void logger_wake_writer() {
+    if (katomic_exchange(&state.writer_sleeping, 0, KATOMIC_SEQ_CST)) {
+        platform_semaphore_signal(&state.wake);
+    }
+}
+
+/**
+ * @brief Blocks until every record enqueued so far has been written out.
+ */
+static void logger_flush() {
+    u64 target = ring_queue_total_enqueued(&state.queue);
+    while (katomic_load(&state.written_count, KATOMIC_ACQUIRE) < target) {
+        katomic_store(&state.writer_sleeping, 0, KATOMIC_RELAXED);
+        platform_semaphore_signal(&state.wake);
+        platform_sleep(1);
+    }
+}
+
+/**
+ * @brief Claims the next free record in the queue, waiting if the queue is full.
+ * @return A pointer to the claimed record. It must be published by passing `out_pos` to logger_publish.
+ */
+static log_record* logger_claim(u64* out_pos) {
+    for (;;) {
+        log_record* record = ring_queue_begin_enqueue(&state.queue, out_pos);
+        if (record) {
+            return record;
+        }
+
+        // The queue is full. Make sure the writer is awake and back off until it catches up.
+        logger_wake_writer();
+        kcpu_relax();
+    }
+}
+
+/**
+ * @brief Publishes a claimed record to the writer thread.
+ */
+static void logger_publish(u64 pos) {
+    ring_queue_end_enqueue(&state.queue, pos);
+    logger_wake_writer();
+}
+
+/**
+ * @brief Formats an entry (level prefix, message, trailing newline) into `buffer`.
+ * @return The length of the formatted entry.
+ */
+static u32 logger_format(char* buffer, u64 buffer_size, log_level level, const char* message, __builtin_va_list args) {
+    const char* level_strings[6] = {"[FATAL]: ", "[ERROR]: ", "[WARN]: ", "[INFO]: ", "[DEBUG]: ", "[TRACE]: "};
+
+    // Prepend the log level string to the buffer.
+    i32 prefix_len = snprintf(buffer, buffer_size, "%s", level_strings[level]);
+    prefix_len = CLAMP(prefix_len, 0, (i32)buffer_size - 1);
+
+    // Format the original message after the prefix.
+    i32 msg_len = vsnprintf(buffer + prefix_len, buffer_size - prefix_len, message, args);
+    msg_len = CLAMP(msg_len, 0, (i32)(buffer_size - prefix_len) - 1);
+
+    // Ensure the message is properly null-terminated and has a newline.
+    u32 total_len = prefix_len + msg_len;
+    total_len = total_len > buffer_size - 2 ? buffer_size - 2 : total_len;
+    buffer[total_len] = '\n';
+    buffer[total_len + 1] = '\0';
+    return total_len + 1;
+}
+
+/**
+ * @brief Initializes the logging system and starts the background writer thread.
  */
 b8 initialize_logging() {
-    // TODO: create log file.
+    // Entries are still written to the console if the log file cannot be opened.
+    state.file_buffer_used = 0;
+    state.last_file_flush = platform_get_absolute_time();
+    if (!logger_file_open()) {
+        platform_console_write_error("[WARN]: Unable to open log file '" LOG_FILE_PATH "'. Logging to console only.\n", LOG_LEVEL_WARN);
+    }
+
+    if (!ring_queue_create(RING_QUEUE_TYPE_MPMC, sizeof(log_record), LOG_QUEUE_CAPACITY, state.queue_memory, &state.queue)) {
+        return FALSE;
+    }
+    state.written_count = 0;
+    state.writer_sleeping = 0;
+
+    if (!platform_semaphore_create(0, &state.wake)) {
+        return FALSE;
+    }
+
+    state.running = TRUE;
+    if (!platform_thread_create(logger_writer_thread, 0, &state.writer)) {
+        state.running = FALSE;
+        platform_semaphore_destroy(&state.wake);
+        return FALSE;
+    }
+
+    katomic_store(&state.initialized, TRUE, KATOMIC_RELEASE);
     return TRUE;
 }
 
 
 /**
  * @brief Shuts down the logging system.
- * @note Currently a stub. Future implementations will write queued entries to a file.
+ * @details Flushes every queued entry, then stops and joins the writer thread.
+ * Later entries are written synchronously.
  */
 void shutdown_logging() {
-    // TODO: cleanup logging/write queued entries
+    if (!katomic_load(&state.initialized, KATOMIC_ACQUIRE)) {
+        return;
+    }
+
+    // Write out queued entries, then stop the writer.
+    logger_flush();
+    katomic_store(&state.initialized, FALSE, KATOMIC_RELEASE);
+    katomic_store(&state.running, FALSE, KATOMIC_RELEASE);
+    platform_semaphore_signal(&state.wake);
+    platform_thread_join(&state.writer);
+    platform_semaphore_destroy(&state.wake);
 }
 
 
@@ -39,11 +753,16 @@ void shutdown_logging() {
  * @brief The core implementation for outputting log messages.
  *
  * This function formats a message by prepending the appropriate log level string
- * and appending a newline character. It then outputs the result to the console.
+ * and appending a newline character, directly into a record of the log queue. The
+ * background writer thread then outputs it to the console, so the calling thread only
+ * pays for formatting plus one enqueue.
+ *
+ * @note Entries are limited to LOG_RECORD_MESSAGE_SIZE bytes and truncated beyond that.
+ * Fatal entries are flushed before this function returns, so they are visible even if
+ * the process terminates right after.
  *
- * @note This function uses a large, static buffer on the stack (32k) to avoid
- * the performance overhead of dynamic memory allocation. This imposes a
- * technical limit on the length of a single log entry.
+ * @note Before initialize_logging (and after shutdown_logging), entries are formatted
+ * on the stack and written synchronously.
  *
  * @note A specific workaround using `__builtin_va_list` is employed because
  * Microsoft's headers can conflict with the standard `va_list` type expected
@@ -54,42 +773,124 @@ void shutdown_logging() {
  * @param ... Variadic arguments corresponding to the format specifiers in the message.
  */
 void log_output(log_level level, const char* message, ...) {
-    const char* level_strings[6] = {"[FATAL]: ", "[ERROR]: ", "[WARN]: ", "[INFO]: ", "[DEBUG]: ", "[TRACE]: "};
-    b8 is_error = level < LOG_LEVEL_WARN;
+    // Suppressed levels return before any formatting happens.
+    if (level > katomic_load(&runtime_level, KATOMIC_RELAXED)) {
+        return;
+    }
 
-    // Buffer for the final formatted message.
-    const i32 msg_length = 32000;
-    char out_message[msg_length];
-    memset(out_message, 0, sizeof(out_message));
+    __builtin_va_list arg_ptr;
+    va_start(arg_ptr, message);
 
-    // If the buffer size is 1, there's no space for any content, 
-    if (sizeof(out_message) == 1) {
-        printf("%s", out_message);
+    if (!katomic_load(&state.initialized, KATOMIC_ACQUIRE)) {
+        // No writer thread; format on the stack and write synchronously.
+        char out_message[LOG_RECORD_MESSAGE_SIZE];
+        logger_format(out_message, sizeof(out_message), level, message, arg_ptr);
+        va_end(arg_ptr);
+        logger_write(level, out_message);
         return;
     }
 
-    // Prepend the log level string to the buffer.
-    size_t prefix_len = snprintf(out_message, sizeof(out_message), "%s", level_strings[level]);
-    prefix_len = CLAMP(prefix_len, 0, sizeof(out_message) - 1);
+    // Format straight into the claimed record; no intermediate copy.
+    u64 pos;
+    log_record* record = logger_claim(&pos);
+    record->type = LOG_RECORD_TYPE_TEXT;
+    record->timestamp = platform_get_absolute_time();
+    record->format = 0;
+    record->level = level;
+    record->length = logger_format(record->message, sizeof(record->message), level, message, arg_ptr);
+    va_end(arg_ptr);
+    logger_publish(pos);
+
+    // Make sure fatal entries reach the console before the application goes down.
+    if (level == LOG_LEVEL_FATAL) {
+        logger_flush();
+    }
+}
+
+
+
+/**
+ * @brief Queues a log entry whose formatting is deferred to the writer thread.
+ *
+ * Instead of running vsnprintf on the calling thread, this scans `format` only to pull
+ * each argument off the list as its exact type, and stores the raw values (copying
+ * strings) in the record together with the format pointer, level and timestamp. The
+ * writer thread turns the record into the same text log_output would have produced.
+ *
+ * @note `format` must remain valid until the entry is written, so it must be a string literal.
+ * Specifiers that cannot be deferred (such as "%n") end the entry at that point.
+ *
+ * @param level The log_level of the message.
+ * @param format The format string. Must be a string literal.
+ * @param ... Variadic arguments corresponding to the format specifiers in the message.
+ */
+void log_output_deferred(log_level level, const char* format, ...) {
+    if (level > katomic_load(&runtime_level, KATOMIC_RELAXED)) {
+        return;
+    }
 
-    // Process the variadic arguments and format the original message.
     __builtin_va_list arg_ptr;
-    va_start(arg_ptr, message);
-    size_t msg_len = (size_t)vsnprintf(out_message + prefix_len, sizeof(out_message) - prefix_len, message, arg_ptr);
-    msg_len = CLAMP(msg_len, 0, sizeof(out_message) - prefix_len - 1);
+    va_start(arg_ptr, format);
+
+    if (!katomic_load(&state.initialized, KATOMIC_ACQUIRE)) {
+        // No writer thread to defer to; format on the stack and write synchronously.
+        char out_message[LOG_RECORD_MESSAGE_SIZE];
+        logger_format(out_message, sizeof(out_message), level, format, arg_ptr);
+        va_end(arg_ptr);
+        logger_write(level, out_message);
+        return;
+    }
+
+    u64 pos;
+    log_record* record = logger_claim(&pos);
+    record->type = LOG_RECORD_TYPE_DEFERRED;
+    record->timestamp = platform_get_absolute_time();
+    record->format = format;
+    record->level = level;
+    record->length = logger_encode_args(record->message, sizeof(record->message), format, arg_ptr);
     va_end(arg_ptr);
-    
-    // Ensure the message is properly null-terminated and has a newline.
-    size_t total_len = prefix_len + msg_len;
-    total_len = CLAMP(total_len, 0, sizeof(out_message) - 2);
-    out_message[total_len] = '\n';
-    out_message[total_len + 1] = '\0';
+    logger_publish(pos);
 
-    // Platform-specific output
-    if (is_error) {
-        platform_console_write_error(out_message, level);
-    } else {
-        platform_console_write(out_message, level);
+    if (level == LOG_LEVEL_FATAL) {
+        logger_flush();
+    }
+}
+
+
+
+/**
+ * @brief Sets the most verbose level that is output at runtime.
+ * @param level The most verbose level to output.
+ */
+void log_set_level(log_level level) {
+    katomic_store(&runtime_level, level, KATOMIC_RELAXED);
+}
+
+
+/**
+ * @brief Gets the most verbose level that is output at runtime.
+ * @return The current runtime log level.
+ */
+log_level log_get_level() {
+    return katomic_load(&runtime_level, KATOMIC_RELAXED);
+}
+
+
+/**
+ * @brief Enables or disables console output.
+ * @param enabled TRUE to write entries to the console, FALSE to skip it.
+ */
+void log_set_console_enabled(b8 enabled) {
+    katomic_store(&console_enabled, enabled, KATOMIC_RELAXED);
+}
+
+
+/**
+ * @brief Blocks until every entry logged so far has been written out.
+ */
+void log_flush() {
+    if (katomic_load(&state.initialized, KATOMIC_ACQUIRE)) {
+        logger_flush();
     }
 }
 
@@ -33,6 +33,24 @@
 #define LOG_TRACE_ENABLED 0
 #endif
 
+/**
+ * @brief Switch to route the logging macros through log_output_deferred.
+ *
+ * When enabled, the K* macros no longer format on the calling thread. They record the
+ * format string pointer, level, timestamp and raw argument bytes, and the writer thread
+ * formats the entry later. This makes high-frequency KTRACE cheap enough to leave on,
+ * so it is enabled by default in profiling builds, i.e. those built with KPROFILE_BUILD
+ * defined to 1. Other builds format on the calling thread. Define it to 0 or 1 on the
+ * command line to override.
+ */
+#ifndef LOG_DEFERRED_FORMAT_ENABLED
+    #if defined(KPROFILE_BUILD) && KPROFILE_BUILD == 1
+        #define LOG_DEFERRED_FORMAT_ENABLED 1
+    #else
+        #define LOG_DEFERRED_FORMAT_ENABLED 0
+    #endif
+#endif
+
 /**
  * @enum log_level
  * @brief Represents the verbosity level of a log message.
@@ -60,20 +78,59 @@ typedef enum log_level {
 /**
  * @brief Initializes the logging system.
  *
- * This function sets up the logging system. In the future, this will handle
- * tasks like creating and opening a log file.
+ * This function opens the log file (console.log), sets up the log queue and
+ * starts the background writer thread that performs all console and file
+ * output. File writes are batched into 64 KiB buffers that are flushed when
+ * full, after a short interval, or on a fatal entry. Entries logged before
+ * this is called are written synchronously to the console only.
  * @return b8 Returns TRUE if initialization was successful; otherwise, FALSE.
  */
-b8 initialize_logging();
+KAPI b8 initialize_logging();
 
 
 /**
  * @brief Shuts down the logging system.
  *
- * Performs any necessary cleanup. In the future, this will handle tasks like
- * writing any queued log entries to disk and closing the log file.
+ * Flushes every queued log entry, writes the file buffer to disk, closes the
+ * log file and stops the background writer thread. Entries logged afterwards
+ * are written synchronously to the console only.
+ */
+KAPI void shutdown_logging();
+
+
+/**
+ * @brief Sets the most verbose log level that is output at runtime.
+ *
+ * Entries above this level are dropped at the top of log_output, before any
+ * formatting. This complements the compile-time LOG_*_ENABLED switches.
+ * @param level The most verbose level to output (e.g. LOG_LEVEL_INFO drops DEBUG and TRACE).
+ */
+KAPI void log_set_level(log_level level);
+
+
+/**
+ * @brief Gets the most verbose log level that is output at runtime.
+ * @return The current runtime log level.
  */
-void shutdown_logging();
+KAPI log_level log_get_level();
+
+
+/**
+ * @brief Enables or disables console output. File output is unaffected.
+ *
+ * Useful for tools such as benchmarks that log heavily and should measure the
+ * logger rather than the terminal. Console output is enabled by default.
+ * @param enabled TRUE to write entries to the console, FALSE to skip it.
+ */
+KAPI void log_set_console_enabled(b8 enabled);
+
+
+/**
+ * @brief Blocks until every entry logged so far has been written out by the writer thread.
+ *
+ * Returns immediately if logging is not initialized, as entries are then written synchronously.
+ */
+KAPI void log_flush();
 
 
 /**
@@ -88,12 +145,33 @@ void shutdown_logging();
 KAPI void log_output(log_level level, const char* message, ...);
 
 
+/**
+ * @brief Outputs a log message whose formatting is deferred to the log writer thread.
+ * @note This function is not intended to be called directly. The logging macros use it
+ * when LOG_DEFERRED_FORMAT_ENABLED is 1.
+ *
+ * @param level The log_level of the message.
+ * @param message The message format string. Must be a string literal, as only the pointer is stored.
+ * @param ... Variadic arguments corresponding to the format specifiers in the message.
+ */
+KAPI void log_output_deferred(log_level level, const char* message, ...);
+
+
+#if LOG_DEFERRED_FORMAT_ENABLED == 1
+/** @brief The function the logging macros output through. */
+#define KLOG_OUTPUT log_output_deferred
+#else
+/** @brief The function the logging macros output through. */
+#define KLOG_OUTPUT log_output
+#endif
+
+
 /**
  * @brief Logs a fatal-level message. Application will terminate.
  * @param message The message format string.
  * @param ... Variadic arguments for the format string.
  */
-#define KFATAL(message, ...) log_output(LOG_LEVEL_FATAL, message, ##__VA_ARGS__);
+#define KFATAL(message, ...) KLOG_OUTPUT(LOG_LEVEL_FATAL, message, ##__VA_ARGS__);
 
 
 #ifndef KERROR
@@ -102,7 +180,7 @@ KAPI void log_output(log_level level, const char* message, ...);
  * @param message The message format string.
  * @param ... Variadic arguments for the format string.
  */
-#define KERROR(message, ...) log_output(LOG_LEVEL_ERROR, message, ##__VA_ARGS__);
+#define KERROR(message, ...) KLOG_OUTPUT(LOG_LEVEL_ERROR, message, ##__VA_ARGS__);
 #endif
 
 
@@ -112,7 +190,7 @@ KAPI void log_output(log_level level, const char* message, ...);
  * @param message The message format string.
  * @param ... Variadic arguments for the format string.
  */
-#define KWARN(message, ...) log_output(LOG_LEVEL_WARN, message, ##__VA_ARGS__);
+#define KWARN(message, ...) KLOG_OUTPUT(LOG_LEVEL_WARN, message, ##__VA_ARGS__);
 #else
 /** @brief Compiles to nothing when LOG_WARN_ENABLED is not 1. */
 #define KWARN(message, ...)
@@ -124,7 +202,7 @@ KAPI void log_output(log_level level, const char* message, ...);
  * @param message The message format string.
  * @param ... Variadic arguments for the format string.
  */
-#define KINFO(message, ...) log_output(LOG_LEVEL_INFO, message, ##__VA_ARGS__);
+#define KINFO(message, ...) KLOG_OUTPUT(LOG_LEVEL_INFO, message, ##__VA_ARGS__);
 #else
 /** @brief Compiles to nothing when LOG_INFO_ENABLED is not 1. */
 #define KINFO(message, ...)
@@ -136,7 +214,7 @@ KAPI void log_output(log_level level, const char* message, ...);
  * @param message The message format string.
  * @param ... Variadic arguments for the format string.
  */
-#define KDEBUG(message, ...) log_output(LOG_LEVEL_DEBUG, message, ##__VA_ARGS__);
+#define KDEBUG(message, ...) KLOG_OUTPUT(LOG_LEVEL_DEBUG, message, ##__VA_ARGS__);
 #else
 /** @brief Compiles to nothing when LOG_DEBUG_ENABLED is not 1. */
 #define KDEBUG(message, ...)
@@ -148,7 +226,7 @@ KAPI void log_output(log_level level, const char* message, ...);
  * @param message The message format string.
  * @param ... Variadic arguments for the format string.
  */
-#define KTRACE(message, ...) log_output(LOG_LEVEL_TRACE, message, ##__VA_ARGS__);
+#define KTRACE(message, ...) KLOG_OUTPUT(LOG_LEVEL_TRACE, message, ##__VA_ARGS__);
 #else
 /** @brief Compiles to nothing when LOG_TRACE_ENABLED is not 1. */
 #define KTRACE(message, ...)
@@ -0,0 +1,179 @@
+/**
+ * @file pool_allocator.c
+ * @brief This file contains the implementation of the engine's fixed-size pool allocator.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "pool_allocator.h"
+
+#include "core/logger.h"
+#include "core/asserts.h"
+
+/** @brief The chunk alignment used when the config does not provide one. */
+#define POOL_ALLOCATOR_DEFAULT_ALIGNMENT 16
+
+/**
+ * @struct pool_block
+ * @brief The header placed at the start of every block reserved by a pool.
+ * Chunks begin after the header, at the next boundary of the block's alignment.
+ */
+typedef struct pool_block {
+    /** @brief The next block owned by the same pool. */
+    struct pool_block* next;
+
+    /** @brief The size of the whole block, including this header. */
+    u64 size;
+
+    /** @brief The number of chunks in this block. */
+    u64 count;
+} pool_block;
+
+/** @brief The alignment of a pool's blocks: a cache line, or the chunk alignment if that is larger. */
+#define POOL_BLOCK_ALIGNMENT(allocator) ((allocator)->alignment > KCACHE_LINE_SIZE ? (allocator)->alignment : KCACHE_LINE_SIZE)
+
+/** @brief The space reserved for the block header. Keeps the first chunk aligned like the block. */
+#define POOL_BLOCK_HEADER_SIZE(allocator) KALIGN_UP(sizeof(pool_block), POOL_BLOCK_ALIGNMENT(allocator))
+
+/**
+ * @brief Reserves a new block of `count` chunks and pushes them onto the free list.
+ * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+ */
+static b8 pool_allocator_add_block(pool_allocator* allocator, u64 count) {
+    u64 block_size = POOL_BLOCK_HEADER_SIZE(allocator) + allocator->chunk_size * count;
+
+    // Blocks are at least cache-line aligned so the chunks inside never straddle lines unnecessarily.
+    pool_block* block = kallocate_aligned(block_size, POOL_BLOCK_ALIGNMENT(allocator), allocator->tag);
+    if (!block) {
+        return FALSE;
+    }
+
+    block->next = allocator->blocks;
+    block->size = block_size;
+    block->count = count;
+    allocator->blocks = block;
+
+    // Thread the chunks together back to front, so allocations walk the block in address order.
+    u8* chunks = ((u8*)block) + POOL_BLOCK_HEADER_SIZE(allocator);
+    for (u64 i = count; i > 0; --i) {
+        void** chunk = (void**)(chunks + (i - 1) * allocator->chunk_size);
+        *chunk = allocator->free_list;
+        allocator->free_list = chunk;
+    }
+
+    allocator->last_block_count = count;
+    allocator->stats.capacity += count;
+    allocator->stats.block_count++;
+    allocator->stats.reserved_bytes += block_size;
+    return TRUE;
+}
+
+b8 pool_allocator_create(const pool_allocator_config* config, pool_allocator* out_allocator) {
+    if (!config || !out_allocator) {
+        KERROR("pool_allocator_create requires a valid config and out_allocator.");
+        return FALSE;
+    }
+
+    if (config->element_size == 0 || config->element_count == 0) {
+        KERROR("pool_allocator_create requires a non-zero element_size and element_count.");
+        return FALSE;
+    }
+
+    u16 alignment = config->alignment ? config->alignment : POOL_ALLOCATOR_DEFAULT_ALIGNMENT;
+    if (!KIS_POWER_OF_TWO(alignment)) {
+        KERROR("pool_allocator_create - alignment %u is not a power of two.", alignment);
+        return FALSE;
+    }
+
+    kzero_memory(out_allocator, sizeof(pool_allocator));
+
+    // A free chunk stores the free-list link in place, so it must fit at least a pointer.
+    u64 element_size = config->element_size < sizeof(void*) ? sizeof(void*) : config->element_size;
+    out_allocator->chunk_size = KALIGN_UP(element_size, alignment);
+    out_allocator->alignment = alignment;
+    out_allocator->growth = config->growth;
+    out_allocator->tag = config->tag;
+
+    if (!pool_allocator_add_block(out_allocator, config->element_count)) {
+        KERROR("pool_allocator_create - failed to reserve the initial block.");
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+void pool_allocator_destroy(pool_allocator* allocator) {
+    if (!allocator) {
+        return;
+    }
+
+    pool_block* block = allocator->blocks;
+    while (block) {
+        pool_block* next = block->next;
+        kfree_aligned(block, block->size, POOL_BLOCK_ALIGNMENT(allocator), allocator->tag);
+        block = next;
+    }
+
+    kzero_memory(allocator, sizeof(pool_allocator));
+}
+
+void* pool_allocator_allocate(pool_allocator* allocator) {
+    if (!allocator->free_list) {
+        if (allocator->growth == POOL_GROWTH_NONE) {
+            KERROR("pool_allocator_allocate - pool exhausted (%llu chunks) and growth is disabled.", allocator->stats.capacity);
+            return 0;
+        }
+
+        u64 count = allocator->growth == POOL_GROWTH_DOUBLE ? allocator->last_block_count * 2 : allocator->last_block_count;
+        if (!pool_allocator_add_block(allocator, count)) {
+            KERROR("pool_allocator_allocate - failed to grow the pool.");
+            return 0;
+        }
+    }
+
+    // Pop the head of the free list.
+    void** chunk = (void**)allocator->free_list;
+    allocator->free_list = *chunk;
+
+    allocator->stats.in_use++;
+    if (allocator->stats.in_use > allocator->stats.peak_in_use) {
+        allocator->stats.peak_in_use = allocator->stats.in_use;
+    }
+
+    return chunk;
+}
+
+void pool_allocator_free(pool_allocator* allocator, void* block) {
+    if (!block) {
+        return;
+    }
+
+    KASSERT_DEBUG(allocator->stats.in_use > 0);
+
+    // Push the chunk back onto the head of the free list.
+    void** chunk = (void**)block;
+    *chunk = allocator->free_list;
+    allocator->free_list = chunk;
+
+    allocator->stats.in_use--;
+}
+
+void pool_allocator_free_all(pool_allocator* allocator) {
+    // Rebuild the free list over every block in address order.
+    allocator->free_list = 0;
+    pool_block* block = allocator->blocks;
+    while (block) {
+        u8* chunks = ((u8*)block) + POOL_BLOCK_HEADER_SIZE(allocator);
+        for (u64 i = block->count; i > 0; --i) {
+            void** chunk = (void**)(chunks + (i - 1) * allocator->chunk_size);
+            *chunk = allocator->free_list;
+            allocator->free_list = chunk;
+        }
+        block = block->next;
+    }
+
+    allocator->stats.in_use = 0;
+}
+
+void pool_allocator_get_stats(const pool_allocator* allocator, pool_allocator_stats* out_stats) {
+    *out_stats = allocator->stats;
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+/**
+ * @file pool_allocator.h
+ * @brief This file contains the declarations for the engine's fixed-size pool allocator.
+ *
+ * @details A pool allocator hands out fixed-size chunks from large, contiguous blocks.
+ * Free chunks are linked together through an intrusive free list stored inside the
+ * chunks themselves, so both allocation and free are O(1) pointer operations with no
+ * heap calls. This is intended for hot, same-sized objects that are created and
+ * destroyed at a high rate (entities, transforms, job nodes, etc.).
+ * @copyright Copyright (c) 2025
+ */
+
+#include "defines.h"
+#include "core/kmemory.h"
+
+/**
+ * @enum pool_allocator_growth
+ * @brief Determines what a pool allocator does once every chunk is in use.
+ */
+typedef enum pool_allocator_growth {
+    /** @brief The pool never grows. Allocations fail once it is exhausted. */
+    POOL_GROWTH_NONE,
+
+    /** @brief A new block with the same number of chunks as the first block is added. */
+    POOL_GROWTH_LINEAR,
+
+    /** @brief A new block with twice as many chunks as the previous block is added. */
+    POOL_GROWTH_DOUBLE
+} pool_allocator_growth;
+
+
+/**
+ * @struct pool_allocator_config
+ * @brief The configuration used to create a pool allocator.
+ */
+typedef struct pool_allocator_config {
+    /** @brief The size of a single element in bytes. */
+    u64 element_size;
+
+    /** @brief The number of elements the first block holds. */
+    u64 element_count;
+
+    /** @brief The alignment of every chunk. Must be a power of two. 0 uses the default (16). */
+    u16 alignment;
+
+    /** @brief What to do once the pool is exhausted. */
+    pool_allocator_growth growth;
+
+    /** @brief The `memory_tag` every block of this pool is tracked under. */
+    memory_tag tag;
+} pool_allocator_config;
+
+
+/**
+ * @struct pool_allocator_stats
+ * @brief A snapshot of a pool allocator's usage.
+ */
+typedef struct pool_allocator_stats {
+    /** @brief The total number of chunks across all blocks. */
+    u64 capacity;
+
+    /** @brief The number of chunks currently handed out. */
+    u64 in_use;
+
+    /** @brief The highest number of chunks ever handed out at once. */
+    u64 peak_in_use;
+
+    /** @brief The number of blocks reserved by the pool. */
+    u32 block_count;
+
+    /** @brief The total number of bytes reserved by the pool, including block headers and padding. */
+    u64 reserved_bytes;
+} pool_allocator_stats;
+
+
+/**
+ * @struct pool_allocator
+ * @brief Holds the state of a single pool allocator.
+ */
+typedef struct pool_allocator {
+    /** @brief The size of each chunk: the element size rounded up to the alignment. */
+    u64 chunk_size;
+
+    /** @brief The alignment of each chunk. */
+    u16 alignment;
+
+    /** @brief The number of chunks the most recently added block holds. */
+    u64 last_block_count;
+
+    /** @brief The growth policy of the pool. */
+    pool_allocator_growth growth;
+
+    /** @brief The tag blocks are allocated with. */
+    memory_tag tag;
+
+    /** @brief The head of the intrusive free list. */
+    void* free_list;
+
+    /** @brief The head of the linked list of blocks owned by the pool. */
+    void* blocks;
+
+    /** @brief Usage statistics for the pool. */
+    pool_allocator_stats stats;
+} pool_allocator;
+
+
+/**
+ * @brief Creates a pool allocator and reserves its first block.
+ * @param config A pointer to the configuration of the pool.
+ * @param out_allocator A pointer to the pool_allocator to be initialized.
+ * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+ */
+KAPI b8 pool_allocator_create(const pool_allocator_config* config, pool_allocator* out_allocator);
+
+
+/**
+ * @brief Destroys the given pool allocator and releases every block it owns.
+ * @param allocator A pointer to the allocator to be destroyed.
+ */
+KAPI void pool_allocator_destroy(pool_allocator* allocator);
+
+
+/**
+ * @brief Takes a single chunk from the pool.
+ * @note The returned memory is NOT zeroed.
+ * @param allocator A pointer to the allocator to allocate from.
+ * @return A pointer to a chunk of at least `element_size` bytes, or 0 if the pool is exhausted and cannot grow.
+ */
+KAPI void* pool_allocator_allocate(pool_allocator* allocator);
+
+
+/**
+ * @brief Returns a chunk to the pool.
+ * @param allocator A pointer to the allocator the chunk was taken from.
+ * @param block A pointer to the chunk to return.
+ */
+KAPI void pool_allocator_free(pool_allocator* allocator, void* block);
+
+
+/**
+ * @brief Returns every chunk to the pool at once, keeping all reserved blocks.
+ * @param allocator A pointer to the allocator to reset.
+ */
+KAPI void pool_allocator_free_all(pool_allocator* allocator);
+
+
+/**
+ * @brief Gets a snapshot of the pool's usage statistics.
+ * @param allocator A pointer to the allocator.
+ * @param out_stats A pointer to the structure to be filled out.
+ */
+KAPI void pool_allocator_get_stats(const pool_allocator* allocator, pool_allocator_stats* out_stats);
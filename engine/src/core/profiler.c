@@ -0,0 +1,541 @@
+/**
+ * @file profiler.c
+ * @brief This file contains the implementation of the engine's CPU frame profiler.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "profiler.h"
+
+#if KPROFILER_ENABLED == 1
+
+#include "core/logger.h"
+#include "core/kmemory.h"
+#include "core/katomic.h"
+#include "core/kstring.h"
+#include "platform/platform.h"
+
+/** @brief The maximum number of threads that can record zones. Zones of further threads are dropped. */
+#define PROFILER_MAX_THREADS 16
+
+/** @brief The number of zones each thread's ring holds. Must be a power of two. */
+#define PROFILER_RING_CAPACITY 8192
+
+/** @brief The maximum nesting depth of zones on a single thread. Deeper zones are ignored. */
+#define PROFILER_MAX_DEPTH 32
+
+/** @brief The maximum number of distinct zone names tracked in the per-frame summaries. */
+#define PROFILER_MAX_ZONE_STATS 128
+
+/** @brief The size of the buffer used to batch writes of the Chrome trace file. */
+#define PROFILER_TRACE_BUFFER_SIZE (64 * 1024)
+
+/**
+ * @struct profiler_zone
+ * @brief A single completed zone, as stored in a thread's ring.
+ */
+typedef struct profiler_zone {
+    /** @brief The name of the zone. The pointer is stored, never the string. */
+    const char* name;
+
+    /** @brief The platform tick value when the zone was opened. */
+    u64 start;
+
+    /** @brief The platform tick value when the zone was closed. */
+    u64 end;
+
+    /** @brief How many zones were open on the thread when this one was opened. */
+    u32 depth;
+} profiler_zone;
+
+/**
+ * @struct profiler_thread_ring
+ * @brief The ring of completed zones written by a single thread.
+ * @details Only the owning thread writes `zones` and `head`. The main thread reads them
+ * during profiler_frame_end, so `head` is published with release semantics after the zone
+ * it covers is written. Rings sit on their own cache lines to avoid false sharing.
+ */
+typedef struct KALIGN(KCACHE_LINE_SIZE) profiler_thread_ring {
+    /** @brief The total number of zones ever written. The write index is `head % PROFILER_RING_CAPACITY`. */
+    u64 head;
+
+    /** @brief The value of `head` up to which the main thread has accumulated zones. Main thread only. */
+    u64 collected;
+
+    /** @brief The platform thread id of the owner, used as the Chrome trace `tid`. */
+    u64 thread_id;
+
+    /** @brief The zone storage, PROFILER_RING_CAPACITY entries. */
+    profiler_zone* zones;
+} profiler_thread_ring;
+
+/**
+ * @struct profiler_zone_stat
+ * @brief The summary statistics for all zones sharing a name.
+ */
+typedef struct profiler_zone_stat {
+    /** @brief The name of the zone. */
+    const char* name;
+
+    /** @brief The ticks spent in the zone during the current frame. */
+    u64 frame_ticks;
+
+    /** @brief The number of times the zone was entered during the current frame. */
+    u64 frame_calls;
+
+    /** @brief The fewest ticks spent in the zone during a single frame of the summary window. */
+    u64 min_ticks;
+
+    /** @brief The most ticks spent in the zone during a single frame of the summary window. */
+    u64 max_ticks;
+
+    /** @brief The ticks spent in the zone across the summary window. */
+    u64 total_ticks;
+
+    /** @brief The number of times the zone was entered across the summary window. */
+    u64 total_calls;
+
+    /** @brief The number of frames of the summary window in which the zone was entered. */
+    u32 frames;
+} profiler_zone_stat;
+
+/**
+ * @struct profiler_state
+ * @brief The global state of the profiler.
+ */
+typedef struct profiler_state {
+    /** @brief Indicates if the profiler has been initialized. Zones recorded before then are dropped. */
+    b8 initialized;
+
+    /** @brief The number of ring slots handed out to threads so far. */
+    u32 next_thread;
+
+    /** @brief The tick frequency, cached at initialization. */
+    u64 tick_frequency;
+
+    /** @brief The tick value at initialization. Chrome trace timestamps are relative to it. */
+    u64 start_ticks;
+
+    /** @brief The tick value at the start of the current frame. */
+    u64 frame_start;
+
+    /** @brief Frame time statistics over the summary window, tracked like a zone. */
+    profiler_zone_stat frame_stat;
+
+    /** @brief The number of frames accumulated into the current summary window. */
+    u32 summary_frames;
+
+    /** @brief The number of distinct zone names in `zone_stats`. */
+    u32 zone_stat_count;
+
+    /** @brief Per-name zone statistics. Main thread only. */
+    profiler_zone_stat zone_stats[PROFILER_MAX_ZONE_STATS];
+
+    /** @brief One ring per recording thread. */
+    profiler_thread_ring rings[PROFILER_MAX_THREADS];
+
+    /** @brief The single block backing all rings. */
+    profiler_zone* zone_memory;
+} profiler_state;
+
+/**
+ * @struct profiler_thread_state
+ * @brief The per-thread stack of currently open zones.
+ */
+typedef struct profiler_thread_state {
+    /** @brief The index of this thread's ring, -1 if not yet assigned and -2 if none was available. */
+    i32 ring_index;
+
+    /** @brief The number of currently open zones. May exceed PROFILER_MAX_DEPTH; deeper zones are not recorded. */
+    u32 depth;
+
+    /** @brief The names of the open zones. */
+    const char* names[PROFILER_MAX_DEPTH];
+
+    /** @brief The start ticks of the open zones. */
+    u64 starts[PROFILER_MAX_DEPTH];
+} profiler_thread_state;
+
+// Static so the profiler needs no allocation before its rings are reserved.
+static profiler_state state;
+
+// The open zones of the calling thread.
+static KTHREAD_LOCAL profiler_thread_state thread_state = {.ring_index = -1, .depth = 0, .names = {0}, .starts = {0}};
+
+b8 profiler_initialize() {
+    u64 ring_bytes = sizeof(profiler_zone) * PROFILER_RING_CAPACITY;
+
+    // One block for every ring. Zones are always written before they are read, so skip zeroing.
+    state.zone_memory = kallocate_uninit(ring_bytes * PROFILER_MAX_THREADS, MEMORY_TAG_PROFILER);
+    if (!state.zone_memory) {
+        KERROR("profiler_initialize - failed to reserve the zone rings.");
+        return FALSE;
+    }
+
+    for (u32 i = 0; i < PROFILER_MAX_THREADS; ++i) {
+        state.rings[i].head = 0;
+        state.rings[i].collected = 0;
+        state.rings[i].thread_id = 0;
+        state.rings[i].zones = state.zone_memory + (u64)i * PROFILER_RING_CAPACITY;
+    }
+
+    state.next_thread = 0;
+    state.zone_stat_count = 0;
+    state.summary_frames = 0;
+    kzero_memory(&state.frame_stat, sizeof(profiler_zone_stat));
+    state.frame_stat.name = "frame";
+    state.tick_frequency = platform_get_tick_frequency();
+    state.start_ticks = platform_get_ticks();
+    state.frame_start = state.start_ticks;
+
+    katomic_store(&state.initialized, TRUE, KATOMIC_RELEASE);
+    return TRUE;
+}
+
+void profiler_shutdown() {
+    katomic_store(&state.initialized, FALSE, KATOMIC_RELEASE);
+
+    if (state.zone_memory) {
+        kfree(state.zone_memory, sizeof(profiler_zone) * PROFILER_RING_CAPACITY * PROFILER_MAX_THREADS, MEMORY_TAG_PROFILER);
+        state.zone_memory = 0;
+    }
+}
+
+/**
+ * @brief Gets the ring of the calling thread, assigning one on first use.
+ * @return A pointer to the ring, or 0 if every ring is taken.
+ */
+static profiler_thread_ring* profiler_thread_ring_get() {
+    if (thread_state.ring_index == -1) {
+        u32 index = katomic_fetch_add(&state.next_thread, 1, KATOMIC_RELAXED);
+        if (index < PROFILER_MAX_THREADS) {
+            thread_state.ring_index = (i32)index;
+            state.rings[index].thread_id = platform_current_thread_id();
+        } else {
+            KWARN("Profiler supports at most %u threads. Zones of further threads are dropped.", PROFILER_MAX_THREADS);
+            thread_state.ring_index = -2;
+        }
+    }
+
+    return thread_state.ring_index >= 0 ? &state.rings[thread_state.ring_index] : 0;
+}
+
+void profiler_zone_begin(const char* name) {
+    u32 depth = thread_state.depth++;
+    if (depth < PROFILER_MAX_DEPTH) {
+        thread_state.names[depth] = name;
+        thread_state.starts[depth] = platform_get_ticks();
+    }
+}
+
+void profiler_zone_end() {
+    u64 end = platform_get_ticks();
+
+    if (thread_state.depth == 0) {
+        KWARN("profiler_zone_end called without a matching profiler_zone_begin.");
+        return;
+    }
+
+    u32 depth = --thread_state.depth;
+    if (depth >= PROFILER_MAX_DEPTH || !katomic_load(&state.initialized, KATOMIC_ACQUIRE)) {
+        return;
+    }
+
+    profiler_thread_ring* ring = profiler_thread_ring_get();
+    if (!ring) {
+        return;
+    }
+
+    // Single writer: write the zone, then publish it by advancing the head.
+    u64 head = ring->head;
+    profiler_zone* zone = &ring->zones[head & (PROFILER_RING_CAPACITY - 1)];
+    zone->name = thread_state.names[depth];
+    zone->start = thread_state.starts[depth];
+    zone->end = end;
+    zone->depth = depth;
+    katomic_store(&ring->head, head + 1, KATOMIC_RELEASE);
+}
+
+void profiler_frame_begin() {
+    state.frame_start = platform_get_ticks();
+}
+
+/**
+ * @brief Finds the summary entry for the given zone name, adding one if needed.
+ * @return A pointer to the entry, or 0 if the table is full.
+ */
+static profiler_zone_stat* profiler_find_zone_stat(const char* name) {
+    // Names are usually string literals, so a pointer compare almost always hits first.
+    for (u32 i = 0; i < state.zone_stat_count; ++i) {
+        if (state.zone_stats[i].name == name) {
+            return &state.zone_stats[i];
+        }
+    }
+
+    // The same literal may have different addresses in different translation units.
+    for (u32 i = 0; i < state.zone_stat_count; ++i) {
+        if (kstring_equal(kstring_from_cstr(state.zone_stats[i].name), kstring_from_cstr(name))) {
+            return &state.zone_stats[i];
+        }
+    }
+
+    if (state.zone_stat_count == PROFILER_MAX_ZONE_STATS) {
+        return 0;
+    }
+
+    profiler_zone_stat* stat = &state.zone_stats[state.zone_stat_count++];
+    kzero_memory(stat, sizeof(profiler_zone_stat));
+    stat->name = name;
+    return stat;
+}
+
+/**
+ * @brief Folds the current frame's totals of a stat into its summary window.
+ */
+static void profiler_stat_close_frame(profiler_zone_stat* stat) {
+    if (stat->frame_calls == 0) {
+        return;
+    }
+
+    if (stat->frames == 0 || stat->frame_ticks < stat->min_ticks) {
+        stat->min_ticks = stat->frame_ticks;
+    }
+    if (stat->frame_ticks > stat->max_ticks) {
+        stat->max_ticks = stat->frame_ticks;
+    }
+
+    stat->total_ticks += stat->frame_ticks;
+    stat->total_calls += stat->frame_calls;
+    stat->frames++;
+    stat->frame_ticks = 0;
+    stat->frame_calls = 0;
+}
+
+/**
+ * @brief Converts a tick count into milliseconds.
+ */
+static f64 profiler_ticks_to_ms(u64 ticks) {
+    return (f64)ticks * 1000.0 / (f64)state.tick_frequency;
+}
+
+/**
+ * @brief Logs a single line of the summary for the given stat.
+ */
+static void profiler_log_stat(const profiler_zone_stat* stat) {
+    if (stat->frames == 0) {
+        return;
+    }
+
+    KDEBUG("  %-28s min %8.3fms  avg %8.3fms  max %8.3fms  calls/frame %6.1f",
+           stat->name,
+           profiler_ticks_to_ms(stat->min_ticks),
+           profiler_ticks_to_ms(stat->total_ticks / stat->frames),
+           profiler_ticks_to_ms(stat->max_ticks),
+           (f64)stat->total_calls / (f64)stat->frames);
+}
+
+/**
+ * @brief Logs the summary of the current window and starts a new one.
+ */
+static void profiler_log_summary() {
+    KDEBUG("Profiler summary over the last %u frames:", state.summary_frames);
+    profiler_log_stat(&state.frame_stat);
+    for (u32 i = 0; i < state.zone_stat_count; ++i) {
+        profiler_log_stat(&state.zone_stats[i]);
+    }
+
+    // Keep the names, reset the numbers.
+    for (u32 i = 0; i < state.zone_stat_count; ++i) {
+        const char* name = state.zone_stats[i].name;
+        kzero_memory(&state.zone_stats[i], sizeof(profiler_zone_stat));
+        state.zone_stats[i].name = name;
+    }
+    kzero_memory(&state.frame_stat, sizeof(profiler_zone_stat));
+    state.frame_stat.name = "frame";
+    state.summary_frames = 0;
+}
+
+void profiler_frame_end() {
+    if (!state.initialized) {
+        return;
+    }
+
+    u64 frame_end = platform_get_ticks();
+    state.frame_stat.frame_ticks = frame_end - state.frame_start;
+    state.frame_stat.frame_calls = 1;
+    profiler_stat_close_frame(&state.frame_stat);
+
+    // Collect the zones completed since the last frame on every thread.
+    u32 thread_count = katomic_load(&state.next_thread, KATOMIC_RELAXED);
+    if (thread_count > PROFILER_MAX_THREADS) {
+        thread_count = PROFILER_MAX_THREADS;
+    }
+
+    for (u32 t = 0; t < thread_count; ++t) {
+        profiler_thread_ring* ring = &state.rings[t];
+        u64 head = katomic_load(&ring->head, KATOMIC_ACQUIRE);
+
+        // If the writer lapped the collector, the oldest zones are gone. Skip straight to what is left.
+        if (head - ring->collected > PROFILER_RING_CAPACITY) {
+            ring->collected = head - PROFILER_RING_CAPACITY;
+        }
+
+        for (u64 i = ring->collected; i < head; ++i) {
+            const profiler_zone* zone = &ring->zones[i & (PROFILER_RING_CAPACITY - 1)];
+            profiler_zone_stat* stat = profiler_find_zone_stat(zone->name);
+            if (stat) {
+                stat->frame_ticks += zone->end - zone->start;
+                stat->frame_calls++;
+            }
+        }
+        ring->collected = head;
+    }
+
+    for (u32 i = 0; i < state.zone_stat_count; ++i) {
+        profiler_stat_close_frame(&state.zone_stats[i]);
+    }
+
+    state.summary_frames++;
+    if (state.summary_frames >= PROFILER_SUMMARY_FRAMES) {
+        profiler_log_summary();
+    }
+}
+
+/**
+ * @brief Appends text to the trace buffer, flushing it to the file first if it would not fit.
+ * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+ */
+static b8 profiler_trace_append(platform_file* file, char* buffer, u64* used, const char* text, u64 length) {
+    if (*used + length > PROFILER_TRACE_BUFFER_SIZE) {
+        u64 written = 0;
+        if (!platform_file_write(file, buffer, *used, &written) || written != *used) {
+            return FALSE;
+        }
+        *used = 0;
+    }
+
+    kcopy_memory(buffer + *used, text, length);
+    *used += length;
+    return TRUE;
+}
+
+/**
+ * @brief Copies a zone name into `out`, escaped for use inside a JSON string.
+ * @details Quotes and backslashes are escaped and control characters written as \u00XX.
+ * A name too long for `out` is truncated, never in the middle of an escape.
+ */
+static void profiler_json_escape(const char* name, char* out, u64 out_size) {
+    static const char hex[] = "0123456789abcdef";
+    u64 used = 0;
+    for (const char* c = name; *c; ++c) {
+        u8 character = (u8)*c;
+        char escaped[6];
+        u64 length = 0;
+        if (character == '"' || character == '\\') {
+            escaped[length++] = '\\';
+            escaped[length++] = (char)character;
+        } else if (character < 0x20) {
+            escaped[length++] = '\\';
+            escaped[length++] = 'u';
+            escaped[length++] = '0';
+            escaped[length++] = '0';
+            escaped[length++] = hex[character >> 4];
+            escaped[length++] = hex[character & 0xF];
+        } else {
+            escaped[length++] = (char)character;
+        }
+
+        if (used + length >= out_size) {
+            break;
+        }
+        kcopy_memory(out + used, escaped, length);
+        used += length;
+    }
+    out[used] = 0;
+}
+
+b8 profiler_write_chrome_trace(const char* path) {
+    if (!state.initialized) {
+        KERROR("profiler_write_chrome_trace - profiler is not initialized.");
+        return FALSE;
+    }
+
+    char* buffer = kallocate_uninit(PROFILER_TRACE_BUFFER_SIZE, MEMORY_TAG_PROFILER);
+    if (!buffer) {
+        KERROR("profiler_write_chrome_trace - unable to allocate the %llu byte trace buffer.", (u64)PROFILER_TRACE_BUFFER_SIZE);
+        return FALSE;
+    }
+
+    platform_file file;
+    if (!platform_file_open(path, PLATFORM_FILE_MODE_WRITE, &file)) {
+        KERROR("profiler_write_chrome_trace - unable to open '%s'.", path);
+        kfree(buffer, PROFILER_TRACE_BUFFER_SIZE, MEMORY_TAG_PROFILER);
+        return FALSE;
+    }
+
+    u64 used = 0;
+    b8 success = TRUE;
+    b8 first = TRUE;
+    char line[512];
+    char name[256];
+
+    kstring header = KSTRING("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    success = profiler_trace_append(&file, buffer, &used, header.data, header.length);
+
+    u32 thread_count = katomic_load(&state.next_thread, KATOMIC_RELAXED);
+    if (thread_count > PROFILER_MAX_THREADS) {
+        thread_count = PROFILER_MAX_THREADS;
+    }
+
+    f64 ticks_to_us = 1000000.0 / (f64)state.tick_frequency;
+    for (u32 t = 0; t < thread_count && success; ++t) {
+        const profiler_thread_ring* ring = &state.rings[t];
+        u64 head = katomic_load(&ring->head, KATOMIC_ACQUIRE);
+        u64 first_zone = head > PROFILER_RING_CAPACITY ? head - PROFILER_RING_CAPACITY : 0;
+
+        for (u64 i = first_zone; i < head && success; ++i) {
+            const profiler_zone* zone = &ring->zones[i & (PROFILER_RING_CAPACITY - 1)];
+
+            // Zone names are arbitrary strings, so they must be escaped to keep the file valid JSON.
+            profiler_json_escape(zone->name, name, sizeof(name));
+
+            // Complete ("X") events: a start timestamp and a duration, both in microseconds.
+            u64 length = kstring_format_into(line, sizeof(line),
+                                             "%s{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":%llu}",
+                                             first ? "" : ",\n",
+                                             name,
+                                             (f64)(zone->start - state.start_ticks) * ticks_to_us,
+                                             (f64)(zone->end - zone->start) * ticks_to_us,
+                                             ring->thread_id);
+            // A line that filled the buffer may have been cut short; a cut event would break the JSON.
+            if (length == 0 || length >= sizeof(line) - 1) {
+                continue;
+            }
+
+            success = profiler_trace_append(&file, buffer, &used, line, length);
+            first = FALSE;
+        }
+    }
+
+    kstring footer = KSTRING("\n]}\n");
+    if (success) {
+        success = profiler_trace_append(&file, buffer, &used, footer.data, footer.length);
+    }
+
+    if (success && used > 0) {
+        u64 written = 0;
+        success = platform_file_write(&file, buffer, used, &written) && written == used;
+    }
+
+    kfree(buffer, PROFILER_TRACE_BUFFER_SIZE, MEMORY_TAG_PROFILER);
+    platform_file_close(&file);
+
+    if (!success) {
+        KERROR("profiler_write_chrome_trace - failed writing to '%s'.", path);
+        return FALSE;
+    }
+
+    KINFO("Profiler trace written to '%s'.", path);
+    return TRUE;
+}
+
+#endif
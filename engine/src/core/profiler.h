@@ -0,0 +1,137 @@
+#pragma once
+
+/**
+ * @file profiler.h
+ * @brief This file contains the engine's built-in CPU frame profiler.
+ *
+ * @details Zones are recorded with the KPROFILE_* macros into a ring buffer owned by the
+ * calling thread, so recording never takes a lock and never allocates. Each zone stores
+ * its name pointer and the raw platform tick values of its start and end.
+ *
+ * Once per frame, KPROFILE_FRAME_END collects the new zones of every thread and
+ * accumulates per-zone totals. Every PROFILER_SUMMARY_FRAMES frames the min/avg/max time
+ * per frame of each zone is logged. The most recent zones of every thread can also be
+ * written out as a Chrome trace (chrome://tracing, Perfetto) with profiler_write_chrome_trace.
+ *
+ * The whole profiler compiles out when KPROFILER_ENABLED is 0, which is the default for
+ * release builds (KRELEASE). The macros then expand to nothing.
+ *
+ * @copyright Copyright (c) 2025
+ */
+
+#include "defines.h"
+
+/**
+ * @brief Switch to enable or disable the profiler.
+ * Disabled by default in release builds. Define it to 0 or 1 on the command line to override.
+ */
+#ifndef KPROFILER_ENABLED
+    #if KRELEASE == 1
+        #define KPROFILER_ENABLED 0
+    #else
+        #define KPROFILER_ENABLED 1
+    #endif
+#endif
+
+/** @brief The number of frames the logged min/avg/max summaries cover. */
+#define PROFILER_SUMMARY_FRAMES 300
+
+#if KPROFILER_ENABLED == 1
+
+/**
+ * @brief Initializes the profiler and reserves the per-thread zone rings.
+ * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+ */
+KAPI b8 profiler_initialize();
+
+
+/**
+ * @brief Shuts down the profiler and releases its memory.
+ * @note No thread may record zones during or after shutdown.
+ */
+KAPI void profiler_shutdown();
+
+
+/**
+ * @brief Marks the start of a new frame.
+ * @note Must be called on the main thread.
+ */
+KAPI void profiler_frame_begin();
+
+
+/**
+ * @brief Marks the end of the current frame and accumulates the zones recorded during it.
+ * Logs a summary every PROFILER_SUMMARY_FRAMES frames.
+ * @note Must be called on the main thread.
+ */
+KAPI void profiler_frame_end();
+
+
+/**
+ * @brief Opens a zone on the calling thread. Must be paired with profiler_zone_end.
+ * @param name The name of the zone. Must point to a string that outlives the profiler (e.g. a string literal).
+ */
+KAPI void profiler_zone_begin(const char* name);
+
+
+/**
+ * @brief Closes the zone most recently opened on the calling thread and records it.
+ */
+KAPI void profiler_zone_end();
+
+
+/**
+ * @brief Writes the zones still held in every thread's ring to a Chrome trace JSON file.
+ * @param path The path of the file to write.
+ * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+ */
+KAPI b8 profiler_write_chrome_trace(const char* path);
+
+
+/**
+ * @brief The cleanup handler used by KPROFILE_SCOPE. Not intended to be called directly.
+ */
+static inline void profiler_scope_cleanup(u8* scope) {
+    (void)scope;
+    profiler_zone_end();
+}
+
+/** @brief Helpers that give every KPROFILE_SCOPE a unique variable name. */
+#define KPROFILE_CONCAT_INNER(a, b) a##b
+#define KPROFILE_CONCAT(a, b) KPROFILE_CONCAT_INNER(a, b)
+
+/**
+ * @brief Profiles the rest of the enclosing scope as a zone with the given name.
+ * The zone is closed automatically when the scope is left, including via return or break.
+ * @note Relies on the cleanup attribute, which clang (the engine's compiler on every platform) and GCC support.
+ */
+#define KPROFILE_SCOPE(name)                                                                         \
+    u8 KPROFILE_CONCAT(profiler_scope_, __LINE__) __attribute__((cleanup(profiler_scope_cleanup))) = \
+        (profiler_zone_begin(name), 0)
+
+/** @brief Opens a zone that must be closed with KPROFILE_ZONE_END. */
+#define KPROFILE_ZONE_BEGIN(name) profiler_zone_begin(name)
+
+/** @brief Closes the zone most recently opened with KPROFILE_ZONE_BEGIN. */
+#define KPROFILE_ZONE_END() profiler_zone_end()
+
+/** @brief Marks the start of a frame. */
+#define KPROFILE_FRAME_BEGIN() profiler_frame_begin()
+
+/** @brief Marks the end of a frame. */
+#define KPROFILE_FRAME_END() profiler_frame_end()
+
+#else
+
+/** @brief Compiles to nothing when KPROFILER_ENABLED is not 1. */
+#define KPROFILE_SCOPE(name)
+/** @brief Compiles to nothing when KPROFILER_ENABLED is not 1. */
+#define KPROFILE_ZONE_BEGIN(name)
+/** @brief Compiles to nothing when KPROFILER_ENABLED is not 1. */
+#define KPROFILE_ZONE_END()
+/** @brief Compiles to nothing when KPROFILER_ENABLED is not 1. */
+#define KPROFILE_FRAME_BEGIN()
+/** @brief Compiles to nothing when KPROFILER_ENABLED is not 1. */
+#define KPROFILE_FRAME_END()
+
+#endif
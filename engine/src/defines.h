@@ -107,6 +107,30 @@ STATIC_ASSERT(sizeof(f64) == 8, "Expected f64 to be 8 byte");
 #define CLAMP(val, min, max) (((val) < (min)) ? (min) : (((val) > (max)) ? (max) : (val)))
 
 
+/**
+ * @brief Round a value up to the next multiple of a power-of-two alignment.
+ *
+ * @param value The value (typically a size or an address) to round up.
+ * @param alignment The alignment to round to. Must be a power of two.
+ *
+ * @return The smallest multiple of `alignment` that is greater than or equal to `value`.
+ */
+#define KALIGN_UP(value, alignment) (((value) + ((alignment) - 1)) & ~((u64)(alignment) - 1))
+
+
+/**
+ * @brief Check whether a value is a non-zero power of two (e.g. a valid alignment).
+ */
+#define KIS_POWER_OF_TWO(value) ((value) != 0 && (((value) & ((value) - 1)) == 0))
+
+
+/**
+ * @brief The assumed size of a CPU cache line in bytes.
+ * Used to align/pad data that is shared between threads to avoid false sharing.
+ */
+#define KCACHE_LINE_SIZE 64
+
+
 /**
  * @name Platform Detection
  * @brief Detects the target platform at compile-time and defines a macro accordingly.
@@ -174,6 +198,42 @@ STATIC_ASSERT(sizeof(f64) == 8, "Expected f64 to be 8 byte");
 /** @} */
 
 
+/**
+ * @name Instruction Set Detection
+ * @brief Detects the SIMD instruction sets the build may use unconditionally.
+ *
+ * SSE2 is part of the x86-64 baseline and NEON of the AArch64 baseline, so one of them is
+ * always on for supported targets. AVX and FMA are only on if the compiler was told to target
+ * them (e.g. -mavx2 -mfma); otherwise code wanting them must check kcpu_has_feature at runtime.
+ * Define KSIMD_DISABLE to force the scalar paths.
+ * @{
+ */
+#if !defined(KSIMD_DISABLE)
+    #if defined(__x86_64__) || defined(_M_X64)
+
+        /** @brief Defined as 1 when SSE2 (and below) may be used. */
+        #define KSIMD_SSE 1
+
+        #if defined(__AVX__)
+            /** @brief Defined as 1 when the build targets AVX. */
+            #define KSIMD_AVX 1
+        #endif
+
+        #if defined(__FMA__)
+            /** @brief Defined as 1 when the build targets FMA3. */
+            #define KSIMD_FMA 1
+        #endif
+
+    #elif defined(__aarch64__) || defined(_M_ARM64)
+
+        /** @brief Defined as 1 when NEON may be used. */
+        #define KSIMD_NEON 1
+
+    #endif
+#endif
+/** @} */
+
+
 /**
  * @brief Controls library symbol visibility for importing/exporting.
  *
@@ -201,4 +261,26 @@ STATIC_ASSERT(sizeof(f64) == 8, "Expected f64 to be 8 byte");
     #else
         #define KAPI
     #endif
+#endif
+
+
+/**
+ * @brief Declares a variable with thread storage duration (one instance per thread).
+ */
+#if defined(_MSC_VER) && !defined(__clang__)
+    #define KTHREAD_LOCAL __declspec(thread)
+#else
+    #define KTHREAD_LOCAL _Thread_local
+#endif
+
+
+/**
+ * @brief Aligns a type or variable to the given number of bytes.
+ * Typically used with KCACHE_LINE_SIZE to keep data written by different
+ * threads on separate cache lines.
+ */
+#if defined(__clang__) || defined(__GNUC__)
+    #define KALIGN(bytes) __attribute__((aligned(bytes)))
+#else
+    #define KALIGN(bytes) __declspec(align(bytes))
 #endif
\ No newline at end of file
@@ -0,0 +1,621 @@
+/**
+ * @file ecs.c
+ * @brief This file contains the implementation of the engine's entity component system.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "ecs.h"
+
+#include "containers/darray.h"
+#include "core/job_system.h"
+#include "core/katomic.h"
+#include "core/kmemory.h"
+#include "core/kstring.h"
+#include "core/logger.h"
+#include "core/profiler.h"
+
+/** @brief The number of entity records reserved when the world is created without a capacity. */
+#define ECS_DEFAULT_ENTITY_CAPACITY 1024
+
+/** @brief The number of rows an archetype reserves the first time an entity moves into it. */
+#define ECS_ARCHETYPE_INITIAL_CAPACITY 64
+
+/** @brief The alignment of every column, so rows can be streamed with aligned SIMD loads. */
+#define ECS_COLUMN_ALIGNMENT KCACHE_LINE_SIZE
+
+/** @brief Marks a component type an archetype has no column for. */
+#define ECS_NO_COLUMN 0xFF
+
+/** @brief The smallest batch ecs_query_run_parallel picks by itself. Below this, job overhead outweighs the work. */
+#define ECS_MIN_BATCH_SIZE 64
+
+/** @brief The number of batches per thread ecs_query_run_parallel aims for, so faster threads take more. */
+#define ECS_BATCHES_PER_THREAD 4
+
+/**
+ * @struct ecs_component_info
+ * @brief A registered component type.
+ */
+typedef struct ecs_component_info {
+    /** @brief The interned name of the type. */
+    kname name;
+
+    /** @brief The size of the type in bytes. Also the stride of its columns. */
+    u32 size;
+
+    /** @brief The alignment of the type. */
+    u32 alignment;
+} ecs_component_info;
+
+/**
+ * @struct ecs_archetype
+ * @brief The storage of every entity having exactly one set of components.
+ */
+typedef struct ecs_archetype {
+    /** @brief The components of the archetype. */
+    ecs_component_mask mask;
+
+    /** @brief The number of rows (entities) in use. */
+    u32 count;
+
+    /** @brief The number of rows every column has room for. */
+    u32 capacity;
+
+    /** @brief The number of columns, one per component in `mask`. */
+    u32 column_count;
+
+    /** @brief The component stored in each column, in ascending ID order. */
+    u8 components[ECS_MAX_COMPONENTS];
+
+    /** @brief The column of each component ID, or ECS_NO_COLUMN. */
+    u8 column_of[ECS_MAX_COMPONENTS];
+
+    /** @brief The columns: `capacity` components each, contiguous. */
+    u8* columns[ECS_MAX_COMPONENTS];
+
+    /** @brief The entity of each row. */
+    entity* entities;
+} ecs_archetype;
+
+/**
+ * @struct ecs_parallel_run
+ * @brief The part of a parallel query run covering one archetype.
+ */
+typedef struct ecs_parallel_run {
+    /** @brief A view of every row of the archetype. Batches are sub-ranges of it. */
+    ecs_view view;
+
+    /** @brief The size of the components of each of `view.columns`. */
+    u32 sizes[ECS_MAX_QUERY_COMPONENTS];
+
+    /** @brief The number of columns in `view`. */
+    u32 column_count;
+
+    /** @brief The function to run over each batch. */
+    ecs_view_fn fn;
+
+    /** @brief The user data passed to `fn`. */
+    void* data;
+} ecs_parallel_run;
+
+/**
+ * @struct ecs_world_state
+ * @brief The internal state of a world.
+ */
+typedef struct ecs_world_state {
+    /** @brief The registered component types, by ID. */
+    ecs_component_info components[ECS_MAX_COMPONENTS];
+
+    /** @brief The number of registered component types. */
+    u32 component_count;
+
+    /** @brief A darray of every archetype created so far. The first is the archetype of no components. */
+    ecs_archetype* archetypes;
+
+    /** @brief The generation of each entity record. Bumped on destroy, so older handles go stale. */
+    u32* generations;
+
+    /** @brief The archetype each live entity is stored in. */
+    u32* record_archetypes;
+
+    /** @brief The row of each live entity within its archetype. */
+    u32* record_rows;
+
+    /** @brief The number of records the record arrays have room for. */
+    u32 record_capacity;
+
+    /** @brief The number of records ever used. */
+    u32 record_count;
+
+    /** @brief A darray of the indices of destroyed entities' records, reused before new ones. */
+    u32* free_records;
+
+    /** @brief The number of live entities. */
+    u32 alive_count;
+
+    /** @brief The number of queries running, on any thread. Structural changes are refused while non-zero. */
+    u32 iterating;
+
+    /** @brief Set while ecs_query_run_parallel runs, as `parallel_runs` is shared. */
+    b8 parallel_active;
+
+    /** @brief A darray reused by ecs_query_run_parallel, one entry per matching archetype. */
+    ecs_parallel_run* parallel_runs;
+} ecs_world_state;
+
+/**
+ * @brief Checks that no query is running, as structural changes would move rows under it.
+ */
+static b8 ecs_check_not_iterating(const ecs_world_state* state, const char* function) {
+    if (katomic_load(&((ecs_world_state*)state)->iterating, KATOMIC_ACQUIRE) != 0) {
+        KERROR("%s - structural changes are not allowed while a query runs.", function);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/**
+ * @brief Gets the record index of an entity if the handle is live.
+ * @return `b8 TRUE` if the entity is alive, otherwise `b8 FALSE`.
+ */
+static b8 ecs_record_of(const ecs_world_state* state, entity e, u32* out_index) {
+    u32 index = ecs_entity_index(e);
+    u32 generation = ecs_entity_generation(e);
+    if (generation == 0 || index >= state->record_count || state->generations[index] != generation) {
+        return FALSE;
+    }
+    *out_index = index;
+    return TRUE;
+}
+
+/**
+ * @brief Reallocates a u32 array to a new capacity, keeping the first `count` elements.
+ */
+static u32* ecs_resize_u32(u32* array, u32 count, u32 old_capacity, u32 new_capacity) {
+    u32* resized = kallocate(sizeof(u32) * new_capacity, MEMORY_TAG_ENTITY);
+    if (array) {
+        kcopy_memory(resized, array, sizeof(u32) * count);
+        kfree(array, sizeof(u32) * old_capacity, MEMORY_TAG_ENTITY);
+    }
+    return resized;
+}
+
+/**
+ * @brief Grows the entity record arrays to `capacity` records.
+ */
+static void ecs_records_grow(ecs_world_state* state, u32 capacity) {
+    state->generations = ecs_resize_u32(state->generations, state->record_count, state->record_capacity, capacity);
+    state->record_archetypes = ecs_resize_u32(state->record_archetypes, state->record_count, state->record_capacity, capacity);
+    state->record_rows = ecs_resize_u32(state->record_rows, state->record_count, state->record_capacity, capacity);
+    state->record_capacity = capacity;
+}
+
+/**
+ * @brief Grows the columns of an archetype to `capacity` rows.
+ */
+static void ecs_archetype_grow(ecs_world_state* state, ecs_archetype* archetype, u32 capacity) {
+    for (u32 c = 0; c < archetype->column_count; ++c) {
+        u64 size = state->components[archetype->components[c]].size;
+        u8* column = kallocate_aligned(size * capacity, ECS_COLUMN_ALIGNMENT, MEMORY_TAG_ENTITY);
+        if (archetype->columns[c]) {
+            kcopy_memory(column, archetype->columns[c], size * archetype->count);
+            kfree_aligned(archetype->columns[c], size * archetype->capacity, ECS_COLUMN_ALIGNMENT, MEMORY_TAG_ENTITY);
+        }
+        archetype->columns[c] = column;
+    }
+
+    entity* entities = kallocate(sizeof(entity) * capacity, MEMORY_TAG_ENTITY);
+    if (archetype->entities) {
+        kcopy_memory(entities, archetype->entities, sizeof(entity) * archetype->count);
+        kfree(archetype->entities, sizeof(entity) * archetype->capacity, MEMORY_TAG_ENTITY);
+    }
+    archetype->entities = entities;
+    archetype->capacity = capacity;
+}
+
+/**
+ * @brief Finds the archetype with exactly the given components, creating it if needed.
+ * @note May move the archetypes array, so pointers into it must be fetched again afterwards.
+ * @return The index of the archetype.
+ */
+static u32 ecs_archetype_get(ecs_world_state* state, ecs_component_mask mask) {
+    u32 archetype_count = (u32)darray_length(state->archetypes);
+    for (u32 i = 0; i < archetype_count; ++i) {
+        if (state->archetypes[i].mask == mask) {
+            return i;
+        }
+    }
+
+    // Columns are created empty; the first row to move in reserves them.
+    ecs_archetype archetype = {0};
+    archetype.mask = mask;
+    kset_memory(archetype.column_of, ECS_NO_COLUMN, sizeof(archetype.column_of));
+    for (u32 id = 0; id < ECS_MAX_COMPONENTS; ++id) {
+        if (mask & ECS_COMPONENT_BIT(id)) {
+            archetype.column_of[id] = (u8)archetype.column_count;
+            archetype.components[archetype.column_count++] = (u8)id;
+        }
+    }
+    darray_push(state->archetypes, archetype);
+    return archetype_count;
+}
+
+/**
+ * @brief Appends a row for an entity to an archetype. The row's components are left uninitialized.
+ * @return The index of the new row.
+ */
+static u32 ecs_archetype_push(ecs_world_state* state, ecs_archetype* archetype, entity e) {
+    if (archetype->count == archetype->capacity) {
+        ecs_archetype_grow(state, archetype, archetype->capacity ? archetype->capacity * 2 : ECS_ARCHETYPE_INITIAL_CAPACITY);
+    }
+    u32 row = archetype->count++;
+    archetype->entities[row] = e;
+    return row;
+}
+
+/**
+ * @brief Removes a row from an archetype by moving the last row into it.
+ */
+static void ecs_archetype_remove_row(ecs_world_state* state, ecs_archetype* archetype, u32 row) {
+    u32 last = archetype->count - 1;
+    if (row != last) {
+        for (u32 c = 0; c < archetype->column_count; ++c) {
+            u64 size = state->components[archetype->components[c]].size;
+            kcopy_memory(archetype->columns[c] + row * size, archetype->columns[c] + last * size, size);
+        }
+        entity moved = archetype->entities[last];
+        archetype->entities[row] = moved;
+        state->record_rows[ecs_entity_index(moved)] = row;
+    }
+    archetype->count--;
+}
+
+/**
+ * @brief Moves an entity to the archetype with `mask`, keeping the components both archetypes
+ * have and zeroing the ones only the new archetype has.
+ * @return The archetype the entity ended up in.
+ */
+static ecs_archetype* ecs_entity_move(ecs_world_state* state, u32 record, ecs_component_mask mask) {
+    u32 target_index = ecs_archetype_get(state, mask);
+    ecs_archetype* source = &state->archetypes[state->record_archetypes[record]];
+    ecs_archetype* target = &state->archetypes[target_index];
+    u32 source_row = state->record_rows[record];
+
+    u32 row = ecs_archetype_push(state, target, source->entities[source_row]);
+    for (u32 c = 0; c < target->column_count; ++c) {
+        u32 id = target->components[c];
+        u64 size = state->components[id].size;
+        u8* destination = target->columns[c] + row * size;
+        if (source->column_of[id] != ECS_NO_COLUMN) {
+            kcopy_memory(destination, source->columns[source->column_of[id]] + source_row * size, size);
+        } else {
+            kzero_memory(destination, size);
+        }
+    }
+
+    ecs_archetype_remove_row(state, source, source_row);
+    state->record_archetypes[record] = target_index;
+    state->record_rows[record] = row;
+    return target;
+}
+
+/** @brief Checks if an archetype holds entities a query selects. */
+static inline b8 ecs_query_matches(const ecs_query* query, const ecs_archetype* archetype) {
+    return archetype->count > 0 && (archetype->mask & query->include) == query->include && (archetype->mask & query->exclude) == 0;
+}
+
+/** @brief Makes a view of every row of an archetype for a query. */
+static void ecs_view_build(const ecs_query* query, const ecs_archetype* archetype, ecs_view* out_view) {
+    out_view->count = archetype->count;
+    out_view->entities = archetype->entities;
+    for (u32 i = 0; i < query->component_count; ++i) {
+        out_view->columns[i] = archetype->columns[archetype->column_of[query->components[i]]];
+    }
+}
+
+b8 ecs_world_create(u32 entity_capacity, ecs_world* out_world) {
+    if (!out_world) {
+        KERROR("ecs_world_create requires a valid pointer to out_world.");
+        return FALSE;
+    }
+
+    ecs_world_state* state = kallocate(sizeof(ecs_world_state), MEMORY_TAG_SCENE);
+    state->archetypes = darray_create(ecs_archetype);
+    state->free_records = darray_create(u32);
+    state->parallel_runs = darray_create(ecs_parallel_run);
+    ecs_records_grow(state, entity_capacity ? entity_capacity : ECS_DEFAULT_ENTITY_CAPACITY);
+
+    // New entities start out in the archetype of no components.
+    ecs_archetype_get(state, 0);
+
+    out_world->internal_state = state;
+    return TRUE;
+}
+
+void ecs_world_destroy(ecs_world* world) {
+    if (!world || !world->internal_state) {
+        return;
+    }
+
+    ecs_world_state* state = world->internal_state;
+    for (u64 i = 0; i < darray_length(state->archetypes); ++i) {
+        ecs_archetype* archetype = &state->archetypes[i];
+        for (u32 c = 0; c < archetype->column_count; ++c) {
+            if (archetype->columns[c]) {
+                u64 size = state->components[archetype->components[c]].size;
+                kfree_aligned(archetype->columns[c], size * archetype->capacity, ECS_COLUMN_ALIGNMENT, MEMORY_TAG_ENTITY);
+            }
+        }
+        if (archetype->entities) {
+            kfree(archetype->entities, sizeof(entity) * archetype->capacity, MEMORY_TAG_ENTITY);
+        }
+    }
+    darray_destroy(state->archetypes);
+    darray_destroy(state->free_records);
+    darray_destroy(state->parallel_runs);
+
+    kfree(state->generations, sizeof(u32) * state->record_capacity, MEMORY_TAG_ENTITY);
+    kfree(state->record_archetypes, sizeof(u32) * state->record_capacity, MEMORY_TAG_ENTITY);
+    kfree(state->record_rows, sizeof(u32) * state->record_capacity, MEMORY_TAG_ENTITY);
+
+    kfree(state, sizeof(ecs_world_state), MEMORY_TAG_SCENE);
+    world->internal_state = 0;
+}
+
+ecs_component_id ecs_component_register(ecs_world* world, const char* name, u32 size, u32 alignment) {
+    ecs_world_state* state = world->internal_state;
+    if (state->component_count == ECS_MAX_COMPONENTS) {
+        KERROR("ecs_component_register - the world already has the maximum of %u component types.", ECS_MAX_COMPONENTS);
+        return ECS_COMPONENT_INVALID;
+    }
+    if (size == 0 || !KIS_POWER_OF_TWO(alignment) || alignment > ECS_COLUMN_ALIGNMENT) {
+        KERROR("ecs_component_register - '%s' needs a non-zero size and a power-of-two alignment of at most %u.", name, ECS_COLUMN_ALIGNMENT);
+        return ECS_COMPONENT_INVALID;
+    }
+
+    kname interned = kname_intern_cstr(name);
+    if (interned == KNAME_NONE) {
+        KERROR("ecs_component_register - components need a name (and the name system must be initialized).");
+        return ECS_COMPONENT_INVALID;
+    }
+    for (u32 i = 0; i < state->component_count; ++i) {
+        if (state->components[i].name == interned) {
+            KERROR("ecs_component_register - '%s' is already registered.", name);
+            return ECS_COMPONENT_INVALID;
+        }
+    }
+
+    ecs_component_id id = state->component_count++;
+    state->components[id].name = interned;
+    state->components[id].size = size;
+    state->components[id].alignment = alignment;
+    return id;
+}
+
+ecs_component_id ecs_component_find(const ecs_world* world, const char* name) {
+    const ecs_world_state* state = world->internal_state;
+    kname interned = kname_find(kstring_from_cstr(name));
+    for (u32 i = 0; interned != KNAME_NONE && i < state->component_count; ++i) {
+        if (state->components[i].name == interned) {
+            return i;
+        }
+    }
+    return ECS_COMPONENT_INVALID;
+}
+
+entity ecs_entity_create(ecs_world* world) {
+    ecs_world_state* state = world->internal_state;
+    if (!ecs_check_not_iterating(state, "ecs_entity_create")) {
+        return ENTITY_INVALID;
+    }
+
+    u32 record;
+    if (darray_length(state->free_records) > 0) {
+        darray_pop(state->free_records, &record);
+    } else {
+        if (state->record_count == state->record_capacity) {
+            ecs_records_grow(state, state->record_capacity * 2);
+        }
+        record = state->record_count++;
+        state->generations[record] = 1;
+    }
+
+    entity e = ((u64)state->generations[record] << 32) | record;
+    state->record_archetypes[record] = 0;
+    state->record_rows[record] = ecs_archetype_push(state, &state->archetypes[0], e);
+    state->alive_count++;
+    return e;
+}
+
+void ecs_entity_destroy(ecs_world* world, entity e) {
+    ecs_world_state* state = world->internal_state;
+    u32 record;
+    if (!ecs_record_of(state, e, &record) || !ecs_check_not_iterating(state, "ecs_entity_destroy")) {
+        return;
+    }
+
+    ecs_archetype_remove_row(state, &state->archetypes[state->record_archetypes[record]], state->record_rows[record]);
+
+    // Generation 0 is never handed out, so ENTITY_INVALID can never become valid.
+    u32 generation = state->generations[record] + 1;
+    state->generations[record] = generation ? generation : 1;
+    darray_push(state->free_records, record);
+    state->alive_count--;
+}
+
+b8 ecs_entity_is_alive(const ecs_world* world, entity e) {
+    u32 record;
+    return ecs_record_of(world->internal_state, e, &record);
+}
+
+u32 ecs_entity_count(const ecs_world* world) {
+    const ecs_world_state* state = world->internal_state;
+    return state->alive_count;
+}
+
+void* ecs_component_add(ecs_world* world, entity e, ecs_component_id component) {
+    ecs_world_state* state = world->internal_state;
+    u32 record;
+    if (!ecs_record_of(state, e, &record) || component >= state->component_count) {
+        KERROR("ecs_component_add - invalid entity or component.");
+        return 0;
+    }
+
+    ecs_archetype* archetype = &state->archetypes[state->record_archetypes[record]];
+    if (!(archetype->mask & ECS_COMPONENT_BIT(component))) {
+        if (!ecs_check_not_iterating(state, "ecs_component_add")) {
+            return 0;
+        }
+        archetype = ecs_entity_move(state, record, archetype->mask | ECS_COMPONENT_BIT(component));
+    }
+    return archetype->columns[archetype->column_of[component]] + (u64)state->record_rows[record] * state->components[component].size;
+}
+
+b8 ecs_component_remove(ecs_world* world, entity e, ecs_component_id component) {
+    ecs_world_state* state = world->internal_state;
+    u32 record;
+    if (!ecs_record_of(state, e, &record) || component >= state->component_count) {
+        return FALSE;
+    }
+
+    const ecs_archetype* archetype = &state->archetypes[state->record_archetypes[record]];
+    if (!(archetype->mask & ECS_COMPONENT_BIT(component)) || !ecs_check_not_iterating(state, "ecs_component_remove")) {
+        return FALSE;
+    }
+    ecs_entity_move(state, record, archetype->mask & ~ECS_COMPONENT_BIT(component));
+    return TRUE;
+}
+
+void* ecs_component_get(const ecs_world* world, entity e, ecs_component_id component) {
+    const ecs_world_state* state = world->internal_state;
+    u32 record;
+    if (!ecs_record_of(state, e, &record) || component >= state->component_count) {
+        return 0;
+    }
+
+    const ecs_archetype* archetype = &state->archetypes[state->record_archetypes[record]];
+    u8 column = archetype->column_of[component];
+    if (column == ECS_NO_COLUMN) {
+        return 0;
+    }
+    return archetype->columns[column] + (u64)state->record_rows[record] * state->components[component].size;
+}
+
+b8 ecs_component_has(const ecs_world* world, entity e, ecs_component_id component) {
+    return ecs_component_get(world, e, component) != 0;
+}
+
+b8 ecs_query_create(const ecs_component_id* components, u32 component_count, ecs_component_mask exclude, ecs_query* out_query) {
+    if (!out_query || component_count > ECS_MAX_QUERY_COMPONENTS || (component_count && !components)) {
+        KERROR("ecs_query_create - a query fetches at most %u components.", ECS_MAX_QUERY_COMPONENTS);
+        return FALSE;
+    }
+
+    kzero_memory(out_query, sizeof(ecs_query));
+    for (u32 i = 0; i < component_count; ++i) {
+        if (components[i] >= ECS_MAX_COMPONENTS) {
+            KERROR("ecs_query_create - invalid component ID %u.", components[i]);
+            return FALSE;
+        }
+        out_query->components[i] = components[i];
+        out_query->include |= ECS_COMPONENT_BIT(components[i]);
+    }
+    out_query->component_count = component_count;
+    out_query->exclude = exclude;
+    return TRUE;
+}
+
+u32 ecs_query_count(const ecs_world* world, const ecs_query* query) {
+    const ecs_world_state* state = world->internal_state;
+    u32 count = 0;
+    for (u64 i = 0; i < darray_length(state->archetypes); ++i) {
+        if (ecs_query_matches(query, &state->archetypes[i])) {
+            count += state->archetypes[i].count;
+        }
+    }
+    return count;
+}
+
+void ecs_query_run(ecs_world* world, const ecs_query* query, ecs_view_fn fn, void* data) {
+    KPROFILE_SCOPE("ecs_query_run");
+    ecs_world_state* state = world->internal_state;
+
+    katomic_fetch_add(&state->iterating, 1, KATOMIC_ACQ_REL);
+    u64 archetype_count = darray_length(state->archetypes);
+    for (u64 i = 0; i < archetype_count; ++i) {
+        const ecs_archetype* archetype = &state->archetypes[i];
+        if (ecs_query_matches(query, archetype)) {
+            ecs_view view;
+            ecs_view_build(query, archetype, &view);
+            fn(&view, data);
+        }
+    }
+    katomic_fetch_sub(&state->iterating, 1, KATOMIC_ACQ_REL);
+}
+
+/** @brief Runs a query's function over rows [start, end) of one archetype. The job_range_entry of parallel runs. */
+static void ecs_parallel_batch(u32 start, u32 end, void* data) {
+    const ecs_parallel_run* run = data;
+    ecs_view view;
+    view.count = end - start;
+    view.entities = run->view.entities + start;
+    for (u32 i = 0; i < run->column_count; ++i) {
+        view.columns[i] = (u8*)run->view.columns[i] + (u64)start * run->sizes[i];
+    }
+    run->fn(&view, run->data);
+}
+
+void ecs_query_run_parallel(ecs_world* world, const ecs_query* query, u32 batch_size, ecs_view_fn fn, void* data) {
+    ecs_world_state* state = world->internal_state;
+
+    // The run list is shared, so nested parallel runs (from inside `fn`) go sequential.
+    u32 thread_count = job_system_thread_count();
+    if (thread_count <= 1 || state->parallel_active) {
+        ecs_query_run(world, query, fn, data);
+        return;
+    }
+
+    KPROFILE_SCOPE("ecs_query_run_parallel");
+    u32 total = ecs_query_count(world, query);
+    if (total == 0) {
+        return;
+    }
+    if (batch_size == 0) {
+        u32 batches = thread_count * ECS_BATCHES_PER_THREAD;
+        batch_size = (total + batches - 1) / batches;
+        batch_size = batch_size < ECS_MIN_BATCH_SIZE ? ECS_MIN_BATCH_SIZE : batch_size;
+    }
+
+    state->parallel_active = TRUE;
+    katomic_fetch_add(&state->iterating, 1, KATOMIC_ACQ_REL);
+
+    // Fill the run list first; jobs point into it, so it must not move once they are submitted.
+    darray_clear(state->parallel_runs);
+    u64 archetype_count = darray_length(state->archetypes);
+    for (u64 i = 0; i < archetype_count; ++i) {
+        const ecs_archetype* archetype = &state->archetypes[i];
+        if (!ecs_query_matches(query, archetype)) {
+            continue;
+        }
+        ecs_parallel_run run;
+        ecs_view_build(query, archetype, &run.view);
+        for (u32 c = 0; c < query->component_count; ++c) {
+            run.sizes[c] = state->components[query->components[c]].size;
+        }
+        run.column_count = query->component_count;
+        run.fn = fn;
+        run.data = data;
+        darray_push(state->parallel_runs, run);
+    }
+
+    job_counter counter = {0};
+    u64 run_count = darray_length(state->parallel_runs);
+    for (u64 i = 0; i < run_count; ++i) {
+        ecs_parallel_run* run = &state->parallel_runs[i];
+        job_system_parallel_for(run->view.count, batch_size, ecs_parallel_batch, run, &counter);
+    }
+    job_system_wait(&counter);
+
+    katomic_fetch_sub(&state->iterating, 1, KATOMIC_ACQ_REL);
+    state->parallel_active = FALSE;
+}
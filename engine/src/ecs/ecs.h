@@ -0,0 +1,265 @@
+#pragma once
+
+/**
+ * @file ecs.h
+ * @brief This file contains the declarations for the engine's entity component system.
+ *
+ * @details Entities are generational handles; components are plain data registered by size.
+ * Storage is archetype-based: every distinct set of components an entity can have is an
+ * archetype, and each archetype keeps one contiguous array (column) per component type plus
+ * the array of its entities, all indexed by row. Iterating a query therefore walks dense
+ * arrays of exactly the components it asks for, with no per-entity indirection, and rows can
+ * be handed out to job-system workers in contiguous batches.
+ *
+ * Adding or removing a component moves the entity's row to another archetype, and destroying
+ * an entity moves the archetype's last row into its place. Component pointers are therefore
+ * only valid until the next structural change (create, destroy, add, remove), and structural
+ * changes are not allowed while a query runs.
+ *
+ * Component names are interned with kname_intern, so the name system must be initialized.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "defines.h"
+
+/**
+ * @brief A handle to an entity: the index of its record in the low 32 bits and the record's
+ * generation in the high 32 bits. Stale handles (of destroyed entities) never match a live one.
+ */
+typedef u64 entity;
+
+/** @brief The handle of no entity. Never returned by ecs_entity_create. */
+#define ENTITY_INVALID 0
+
+/** @brief Gets the record index of an entity handle. */
+#define ecs_entity_index(e) ((u32)((e) & 0xFFFFFFFFull))
+
+/** @brief Gets the generation of an entity handle. */
+#define ecs_entity_generation(e) ((u32)((e) >> 32))
+
+/** @brief The ID of a registered component type. */
+typedef u32 ecs_component_id;
+
+/** @brief The ID of no component type. */
+#define ECS_COMPONENT_INVALID 0xFFFFFFFFu
+
+/** @brief The maximum number of component types per world. */
+#define ECS_MAX_COMPONENTS 64
+
+/** @brief The maximum number of components a single query can fetch. */
+#define ECS_MAX_QUERY_COMPONENTS 8
+
+/** @brief A set of component types, one bit per ecs_component_id. */
+typedef u64 ecs_component_mask;
+
+/** @brief Gets the mask bit of a component type. */
+#define ECS_COMPONENT_BIT(id) (1ull << (id))
+
+/** @brief Registers a component type by its C type, using the type's name, size and alignment. */
+#define ECS_COMPONENT_REGISTER(world, type) ecs_component_register((world), #type, sizeof(type), _Alignof(type))
+
+/**
+ * @struct ecs_world
+ * @brief A set of entities and their components.
+ */
+typedef struct ecs_world {
+    /** @brief The internal state of the world. */
+    void* internal_state;
+} ecs_world;
+
+/**
+ * @struct ecs_query
+ * @brief Selects the entities having every one of `components` and none of `exclude`.
+ */
+typedef struct ecs_query {
+    /** @brief The components to fetch, in the order they appear in ecs_view::columns. */
+    ecs_component_id components[ECS_MAX_QUERY_COMPONENTS];
+
+    /** @brief The number of entries in `components`. */
+    u32 component_count;
+
+    /** @brief The mask of `components`. */
+    ecs_component_mask include;
+
+    /** @brief The components the entities must not have. */
+    ecs_component_mask exclude;
+} ecs_query;
+
+/**
+ * @struct ecs_view
+ * @brief A contiguous run of rows of one archetype matching a query.
+ */
+typedef struct ecs_view {
+    /** @brief The number of rows in the view. */
+    u32 count;
+
+    /** @brief The entities of the rows. */
+    const entity* entities;
+
+    /**
+     * @brief One array of `count` components per entry of ecs_query::components, in the same
+     * order. Cast each to the component's type.
+     */
+    void* columns[ECS_MAX_QUERY_COMPONENTS];
+} ecs_view;
+
+/**
+ * @brief The signature of a function processing the rows of a query.
+ * @param view The rows to process.
+ * @param data The user data supplied to ecs_query_run or ecs_query_run_parallel.
+ */
+typedef void (*ecs_view_fn)(const ecs_view* view, void* data);
+
+
+/**
+ * @brief Creates a world.
+ * @param entity_capacity The number of entities to reserve records for. 0 uses a default. The world grows past it as needed.
+ * @param out_world A pointer to the world to create.
+ * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+ */
+KAPI b8 ecs_world_create(u32 entity_capacity, ecs_world* out_world);
+
+
+/**
+ * @brief Destroys a world with all of its entities and components.
+ * @param world A pointer to the world.
+ */
+KAPI void ecs_world_destroy(ecs_world* world);
+
+
+/**
+ * @brief Registers a component type. Prefer ECS_COMPONENT_REGISTER.
+ * @param world A pointer to the world.
+ * @param name The name of the type. Must be unique within the world.
+ * @param size The size of the type in bytes.
+ * @param alignment The alignment of the type. Must be a power of two, at most KCACHE_LINE_SIZE.
+ * @return The ID of the type, or ECS_COMPONENT_INVALID on failure.
+ */
+KAPI ecs_component_id ecs_component_register(ecs_world* world, const char* name, u32 size, u32 alignment);
+
+
+/**
+ * @brief Looks up a registered component type by name.
+ * @param world A pointer to the world.
+ * @param name The name the type was registered with.
+ * @return The ID of the type, or ECS_COMPONENT_INVALID if there is none.
+ */
+KAPI ecs_component_id ecs_component_find(const ecs_world* world, const char* name);
+
+
+/**
+ * @brief Creates an entity with no components.
+ * @param world A pointer to the world.
+ * @return The handle of the new entity.
+ */
+KAPI entity ecs_entity_create(ecs_world* world);
+
+
+/**
+ * @brief Destroys an entity and its components. Stale handles are ignored.
+ * @param world A pointer to the world.
+ * @param e The entity.
+ */
+KAPI void ecs_entity_destroy(ecs_world* world, entity e);
+
+
+/**
+ * @brief Checks if an entity handle refers to a live entity.
+ * @param world A pointer to the world.
+ * @param e The entity.
+ * @return `b8 TRUE` if the entity is alive, otherwise `b8 FALSE`.
+ */
+KAPI b8 ecs_entity_is_alive(const ecs_world* world, entity e);
+
+
+/**
+ * @brief Gets the number of live entities.
+ * @param world A pointer to the world.
+ * @return The number of live entities.
+ */
+KAPI u32 ecs_entity_count(const ecs_world* world);
+
+
+/**
+ * @brief Adds a component to an entity, zero-initialized. Returns the existing one if the entity already has it.
+ * @param world A pointer to the world.
+ * @param e The entity.
+ * @param component The component type.
+ * @return A pointer to the component, valid until the next structural change, or 0 on failure.
+ */
+KAPI void* ecs_component_add(ecs_world* world, entity e, ecs_component_id component);
+
+
+/**
+ * @brief Removes a component from an entity.
+ * @param world A pointer to the world.
+ * @param e The entity.
+ * @param component The component type.
+ * @return `b8 TRUE` if the component was removed, `b8 FALSE` if the entity did not have it.
+ */
+KAPI b8 ecs_component_remove(ecs_world* world, entity e, ecs_component_id component);
+
+
+/**
+ * @brief Gets a component of an entity.
+ * @param world A pointer to the world.
+ * @param e The entity.
+ * @param component The component type.
+ * @return A pointer to the component, valid until the next structural change, or 0 if the entity does not have it.
+ */
+KAPI void* ecs_component_get(const ecs_world* world, entity e, ecs_component_id component);
+
+
+/**
+ * @brief Checks if an entity has a component.
+ * @param world A pointer to the world.
+ * @param e The entity.
+ * @param component The component type.
+ * @return `b8 TRUE` if the entity is alive and has the component, otherwise `b8 FALSE`.
+ */
+KAPI b8 ecs_component_has(const ecs_world* world, entity e, ecs_component_id component);
+
+
+/**
+ * @brief Fills out a query.
+ * @param components The components to fetch, in the order they should appear in ecs_view::columns.
+ * @param component_count The number of entries in `components`. At most ECS_MAX_QUERY_COMPONENTS.
+ * @param exclude The components matching entities must not have. May be 0.
+ * @param out_query A pointer to the query to fill out.
+ * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+ */
+KAPI b8 ecs_query_create(const ecs_component_id* components, u32 component_count, ecs_component_mask exclude, ecs_query* out_query);
+
+
+/**
+ * @brief Counts the entities matching a query.
+ * @param world A pointer to the world.
+ * @param query A pointer to the query.
+ * @return The number of matching entities.
+ */
+KAPI u32 ecs_query_count(const ecs_world* world, const ecs_query* query);
+
+
+/**
+ * @brief Runs a function over every entity matching a query, one view per matching archetype, on the calling thread.
+ * @param world A pointer to the world.
+ * @param query A pointer to the query.
+ * @param fn The function to run.
+ * @param data The user data passed to `fn`.
+ */
+KAPI void ecs_query_run(ecs_world* world, const ecs_query* query, ecs_view_fn fn, void* data);
+
+
+/**
+ * @brief Runs a function over every entity matching a query, split into batches run as jobs, and waits for them.
+ * @details Batches never span archetypes, and each row is in exactly one batch, so `fn` may
+ * write to the components of its view without synchronization. Anything else it touches
+ * must be safe to use from several threads at once. Runs on the calling thread alone if the
+ * job system has no workers. Must be called from the main thread or a job worker.
+ * @param world A pointer to the world.
+ * @param query A pointer to the query.
+ * @param batch_size The maximum number of rows per batch. 0 picks a size that gives every thread a few batches.
+ * @param fn The function to run.
+ * @param data The user data passed to `fn`.
+ */
+KAPI void ecs_query_run_parallel(ecs_world* world, const ecs_query* query, u32 batch_size, ecs_view_fn fn, void* data);
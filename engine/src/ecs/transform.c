@@ -0,0 +1,447 @@
+/**
+ * @file transform.c
+ * @brief This file contains the implementation of the engine's transform hierarchy.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "transform.h"
+
+#include "core/kmemory.h"
+#include "core/logger.h"
+#include "core/profiler.h"
+#include "math/kmath.h"
+
+/** @brief The number of transforms reserved when the hierarchy is created without a capacity. */
+#define TRANSFORM_DEFAULT_CAPACITY 256
+
+/** @brief Marks an empty lookup slot, and the parent index of roots. */
+#define TRANSFORM_NONE 0xFFFFFFFFu
+
+/** @brief The alignment of every array, so quat and mat4 elements are SIMD-aligned. */
+#define TRANSFORM_ARRAY_ALIGNMENT 16
+
+/**
+ * @enum transform_flag
+ * @brief The per-transform flags driving the update pass.
+ */
+typedef enum transform_flag {
+    /** @brief The position, rotation or scale changed, so the local matrix must be rebuilt. */
+    TRANSFORM_FLAG_LOCAL_DIRTY = 0x1,
+
+    /** @brief The parent changed, so the world matrix must be rebuilt. */
+    TRANSFORM_FLAG_WORLD_DIRTY = 0x2,
+
+    /** @brief The world matrix was rebuilt by the last update, so the children's must be as well. */
+    TRANSFORM_FLAG_CHANGED = 0x4
+} transform_flag;
+
+/**
+ * @struct transform_state
+ * @brief The internal state of a transform hierarchy. Every array except `lookup` is indexed by
+ * slot, and slots are in topological order unless `order_stale` is set.
+ */
+typedef struct transform_state {
+    /** @brief The number of transforms. */
+    u32 count;
+
+    /** @brief The number of slots every array has room for. */
+    u32 capacity;
+
+    /** @brief The entity of each slot. */
+    entity* entities;
+
+    /** @brief The parent entity of each slot, or ENTITY_INVALID. The source of truth for the shape. */
+    entity* parents;
+
+    /** @brief The slot of each slot's parent, or TRANSFORM_NONE. Derived from `parents` when sorting. */
+    u32* parent_slots;
+
+    /** @brief The transform_flag bits of each slot. */
+    u8* flags;
+
+    /** @brief The local translation of each slot. */
+    vec3* positions;
+
+    /** @brief The local rotation of each slot. */
+    quat* rotations;
+
+    /** @brief The local scale of each slot. */
+    vec3* scales;
+
+    /** @brief The local matrix of each slot. */
+    mat4* locals;
+
+    /** @brief The world matrix of each slot. */
+    mat4* worlds;
+
+    /** @brief The slot of each entity, indexed by ecs_entity_index, or TRANSFORM_NONE. */
+    u32* lookup;
+
+    /** @brief The number of entries in `lookup`. */
+    u32 lookup_capacity;
+
+    /** @brief Set when the shape changed since the last sort, so slots may be out of order. */
+    b8 order_stale;
+
+    /** @brief Sorting scratch: the depth of each slot. */
+    u32* depths;
+
+    /** @brief Sorting scratch: the old slot of each new slot. */
+    u32* order;
+
+    /** @brief Sorting scratch: the first new slot of each depth. Has `capacity + 1` entries. */
+    u32* depth_starts;
+
+    /** @brief Sorting scratch: room for `capacity` of the largest element, used to permute each array. */
+    void* permute_buffer;
+} transform_state;
+
+/**
+ * @brief Reallocates an array to a new capacity, keeping the first `count` elements.
+ */
+static void* transform_resize(void* array, u64 stride, u32 count, u32 old_capacity, u32 new_capacity, memory_tag tag) {
+    void* resized = kallocate_aligned(stride * new_capacity, TRANSFORM_ARRAY_ALIGNMENT, tag);
+    if (array) {
+        kcopy_memory(resized, array, stride * count);
+        kfree_aligned(array, stride * old_capacity, TRANSFORM_ARRAY_ALIGNMENT, tag);
+    }
+    return resized;
+}
+
+/**
+ * @brief Grows every slot array of the hierarchy to `capacity` slots.
+ */
+static void transform_resize_all(transform_state* state, u32 capacity) {
+    u32 count = state->count;
+    u32 old = state->capacity;
+    state->entities = transform_resize(state->entities, sizeof(entity), count, old, capacity, MEMORY_TAG_ENTTY_NODE);
+    state->parents = transform_resize(state->parents, sizeof(entity), count, old, capacity, MEMORY_TAG_ENTTY_NODE);
+    state->parent_slots = transform_resize(state->parent_slots, sizeof(u32), count, old, capacity, MEMORY_TAG_ENTTY_NODE);
+    state->flags = transform_resize(state->flags, sizeof(u8), count, old, capacity, MEMORY_TAG_ENTTY_NODE);
+    state->positions = transform_resize(state->positions, sizeof(vec3), count, old, capacity, MEMORY_TAG_TRANSFORM);
+    state->rotations = transform_resize(state->rotations, sizeof(quat), count, old, capacity, MEMORY_TAG_TRANSFORM);
+    state->scales = transform_resize(state->scales, sizeof(vec3), count, old, capacity, MEMORY_TAG_TRANSFORM);
+    state->locals = transform_resize(state->locals, sizeof(mat4), count, old, capacity, MEMORY_TAG_TRANSFORM);
+    state->worlds = transform_resize(state->worlds, sizeof(mat4), count, old, capacity, MEMORY_TAG_TRANSFORM);
+
+    // The scratch arrays hold nothing between sorts.
+    state->depths = transform_resize(state->depths, sizeof(u32), 0, old, capacity, MEMORY_TAG_ENTTY_NODE);
+    state->order = transform_resize(state->order, sizeof(u32), 0, old, capacity, MEMORY_TAG_ENTTY_NODE);
+    state->depth_starts = transform_resize(state->depth_starts, sizeof(u32), 0, old + 1, capacity + 1, MEMORY_TAG_ENTTY_NODE);
+    state->permute_buffer = transform_resize(state->permute_buffer, sizeof(mat4), 0, old, capacity, MEMORY_TAG_TRANSFORM);
+
+    state->capacity = capacity;
+}
+
+/**
+ * @brief Gets the slot of an entity.
+ * @return The slot, or TRANSFORM_NONE if the entity has no transform.
+ */
+static u32 transform_slot_of(const transform_state* state, entity e) {
+    u32 index = ecs_entity_index(e);
+    if (e == ENTITY_INVALID || index >= state->lookup_capacity) {
+        return TRANSFORM_NONE;
+    }
+    u32 slot = state->lookup[index];
+    return slot != TRANSFORM_NONE && state->entities[slot] == e ? slot : TRANSFORM_NONE;
+}
+
+/**
+ * @brief Reorders the elements of an array so that new slot i holds what old slot order[i] held.
+ */
+static void transform_permute(transform_state* state, void* array, u64 stride) {
+    u8* source = array;
+    u8* buffer = state->permute_buffer;
+    for (u32 i = 0; i < state->count; ++i) {
+        kcopy_memory(buffer + i * stride, source + state->order[i] * stride, stride);
+    }
+    kcopy_memory(array, buffer, stride * state->count);
+}
+
+/**
+ * @brief Sorts the slots by depth, so every parent comes before its children, and rebuilds
+ * the lookup and the parent slots. The sort is stable, so siblings stay in the order they were
+ * added.
+ */
+static void transform_sort(transform_state* state) {
+    KPROFILE_SCOPE("transform_sort");
+    u32 count = state->count;
+
+    for (u32 i = 0; i < count; ++i) {
+        state->parent_slots[i] = transform_slot_of(state, state->parents[i]);
+        state->depths[i] = TRANSFORM_NONE;
+    }
+
+    // Walk up to the nearest node of known depth, then write the depths on the way back.
+    // Each node is written once, so this is linear overall.
+    u32 max_depth = 0;
+    for (u32 i = 0; i < count; ++i) {
+        u32 slot = i;
+        u32 steps = 0;
+        while (state->depths[slot] == TRANSFORM_NONE && state->parent_slots[slot] != TRANSFORM_NONE) {
+            slot = state->parent_slots[slot];
+            steps++;
+        }
+        // `slot` is now either of known depth or a root, which is at depth 0.
+        u32 depth = (state->depths[slot] == TRANSFORM_NONE ? 0 : state->depths[slot]) + steps;
+        max_depth = depth > max_depth ? depth : max_depth;
+        for (slot = i; state->depths[slot] == TRANSFORM_NONE; slot = state->parent_slots[slot]) {
+            state->depths[slot] = depth--;
+            if (state->parent_slots[slot] == TRANSFORM_NONE) {
+                break;
+            }
+        }
+    }
+
+    // Counting sort by depth.
+    kzero_memory(state->depth_starts, sizeof(u32) * (max_depth + 2));
+    for (u32 i = 0; i < count; ++i) {
+        state->depth_starts[state->depths[i] + 1]++;
+    }
+    for (u32 d = 1; d <= max_depth + 1; ++d) {
+        state->depth_starts[d] += state->depth_starts[d - 1];
+    }
+    for (u32 i = 0; i < count; ++i) {
+        state->order[state->depth_starts[state->depths[i]]++] = i;
+    }
+
+    transform_permute(state, state->entities, sizeof(entity));
+    transform_permute(state, state->parents, sizeof(entity));
+    transform_permute(state, state->flags, sizeof(u8));
+    transform_permute(state, state->positions, sizeof(vec3));
+    transform_permute(state, state->rotations, sizeof(quat));
+    transform_permute(state, state->scales, sizeof(vec3));
+    transform_permute(state, state->locals, sizeof(mat4));
+    transform_permute(state, state->worlds, sizeof(mat4));
+
+    for (u32 i = 0; i < count; ++i) {
+        state->lookup[ecs_entity_index(state->entities[i])] = i;
+    }
+    for (u32 i = 0; i < count; ++i) {
+        state->parent_slots[i] = transform_slot_of(state, state->parents[i]);
+    }
+
+    state->order_stale = FALSE;
+}
+
+b8 transform_hierarchy_create(u32 capacity, transform_hierarchy* out_hierarchy) {
+    if (!out_hierarchy) {
+        KERROR("transform_hierarchy_create requires a valid pointer to out_hierarchy.");
+        return FALSE;
+    }
+
+    transform_state* state = kallocate(sizeof(transform_state), MEMORY_TAG_SCENE);
+    transform_resize_all(state, capacity ? capacity : TRANSFORM_DEFAULT_CAPACITY);
+    out_hierarchy->internal_state = state;
+    return TRUE;
+}
+
+void transform_hierarchy_destroy(transform_hierarchy* hierarchy) {
+    if (!hierarchy || !hierarchy->internal_state) {
+        return;
+    }
+
+    transform_state* state = hierarchy->internal_state;
+    state->count = 0;
+    u32 capacity = state->capacity;
+    kfree_aligned(state->entities, sizeof(entity) * capacity, TRANSFORM_ARRAY_ALIGNMENT, MEMORY_TAG_ENTTY_NODE);
+    kfree_aligned(state->parents, sizeof(entity) * capacity, TRANSFORM_ARRAY_ALIGNMENT, MEMORY_TAG_ENTTY_NODE);
+    kfree_aligned(state->parent_slots, sizeof(u32) * capacity, TRANSFORM_ARRAY_ALIGNMENT, MEMORY_TAG_ENTTY_NODE);
+    kfree_aligned(state->flags, sizeof(u8) * capacity, TRANSFORM_ARRAY_ALIGNMENT, MEMORY_TAG_ENTTY_NODE);
+    kfree_aligned(state->positions, sizeof(vec3) * capacity, TRANSFORM_ARRAY_ALIGNMENT, MEMORY_TAG_TRANSFORM);
+    kfree_aligned(state->rotations, sizeof(quat) * capacity, TRANSFORM_ARRAY_ALIGNMENT, MEMORY_TAG_TRANSFORM);
+    kfree_aligned(state->scales, sizeof(vec3) * capacity, TRANSFORM_ARRAY_ALIGNMENT, MEMORY_TAG_TRANSFORM);
+    kfree_aligned(state->locals, sizeof(mat4) * capacity, TRANSFORM_ARRAY_ALIGNMENT, MEMORY_TAG_TRANSFORM);
+    kfree_aligned(state->worlds, sizeof(mat4) * capacity, TRANSFORM_ARRAY_ALIGNMENT, MEMORY_TAG_TRANSFORM);
+    kfree_aligned(state->depths, sizeof(u32) * capacity, TRANSFORM_ARRAY_ALIGNMENT, MEMORY_TAG_ENTTY_NODE);
+    kfree_aligned(state->order, sizeof(u32) * capacity, TRANSFORM_ARRAY_ALIGNMENT, MEMORY_TAG_ENTTY_NODE);
+    kfree_aligned(state->depth_starts, sizeof(u32) * (capacity + 1), TRANSFORM_ARRAY_ALIGNMENT, MEMORY_TAG_ENTTY_NODE);
+    kfree_aligned(state->permute_buffer, sizeof(mat4) * capacity, TRANSFORM_ARRAY_ALIGNMENT, MEMORY_TAG_TRANSFORM);
+    if (state->lookup) {
+        kfree(state->lookup, sizeof(u32) * state->lookup_capacity, MEMORY_TAG_ENTTY_NODE);
+    }
+
+    kfree(state, sizeof(transform_state), MEMORY_TAG_SCENE);
+    hierarchy->internal_state = 0;
+}
+
+b8 transform_add(transform_hierarchy* hierarchy, entity e, entity parent) {
+    transform_state* state = hierarchy->internal_state;
+    if (e == ENTITY_INVALID || transform_slot_of(state, e) != TRANSFORM_NONE) {
+        KERROR("transform_add - the entity is invalid or already has a transform.");
+        return FALSE;
+    }
+    u32 parent_slot = transform_slot_of(state, parent);
+    if (parent != ENTITY_INVALID && parent_slot == TRANSFORM_NONE) {
+        KERROR("transform_add - the parent has no transform.");
+        return FALSE;
+    }
+
+    if (state->count == state->capacity) {
+        transform_resize_all(state, state->capacity * 2);
+    }
+
+    u32 index = ecs_entity_index(e);
+    if (index >= state->lookup_capacity) {
+        u32 capacity = state->lookup_capacity ? state->lookup_capacity : TRANSFORM_DEFAULT_CAPACITY;
+        while (capacity <= index) {
+            capacity *= 2;
+        }
+        u32* lookup = kallocate(sizeof(u32) * capacity, MEMORY_TAG_ENTTY_NODE);
+        kset_memory(lookup, 0xFF, sizeof(u32) * capacity);
+        if (state->lookup) {
+            kcopy_memory(lookup, state->lookup, sizeof(u32) * state->lookup_capacity);
+            kfree(state->lookup, sizeof(u32) * state->lookup_capacity, MEMORY_TAG_ENTTY_NODE);
+        }
+        state->lookup = lookup;
+        state->lookup_capacity = capacity;
+    }
+
+    // Appending keeps the order topological, as the parent is already in an earlier slot.
+    u32 slot = state->count++;
+    state->entities[slot] = e;
+    state->parents[slot] = parent;
+    state->parent_slots[slot] = parent_slot;
+    state->flags[slot] = TRANSFORM_FLAG_LOCAL_DIRTY;
+    state->positions[slot] = vec3_zero();
+    state->rotations[slot] = quat_identity();
+    state->scales[slot] = vec3_one();
+    state->lookup[index] = slot;
+    return TRUE;
+}
+
+b8 transform_remove(transform_hierarchy* hierarchy, entity e) {
+    transform_state* state = hierarchy->internal_state;
+    u32 slot = transform_slot_of(state, e);
+    if (slot == TRANSFORM_NONE) {
+        return FALSE;
+    }
+
+    for (u32 i = 0; i < state->count; ++i) {
+        if (state->parents[i] == e) {
+            state->parents[i] = state->parents[slot];
+            state->flags[i] |= TRANSFORM_FLAG_WORLD_DIRTY;
+        }
+    }
+
+    // Move the last slot into the hole. That breaks the order, which the next update restores.
+    u32 last = --state->count;
+    if (slot != last) {
+        state->entities[slot] = state->entities[last];
+        state->parents[slot] = state->parents[last];
+        state->flags[slot] = state->flags[last];
+        state->positions[slot] = state->positions[last];
+        state->rotations[slot] = state->rotations[last];
+        state->scales[slot] = state->scales[last];
+        state->locals[slot] = state->locals[last];
+        state->worlds[slot] = state->worlds[last];
+        state->lookup[ecs_entity_index(state->entities[slot])] = slot;
+    }
+    state->lookup[ecs_entity_index(e)] = TRANSFORM_NONE;
+    state->order_stale = TRUE;
+    return TRUE;
+}
+
+b8 transform_has(const transform_hierarchy* hierarchy, entity e) {
+    return transform_slot_of(hierarchy->internal_state, e) != TRANSFORM_NONE;
+}
+
+b8 transform_set_parent(transform_hierarchy* hierarchy, entity e, entity parent) {
+    transform_state* state = hierarchy->internal_state;
+    u32 slot = transform_slot_of(state, e);
+    if (slot == TRANSFORM_NONE) {
+        KERROR("transform_set_parent - the entity has no transform.");
+        return FALSE;
+    }
+
+    // Walk up from the new parent; reaching `e` would make a cycle.
+    for (entity ancestor = parent; ancestor != ENTITY_INVALID;) {
+        u32 ancestor_slot = transform_slot_of(state, ancestor);
+        if (ancestor == e || ancestor_slot == TRANSFORM_NONE) {
+            KERROR("transform_set_parent - the parent has no transform, or is the entity or one of its descendants.");
+            return FALSE;
+        }
+        ancestor = state->parents[ancestor_slot];
+    }
+
+    if (state->parents[slot] != parent) {
+        state->parents[slot] = parent;
+        state->flags[slot] |= TRANSFORM_FLAG_WORLD_DIRTY;
+        state->order_stale = TRUE;
+    }
+    return TRUE;
+}
+
+entity transform_get_parent(const transform_hierarchy* hierarchy, entity e) {
+    const transform_state* state = hierarchy->internal_state;
+    u32 slot = transform_slot_of(state, e);
+    return slot == TRANSFORM_NONE ? ENTITY_INVALID : state->parents[slot];
+}
+
+b8 transform_set_local(transform_hierarchy* hierarchy, entity e, vec3 position, quat rotation, vec3 scale) {
+    transform_state* state = hierarchy->internal_state;
+    u32 slot = transform_slot_of(state, e);
+    if (slot == TRANSFORM_NONE) {
+        return FALSE;
+    }
+
+    state->positions[slot] = position;
+    state->rotations[slot] = rotation;
+    state->scales[slot] = scale;
+    state->flags[slot] |= TRANSFORM_FLAG_LOCAL_DIRTY;
+    return TRUE;
+}
+
+b8 transform_get_local(const transform_hierarchy* hierarchy, entity e, vec3* out_position, quat* out_rotation, vec3* out_scale) {
+    const transform_state* state = hierarchy->internal_state;
+    u32 slot = transform_slot_of(state, e);
+    if (slot == TRANSFORM_NONE) {
+        return FALSE;
+    }
+
+    if (out_position) {
+        *out_position = state->positions[slot];
+    }
+    if (out_rotation) {
+        *out_rotation = state->rotations[slot];
+    }
+    if (out_scale) {
+        *out_scale = state->scales[slot];
+    }
+    return TRUE;
+}
+
+const mat4* transform_get_world(const transform_hierarchy* hierarchy, entity e) {
+    const transform_state* state = hierarchy->internal_state;
+    u32 slot = transform_slot_of(state, e);
+    return slot == TRANSFORM_NONE ? 0 : &state->worlds[slot];
+}
+
+u32 transform_count(const transform_hierarchy* hierarchy) {
+    const transform_state* state = hierarchy->internal_state;
+    return state->count;
+}
+
+void transform_hierarchy_update(transform_hierarchy* hierarchy) {
+    KPROFILE_SCOPE("transform_hierarchy_update");
+    transform_state* state = hierarchy->internal_state;
+    if (state->order_stale) {
+        transform_sort(state);
+    }
+
+    // Parents come first, so their flags and world matrices are already this update's.
+    for (u32 i = 0; i < state->count; ++i) {
+        u8 flags = state->flags[i];
+        u32 parent = state->parent_slots[i];
+        b8 changed = (flags & (TRANSFORM_FLAG_LOCAL_DIRTY | TRANSFORM_FLAG_WORLD_DIRTY)) ||
+                     (parent != TRANSFORM_NONE && (state->flags[parent] & TRANSFORM_FLAG_CHANGED));
+
+        if (flags & TRANSFORM_FLAG_LOCAL_DIRTY) {
+            state->locals[i] = mat4_from_trs(state->positions[i], state->rotations[i], state->scales[i]);
+        }
+        if (changed) {
+            state->worlds[i] = parent == TRANSFORM_NONE ? state->locals[i] : mat4_mul(&state->worlds[parent], &state->locals[i]);
+        }
+        state->flags[i] = changed ? TRANSFORM_FLAG_CHANGED : 0;
+    }
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+/**
+ * @file transform.h
+ * @brief This file contains the declarations for the engine's transform hierarchy.
+ *
+ * @details The hierarchy stores the transforms of a set of entities, keyed by their ecs
+ * handles, in structure-of-arrays form: positions, rotations, scales, local matrices and world
+ * matrices each live in their own dense array. The arrays are kept in topological order —
+ * sorted by depth, so every parent comes before all of its children — which lets
+ * transform_hierarchy_update compute every world matrix in one linear pass, reading the
+ * parent's world matrix that the same pass has already written.
+ *
+ * Changing the shape of the hierarchy (adding, removing and reparenting) only marks the order
+ * stale; the next update re-sorts it once, however many changes were made. Changing a local
+ * transform marks the node dirty, and the update recomputes only dirty nodes and their
+ * descendants.
+ *
+ * The hierarchy does not own its entities: when an entity is destroyed, remove its
+ * transform as well.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "defines.h"
+#include "ecs/ecs.h"
+#include "math/math_types.h"
+
+/**
+ * @struct transform_hierarchy
+ * @brief A forest of entity transforms.
+ */
+typedef struct transform_hierarchy {
+    /** @brief The internal state of the hierarchy. */
+    void* internal_state;
+} transform_hierarchy;
+
+
+/**
+ * @brief Creates a transform hierarchy.
+ * @param capacity The number of transforms to reserve room for. 0 uses a default. The hierarchy grows past it as needed.
+ * @param out_hierarchy A pointer to the hierarchy to create.
+ * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+ */
+KAPI b8 transform_hierarchy_create(u32 capacity, transform_hierarchy* out_hierarchy);
+
+
+/**
+ * @brief Destroys a transform hierarchy.
+ * @param hierarchy A pointer to the hierarchy.
+ */
+KAPI void transform_hierarchy_destroy(transform_hierarchy* hierarchy);
+
+
+/**
+ * @brief Adds a transform for an entity, at the origin with no rotation and a scale of 1.
+ * @param hierarchy A pointer to the hierarchy.
+ * @param e The entity. Must not have a transform yet.
+ * @param parent The parent entity, which must have a transform, or ENTITY_INVALID for a root.
+ * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+ */
+KAPI b8 transform_add(transform_hierarchy* hierarchy, entity e, entity parent);
+
+
+/**
+ * @brief Removes the transform of an entity. Its children are moved to its parent, keeping their local transforms.
+ * @param hierarchy A pointer to the hierarchy.
+ * @param e The entity.
+ * @return `b8 TRUE` if the entity had a transform, otherwise `b8 FALSE`.
+ */
+KAPI b8 transform_remove(transform_hierarchy* hierarchy, entity e);
+
+
+/**
+ * @brief Checks if an entity has a transform.
+ * @param hierarchy A pointer to the hierarchy.
+ * @param e The entity.
+ * @return `b8 TRUE` if the entity has a transform, otherwise `b8 FALSE`.
+ */
+KAPI b8 transform_has(const transform_hierarchy* hierarchy, entity e);
+
+
+/**
+ * @brief Moves a transform under a new parent, keeping its local transform.
+ * @param hierarchy A pointer to the hierarchy.
+ * @param e The entity.
+ * @param parent The new parent, or ENTITY_INVALID to make `e` a root. Must not be `e` or one of its descendants.
+ * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+ */
+KAPI b8 transform_set_parent(transform_hierarchy* hierarchy, entity e, entity parent);
+
+
+/**
+ * @brief Gets the parent of a transform.
+ * @param hierarchy A pointer to the hierarchy.
+ * @param e The entity.
+ * @return The parent entity, or ENTITY_INVALID for roots and entities without a transform.
+ */
+KAPI entity transform_get_parent(const transform_hierarchy* hierarchy, entity e);
+
+
+/**
+ * @brief Sets the local transform of an entity, relative to its parent.
+ * @param hierarchy A pointer to the hierarchy.
+ * @param e The entity.
+ * @param position The translation.
+ * @param rotation The rotation. Must be normalized.
+ * @param scale The scale along each axis.
+ * @return `b8 TRUE` on success, `b8 FALSE` if the entity has no transform.
+ */
+KAPI b8 transform_set_local(transform_hierarchy* hierarchy, entity e, vec3 position, quat rotation, vec3 scale);
+
+
+/**
+ * @brief Gets the local transform of an entity.
+ * @param hierarchy A pointer to the hierarchy.
+ * @param e The entity.
+ * @param out_position A pointer to receive the translation. May be 0.
+ * @param out_rotation A pointer to receive the rotation. May be 0.
+ * @param out_scale A pointer to receive the scale. May be 0.
+ * @return `b8 TRUE` on success, `b8 FALSE` if the entity has no transform.
+ */
+KAPI b8 transform_get_local(const transform_hierarchy* hierarchy, entity e, vec3* out_position, quat* out_rotation, vec3* out_scale);
+
+
+/**
+ * @brief Gets the world matrix of an entity as of the last transform_hierarchy_update.
+ * @param hierarchy A pointer to the hierarchy.
+ * @param e The entity.
+ * @return A pointer to the matrix, valid until the hierarchy changes shape, or 0 if the entity has no transform.
+ */
+KAPI const mat4* transform_get_world(const transform_hierarchy* hierarchy, entity e);
+
+
+/**
+ * @brief Gets the number of transforms.
+ * @param hierarchy A pointer to the hierarchy.
+ * @return The number of transforms.
+ */
+KAPI u32 transform_count(const transform_hierarchy* hierarchy);
+
+
+/**
+ * @brief Re-sorts the hierarchy if its shape changed, then recomputes the local and world
+ * matrices of every dirty transform and of their descendants, in one pass.
+ * @param hierarchy A pointer to the hierarchy.
+ */
+KAPI void transform_hierarchy_update(transform_hierarchy* hierarchy);
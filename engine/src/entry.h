@@ -41,7 +41,9 @@ int main(void)
     initialize_memory();
 
     // Request the game instance from the user-defined function. (startup step)
+    // Zeroed first, so any optional fields the game does not set are 0/NULL.
     game game_inst;
+    kzero_memory(&game_inst, sizeof(game));
     if (!create_game(&game_inst)) {
         KERROR("Could not create game!");
         return -1;
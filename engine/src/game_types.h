@@ -59,6 +59,44 @@ typedef struct game
     void (*on_resize)(struct game* game_inst, u32 width, u32 height);
 
 
+    /** @brief Optional function pointer the engine asks whether the game is idle. May be 0.
+     * While it returns TRUE, the main loop blocks until OS input arrives (or a short timeout
+     * expires) instead of spinning, so tools that only redraw on input use no CPU when idle.
+     * @param game_inst A pointer to the game instance.
+     * @return `b8 TRUE` if the game has nothing to do until the next input, otherwise `b8 FALSE`.
+     */
+    b8 (*is_idle)(struct game* game_inst);
+
+
+    /** @brief The size of the game's frame packet in bytes. Only used with pipelined rendering.
+     * A frame packet holds everything the render step needs for one frame (camera, draw
+     * lists, interpolated transforms, ...), so rendering never reads live simulation state.
+     * `u64` matches the engine's allocation sizes.
+     */
+    u64 frame_packet_size;
+
+
+    /** @brief Function pointer to fill a frame packet after the frame's update. Only used with pipelined rendering.
+     * Called on the main thread, after `update`, while the render thread may still be
+     * rendering an older packet.
+     * @param game_inst A pointer to the game instance.
+     * @param packet A pointer to `frame_packet_size` bytes to write. Holds the data of an older frame on entry.
+     * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+     */
+    b8 (*write_frame_packet)(struct game* game_inst, void* packet);
+
+
+    /** @brief Function pointer to render a frame packet. Only used with pipelined rendering.
+     * Called on the render thread instead of `render`. It must only read the packet (and
+     * render-thread-owned data), never state touched by `update`.
+     * @param game_inst A pointer to the game instance.
+     * @param packet A pointer to the packet written by write_frame_packet.
+     * @param delta_time The delta time of the frame the packet was written in.
+     * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+     */
+    b8 (*render_frame_packet)(struct game* game_inst, const void* packet, f32 delta_time);
+
+
     /** @brief A pointer to the game-specific state, managed entirely by the game.
      * `void*` is used to make this a generic container, decoupling the engine from
      * the game's internal implementation. The engine only needs to store the pointer.
@@ -0,0 +1,316 @@
+/**
+ * @file kmath.c
+ * @brief This file contains the implementation of the scalar math functions and the batch kernels.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "kmath.h"
+
+#include "core/katomic.h"
+#include "core/kcpu.h"
+#include "core/kmemory.h"
+#include "core/logger.h"
+
+#include <math.h>
+
+#if defined(KSIMD_SSE)
+    #include <immintrin.h>
+#endif
+
+/**
+ * @enum kmath_simd_path
+ * @brief The instruction set the batch kernels use, chosen once from the CPU features.
+ */
+typedef enum kmath_simd_path {
+    /** @brief Not chosen yet. */
+    KMATH_SIMD_PATH_UNRESOLVED = 0,
+    /** @brief Plain C. */
+    KMATH_SIMD_PATH_SCALAR,
+    /** @brief SSE2, 4 lanes. */
+    KMATH_SIMD_PATH_SSE2,
+    /** @brief AVX with FMA3, 8 lanes. */
+    KMATH_SIMD_PATH_AVX_FMA,
+    /** @brief NEON, 4 lanes. */
+    KMATH_SIMD_PATH_NEON
+} kmath_simd_path;
+
+/** @brief The chosen path. Resolving it twice from two threads gives the same answer, so a relaxed store is enough. */
+static i32 simd_path = KMATH_SIMD_PATH_UNRESOLVED;
+
+/** @brief Gets the path the batch kernels use, choosing it on the first call. */
+static kmath_simd_path kmath_get_simd_path() {
+    i32 path = katomic_load(&simd_path, KATOMIC_RELAXED);
+    if (path != KMATH_SIMD_PATH_UNRESOLVED) {
+        return (kmath_simd_path)path;
+    }
+
+#if defined(KSIMD_SSE)
+    path = kcpu_has_feature(KCPU_FEATURE_AVX) && kcpu_has_feature(KCPU_FEATURE_FMA) ? KMATH_SIMD_PATH_AVX_FMA : KMATH_SIMD_PATH_SSE2;
+#elif defined(KSIMD_NEON)
+    path = KMATH_SIMD_PATH_NEON;
+#else
+    path = KMATH_SIMD_PATH_SCALAR;
+#endif
+    katomic_store(&simd_path, path, KATOMIC_RELAXED);
+    return (kmath_simd_path)path;
+}
+
+f32 ksin(f32 x) {
+    return sinf(x);
+}
+
+f32 kcos(f32 x) {
+    return cosf(x);
+}
+
+f32 ktan(f32 x) {
+    return tanf(x);
+}
+
+f32 kacos(f32 x) {
+    return acosf(x);
+}
+
+f32 katan2(f32 y, f32 x) {
+    return atan2f(y, x);
+}
+
+f32 kmath_sqrt(f32 x) {
+    return sqrtf(x);
+}
+
+b8 vec3_soa_create(u32 capacity, vec3_soa* out_points) {
+    if (!out_points) {
+        KERROR("vec3_soa_create requires a valid pointer to hold the points.");
+        return FALSE;
+    }
+
+    kzero_memory(out_points, sizeof(vec3_soa));
+    // Rounding up lets callers pad a partial last step instead of special-casing it.
+    u32 rounded = (u32)KALIGN_UP(capacity ? capacity : 1, KMATH_SOA_WIDTH);
+    u64 size = sizeof(f32) * rounded;
+    out_points->x = kallocate_aligned(size, KMATH_SOA_ALIGNMENT, MEMORY_TAG_ARRAY);
+    out_points->y = kallocate_aligned(size, KMATH_SOA_ALIGNMENT, MEMORY_TAG_ARRAY);
+    out_points->z = kallocate_aligned(size, KMATH_SOA_ALIGNMENT, MEMORY_TAG_ARRAY);
+    out_points->capacity = rounded;
+    if (!out_points->x || !out_points->y || !out_points->z) {
+        KERROR("vec3_soa_create failed to allocate room for %u points.", rounded);
+        vec3_soa_destroy(out_points);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+void vec3_soa_destroy(vec3_soa* points) {
+    if (!points) {
+        return;
+    }
+
+    u64 size = sizeof(f32) * points->capacity;
+    if (points->x) {
+        kfree_aligned(points->x, size, KMATH_SOA_ALIGNMENT, MEMORY_TAG_ARRAY);
+    }
+    if (points->y) {
+        kfree_aligned(points->y, size, KMATH_SOA_ALIGNMENT, MEMORY_TAG_ARRAY);
+    }
+    if (points->z) {
+        kfree_aligned(points->z, size, KMATH_SOA_ALIGNMENT, MEMORY_TAG_ARRAY);
+    }
+    kzero_memory(points, sizeof(vec3_soa));
+}
+
+
+// ------------------------------------------
+// Point transforms
+// ------------------------------------------
+
+/** @brief Transforms points [start, end) one at a time. Handles the tail the vector kernels leave. */
+static void transform_points_scalar(const mat4* m, const vec3_soa* in, vec3_soa* out, u32 start, u32 end) {
+    const f32* d = m->data;
+    for (u32 i = start; i < end; ++i) {
+        f32 x = in->x[i], y = in->y[i], z = in->z[i];
+        out->x[i] = d[0] * x + d[4] * y + d[8] * z + d[12];
+        out->y[i] = d[1] * x + d[5] * y + d[9] * z + d[13];
+        out->z[i] = d[2] * x + d[6] * y + d[10] * z + d[14];
+    }
+}
+
+#if defined(KSIMD_SSE)
+
+/** @brief Transforms the points 4 at a time with SSE. @return The number of points transformed. */
+static u32 transform_points_sse2(const mat4* m, const vec3_soa* in, vec3_soa* out, u32 count) {
+    const f32* d = m->data;
+    __m128 m0 = _mm_set1_ps(d[0]), m1 = _mm_set1_ps(d[1]), m2 = _mm_set1_ps(d[2]);
+    __m128 m4 = _mm_set1_ps(d[4]), m5 = _mm_set1_ps(d[5]), m6 = _mm_set1_ps(d[6]);
+    __m128 m8 = _mm_set1_ps(d[8]), m9 = _mm_set1_ps(d[9]), m10 = _mm_set1_ps(d[10]);
+    __m128 m12 = _mm_set1_ps(d[12]), m13 = _mm_set1_ps(d[13]), m14 = _mm_set1_ps(d[14]);
+
+    u32 done = count & ~3u;
+    for (u32 i = 0; i < done; i += 4) {
+        __m128 x = _mm_loadu_ps(in->x + i);
+        __m128 y = _mm_loadu_ps(in->y + i);
+        __m128 z = _mm_loadu_ps(in->z + i);
+        __m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m0, x), _mm_mul_ps(m4, y)), _mm_add_ps(_mm_mul_ps(m8, z), m12));
+        __m128 ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m1, x), _mm_mul_ps(m5, y)), _mm_add_ps(_mm_mul_ps(m9, z), m13));
+        __m128 rz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m2, x), _mm_mul_ps(m6, y)), _mm_add_ps(_mm_mul_ps(m10, z), m14));
+        _mm_storeu_ps(out->x + i, rx);
+        _mm_storeu_ps(out->y + i, ry);
+        _mm_storeu_ps(out->z + i, rz);
+    }
+    return done;
+}
+
+/** @brief Transforms the points 8 at a time with AVX and FMA. @return The number of points transformed. */
+__attribute__((target("avx,fma"))) static u32 transform_points_avx_fma(const mat4* m, const vec3_soa* in, vec3_soa* out, u32 count) {
+    const f32* d = m->data;
+    __m256 m0 = _mm256_set1_ps(d[0]), m1 = _mm256_set1_ps(d[1]), m2 = _mm256_set1_ps(d[2]);
+    __m256 m4 = _mm256_set1_ps(d[4]), m5 = _mm256_set1_ps(d[5]), m6 = _mm256_set1_ps(d[6]);
+    __m256 m8 = _mm256_set1_ps(d[8]), m9 = _mm256_set1_ps(d[9]), m10 = _mm256_set1_ps(d[10]);
+    __m256 m12 = _mm256_set1_ps(d[12]), m13 = _mm256_set1_ps(d[13]), m14 = _mm256_set1_ps(d[14]);
+
+    u32 done = count & ~7u;
+    for (u32 i = 0; i < done; i += 8) {
+        __m256 x = _mm256_loadu_ps(in->x + i);
+        __m256 y = _mm256_loadu_ps(in->y + i);
+        __m256 z = _mm256_loadu_ps(in->z + i);
+        __m256 rx = _mm256_fmadd_ps(m0, x, _mm256_fmadd_ps(m4, y, _mm256_fmadd_ps(m8, z, m12)));
+        __m256 ry = _mm256_fmadd_ps(m1, x, _mm256_fmadd_ps(m5, y, _mm256_fmadd_ps(m9, z, m13)));
+        __m256 rz = _mm256_fmadd_ps(m2, x, _mm256_fmadd_ps(m6, y, _mm256_fmadd_ps(m10, z, m14)));
+        _mm256_storeu_ps(out->x + i, rx);
+        _mm256_storeu_ps(out->y + i, ry);
+        _mm256_storeu_ps(out->z + i, rz);
+    }
+    return done;
+}
+
+#endif
+
+#if defined(KSIMD_NEON)
+
+/** @brief Transforms the points 4 at a time with NEON. @return The number of points transformed. */
+static u32 transform_points_neon(const mat4* m, const vec3_soa* in, vec3_soa* out, u32 count) {
+    const f32* d = m->data;
+    u32 done = count & ~3u;
+    for (u32 i = 0; i < done; i += 4) {
+        float32x4_t x = vld1q_f32(in->x + i);
+        float32x4_t y = vld1q_f32(in->y + i);
+        float32x4_t z = vld1q_f32(in->z + i);
+        float32x4_t rx = vfmaq_n_f32(vfmaq_n_f32(vfmaq_n_f32(vdupq_n_f32(d[12]), z, d[8]), y, d[4]), x, d[0]);
+        float32x4_t ry = vfmaq_n_f32(vfmaq_n_f32(vfmaq_n_f32(vdupq_n_f32(d[13]), z, d[9]), y, d[5]), x, d[1]);
+        float32x4_t rz = vfmaq_n_f32(vfmaq_n_f32(vfmaq_n_f32(vdupq_n_f32(d[14]), z, d[10]), y, d[6]), x, d[2]);
+        vst1q_f32(out->x + i, rx);
+        vst1q_f32(out->y + i, ry);
+        vst1q_f32(out->z + i, rz);
+    }
+    return done;
+}
+
+#endif
+
+void kmath_transform_points(const mat4* m, const vec3_soa* in, vec3_soa* out) {
+    if (!m || !in || !out || out->capacity < in->count) {
+        KERROR("kmath_transform_points requires a matrix and an output with room for every input point.");
+        return;
+    }
+
+    // Copied so that the kernels see the same matrix however `out` aliases it.
+    mat4 transform = *m;
+    u32 count = in->count;
+    u32 done = 0;
+    switch (kmath_get_simd_path()) {
+#if defined(KSIMD_SSE)
+        case KMATH_SIMD_PATH_AVX_FMA: done = transform_points_avx_fma(&transform, in, out, count); break;
+        case KMATH_SIMD_PATH_SSE2: done = transform_points_sse2(&transform, in, out, count); break;
+#endif
+#if defined(KSIMD_NEON)
+        case KMATH_SIMD_PATH_NEON: done = transform_points_neon(&transform, in, out, count); break;
+#endif
+        default: break;
+    }
+    transform_points_scalar(&transform, in, out, done, count);
+    out->count = count;
+}
+
+
+// ------------------------------------------
+// Matrix products
+// ------------------------------------------
+
+#if defined(KSIMD_SSE)
+
+/**
+ * @brief Multiplies two matrices with AVX and FMA, two result columns per register.
+ * @details Both operands are loaded before anything is stored, so `out` may alias either.
+ */
+__attribute__((target("avx,fma"))) static inline void mat4_mul_avx_fma(const mat4* a, const mat4* b, mat4* out) {
+    // Each column of `a`, repeated in both 128-bit halves.
+    __m256 a0 = _mm256_broadcast_ps(&a->columns[0].simd);
+    __m256 a1 = _mm256_broadcast_ps(&a->columns[1].simd);
+    __m256 a2 = _mm256_broadcast_ps(&a->columns[2].simd);
+    __m256 a3 = _mm256_broadcast_ps(&a->columns[3].simd);
+    // Columns 0 and 1 of `b`, then 2 and 3.
+    __m256 b01 = _mm256_loadu_ps(&b->data[0]);
+    __m256 b23 = _mm256_loadu_ps(&b->data[8]);
+
+    // Shuffling with one index splats that element of each half: the weights for two columns at once.
+    __m256 r01 = _mm256_mul_ps(a0, _mm256_shuffle_ps(b01, b01, 0x00));
+    r01 = _mm256_fmadd_ps(a1, _mm256_shuffle_ps(b01, b01, 0x55), r01);
+    r01 = _mm256_fmadd_ps(a2, _mm256_shuffle_ps(b01, b01, 0xAA), r01);
+    r01 = _mm256_fmadd_ps(a3, _mm256_shuffle_ps(b01, b01, 0xFF), r01);
+
+    __m256 r23 = _mm256_mul_ps(a0, _mm256_shuffle_ps(b23, b23, 0x00));
+    r23 = _mm256_fmadd_ps(a1, _mm256_shuffle_ps(b23, b23, 0x55), r23);
+    r23 = _mm256_fmadd_ps(a2, _mm256_shuffle_ps(b23, b23, 0xAA), r23);
+    r23 = _mm256_fmadd_ps(a3, _mm256_shuffle_ps(b23, b23, 0xFF), r23);
+
+    _mm256_storeu_ps(&out->data[0], r01);
+    _mm256_storeu_ps(&out->data[8], r23);
+}
+
+/** @brief The AVX/FMA variant of kmath_mat4_mul_batch. */
+__attribute__((target("avx,fma"))) static void mat4_mul_batch_avx_fma(const mat4* a, const mat4* b, mat4* out, u32 count) {
+    for (u32 i = 0; i < count; ++i) {
+        mat4_mul_avx_fma(&a[i], &b[i], &out[i]);
+    }
+}
+
+/** @brief The AVX/FMA variant of kmath_mat4_premul_batch. */
+__attribute__((target("avx,fma"))) static void mat4_premul_batch_avx_fma(const mat4* m, const mat4* in, mat4* out, u32 count) {
+    for (u32 i = 0; i < count; ++i) {
+        mat4_mul_avx_fma(m, &in[i], &out[i]);
+    }
+}
+
+#endif
+
+void kmath_mat4_mul_batch(const mat4* a, const mat4* b, mat4* out, u32 count) {
+#if defined(KSIMD_SSE)
+    if (kmath_get_simd_path() == KMATH_SIMD_PATH_AVX_FMA) {
+        mat4_mul_batch_avx_fma(a, b, out, count);
+        return;
+    }
+#endif
+    // mat4_mul is already SSE or NEON where the build has them.
+    for (u32 i = 0; i < count; ++i) {
+        out[i] = mat4_mul(&a[i], &b[i]);
+    }
+}
+
+void kmath_mat4_premul_batch(const mat4* m, const mat4* in, mat4* out, u32 count) {
+    // Copied so that `m` stays intact if it is one of the outputs.
+    mat4 left = *m;
+#if defined(KSIMD_SSE)
+    if (kmath_get_simd_path() == KMATH_SIMD_PATH_AVX_FMA) {
+        mat4_premul_batch_avx_fma(&left, in, out, count);
+        return;
+    }
+#endif
+    for (u32 i = 0; i < count; ++i) {
+        out[i] = mat4_mul(&left, &in[i]);
+    }
+}
+
+const char* kmath_simd_path_name() {
+    static const char* names[] = {"unresolved", "scalar", "SSE2", "AVX+FMA", "NEON"};
+    return names[kmath_get_simd_path()];
+}
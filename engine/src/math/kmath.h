@@ -0,0 +1,863 @@
+#pragma once
+
+/**
+ * @file kmath.h
+ * @brief This file contains the engine's math library: scalar helpers, vectors, quaternions,
+ * matrices, and batch kernels over arrays of them.
+ *
+ * @details Single-value operations are inline, so they compile down to a few instructions
+ * at the call site. The vec4, quat and mat4 operations that benefit use SSE or NEON when the
+ * build has them (see the instruction set detection in defines.h), and plain C otherwise.
+ *
+ * The batch kernels (kmath_transform_points, kmath_mat4_mul_batch, kmath_mat4_premul_batch)
+ * process whole arrays in one call. They live in kmath.c, where on x86-64 an AVX/FMA variant
+ * is compiled alongside the SSE one and picked at runtime with kcpu_has_feature, the same
+ * way kmemory_stream_copy is. Points are passed in SoA form (vec3_soa), so that 8 of them fill
+ * one AVX register per component.
+ *
+ * See math_types.h for the conventions (column-major matrices, column vectors).
+ * @copyright Copyright (c) 2025
+ */
+
+#include "math/math_types.h"
+
+/** @brief An approximation of pi. */
+#define K_PI 3.14159265358979323846f
+
+/** @brief An approximation of pi multiplied by 2. */
+#define K_2PI (2.0f * K_PI)
+
+/** @brief An approximation of pi divided by 2. */
+#define K_HALF_PI (0.5f * K_PI)
+
+/** @brief An approximation of pi divided by 4. */
+#define K_QUARTER_PI (0.25f * K_PI)
+
+/** @brief One divided by an approximation of pi. */
+#define K_ONE_OVER_PI (1.0f / K_PI)
+
+/** @brief An approximation of the square root of 2. */
+#define K_SQRT_TWO 1.41421356237309504880f
+
+/** @brief The multiplier converting degrees to radians. */
+#define K_DEG2RAD_MULTIPLIER (K_PI / 180.0f)
+
+/** @brief The multiplier converting radians to degrees. */
+#define K_RAD2DEG_MULTIPLIER (180.0f / K_PI)
+
+/** @brief The smallest positive f32 `x` for which `1.0f + x != 1.0f`. */
+#define K_FLOAT_EPSILON 1.192092896e-07f
+
+/** @brief The alignment of the arrays of a vec3_soa: one AVX register. */
+#define KMATH_SOA_ALIGNMENT 32
+
+/** @brief The number of points the batch kernels process per step at most. vec3_soa capacities are rounded up to it. */
+#define KMATH_SOA_WIDTH 8
+
+
+// ------------------------------------------
+// Scalar functions
+// ------------------------------------------
+
+/**
+ * @brief Gets the sine of an angle.
+ * @param x The angle in radians.
+ * @return The sine of `x`.
+ */
+KAPI f32 ksin(f32 x);
+
+/**
+ * @brief Gets the cosine of an angle.
+ * @param x The angle in radians.
+ * @return The cosine of `x`.
+ */
+KAPI f32 kcos(f32 x);
+
+/**
+ * @brief Gets the tangent of an angle.
+ * @param x The angle in radians.
+ * @return The tangent of `x`.
+ */
+KAPI f32 ktan(f32 x);
+
+/**
+ * @brief Gets the arc cosine of a value.
+ * @param x The value, in [-1, 1].
+ * @return The angle in radians, in [0, pi].
+ */
+KAPI f32 kacos(f32 x);
+
+/**
+ * @brief Gets the angle of the vector (x, y) from the x axis.
+ * @param y The y component.
+ * @param x The x component.
+ * @return The angle in radians, in [-pi, pi].
+ */
+KAPI f32 katan2(f32 y, f32 x);
+
+/**
+ * @brief Gets the square root of a value through the C library. Prefer ksqrt, which is inline where the instruction set has a square root.
+ * @param x The value. Must not be negative.
+ * @return The square root of `x`.
+ */
+KAPI f32 kmath_sqrt(f32 x);
+
+/** @brief Gets the square root of a value. */
+static inline f32 ksqrt(f32 x) {
+#if defined(KSIMD_SSE)
+    return _mm_cvtss_f32(_mm_sqrt_ss(_mm_set_ss(x)));
+#elif defined(KSIMD_NEON)
+    return vget_lane_f32(vsqrt_f32(vdup_n_f32(x)), 0);
+#else
+    return kmath_sqrt(x);
+#endif
+}
+
+/** @brief Gets the absolute value of a value. */
+static inline f32 kabs(f32 x) {
+    return x < 0.0f ? -x : x;
+}
+
+/** @brief Gets the smaller of two values. */
+static inline f32 kmin(f32 a, f32 b) {
+    return a < b ? a : b;
+}
+
+/** @brief Gets the larger of two values. */
+static inline f32 kmax(f32 a, f32 b) {
+    return a > b ? a : b;
+}
+
+/** @brief Interpolates linearly from `a` (t = 0) to `b` (t = 1). */
+static inline f32 klerp(f32 a, f32 b, f32 t) {
+    return a + (b - a) * t;
+}
+
+/** @brief Converts degrees to radians. */
+static inline f32 deg_to_rad(f32 degrees) {
+    return degrees * K_DEG2RAD_MULTIPLIER;
+}
+
+/** @brief Converts radians to degrees. */
+static inline f32 rad_to_deg(f32 radians) {
+    return radians * K_RAD2DEG_MULTIPLIER;
+}
+
+
+// ------------------------------------------
+// Vector 2
+// ------------------------------------------
+
+/** @brief Creates a vec2. */
+static inline vec2 vec2_create(f32 x, f32 y) {
+    return (vec2){{x, y}};
+}
+
+/** @brief Gets the zero vector. */
+static inline vec2 vec2_zero() {
+    return (vec2){{0.0f, 0.0f}};
+}
+
+/** @brief Gets the vector with every component set to 1. */
+static inline vec2 vec2_one() {
+    return (vec2){{1.0f, 1.0f}};
+}
+
+/** @brief Adds two vectors. */
+static inline vec2 vec2_add(vec2 a, vec2 b) {
+    return (vec2){{a.x + b.x, a.y + b.y}};
+}
+
+/** @brief Subtracts `b` from `a`. */
+static inline vec2 vec2_sub(vec2 a, vec2 b) {
+    return (vec2){{a.x - b.x, a.y - b.y}};
+}
+
+/** @brief Multiplies two vectors component-wise. */
+static inline vec2 vec2_mul(vec2 a, vec2 b) {
+    return (vec2){{a.x * b.x, a.y * b.y}};
+}
+
+/** @brief Multiplies every component of a vector by a scalar. */
+static inline vec2 vec2_mul_scalar(vec2 v, f32 scalar) {
+    return (vec2){{v.x * scalar, v.y * scalar}};
+}
+
+/** @brief Divides `a` by `b` component-wise. */
+static inline vec2 vec2_div(vec2 a, vec2 b) {
+    return (vec2){{a.x / b.x, a.y / b.y}};
+}
+
+/** @brief Gets the squared length of a vector. Cheaper than vec2_length when only comparing. */
+static inline f32 vec2_length_squared(vec2 v) {
+    return v.x * v.x + v.y * v.y;
+}
+
+/** @brief Gets the length of a vector. */
+static inline f32 vec2_length(vec2 v) {
+    return ksqrt(vec2_length_squared(v));
+}
+
+/** @brief Gets a vector with the same direction and a length of 1. */
+static inline vec2 vec2_normalized(vec2 v) {
+    return vec2_mul_scalar(v, 1.0f / vec2_length(v));
+}
+
+/** @brief Gets the distance between two points. */
+static inline f32 vec2_distance(vec2 a, vec2 b) {
+    return vec2_length(vec2_sub(a, b));
+}
+
+/** @brief Checks if every component of two vectors differs by at most `tolerance`. */
+static inline b8 vec2_compare(vec2 a, vec2 b, f32 tolerance) {
+    return kabs(a.x - b.x) <= tolerance && kabs(a.y - b.y) <= tolerance;
+}
+
+
+// ------------------------------------------
+// Vector 3
+// ------------------------------------------
+
+/** @brief Creates a vec3. */
+static inline vec3 vec3_create(f32 x, f32 y, f32 z) {
+    return (vec3){{x, y, z}};
+}
+
+/** @brief Gets the zero vector. */
+static inline vec3 vec3_zero() {
+    return (vec3){{0.0f, 0.0f, 0.0f}};
+}
+
+/** @brief Gets the vector with every component set to 1. */
+static inline vec3 vec3_one() {
+    return (vec3){{1.0f, 1.0f, 1.0f}};
+}
+
+/** @brief Gets the up vector (0, 1, 0). */
+static inline vec3 vec3_up() {
+    return (vec3){{0.0f, 1.0f, 0.0f}};
+}
+
+/** @brief Gets the right vector (1, 0, 0). */
+static inline vec3 vec3_right() {
+    return (vec3){{1.0f, 0.0f, 0.0f}};
+}
+
+/** @brief Gets the forward vector (0, 0, -1), as the camera looks down -z. */
+static inline vec3 vec3_forward() {
+    return (vec3){{0.0f, 0.0f, -1.0f}};
+}
+
+/** @brief Gets the first three components of a vec4. */
+static inline vec3 vec3_from_vec4(vec4 v) {
+    return (vec3){{v.x, v.y, v.z}};
+}
+
+/** @brief Adds two vectors. */
+static inline vec3 vec3_add(vec3 a, vec3 b) {
+    return (vec3){{a.x + b.x, a.y + b.y, a.z + b.z}};
+}
+
+/** @brief Subtracts `b` from `a`. */
+static inline vec3 vec3_sub(vec3 a, vec3 b) {
+    return (vec3){{a.x - b.x, a.y - b.y, a.z - b.z}};
+}
+
+/** @brief Multiplies two vectors component-wise. */
+static inline vec3 vec3_mul(vec3 a, vec3 b) {
+    return (vec3){{a.x * b.x, a.y * b.y, a.z * b.z}};
+}
+
+/** @brief Multiplies every component of a vector by a scalar. */
+static inline vec3 vec3_mul_scalar(vec3 v, f32 scalar) {
+    return (vec3){{v.x * scalar, v.y * scalar, v.z * scalar}};
+}
+
+/** @brief Divides `a` by `b` component-wise. */
+static inline vec3 vec3_div(vec3 a, vec3 b) {
+    return (vec3){{a.x / b.x, a.y / b.y, a.z / b.z}};
+}
+
+/** @brief Gets the dot product of two vectors. */
+static inline f32 vec3_dot(vec3 a, vec3 b) {
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+/** @brief Gets the cross product of two vectors, perpendicular to both (right-handed). */
+static inline vec3 vec3_cross(vec3 a, vec3 b) {
+    return (vec3){{a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x}};
+}
+
+/** @brief Gets the squared length of a vector. Cheaper than vec3_length when only comparing. */
+static inline f32 vec3_length_squared(vec3 v) {
+    return vec3_dot(v, v);
+}
+
+/** @brief Gets the length of a vector. */
+static inline f32 vec3_length(vec3 v) {
+    return ksqrt(vec3_length_squared(v));
+}
+
+/** @brief Gets a vector with the same direction and a length of 1. */
+static inline vec3 vec3_normalized(vec3 v) {
+    return vec3_mul_scalar(v, 1.0f / vec3_length(v));
+}
+
+/** @brief Gets the distance between two points. */
+static inline f32 vec3_distance(vec3 a, vec3 b) {
+    return vec3_length(vec3_sub(a, b));
+}
+
+/** @brief Checks if every component of two vectors differs by at most `tolerance`. */
+static inline b8 vec3_compare(vec3 a, vec3 b, f32 tolerance) {
+    return kabs(a.x - b.x) <= tolerance && kabs(a.y - b.y) <= tolerance && kabs(a.z - b.z) <= tolerance;
+}
+
+
+// ------------------------------------------
+// Vector 4
+// ------------------------------------------
+
+/** @brief Creates a vec4. */
+static inline vec4 vec4_create(f32 x, f32 y, f32 z, f32 w) {
+    vec4 out;
+#if defined(KSIMD_SSE)
+    out.simd = _mm_setr_ps(x, y, z, w);
+#else
+    out.x = x;
+    out.y = y;
+    out.z = z;
+    out.w = w;
+#endif
+    return out;
+}
+
+/** @brief Gets the zero vector. */
+static inline vec4 vec4_zero() {
+    return vec4_create(0.0f, 0.0f, 0.0f, 0.0f);
+}
+
+/** @brief Gets the vector with every component set to 1. */
+static inline vec4 vec4_one() {
+    return vec4_create(1.0f, 1.0f, 1.0f, 1.0f);
+}
+
+/** @brief Extends a vec3 with a fourth component: 1 for points, 0 for directions. */
+static inline vec4 vec4_from_vec3(vec3 v, f32 w) {
+    return vec4_create(v.x, v.y, v.z, w);
+}
+
+/** @brief Adds two vectors. */
+static inline vec4 vec4_add(vec4 a, vec4 b) {
+    vec4 out;
+#if defined(KSIMD_SSE)
+    out.simd = _mm_add_ps(a.simd, b.simd);
+#elif defined(KSIMD_NEON)
+    out.simd = vaddq_f32(a.simd, b.simd);
+#else
+    for (u32 i = 0; i < 4; ++i) {
+        out.elements[i] = a.elements[i] + b.elements[i];
+    }
+#endif
+    return out;
+}
+
+/** @brief Subtracts `b` from `a`. */
+static inline vec4 vec4_sub(vec4 a, vec4 b) {
+    vec4 out;
+#if defined(KSIMD_SSE)
+    out.simd = _mm_sub_ps(a.simd, b.simd);
+#elif defined(KSIMD_NEON)
+    out.simd = vsubq_f32(a.simd, b.simd);
+#else
+    for (u32 i = 0; i < 4; ++i) {
+        out.elements[i] = a.elements[i] - b.elements[i];
+    }
+#endif
+    return out;
+}
+
+/** @brief Multiplies two vectors component-wise. */
+static inline vec4 vec4_mul(vec4 a, vec4 b) {
+    vec4 out;
+#if defined(KSIMD_SSE)
+    out.simd = _mm_mul_ps(a.simd, b.simd);
+#elif defined(KSIMD_NEON)
+    out.simd = vmulq_f32(a.simd, b.simd);
+#else
+    for (u32 i = 0; i < 4; ++i) {
+        out.elements[i] = a.elements[i] * b.elements[i];
+    }
+#endif
+    return out;
+}
+
+/** @brief Multiplies every component of a vector by a scalar. */
+static inline vec4 vec4_mul_scalar(vec4 v, f32 scalar) {
+    vec4 out;
+#if defined(KSIMD_SSE)
+    out.simd = _mm_mul_ps(v.simd, _mm_set1_ps(scalar));
+#elif defined(KSIMD_NEON)
+    out.simd = vmulq_n_f32(v.simd, scalar);
+#else
+    for (u32 i = 0; i < 4; ++i) {
+        out.elements[i] = v.elements[i] * scalar;
+    }
+#endif
+    return out;
+}
+
+/** @brief Divides `a` by `b` component-wise. */
+static inline vec4 vec4_div(vec4 a, vec4 b) {
+    vec4 out;
+#if defined(KSIMD_SSE)
+    out.simd = _mm_div_ps(a.simd, b.simd);
+#elif defined(KSIMD_NEON)
+    out.simd = vdivq_f32(a.simd, b.simd);
+#else
+    for (u32 i = 0; i < 4; ++i) {
+        out.elements[i] = a.elements[i] / b.elements[i];
+    }
+#endif
+    return out;
+}
+
+/** @brief Gets the dot product of two vectors. */
+static inline f32 vec4_dot(vec4 a, vec4 b) {
+#if defined(KSIMD_NEON)
+    return vaddvq_f32(vmulq_f32(a.simd, b.simd));
+#else
+    // SSE2 has no horizontal add worth its latency here; the scalar sum is as fast.
+    return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+#endif
+}
+
+/** @brief Gets the squared length of a vector. */
+static inline f32 vec4_length_squared(vec4 v) {
+    return vec4_dot(v, v);
+}
+
+/** @brief Gets the length of a vector. */
+static inline f32 vec4_length(vec4 v) {
+    return ksqrt(vec4_length_squared(v));
+}
+
+/** @brief Gets a vector with the same direction and a length of 1. */
+static inline vec4 vec4_normalized(vec4 v) {
+    return vec4_mul_scalar(v, 1.0f / vec4_length(v));
+}
+
+
+// ------------------------------------------
+// Quaternion
+// ------------------------------------------
+
+/** @brief Gets the identity rotation. */
+static inline quat quat_identity() {
+    return vec4_create(0.0f, 0.0f, 0.0f, 1.0f);
+}
+
+/** @brief Gets the norm (length) of a quaternion. */
+static inline f32 quat_normal(quat q) {
+    return vec4_length(q);
+}
+
+/** @brief Gets a quaternion scaled to unit length, as rotations must be. */
+static inline quat quat_normalize(quat q) {
+    return vec4_normalized(q);
+}
+
+/** @brief Gets the conjugate of a quaternion. For unit quaternions, the opposite rotation. */
+static inline quat quat_conjugate(quat q) {
+    return vec4_create(-q.x, -q.y, -q.z, q.w);
+}
+
+/** @brief Gets the inverse of a quaternion. */
+static inline quat quat_inverse(quat q) {
+    return vec4_mul_scalar(quat_conjugate(q), 1.0f / vec4_length_squared(q));
+}
+
+/** @brief Gets the dot product of two quaternions. */
+static inline f32 quat_dot(quat a, quat b) {
+    return vec4_dot(a, b);
+}
+
+/**
+ * @brief Multiplies two quaternions.
+ * @return `a * b`: the rotation by `b`, then by `a`.
+ */
+static inline quat quat_mul(quat a, quat b) {
+    return vec4_create(a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+                       a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+                       a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+                       a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z);
+}
+
+/**
+ * @brief Creates a rotation around an axis.
+ * @param axis The axis. Must be normalized.
+ * @param angle The angle in radians, counter-clockwise when looking down the axis.
+ * @return The rotation.
+ */
+static inline quat quat_from_axis_angle(vec3 axis, f32 angle) {
+    f32 half = 0.5f * angle;
+    f32 s = ksin(half);
+    return vec4_create(axis.x * s, axis.y * s, axis.z * s, kcos(half));
+}
+
+/** @brief Rotates a vector by a unit quaternion. */
+static inline vec3 quat_rotate(quat q, vec3 v) {
+    // v + 2w(u x v) + 2(u x (u x v)), with u the vector part, which avoids building a matrix.
+    vec3 u = {{q.x, q.y, q.z}};
+    vec3 t = vec3_mul_scalar(vec3_cross(u, v), 2.0f);
+    return vec3_add(vec3_add(v, vec3_mul_scalar(t, q.w)), vec3_cross(u, t));
+}
+
+/**
+ * @brief Interpolates spherically between two rotations, at constant angular speed.
+ * @param a The rotation at t = 0. Must be normalized.
+ * @param b The rotation at t = 1. Must be normalized.
+ * @param t The interpolation factor, in [0, 1].
+ * @return The normalized rotation in between, along the shortest arc.
+ */
+static inline quat quat_slerp(quat a, quat b, f32 t) {
+    f32 cosine = quat_dot(a, b);
+
+    // q and -q are the same rotation; flipping one takes the shorter way around.
+    if (cosine < 0.0f) {
+        b = vec4_mul_scalar(b, -1.0f);
+        cosine = -cosine;
+    }
+
+    // Nearly parallel: the sine below would vanish, and a normalized lerp is as accurate.
+    if (cosine > 0.9995f) {
+        return quat_normalize(vec4_add(a, vec4_mul_scalar(vec4_sub(b, a), t)));
+    }
+
+    f32 theta_0 = kacos(cosine);
+    f32 theta = theta_0 * t;
+    f32 sin_theta = ksin(theta);
+    f32 sin_theta_0 = ksin(theta_0);
+    f32 s0 = kcos(theta) - cosine * sin_theta / sin_theta_0;
+    f32 s1 = sin_theta / sin_theta_0;
+    return vec4_add(vec4_mul_scalar(a, s0), vec4_mul_scalar(b, s1));
+}
+
+
+// ------------------------------------------
+// Matrix 4x4
+// ------------------------------------------
+
+/** @brief Gets the identity matrix. */
+static inline mat4 mat4_identity() {
+    mat4 m = {0};
+    m.data[0] = 1.0f;
+    m.data[5] = 1.0f;
+    m.data[10] = 1.0f;
+    m.data[15] = 1.0f;
+    return m;
+}
+
+/**
+ * @brief Multiplies two matrices.
+ * @return `a * b`: the transform that applies `b`, then `a`.
+ */
+static inline mat4 mat4_mul(const mat4* a, const mat4* b) {
+    mat4 out;
+    // Each column of the result is the columns of `a` weighted by one column of `b`.
+    for (u32 column = 0; column < 4; ++column) {
+        const f32* weights = &b->data[column * 4];
+#if defined(KSIMD_SSE)
+        __m128 result = _mm_mul_ps(a->columns[0].simd, _mm_set1_ps(weights[0]));
+        result = _mm_add_ps(result, _mm_mul_ps(a->columns[1].simd, _mm_set1_ps(weights[1])));
+        result = _mm_add_ps(result, _mm_mul_ps(a->columns[2].simd, _mm_set1_ps(weights[2])));
+        out.columns[column].simd = _mm_add_ps(result, _mm_mul_ps(a->columns[3].simd, _mm_set1_ps(weights[3])));
+#elif defined(KSIMD_NEON)
+        float32x4_t result = vmulq_n_f32(a->columns[0].simd, weights[0]);
+        result = vfmaq_n_f32(result, a->columns[1].simd, weights[1]);
+        result = vfmaq_n_f32(result, a->columns[2].simd, weights[2]);
+        out.columns[column].simd = vfmaq_n_f32(result, a->columns[3].simd, weights[3]);
+#else
+        for (u32 row = 0; row < 4; ++row) {
+            out.data[column * 4 + row] = a->data[0 * 4 + row] * weights[0] + a->data[1 * 4 + row] * weights[1] +
+                                         a->data[2 * 4 + row] * weights[2] + a->data[3 * 4 + row] * weights[3];
+        }
+#endif
+    }
+    return out;
+}
+
+/** @brief Transforms a vector by a matrix: `m * v`. */
+static inline vec4 mat4_mul_vec4(const mat4* m, vec4 v) {
+    vec4 out;
+#if defined(KSIMD_SSE)
+    __m128 result = _mm_mul_ps(m->columns[0].simd, _mm_set1_ps(v.x));
+    result = _mm_add_ps(result, _mm_mul_ps(m->columns[1].simd, _mm_set1_ps(v.y)));
+    result = _mm_add_ps(result, _mm_mul_ps(m->columns[2].simd, _mm_set1_ps(v.z)));
+    out.simd = _mm_add_ps(result, _mm_mul_ps(m->columns[3].simd, _mm_set1_ps(v.w)));
+#elif defined(KSIMD_NEON)
+    float32x4_t result = vmulq_n_f32(m->columns[0].simd, v.x);
+    result = vfmaq_n_f32(result, m->columns[1].simd, v.y);
+    result = vfmaq_n_f32(result, m->columns[2].simd, v.z);
+    out.simd = vfmaq_n_f32(result, m->columns[3].simd, v.w);
+#else
+    for (u32 row = 0; row < 4; ++row) {
+        out.elements[row] = m->data[row] * v.x + m->data[4 + row] * v.y + m->data[8 + row] * v.z + m->data[12 + row] * v.w;
+    }
+#endif
+    return out;
+}
+
+/** @brief Transforms a point (w = 1) by a matrix, without the perspective divide. */
+static inline vec3 mat4_transform_point(const mat4* m, vec3 point) {
+    return vec3_from_vec4(mat4_mul_vec4(m, vec4_from_vec3(point, 1.0f)));
+}
+
+/** @brief Transforms a direction (w = 0) by a matrix, ignoring the translation. */
+static inline vec3 mat4_transform_direction(const mat4* m, vec3 direction) {
+    return vec3_from_vec4(mat4_mul_vec4(m, vec4_from_vec3(direction, 0.0f)));
+}
+
+/** @brief Gets the transpose of a matrix. */
+static inline mat4 mat4_transposed(const mat4* m) {
+    mat4 out = *m;
+#if defined(KSIMD_SSE)
+    _MM_TRANSPOSE4_PS(out.columns[0].simd, out.columns[1].simd, out.columns[2].simd, out.columns[3].simd);
+#else
+    for (u32 column = 0; column < 4; ++column) {
+        for (u32 row = 0; row < 4; ++row) {
+            out.data[column * 4 + row] = m->data[row * 4 + column];
+        }
+    }
+#endif
+    return out;
+}
+
+/**
+ * @brief Gets the inverse of a matrix.
+ * @param m The matrix. Must be invertible.
+ * @return The inverse, such that `m * inverse` is the identity.
+ */
+static inline mat4 mat4_inverse(const mat4* m) {
+    const f32* d = m->data;
+
+    // The 2x2 minors of the bottom two and top two rows, shared by the cofactors.
+    f32 s0 = d[0] * d[5] - d[4] * d[1];
+    f32 s1 = d[0] * d[9] - d[8] * d[1];
+    f32 s2 = d[0] * d[13] - d[12] * d[1];
+    f32 s3 = d[4] * d[9] - d[8] * d[5];
+    f32 s4 = d[4] * d[13] - d[12] * d[5];
+    f32 s5 = d[8] * d[13] - d[12] * d[9];
+    f32 c5 = d[10] * d[15] - d[14] * d[11];
+    f32 c4 = d[6] * d[15] - d[14] * d[7];
+    f32 c3 = d[6] * d[11] - d[10] * d[7];
+    f32 c2 = d[2] * d[15] - d[14] * d[3];
+    f32 c1 = d[2] * d[11] - d[10] * d[3];
+    f32 c0 = d[2] * d[7] - d[6] * d[3];
+
+    f32 inverse_determinant = 1.0f / (s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0);
+
+    mat4 out;
+    f32* o = out.data;
+    o[0] = (d[5] * c5 - d[9] * c4 + d[13] * c3) * inverse_determinant;
+    o[1] = (-d[1] * c5 + d[9] * c2 - d[13] * c1) * inverse_determinant;
+    o[2] = (d[1] * c4 - d[5] * c2 + d[13] * c0) * inverse_determinant;
+    o[3] = (-d[1] * c3 + d[5] * c1 - d[9] * c0) * inverse_determinant;
+    o[4] = (-d[4] * c5 + d[8] * c4 - d[12] * c3) * inverse_determinant;
+    o[5] = (d[0] * c5 - d[8] * c2 + d[12] * c1) * inverse_determinant;
+    o[6] = (-d[0] * c4 + d[4] * c2 - d[12] * c0) * inverse_determinant;
+    o[7] = (d[0] * c3 - d[4] * c1 + d[8] * c0) * inverse_determinant;
+    o[8] = (d[7] * s5 - d[11] * s4 + d[15] * s3) * inverse_determinant;
+    o[9] = (-d[3] * s5 + d[11] * s2 - d[15] * s1) * inverse_determinant;
+    o[10] = (d[3] * s4 - d[7] * s2 + d[15] * s0) * inverse_determinant;
+    o[11] = (-d[3] * s3 + d[7] * s1 - d[11] * s0) * inverse_determinant;
+    o[12] = (-d[6] * s5 + d[10] * s4 - d[14] * s3) * inverse_determinant;
+    o[13] = (d[2] * s5 - d[10] * s2 + d[14] * s1) * inverse_determinant;
+    o[14] = (-d[2] * s4 + d[6] * s2 - d[14] * s0) * inverse_determinant;
+    o[15] = (d[2] * s3 - d[6] * s1 + d[10] * s0) * inverse_determinant;
+    return out;
+}
+
+/** @brief Creates a translation matrix. */
+static inline mat4 mat4_translation(vec3 position) {
+    mat4 m = mat4_identity();
+    m.data[12] = position.x;
+    m.data[13] = position.y;
+    m.data[14] = position.z;
+    return m;
+}
+
+/** @brief Creates a scale matrix. */
+static inline mat4 mat4_scale(vec3 scale) {
+    mat4 m = mat4_identity();
+    m.data[0] = scale.x;
+    m.data[5] = scale.y;
+    m.data[10] = scale.z;
+    return m;
+}
+
+/**
+ * @brief Builds the matrix that scales, then rotates, then translates.
+ * @param position The translation.
+ * @param rotation The rotation. Must be normalized.
+ * @param scale The scale along each axis.
+ * @return The matrix `T * R * S`.
+ */
+static inline mat4 mat4_from_trs(vec3 position, quat rotation, vec3 scale) {
+    f32 x = rotation.x, y = rotation.y, z = rotation.z, w = rotation.w;
+    f32 xx = x * x, yy = y * y, zz = z * z;
+    f32 xy = x * y, xz = x * z, yz = y * z;
+    f32 wx = w * x, wy = w * y, wz = w * z;
+
+    mat4 m;
+    m.data[0] = (1.0f - 2.0f * (yy + zz)) * scale.x;
+    m.data[1] = 2.0f * (xy + wz) * scale.x;
+    m.data[2] = 2.0f * (xz - wy) * scale.x;
+    m.data[3] = 0.0f;
+
+    m.data[4] = 2.0f * (xy - wz) * scale.y;
+    m.data[5] = (1.0f - 2.0f * (xx + zz)) * scale.y;
+    m.data[6] = 2.0f * (yz + wx) * scale.y;
+    m.data[7] = 0.0f;
+
+    m.data[8] = 2.0f * (xz + wy) * scale.z;
+    m.data[9] = 2.0f * (yz - wx) * scale.z;
+    m.data[10] = (1.0f - 2.0f * (xx + yy)) * scale.z;
+    m.data[11] = 0.0f;
+
+    m.data[12] = position.x;
+    m.data[13] = position.y;
+    m.data[14] = position.z;
+    m.data[15] = 1.0f;
+    return m;
+}
+
+/** @brief Creates the rotation matrix of a unit quaternion. */
+static inline mat4 quat_to_mat4(quat q) {
+    return mat4_from_trs(vec3_zero(), q, vec3_one());
+}
+
+/**
+ * @brief Creates an orthographic projection, mapping the box to x, y in [-1, 1] and depth to [0, 1].
+ * @param left The left edge of the view volume.
+ * @param right The right edge of the view volume.
+ * @param bottom The bottom edge of the view volume.
+ * @param top The top edge of the view volume.
+ * @param near_clip The distance to the near plane, mapped to depth 0.
+ * @param far_clip The distance to the far plane, mapped to depth 1.
+ * @return The projection matrix.
+ */
+static inline mat4 mat4_orthographic(f32 left, f32 right, f32 bottom, f32 top, f32 near_clip, f32 far_clip) {
+    mat4 m = mat4_identity();
+    m.data[0] = 2.0f / (right - left);
+    m.data[5] = 2.0f / (top - bottom);
+    m.data[10] = -1.0f / (far_clip - near_clip);
+    m.data[12] = -(right + left) / (right - left);
+    m.data[13] = -(top + bottom) / (top - bottom);
+    m.data[14] = -near_clip / (far_clip - near_clip);
+    return m;
+}
+
+/**
+ * @brief Creates a right-handed perspective projection with depth in [0, 1], as Vulkan uses.
+ * @details +y stays up in clip space; flip the viewport (negative height) to match Vulkan's
+ * y-down framebuffer.
+ * @param fov_radians The vertical field of view in radians.
+ * @param aspect_ratio The width of the view divided by its height.
+ * @param near_clip The distance to the near plane, mapped to depth 0.
+ * @param far_clip The distance to the far plane, mapped to depth 1.
+ * @return The projection matrix.
+ */
+static inline mat4 mat4_perspective(f32 fov_radians, f32 aspect_ratio, f32 near_clip, f32 far_clip) {
+    f32 focal_length = 1.0f / ktan(0.5f * fov_radians);
+    mat4 m = {0};
+    m.data[0] = focal_length / aspect_ratio;
+    m.data[5] = focal_length;
+    m.data[10] = far_clip / (near_clip - far_clip);
+    m.data[11] = -1.0f;
+    m.data[14] = (near_clip * far_clip) / (near_clip - far_clip);
+    return m;
+}
+
+/**
+ * @brief Creates a view matrix looking from `position` towards `target`.
+ * @param position The position of the eye.
+ * @param target The point to look at.
+ * @param up The approximate up direction. Must not be parallel to the view direction.
+ * @return The view matrix, with the eye looking down -z.
+ */
+static inline mat4 mat4_look_at(vec3 position, vec3 target, vec3 up) {
+    vec3 z = vec3_normalized(vec3_sub(position, target));
+    vec3 x = vec3_normalized(vec3_cross(up, z));
+    vec3 y = vec3_cross(z, x);
+
+    mat4 m;
+    m.data[0] = x.x;
+    m.data[1] = y.x;
+    m.data[2] = z.x;
+    m.data[3] = 0.0f;
+    m.data[4] = x.y;
+    m.data[5] = y.y;
+    m.data[6] = z.y;
+    m.data[7] = 0.0f;
+    m.data[8] = x.z;
+    m.data[9] = y.z;
+    m.data[10] = z.z;
+    m.data[11] = 0.0f;
+    m.data[12] = -vec3_dot(x, position);
+    m.data[13] = -vec3_dot(y, position);
+    m.data[14] = -vec3_dot(z, position);
+    m.data[15] = 1.0f;
+    return m;
+}
+
+
+// ------------------------------------------
+// Batch kernels
+// ------------------------------------------
+
+/**
+ * @brief Allocates the arrays of a vec3_soa, aligned for the batch kernels.
+ * @param capacity The number of points to make room for.
+ * @param out_points A pointer to the vec3_soa to create. Its count starts at 0.
+ * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+ */
+KAPI b8 vec3_soa_create(u32 capacity, vec3_soa* out_points);
+
+/**
+ * @brief Frees the arrays of a vec3_soa.
+ * @param points A pointer to the vec3_soa.
+ */
+KAPI void vec3_soa_destroy(vec3_soa* points);
+
+/**
+ * @brief Transforms every point of `in` by `m` (w = 1), writing the results to `out`.
+ * @param m The transform.
+ * @param in The points to transform.
+ * @param out Receives the transformed points. Needs room for `in->count` points; may be `in` itself.
+ */
+KAPI void kmath_transform_points(const mat4* m, const vec3_soa* in, vec3_soa* out);
+
+/**
+ * @brief Multiplies arrays of matrices pairwise: `out[i] = a[i] * b[i]`.
+ * @param a The left-hand matrices.
+ * @param b The right-hand matrices.
+ * @param out Receives the products. May be `a` or `b`.
+ * @param count The number of matrices in each array.
+ */
+KAPI void kmath_mat4_mul_batch(const mat4* a, const mat4* b, mat4* out, u32 count);
+
+/**
+ * @brief Multiplies one matrix by each of an array: `out[i] = m * in[i]`, e.g. a view-projection by every model matrix.
+ * @param m The left-hand matrix.
+ * @param in The right-hand matrices.
+ * @param out Receives the products. May be `in`.
+ * @param count The number of matrices in `in`.
+ */
+KAPI void kmath_mat4_premul_batch(const mat4* m, const mat4* in, mat4* out, u32 count);
+
+/**
+ * @brief Gets the name of the instruction set the batch kernels use on this CPU.
+ * @return "AVX+FMA", "SSE2", "NEON" or "scalar".
+ */
+KAPI const char* kmath_simd_path_name();
@@ -0,0 +1,117 @@
+#pragma once
+
+/**
+ * @file math_types.h
+ * @brief This file contains the engine's vector, quaternion and matrix types.
+ *
+ * @details Matrices are column-major: `data[column * 4 + row]`, and vectors are columns, so a
+ * point is transformed as `m * v` and `a * b` applies `b` first. vec4, quat and mat4 are
+ * 16-byte aligned and, when the build has SSE or NEON (see defines.h), overlay a SIMD register
+ * type, so kmath can operate on them without shuffling through memory.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "defines.h"
+
+#if defined(KSIMD_SSE)
+    #include <emmintrin.h>
+    /** @brief Four packed floats in one SIMD register. */
+    typedef __m128 ksimd_f32x4;
+#elif defined(KSIMD_NEON)
+    #include <arm_neon.h>
+    /** @brief Four packed floats in one SIMD register. */
+    typedef float32x4_t ksimd_f32x4;
+#endif
+
+/**
+ * @union vec2
+ * @brief A 2-component vector.
+ */
+typedef union vec2_u {
+    /** @brief The components as an array. */
+    f32 elements[2];
+    struct {
+        /** @brief The first component. */
+        union { f32 x, r, s, u; };
+        /** @brief The second component. */
+        union { f32 y, g, t, v; };
+    };
+} vec2;
+
+/**
+ * @union vec3
+ * @brief A 3-component vector.
+ */
+typedef union vec3_u {
+    /** @brief The components as an array. */
+    f32 elements[3];
+    struct {
+        /** @brief The first component. */
+        union { f32 x, r, s, u; };
+        /** @brief The second component. */
+        union { f32 y, g, t, v; };
+        /** @brief The third component. */
+        union { f32 z, b, p, w; };
+    };
+} vec3;
+
+/**
+ * @union vec4
+ * @brief A 4-component vector.
+ */
+typedef union vec4_u {
+    /** @brief The components as an array. */
+    KALIGN(16) f32 elements[4];
+#if defined(KSIMD_SSE) || defined(KSIMD_NEON)
+    /** @brief The components as a SIMD register. */
+    ksimd_f32x4 simd;
+#endif
+    struct {
+        /** @brief The first component. */
+        union { f32 x, r, s; };
+        /** @brief The second component. */
+        union { f32 y, g, t; };
+        /** @brief The third component. */
+        union { f32 z, b, p; };
+        /** @brief The fourth component. */
+        union { f32 w, a, q; };
+    };
+} vec4;
+
+/** @brief A rotation quaternion: (x, y, z) is the vector part, w the scalar part. */
+typedef vec4 quat;
+
+/**
+ * @union mat4
+ * @brief A 4x4 column-major matrix.
+ */
+typedef union mat4_u {
+    /** @brief The elements, column by column. */
+    KALIGN(16) f32 data[16];
+
+    /** @brief The columns. */
+    vec4 columns[4];
+} mat4;
+
+/**
+ * @struct vec3_soa
+ * @brief An array of 3D points in structure-of-arrays form, for the batch kernels in kmath.h.
+ * @details Each component array is aligned to KMATH_SOA_ALIGNMENT, with room for `capacity`
+ * points rounded up to KMATH_SOA_WIDTH. Create with vec3_soa_create.
+ */
+typedef struct vec3_soa {
+    /** @brief The x components. */
+    f32* x;
+
+    /** @brief The y components. */
+    f32* y;
+
+    /** @brief The z components. */
+    f32* z;
+
+    /** @brief The number of points in use. */
+    u32 count;
+
+    /** @brief The number of points the arrays can hold. */
+    u32 capacity;
+} vec3_soa;
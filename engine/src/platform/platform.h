@@ -63,27 +63,68 @@ void platform_shutdown(platform_state* plat_state);
  */
 b8 platform_pump_messages(platform_state* plat_state);
 
+
+/**
+ * @brief Blocks until OS messages are available or the timeout expires.
+ *
+ * Used instead of spinning on platform_pump_messages when the application has nothing
+ * to do until the next input (e.g. when minimized, or in a tool that only redraws on
+ * input). It does not process the messages; call platform_pump_messages afterwards.
+ *
+ * @param plat_state A pointer to the platform_state structure.
+ * @param timeout_ms The maximum time to wait in milliseconds, or PLATFORM_WAIT_INFINITE.
+ * @return b8 Returns TRUE if messages are available, FALSE if the wait timed out.
+ */
+b8 platform_wait_messages(platform_state* plat_state, u32 timeout_ms);
+
 /*
 ==================================
       MEMORY MANAGEMENT
 ==================================
 */
 
+/** @brief The alignment used by platform_allocate when `aligned` is TRUE. */
+#define PLATFORM_DEFAULT_ALIGNMENT 16
+
 /**
  * @brief Allocates a block of memory.
  * @param size The size of the block to allocate.
- * @param aligned Indicates if the allocation should be aligned.
+ * @param aligned Indicates if the allocation should be aligned to PLATFORM_DEFAULT_ALIGNMENT.
  * @return A pointer to the allocated memory block.
  */
 void* platform_allocate(u64 size, b8 aligned);
 
+/**
+ * @brief Allocates a block of memory that is guaranteed to be zeroed.
+ * @details This lets the OS/CRT hand out pages that are already zero (e.g. fresh
+ * mmap/VirtualAlloc pages behind calloc) instead of writing over the whole block.
+ * The block is released with platform_free (not aligned).
+ * @param size The size of the block to allocate.
+ * @return A pointer to the allocated, zeroed memory block.
+ */
+void* platform_allocate_zeroed(u64 size);
+
 /**
  * @brief Frees a previously allocated block of memory.
  * @param block A pointer to the memory block to free.
- * @param aligned Indicates if the allocation was aligned.
+ * @param aligned Indicates if the allocation was aligned. Must match the value passed to platform_allocate.
  */
 void platform_free(void* block, b8 aligned);
 
+/**
+ * @brief Allocates a block of memory whose address is a multiple of `alignment`.
+ * @param size The size of the block to allocate.
+ * @param alignment The required alignment in bytes. Must be a power of two.
+ * @return A pointer to the allocated memory block, or 0 on failure.
+ */
+void* platform_allocate_aligned(u64 size, u16 alignment);
+
+/**
+ * @brief Frees a block of memory that was allocated with platform_allocate_aligned.
+ * @param block A pointer to the memory block to free.
+ */
+void platform_free_aligned(void* block);
+
 /**
  * @brief Zeros out a block of memory.
  * @param block A pointer to the memory block.
@@ -103,6 +144,16 @@ void* platform_zero_memory(void* block, u64 size);
 void* platform_copy_memory(void* dest, const void* source, u64 size);
 
 
+/**
+ * @brief Copies a block of memory where the source and destination may overlap.
+ * @param dest A pointer to the destination memory block.
+ * @param source A pointer to the source memory block.
+ * @param size The number of bytes to copy.
+ * @return A pointer to the destination memory block.
+ */
+void* platform_move_memory(void* dest, const void* source, u64 size);
+
+
 /**
  * @brief Sets a block of memory to a specific value.
  * @param dest A pointer to the destination memory block.
@@ -113,6 +164,56 @@ void* platform_copy_memory(void* dest, const void* source, u64 size);
 void* platform_set_memory(void* dest, i32 value, u64 size);
 
 
+/*
+==================================
+      VIRTUAL MEMORY
+==================================
+*/
+
+/**
+ * @brief Gets the size of a virtual memory page.
+ * @details Every address and size passed to the reserve/commit functions should be a
+ * multiple of this value.
+ * @return The page size in bytes.
+ */
+u64 platform_get_page_size();
+
+/**
+ * @brief Reserves a range of virtual address space without backing it with memory.
+ * @details Reserved pages cannot be accessed until they are committed with platform_commit.
+ * This allows a structure to reserve a large range up front and grow in place, so its
+ * memory never needs to be reallocated and copied, and pointers into it stay stable.
+ * @param size The size of the range to reserve. Rounded up to the page size.
+ * @param large_pages A hint to back the range with huge/large pages to reduce TLB misses.
+ * Ignored where the platform does not support it.
+ * @return A pointer to the start of the reserved range, or 0 on failure.
+ */
+void* platform_reserve(u64 size, b8 large_pages);
+
+/**
+ * @brief Commits pages inside a previously reserved range, making them readable and writable.
+ * @details Newly committed pages are zeroed by the OS.
+ * @param address The start of the range to commit. Must be page-aligned.
+ * @param size The size of the range to commit.
+ * @return b8 Returns TRUE on success, FALSE on failure.
+ */
+b8 platform_commit(void* address, u64 size);
+
+/**
+ * @brief Decommits pages, returning their memory to the OS while keeping the address range reserved.
+ * @param address The start of the range to decommit. Must be page-aligned.
+ * @param size The size of the range to decommit.
+ */
+void platform_decommit(void* address, u64 size);
+
+/**
+ * @brief Releases an entire reserved range back to the OS.
+ * @param address The start of the range, as returned by platform_reserve.
+ * @param size The size that was passed to platform_reserve.
+ */
+void platform_release(void* address, u64 size);
+
+
 /*
 ==================================
       CONSOLE I/O
@@ -147,7 +248,26 @@ void platform_console_write_error(const char* message, u8 colour);
  * @brief Gets the absolute time since the application started.
  * @return The absolute time in seconds as a 64-bit float.
  */
-f64 platform_get_absolute_time();
+KAPI f64 platform_get_absolute_time();
+
+
+/**
+ * @brief Gets the current value of the platform's high-resolution tick counter.
+ *
+ * Cheaper and more precise than platform_get_absolute_time, as it skips the
+ * conversion to seconds. Intended for profiling and other fine-grained timing.
+ * Divide a difference of two tick values by platform_get_tick_frequency to get seconds.
+ *
+ * @return The current tick count as a `u64`. Only differences between values are meaningful.
+ */
+u64 platform_get_ticks();
+
+
+/**
+ * @brief Gets the number of ticks per second returned by platform_get_ticks.
+ * @return The tick frequency in Hz. Constant for the lifetime of the process.
+ */
+u64 platform_get_tick_frequency();
 
 
 /**
@@ -159,4 +279,380 @@ f64 platform_get_absolute_time();
  *
  * @param ms The number of milliseconds to sleep.
  */
-void platform_sleep(u64 ms);
\ No newline at end of file
+void platform_sleep(u64 ms);
+
+
+/*
+==================================
+      THREADING
+==================================
+*/
+
+/**
+ * @brief The timeout value that makes a wait block until it is satisfied.
+ */
+#define PLATFORM_WAIT_INFINITE 0xFFFFFFFF
+
+/**
+ * @brief The signature of a thread's entry point.
+ * @param params The user-provided parameter passed to platform_thread_create.
+ * @return The thread's exit code.
+ */
+typedef u32 (*platform_thread_start)(void* params);
+
+/**
+ * @struct platform_thread
+ * @brief Holds a handle to an OS thread.
+ */
+typedef struct platform_thread {
+    /** @brief A pointer to the platform-specific thread handle. */
+    void* internal_data;
+
+    /** @brief The OS identifier of the thread. */
+    u64 thread_id;
+} platform_thread;
+
+/**
+ * @struct platform_semaphore
+ * @brief Holds a handle to an OS counting semaphore.
+ */
+typedef struct platform_semaphore {
+    /** @brief A pointer to the platform-specific semaphore handle. */
+    void* internal_data;
+} platform_semaphore;
+
+/**
+ * @brief Creates and starts a new thread.
+ * @param start The function the thread begins executing.
+ * @param params A parameter passed to `start`.
+ * @param out_thread A pointer to the thread handle to be filled out.
+ * @return b8 Returns TRUE on success, FALSE on failure.
+ */
+b8 platform_thread_create(platform_thread_start start, void* params, platform_thread* out_thread);
+
+/**
+ * @brief Blocks until the given thread exits, then releases its handle.
+ * @param thread A pointer to the thread to join.
+ */
+void platform_thread_join(platform_thread* thread);
+
+/**
+ * @brief Gets the OS identifier of the calling thread.
+ * @return The identifier of the calling thread.
+ */
+u64 platform_current_thread_id();
+
+/**
+ * @brief Gets the number of logical processors available to the process.
+ * @return The number of logical processors. Always at least 1.
+ */
+u32 platform_get_processor_count();
+
+
+/**
+ * @brief Creates a counting semaphore.
+ * @param initial_count The initial count of the semaphore.
+ * @param out_semaphore A pointer to the semaphore to be filled out.
+ * @return b8 Returns TRUE on success, FALSE on failure.
+ */
+b8 platform_semaphore_create(u32 initial_count, platform_semaphore* out_semaphore);
+
+/**
+ * @brief Destroys a semaphore. No thread may be waiting on it.
+ * @param semaphore A pointer to the semaphore to destroy.
+ */
+void platform_semaphore_destroy(platform_semaphore* semaphore);
+
+/**
+ * @brief Increments the semaphore's count, waking one waiting thread if there is one.
+ * @param semaphore A pointer to the semaphore to signal.
+ */
+void platform_semaphore_signal(platform_semaphore* semaphore);
+
+/**
+ * @brief Waits until the semaphore's count is non-zero, then decrements it.
+ * @param semaphore A pointer to the semaphore to wait on.
+ * @param timeout_ms The maximum time to wait in milliseconds, or PLATFORM_WAIT_INFINITE.
+ * @return b8 Returns TRUE if the semaphore was acquired, FALSE if the wait timed out.
+ */
+b8 platform_semaphore_wait(platform_semaphore* semaphore, u32 timeout_ms);
+
+
+/*
+==================================
+      FILE I/O
+==================================
+*/
+
+/**
+ * @enum platform_file_mode
+ * @brief Flags describing how a file is opened. Combine with bitwise OR.
+ */
+typedef enum platform_file_mode {
+    /** @brief Open the file for reading. */
+    PLATFORM_FILE_MODE_READ = 0x1,
+
+    /** @brief Open the file for writing. Creates it if needed and truncates it unless APPEND is set. */
+    PLATFORM_FILE_MODE_WRITE = 0x2,
+
+    /** @brief With WRITE: keep existing contents and write at the end of the file. */
+    PLATFORM_FILE_MODE_APPEND = 0x4,
+
+    /**
+     * @brief Open the file for reading through a platform_io_queue. On Win32 the handle becomes
+     * overlapped, which platform_file_read and platform_file_write do not support.
+     */
+    PLATFORM_FILE_MODE_ASYNC = 0x8
+} platform_file_mode;
+
+/**
+ * @struct platform_file
+ * @brief Holds a handle to an open file.
+ * @details Reads and writes are unbuffered: each call maps to a single OS call, so callers
+ * should batch their data.
+ */
+typedef struct platform_file {
+    /** @brief The platform-specific file handle (a file descriptor or HANDLE). */
+    void* handle;
+
+    /** @brief Indicates if the handle refers to an open file. */
+    b8 is_valid;
+} platform_file;
+
+/**
+ * @brief Opens a file.
+ * @param path The path of the file to open.
+ * @param mode A combination of platform_file_mode flags.
+ * @param out_file A pointer to the file handle to be filled out.
+ * @return b8 Returns TRUE on success, FALSE on failure.
+ */
+b8 platform_file_open(const char* path, u32 mode, platform_file* out_file);
+
+/**
+ * @brief Closes an open file.
+ * @param file A pointer to the file to close.
+ */
+void platform_file_close(platform_file* file);
+
+/**
+ * @brief Writes data to a file at its current position.
+ * @param file A pointer to the file to write to.
+ * @param data A pointer to the data to write.
+ * @param size The number of bytes to write.
+ * @param out_written An optional pointer receiving the number of bytes written.
+ * @return b8 Returns TRUE if every byte was written, FALSE otherwise.
+ */
+b8 platform_file_write(platform_file* file, const void* data, u64 size, u64* out_written);
+
+/**
+ * @brief Reads data from a file at its current position.
+ * @param file A pointer to the file to read from.
+ * @param buffer A pointer to the buffer receiving the data.
+ * @param size The maximum number of bytes to read.
+ * @param out_read An optional pointer receiving the number of bytes read.
+ * @return b8 Returns TRUE on success (including a short read at end of file), FALSE on failure.
+ */
+b8 platform_file_read(platform_file* file, void* buffer, u64 size, u64* out_read);
+
+/**
+ * @brief Gets the size of an open file.
+ * @param file A pointer to the file.
+ * @param out_size A pointer receiving the size in bytes.
+ * @return b8 Returns TRUE on success, FALSE on failure.
+ */
+b8 platform_file_size(platform_file* file, u64* out_size);
+
+/**
+ * @brief Checks if a file exists.
+ * @param path The path of the file.
+ * @return b8 Returns TRUE if the file exists, FALSE otherwise.
+ */
+b8 platform_file_exists(const char* path);
+
+/**
+ * @brief Renames (moves) a file, replacing the destination if it exists.
+ * @param from The current path of the file.
+ * @param to The new path of the file.
+ * @return b8 Returns TRUE on success, FALSE on failure.
+ */
+b8 platform_file_rename(const char* from, const char* to);
+
+/**
+ * @brief Deletes a file.
+ * @param path The path of the file to delete.
+ * @return b8 Returns TRUE on success, FALSE on failure.
+ */
+b8 platform_file_delete(const char* path);
+
+/**
+ * @enum platform_file_map_hint
+ * @brief Flags describing how a mapped file will be accessed. Combine with bitwise OR.
+ * @details These are only hints to the OS paging policy; a mapping behaves the same with or
+ * without them.
+ */
+typedef enum platform_file_map_hint {
+    /** @brief No hint; the OS default read-ahead applies. */
+    PLATFORM_FILE_MAP_HINT_NORMAL = 0x0,
+
+    /** @brief The file is read front to back, so aggressive read-ahead pays off. */
+    PLATFORM_FILE_MAP_HINT_SEQUENTIAL = 0x1,
+
+    /** @brief The file is read in scattered pieces, so read-ahead should be limited. */
+    PLATFORM_FILE_MAP_HINT_RANDOM = 0x2,
+
+    /** @brief The whole file will be needed soon; paging it in starts immediately. */
+    PLATFORM_FILE_MAP_HINT_WILL_NEED = 0x4
+} platform_file_map_hint;
+
+/**
+ * @struct platform_file_mapping
+ * @brief A read-only view of a whole file mapped into the address space.
+ * @details The data is backed directly by the OS page cache: nothing is copied, and pages are
+ * read from disk lazily on first touch. The view stays valid until platform_file_unmap, even
+ * though the file itself is closed as soon as it has been mapped.
+ */
+typedef struct platform_file_mapping {
+    /** @brief The mapped contents of the file. 0 for an empty file. */
+    const void* data;
+
+    /** @brief The size of the mapped contents in bytes. */
+    u64 size;
+
+    /** @brief Indicates if the mapping was created successfully. */
+    b8 is_valid;
+} platform_file_mapping;
+
+/**
+ * @brief Maps a whole file into memory for reading.
+ * @details An empty file produces a valid mapping with no data. Writing through the
+ * mapping is not allowed.
+ * @param path The path of the file to map.
+ * @param hints A combination of platform_file_map_hint flags.
+ * @param out_mapping A pointer to the mapping to be filled out.
+ * @return b8 Returns TRUE on success, FALSE on failure.
+ */
+b8 platform_file_map(const char* path, u32 hints, platform_file_mapping* out_mapping);
+
+/**
+ * @brief Asks the OS to start paging in a range of a mapped file ahead of use.
+ * @details Returns without waiting for the read. Useful when a loader knows which part of a
+ * file it will parse next, e.g. the mip chain of a texture after its header.
+ * @param mapping A pointer to the mapping.
+ * @param offset The start of the range, in bytes from the start of the file.
+ * @param size The size of the range in bytes. Clamped to the end of the file.
+ */
+void platform_file_map_prefetch(platform_file_mapping* mapping, u64 offset, u64 size);
+
+/**
+ * @brief Unmaps a mapped file. Pointers into its data become invalid.
+ * @param mapping A pointer to the mapping to unmap.
+ */
+void platform_file_unmap(platform_file_mapping* mapping);
+
+
+/*
+==================================
+      ASYNC FILE I/O
+==================================
+*/
+
+/**
+ * @enum platform_io_backend
+ * @brief Selects how a platform_io_queue performs its reads.
+ */
+typedef enum platform_io_backend {
+    /**
+     * @brief The fastest backend the OS offers: io_uring on Linux, falling back to the thread
+     * pool if the kernel lacks it (or it is blocked); overlapped I/O on an IOCP on Win32.
+     */
+    PLATFORM_IO_BACKEND_DEFAULT,
+
+    /** @brief Blocking reads on a small pool of I/O threads. Linux only; Win32 always uses its IOCP. */
+    PLATFORM_IO_BACKEND_THREAD_POOL
+} platform_io_backend;
+
+/**
+ * @struct platform_io_completion
+ * @brief Describes a finished read, as returned by platform_io_queue_poll.
+ */
+typedef struct platform_io_completion {
+    /** @brief The user data the read was queued with. */
+    void* user_data;
+
+    /** @brief The number of bytes read. Less than requested only when the read hit the end of the file. */
+    u32 bytes_read;
+
+    /** @brief Indicates if the read succeeded. */
+    b8 success;
+} platform_io_completion;
+
+/**
+ * @struct platform_io_queue
+ * @brief Holds a queue of asynchronous file reads.
+ * @details Reads are queued with platform_io_queue_read, handed to the OS together by
+ * platform_io_queue_submit, and harvested with platform_io_queue_poll, so a whole batch
+ * costs a handful of system calls. A queue must only be used from one thread; the reads
+ * themselves run in the kernel (or on the backend's threads).
+ */
+typedef struct platform_io_queue {
+    /** @brief A pointer to the platform-specific queue state. */
+    void* internal_state;
+} platform_io_queue;
+
+/**
+ * @brief Creates an asynchronous I/O queue.
+ * @param capacity The maximum number of reads in flight (queued and not yet polled).
+ * @param backend The backend to use.
+ * @param out_queue A pointer to the queue to be filled out.
+ * @return b8 Returns TRUE on success, FALSE on failure.
+ */
+b8 platform_io_queue_create(u32 capacity, platform_io_backend backend, platform_io_queue* out_queue);
+
+/**
+ * @brief Destroys an asynchronous I/O queue. Every read must have been polled.
+ * @param queue A pointer to the queue to destroy.
+ */
+void platform_io_queue_destroy(platform_io_queue* queue);
+
+/**
+ * @brief Gets a short name of the backend a queue runs on, for logging.
+ * @param queue A pointer to the queue.
+ * @return The name of the backend.
+ */
+const char* platform_io_queue_backend_name(platform_io_queue* queue);
+
+/**
+ * @brief Queues a read. It starts at the latest on the next platform_io_queue_submit.
+ * @param queue A pointer to the queue.
+ * @param file The file to read from. Must be opened with PLATFORM_FILE_MODE_READ | PLATFORM_FILE_MODE_ASYNC
+ * and stay open until the read has been polled.
+ * @param offset The position in the file to read from.
+ * @param buffer The buffer receiving the data. Must stay valid until the read has been polled.
+ * @param size The number of bytes to read.
+ * @param user_data A pointer returned with the read's completion.
+ * @return b8 Returns TRUE if the read was queued, FALSE if the queue is at capacity.
+ */
+b8 platform_io_queue_read(platform_io_queue* queue, platform_file* file, u64 offset, void* buffer, u32 size, void* user_data);
+
+/**
+ * @brief Hands every queued read to the OS.
+ * @param queue A pointer to the queue.
+ */
+void platform_io_queue_submit(platform_io_queue* queue);
+
+/**
+ * @brief Takes finished reads off the queue.
+ * @param queue A pointer to the queue.
+ * @param out_completions An array receiving up to `max_count` completions.
+ * @param max_count The size of `out_completions`.
+ * @param wait If TRUE and reads are in flight, blocks until at least one has finished.
+ * @return The number of completions written to `out_completions`.
+ */
+u32 platform_io_queue_poll(platform_io_queue* queue, platform_io_completion* out_completions, u32 max_count, b8 wait);
+
+/**
+ * @brief Gets the number of reads in flight: queued, submitted or finished but not yet polled.
+ * @param queue A pointer to the queue.
+ * @return The number of reads in flight.
+ */
+u32 platform_io_queue_in_flight(platform_io_queue* queue);
\ No newline at end of file
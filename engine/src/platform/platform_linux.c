@@ -14,6 +14,10 @@
 #if KPLATFORM_LINUX
 
 #include "core/logger.h"
+#include "core/event.h"
+#include "core/kmemory.h"
+#include "core/katomic.h"
+#include "containers/ring_queue.h"
 
 
 
@@ -34,6 +38,13 @@
 #include <X11/keysym.h>
 #include <sys/time.h>
 
+// Vulkan surfaces on the XCB window. Must follow the XCB include.
+#define VK_USE_PLATFORM_XCB_KHR
+#include <vulkan/vulkan.h>
+#include "containers/darray.h"
+#include "renderer/vulkan/vulkan_platform.h"
+#include "renderer/vulkan/vulkan_types.h"
+
 // For high-resolution sleep timers (nanosleep)
 #if _POSIX_C_SOURCE >= 199309L
     #include <time.h>   // nanosleep
@@ -62,6 +73,32 @@
 #endif
 
 
+// For virtual memory reservation (mmap/mprotect/madvise) and the page size (sysconf).
+#include <sys/mman.h>
+#include <unistd.h>
+
+// For the file API (open/fstat).
+#include <fcntl.h>
+#include <sys/stat.h>
+
+// For the async file I/O API: pread/readv and the raw io_uring system calls.
+#include <sys/uio.h>
+#include <sys/syscall.h>
+#if defined(__has_include)
+    #if __has_include(<linux/io_uring.h>)
+        #include <linux/io_uring.h>
+        #define KPLATFORM_IO_URING 1
+    #endif
+#endif
+
+// POSIX threads and semaphores for the threading API.
+#include <pthread.h>
+#include <semaphore.h>
+#include <errno.h>
+
+// For waiting on the X server connection with a timeout.
+#include <poll.h>
+
 // Standard ANSI C libraries for memory allocation and string manipulation.
 // Used for their portability and standardized functionality.
 #include <stdlib.h>
@@ -92,6 +129,13 @@ typedef struct internal_state {
 
      /** @brief An handle/atom for the window deletion event. Server-side resource*/
     xcb_atom_t wm_delete_win;
+
+    /** @brief An event taken from XCB's queue by platform_wait_messages, handled first by the next pump. */
+    xcb_generic_event_t *pending_event;
+
+    /** @brief The last known size of the window, used to filter configure notifications that are only moves. */
+    u16 width;
+    u16 height;
 } internal_state;
   
 
@@ -116,7 +160,7 @@ b8 platform_startup (
     i32 height) { 
 
     // Create the internal state
-    plat_state->internal_state = malloc(sizeof(internal_state));
+    plat_state->internal_state = calloc(1, sizeof(internal_state));
     internal_state *state = (internal_state*) plat_state->internal_state;
     
     // Connect to the X server using Xlib.
@@ -187,6 +231,10 @@ b8 platform_startup (
         event_mask,
         value_list);
 
+    // Remember the initial size, so only real size changes are reported as resize events.
+    state->width = (u16)width;
+    state->height = (u16)height;
+
     xcb_generic_error_t *error = xcb_request_check(state->connection, cookie);
     if (error)
     {
@@ -269,6 +317,12 @@ void platform_shutdown(platform_state* plat_state) {
     // Turn key repeats back on. This is crucial as it's a global OS setting.
     XAutoRepeatOn(state->display);
 
+    // Drop an event taken off the queue by platform_wait_messages that was never pumped.
+    if (state->pending_event) {
+        free(state->pending_event);
+        state->pending_event = 0;
+    }
+
     if (state->window)
     {
         xcb_destroy_window(state->connection, state->window);
@@ -276,6 +330,77 @@ void platform_shutdown(platform_state* plat_state) {
     }
 }
 
+/**
+ * @brief Translates an X key symbol into the engine's key code.
+ * @param x_keycode The key symbol, as returned by XkbKeycodeToKeysym for level 0.
+ * @return The matching `keys` value, or KEY_UNKNOWN.
+ */
+static keys translate_keycode(KeySym x_keycode) {
+    // Ranges first. Level 0 symbols are lowercase letters.
+    if (x_keycode >= XK_a && x_keycode <= XK_z) {
+        return (keys)(KEY_A + (x_keycode - XK_a));
+    }
+    if (x_keycode >= XK_0 && x_keycode <= XK_9) {
+        return (keys)(KEY_0 + (x_keycode - XK_0));
+    }
+    if (x_keycode >= XK_F1 && x_keycode <= XK_F12) {
+        return (keys)(KEY_F1 + (x_keycode - XK_F1));
+    }
+    if (x_keycode >= XK_KP_0 && x_keycode <= XK_KP_9) {
+        return (keys)(KEY_NUMPAD0 + (x_keycode - XK_KP_0));
+    }
+
+    switch (x_keycode) {
+        case XK_BackSpace: return KEY_BACKSPACE;
+        case XK_Tab: return KEY_TAB;
+        case XK_Return: return KEY_ENTER;
+        case XK_KP_Enter: return KEY_ENTER;
+        case XK_Pause: return KEY_PAUSE;
+        case XK_Caps_Lock: return KEY_CAPITAL;
+        case XK_Escape: return KEY_ESCAPE;
+        case XK_space: return KEY_SPACE;
+        case XK_Prior: return KEY_PAGEUP;
+        case XK_Next: return KEY_PAGEDOWN;
+        case XK_End: return KEY_END;
+        case XK_Home: return KEY_HOME;
+        case XK_Left: return KEY_LEFT;
+        case XK_Up: return KEY_UP;
+        case XK_Right: return KEY_RIGHT;
+        case XK_Down: return KEY_DOWN;
+        case XK_Print: return KEY_PRINTSCREEN;
+        case XK_Insert: return KEY_INSERT;
+        case XK_Delete: return KEY_DELETE;
+        case XK_Super_L: return KEY_LSUPER;
+        case XK_Super_R: return KEY_RSUPER;
+        case XK_KP_Multiply: return KEY_MULTIPLY;
+        case XK_KP_Add: return KEY_ADD;
+        case XK_KP_Subtract: return KEY_SUBTRACT;
+        case XK_KP_Decimal: return KEY_DECIMAL;
+        case XK_KP_Divide: return KEY_DIVIDE;
+        case XK_Num_Lock: return KEY_NUMLOCK;
+        case XK_Scroll_Lock: return KEY_SCROLL;
+        case XK_Shift_L: return KEY_LSHIFT;
+        case XK_Shift_R: return KEY_RSHIFT;
+        case XK_Control_L: return KEY_LCONTROL;
+        case XK_Control_R: return KEY_RCONTROL;
+        case XK_Alt_L: return KEY_LALT;
+        case XK_Alt_R: return KEY_RALT;
+        case XK_semicolon: return KEY_SEMICOLON;
+        case XK_equal: return KEY_EQUAL;
+        case XK_comma: return KEY_COMMA;
+        case XK_minus: return KEY_MINUS;
+        case XK_period: return KEY_PERIOD;
+        case XK_slash: return KEY_SLASH;
+        case XK_grave: return KEY_GRAVE;
+        case XK_bracketleft: return KEY_LBRACKET;
+        case XK_backslash: return KEY_BACKSLASH;
+        case XK_bracketright: return KEY_RBRACKET;
+        case XK_apostrophe: return KEY_APOSTROPHE;
+        default: return KEY_UNKNOWN;
+    }
+}
+
+
 /**
  * @brief Pumps messages from the X server event queue.
  * @param plat_state A pointer to the platform state structure. `platform_state*` provides access to the internal state.
@@ -285,13 +410,19 @@ b8 platform_pump_messages(platform_state* plat_state) {
     // Cold-cast the void pointer to our known internal state type..
     internal_state *state = (internal_state*) plat_state->internal_state;
 
+    // Every OS event is translated into this one stack event and copied into the engine's queue.
+    // Declared first, as the XCB event pointer below shadows the engine's `event` type.
+    event platform_event;
+    kzero_memory(&platform_event, sizeof(platform_event));
+
     xcb_generic_event_t *event;
     xcb_client_message_event_t *cm;
 
     b8 quit_flagged = FALSE; 
     
-    // Poll for events until the queue is empty.
-    while ((event = xcb_poll_for_event(state->connection))) {
+    // Handle the event platform_wait_messages took off the queue first, then poll until the queue is empty.
+    while ((event = state->pending_event ? state->pending_event : xcb_poll_for_event(state->connection))) {
+        state->pending_event = 0;
         
         // The high bit of response_type indicates if the event was "sent" by another client.
         // We mask it out to get the actual event type code.
@@ -299,20 +430,68 @@ b8 platform_pump_messages(platform_state* plat_state) {
         {
             case XCB_KEY_PRESS:
             case XCB_KEY_RELEASE: {
-                // TODO: Key presses & releases
+                // Key press and release events share the same layout.
+                xcb_key_press_event_t *kb_event = (xcb_key_press_event_t*) event;
+                KeySym key_sym = XkbKeycodeToKeysym(state->display, (KeyCode)kb_event->detail, 0, 0);
+
+                platform_event.code = (event->response_type & ~0x80) == XCB_KEY_PRESS ?
+                    EVENT_CODE_KEY_PRESSED : EVENT_CODE_KEY_RELEASED;
+                platform_event.key.key = translate_keycode(key_sym);
+                event_post(&platform_event);
             }break;
 
             case XCB_BUTTON_PRESS:
             case XCB_BUTTON_RELEASE: {
-                // TODO: Mouse button presses & releases
+                xcb_button_press_event_t *mouse_event = (xcb_button_press_event_t*) event;
+                b8 pressed = (event->response_type & ~0x80) == XCB_BUTTON_PRESS;
+
+                // X reports the wheel as buttons 4 (up) and 5 (down). Only the press carries meaning.
+                if (mouse_event->detail == XCB_BUTTON_INDEX_4 || mouse_event->detail == XCB_BUTTON_INDEX_5) {
+                    if (pressed) {
+                        platform_event.code = EVENT_CODE_MOUSE_WHEEL;
+                        platform_event.mouse_wheel.z_delta = mouse_event->detail == XCB_BUTTON_INDEX_4 ? 1 : -1;
+                        event_post(&platform_event);
+                    }
+                    break;
+                }
+
+                buttons mouse_button = BUTTON_MAX_BUTTONS;
+                switch (mouse_event->detail) {
+                    case XCB_BUTTON_INDEX_1: mouse_button = BUTTON_LEFT; break;
+                    case XCB_BUTTON_INDEX_2: mouse_button = BUTTON_MIDDLE; break;
+                    case XCB_BUTTON_INDEX_3: mouse_button = BUTTON_RIGHT; break;
+                }
+
+                if (mouse_button != BUTTON_MAX_BUTTONS) {
+                    platform_event.code = pressed ? EVENT_CODE_BUTTON_PRESSED : EVENT_CODE_BUTTON_RELEASED;
+                    platform_event.button.button = mouse_button;
+                    platform_event.button.x = mouse_event->event_x;
+                    platform_event.button.y = mouse_event->event_y;
+                    event_post(&platform_event);
+                }
+            }break;
+
+            case XCB_MOTION_NOTIFY: {
+                // The event system coalesces these, so a burst of motion costs a single queue slot.
+                xcb_motion_notify_event_t *move_event = (xcb_motion_notify_event_t*) event;
+                platform_event.code = EVENT_CODE_MOUSE_MOVED;
+                platform_event.mouse_move.x = move_event->event_x;
+                platform_event.mouse_move.y = move_event->event_y;
+                event_post(&platform_event);
             }break;
 
-            case XCB_MOTION_NOTIFY:
-                // TODO: Mouse movement
-            break;
-            
             case XCB_CONFIGURE_NOTIFY: {
-                // TODO: Resizing
+                // Configure notifications also fire on moves. Only report actual size changes.
+                xcb_configure_notify_event_t *configure_event = (xcb_configure_notify_event_t*) event;
+                if (configure_event->width != state->width || configure_event->height != state->height) {
+                    state->width = configure_event->width;
+                    state->height = configure_event->height;
+
+                    platform_event.code = EVENT_CODE_RESIZED;
+                    platform_event.resize.width = configure_event->width;
+                    platform_event.resize.height = configure_event->height;
+                    event_post(&platform_event);
+                }
             }break;
 
             case XCB_CLIENT_MESSAGE: {
@@ -321,6 +500,9 @@ b8 platform_pump_messages(platform_state* plat_state) {
                 // Window close event from the window manager
                 if (cm->data.data32[0] == state->wm_delete_win) {
                     quit_flagged = TRUE;
+
+                    platform_event.code = EVENT_CODE_APPLICATION_QUIT;
+                    event_post(&platform_event);
                 }
             }break;
 
@@ -329,7 +511,7 @@ b8 platform_pump_messages(platform_state* plat_state) {
                 break;
         }
 
-        // The event object is dynamically allocated by xcb_poll_for_event and must be freed.
+        // The event object is allocated inside libxcb and must be freed. Nothing on our side allocates.
         free(event);
     }
 
@@ -337,22 +519,70 @@ b8 platform_pump_messages(platform_state* plat_state) {
 }
 
 
+b8 platform_wait_messages(platform_state* plat_state, u32 timeout_ms) {
+    internal_state *state = (internal_state*) plat_state->internal_state;
+
+    if (state->pending_event) {
+        return TRUE;
+    }
+
+    // Events XCB already read from the socket sit in its queue and will not wake poll().
+    // There is no peek, so take one and leave it for the next pump.
+    state->pending_event = xcb_poll_for_queued_event(state->connection);
+    if (state->pending_event) {
+        return TRUE;
+    }
+
+    // Make sure outstanding requests reach the server, or its reply events may never come.
+    xcb_flush(state->connection);
+
+    struct pollfd fd;
+    fd.fd = xcb_get_file_descriptor(state->connection);
+    fd.events = POLLIN;
+    fd.revents = 0;
+
+    int timeout = timeout_ms == PLATFORM_WAIT_INFINITE ? -1 : (int)timeout_ms;
+    int result;
+    do {
+        result = poll(&fd, 1, timeout);
+    } while (result < 0 && errno == EINTR);
+
+    return result > 0;
+}
+
+
 /**
  * @brief Allocates a block of memory.
  * @param size The size of the block to allocate. `u64` for a large, non-negative size.
- * @param aligned Unused in this implementation, but kept for API consistency.
+ * @param aligned If TRUE, the block is aligned to PLATFORM_DEFAULT_ALIGNMENT.
  * @return A void pointer to the allocated memory.
  */
 void* platform_allocate(u64 size, b8 aligned) {
+    if (aligned) {
+        return platform_allocate_aligned(size, PLATFORM_DEFAULT_ALIGNMENT);
+    }
+
      // Uses malloc from the standard ANSI C library for basic memory allocation.
     return malloc(size);
 }
 
 
+/**
+ * @brief Allocates a zeroed block of memory.
+ * @param size The size of the block to allocate. `u64` for a large, non-negative size.
+ * @return A void pointer to the allocated, zeroed memory.
+ */
+void* platform_allocate_zeroed(u64 size) {
+    // glibc serves large calloc requests with fresh mmap'd pages, which the kernel
+    // already zeroed, and skips the memset entirely in that case.
+    return calloc(1, size);
+}
+
+
 /**
  * @brief Frees a block of memory.
  * @param block A pointer to the memory block to free. `void*` for a generic pointer.
- * @param aligned Unused in this implementation.
+ * @param aligned Whether the block was allocated aligned. Unused here, since glibc's free handles both.
  */
 void platform_free(void* block, b8 aligned) {
     // Uses free from the standard ANSI C library.
@@ -360,6 +590,35 @@ void platform_free(void* block, b8 aligned) {
 }
 
 
+/**
+ * @brief Allocates an aligned block of memory.
+ * @param size The size of the block to allocate. `u64` for a large, non-negative size.
+ * @param alignment The required alignment. `u16` is plenty for cache-line/SIMD alignments.
+ * @return A void pointer to the allocated memory, or 0 on failure.
+ */
+void* platform_allocate_aligned(u64 size, u16 alignment) {
+    // posix_memalign requires the alignment to be at least the size of a pointer.
+    if (alignment < sizeof(void*)) {
+        alignment = sizeof(void*);
+    }
+
+    void* block = 0;
+    if (posix_memalign(&block, alignment, size) != 0) {
+        return 0;
+    }
+    return block;
+}
+
+
+/**
+ * @brief Frees an aligned block of memory.
+ * @param block A pointer to the memory block to free. Memory from posix_memalign is released with free.
+ */
+void platform_free_aligned(void* block) {
+    free(block);
+}
+
+
 /**
  * @brief Zeros out a block of memory.
  * @param block The memory block to zero. `void*` for a generic pointer.
@@ -386,6 +645,19 @@ void* platform_copy_memory(void* dest, const void* source, u64 size) {
 }
 
 
+/**
+ * @brief Copies a block of memory that may overlap with its destination.
+ * @param dest The destination pointer.
+ * @param source The source pointer.
+ * @param size The amount of memory to copy. `u64` for a large, non-negative size.
+ * @return A pointer to the destination.
+ */
+void* platform_move_memory(void* dest, const void* source, u64 size) {
+    // memmove handles overlapping ranges, which memcpy does not.
+    return memmove(dest, source, size);
+}
+
+
 
 /**
  * @brief Sets a block of memory to a specific value.
@@ -402,6 +674,91 @@ void* platform_set_memory(void* dest, i32 value, u64 size) {
 
 
 
+/**
+ * @brief Gets the size of a virtual memory page.
+ * @return `u64` The page size in bytes, as reported by sysconf.
+ */
+u64 platform_get_page_size() {
+    static u64 page_size = 0;
+    if (!page_size) {
+        page_size = (u64)sysconf(_SC_PAGESIZE);
+    }
+    return page_size;
+}
+
+
+/**
+ * @brief Reserves a range of address space.
+ * @param size The size of the range. `u64` allows reserving far more than physical memory.
+ * @param large_pages If TRUE, transparent huge pages are requested for the range.
+ * @return A pointer to the reserved range, or 0 on failure.
+ */
+void* platform_reserve(u64 size, b8 large_pages) {
+    size = KALIGN_UP(size, platform_get_page_size());
+
+    // PROT_NONE + MAP_NORESERVE claims address space only; no memory or swap is accounted yet.
+    void* address = mmap(0, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (address == MAP_FAILED) {
+        KERROR("platform_reserve - mmap failed to reserve %llu bytes.", size);
+        return 0;
+    }
+
+#ifdef MADV_HUGEPAGE
+    if (large_pages) {
+        // Only a hint; the kernel falls back to regular pages if huge pages are unavailable.
+        madvise(address, size, MADV_HUGEPAGE);
+    }
+#endif
+
+    return address;
+}
+
+
+/**
+ * @brief Commits pages inside a reserved range.
+ * @param address The page-aligned start of the range.
+ * @param size The size of the range. Rounded up to the page size.
+ * @return `b8` TRUE on success, FALSE on failure.
+ */
+b8 platform_commit(void* address, u64 size) {
+    size = KALIGN_UP(size, platform_get_page_size());
+
+    // The pages are faulted in (zeroed) by the kernel on first touch.
+    if (mprotect(address, size, PROT_READ | PROT_WRITE) != 0) {
+        KERROR("platform_commit - mprotect failed to commit %llu bytes.", size);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+
+/**
+ * @brief Decommits pages inside a reserved range.
+ * @param address The page-aligned start of the range.
+ * @param size The size of the range. Rounded up to the page size.
+ */
+void platform_decommit(void* address, u64 size) {
+    size = KALIGN_UP(size, platform_get_page_size());
+
+    // Drop the physical pages, then make the range inaccessible again.
+    madvise(address, size, MADV_DONTNEED);
+    mprotect(address, size, PROT_NONE);
+}
+
+
+/**
+ * @brief Releases a reserved range.
+ * @param address The start of the range, as returned by platform_reserve.
+ * @param size The size that was passed to platform_reserve.
+ */
+void platform_release(void* address, u64 size) {
+    size = KALIGN_UP(size, platform_get_page_size());
+    munmap(address, size);
+}
+
+
+
+
 /**
  * @brief Writes a message to the console with color.
  * @param message The message to write. `const char*` for a read-only string.
@@ -447,6 +804,20 @@ f64 platform_get_absolute_time() {
 }
 
 
+u64 platform_get_ticks() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    // Ticks are nanoseconds, so no floating point conversion is needed.
+    return (u64)now.tv_sec * 1000000000ULL + (u64)now.tv_nsec;
+}
+
+
+u64 platform_get_tick_frequency() {
+    return 1000000000ULL;
+}
+
+
 void platform_sleep(u64 ms) {
 
 // Use high-precision nanosleep if available (newer POSIX versions).
@@ -467,4 +838,986 @@ void platform_sleep(u64 ms) {
 
 }
 
+
+/**
+ * @struct linux_thread_start_data
+ * @brief Carries the user's entry point across pthread's `void* (*)(void*)` signature.
+ */
+typedef struct linux_thread_start_data {
+    /** @brief The user's entry point. */
+    platform_thread_start start;
+
+    /** @brief The user's parameter. */
+    void* params;
+} linux_thread_start_data;
+
+/**
+ * @brief The pthread entry point. Unpacks the start data and calls the user's function.
+ */
+static void* linux_thread_entry(void* arg) {
+    linux_thread_start_data data = *(linux_thread_start_data*)arg;
+    free(arg);
+    return (void*)(u64)data.start(data.params);
+}
+
+
+/**
+ * @brief Creates and starts a new thread.
+ * @param start The entry point of the thread.
+ * @param params A `void*` parameter forwarded to `start`.
+ * @param out_thread A pointer to the thread handle to fill out.
+ * @return `b8` TRUE on success, FALSE on failure.
+ */
+b8 platform_thread_create(platform_thread_start start, void* params, platform_thread* out_thread) {
+    if (!start || !out_thread) {
+        return FALSE;
+    }
+
+    // Freed by the new thread once it has copied the data out.
+    linux_thread_start_data* data = malloc(sizeof(linux_thread_start_data));
+    data->start = start;
+    data->params = params;
+
+    pthread_t* handle = malloc(sizeof(pthread_t));
+    i32 result = pthread_create(handle, 0, linux_thread_entry, data);
+    if (result != 0) {
+        KERROR("platform_thread_create - pthread_create failed with error %d.", result);
+        free(data);
+        free(handle);
+        return FALSE;
+    }
+
+    out_thread->internal_data = handle;
+    out_thread->thread_id = (u64)*handle;
+    return TRUE;
+}
+
+
+/**
+ * @brief Waits for a thread to exit and releases its handle.
+ * @param thread A pointer to the thread handle.
+ */
+void platform_thread_join(platform_thread* thread) {
+    if (thread && thread->internal_data) {
+        pthread_join(*(pthread_t*)thread->internal_data, 0);
+        free(thread->internal_data);
+        thread->internal_data = 0;
+        thread->thread_id = 0;
+    }
+}
+
+
+/**
+ * @brief Gets the identifier of the calling thread.
+ * @return `u64` The pthread identifier of the calling thread.
+ */
+u64 platform_current_thread_id() {
+    return (u64)pthread_self();
+}
+
+
+/**
+ * @return The number of online logical processors, as reported by sysconf.
+ */
+u32 platform_get_processor_count() {
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (u32)count : 1;
+}
+
+
+/**
+ * @brief Creates a counting semaphore.
+ * @param initial_count The starting count. `u32` matches sem_init's `unsigned int`.
+ * @param out_semaphore A pointer to the semaphore handle to fill out.
+ * @return `b8` TRUE on success, FALSE on failure.
+ */
+b8 platform_semaphore_create(u32 initial_count, platform_semaphore* out_semaphore) {
+    sem_t* semaphore = malloc(sizeof(sem_t));
+    if (sem_init(semaphore, 0, initial_count) != 0) {
+        KERROR("platform_semaphore_create - sem_init failed.");
+        free(semaphore);
+        return FALSE;
+    }
+    out_semaphore->internal_data = semaphore;
+    return TRUE;
+}
+
+
+/**
+ * @brief Destroys a semaphore.
+ * @param semaphore A pointer to the semaphore handle.
+ */
+void platform_semaphore_destroy(platform_semaphore* semaphore) {
+    if (semaphore && semaphore->internal_data) {
+        sem_destroy((sem_t*)semaphore->internal_data);
+        free(semaphore->internal_data);
+        semaphore->internal_data = 0;
+    }
+}
+
+
+/**
+ * @brief Signals a semaphore.
+ * @param semaphore A pointer to the semaphore handle.
+ */
+void platform_semaphore_signal(platform_semaphore* semaphore) {
+    sem_post((sem_t*)semaphore->internal_data);
+}
+
+
+/**
+ * @brief Waits on a semaphore.
+ * @param semaphore A pointer to the semaphore handle.
+ * @param timeout_ms The maximum wait in milliseconds, or PLATFORM_WAIT_INFINITE.
+ * @return `b8` TRUE if the semaphore was acquired, FALSE on timeout.
+ */
+b8 platform_semaphore_wait(platform_semaphore* semaphore, u32 timeout_ms) {
+    sem_t* handle = (sem_t*)semaphore->internal_data;
+
+    if (timeout_ms == PLATFORM_WAIT_INFINITE) {
+        // Retry if the wait is interrupted by a signal.
+        while (sem_wait(handle) != 0) {
+            if (errno != EINTR) {
+                return FALSE;
+            }
+        }
+        return TRUE;
+    }
+
+    // sem_timedwait takes an absolute deadline on the realtime clock.
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += timeout_ms / 1000;
+    deadline.tv_nsec += (i64)(timeout_ms % 1000) * 1000 * 1000;
+    if (deadline.tv_nsec >= 1000 * 1000 * 1000) {
+        deadline.tv_sec += 1;
+        deadline.tv_nsec -= 1000 * 1000 * 1000;
+    }
+
+    while (sem_timedwait(handle, &deadline) != 0) {
+        if (errno != EINTR) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+
+/**
+ * @brief Opens a file with POSIX open().
+ * @param path The path of the file. `const char*` for a read-only string.
+ * @param mode A combination of platform_file_mode flags.
+ * @param out_file A pointer to the file handle to fill out.
+ * @return `b8` TRUE on success, FALSE on failure.
+ */
+b8 platform_file_open(const char* path, u32 mode, platform_file* out_file) {
+    out_file->handle = 0;
+    out_file->is_valid = FALSE;
+
+    i32 flags = 0;
+    b8 read = (mode & PLATFORM_FILE_MODE_READ) != 0;
+    b8 write = (mode & PLATFORM_FILE_MODE_WRITE) != 0;
+    if (read && write) {
+        flags = O_RDWR | O_CREAT;
+    } else if (write) {
+        flags = O_WRONLY | O_CREAT;
+    } else {
+        flags = O_RDONLY;
+    }
+    if (write) {
+        flags |= (mode & PLATFORM_FILE_MODE_APPEND) ? O_APPEND : O_TRUNC;
+    }
+
+    i32 fd = open(path, flags | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return FALSE;
+    }
+
+    // The descriptor is stored directly in the handle.
+    out_file->handle = (void*)(u64)fd;
+    out_file->is_valid = TRUE;
+    return TRUE;
+}
+
+
+/**
+ * @brief Closes a file.
+ * @param file A pointer to the file handle.
+ */
+void platform_file_close(platform_file* file) {
+    if (file && file->is_valid) {
+        close((i32)(u64)file->handle);
+        file->handle = 0;
+        file->is_valid = FALSE;
+    }
+}
+
+
+/**
+ * @brief Writes to a file, retrying on partial writes.
+ * @param file A pointer to the file handle.
+ * @param data The data to write. `const void*` as it is only read.
+ * @param size The number of bytes to write.
+ * @param out_written An optional pointer receiving the number of bytes written.
+ * @return `b8` TRUE if every byte was written.
+ */
+b8 platform_file_write(platform_file* file, const void* data, u64 size, u64* out_written) {
+    i32 fd = (i32)(u64)file->handle;
+    u64 total = 0;
+    while (total < size) {
+        ssize_t result = write(fd, (const u8*)data + total, size - total);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        total += (u64)result;
+    }
+
+    if (out_written) {
+        *out_written = total;
+    }
+    return total == size;
+}
+
+
+/**
+ * @brief Reads from a file, retrying on partial reads until `size` bytes or end of file.
+ * @param file A pointer to the file handle.
+ * @param buffer The buffer receiving the data.
+ * @param size The maximum number of bytes to read.
+ * @param out_read An optional pointer receiving the number of bytes read.
+ * @return `b8` TRUE on success.
+ */
+b8 platform_file_read(platform_file* file, void* buffer, u64 size, u64* out_read) {
+    i32 fd = (i32)(u64)file->handle;
+    u64 total = 0;
+    b8 success = TRUE;
+    while (total < size) {
+        ssize_t result = read(fd, (u8*)buffer + total, size - total);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            success = FALSE;
+            break;
+        }
+        if (result == 0) {
+            // End of file.
+            break;
+        }
+        total += (u64)result;
+    }
+
+    if (out_read) {
+        *out_read = total;
+    }
+    return success;
+}
+
+
+/**
+ * @brief Gets the size of an open file.
+ * @param file A pointer to the file handle.
+ * @param out_size A pointer receiving the size in bytes.
+ * @return `b8` TRUE on success.
+ */
+b8 platform_file_size(platform_file* file, u64* out_size) {
+    struct stat info;
+    if (fstat((i32)(u64)file->handle, &info) != 0) {
+        return FALSE;
+    }
+    *out_size = (u64)info.st_size;
+    return TRUE;
+}
+
+
+/**
+ * @brief Checks if a file exists.
+ * @param path The path of the file.
+ * @return `b8` TRUE if the file exists.
+ */
+b8 platform_file_exists(const char* path) {
+    struct stat info;
+    return stat(path, &info) == 0;
+}
+
+
+/**
+ * @brief Renames a file, replacing the destination.
+ * @param from The current path.
+ * @param to The new path.
+ * @return `b8` TRUE on success.
+ */
+b8 platform_file_rename(const char* from, const char* to) {
+    return rename(from, to) == 0;
+}
+
+
+/**
+ * @brief Deletes a file.
+ * @param path The path of the file.
+ * @return `b8` TRUE on success.
+ */
+b8 platform_file_delete(const char* path) {
+    return unlink(path) == 0;
+}
+
+
+/**
+ * @brief Maps a whole file read-only with mmap().
+ * @param path The path of the file. `const char*` for a read-only string.
+ * @param hints A combination of platform_file_map_hint flags, passed on to madvise().
+ * @param out_mapping A pointer to the mapping to fill out.
+ * @return `b8` TRUE on success, FALSE on failure.
+ */
+b8 platform_file_map(const char* path, u32 hints, platform_file_mapping* out_mapping) {
+    out_mapping->data = 0;
+    out_mapping->size = 0;
+    out_mapping->is_valid = FALSE;
+
+    i32 fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return FALSE;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        return FALSE;
+    }
+
+    u64 size = (u64)info.st_size;
+    if (size == 0) {
+        // mmap() rejects empty ranges, so an empty file maps to no data.
+        close(fd);
+        out_mapping->is_valid = TRUE;
+        return TRUE;
+    }
+
+    void* data = mmap(0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping holds its own reference to the file.
+    close(fd);
+    if (data == MAP_FAILED) {
+        KERROR("platform_file_map - mmap failed to map '%s' (%llu bytes).", path, size);
+        return FALSE;
+    }
+
+    if (hints & PLATFORM_FILE_MAP_HINT_SEQUENTIAL) {
+        madvise(data, size, MADV_SEQUENTIAL);
+    } else if (hints & PLATFORM_FILE_MAP_HINT_RANDOM) {
+        madvise(data, size, MADV_RANDOM);
+    }
+    if (hints & PLATFORM_FILE_MAP_HINT_WILL_NEED) {
+        madvise(data, size, MADV_WILLNEED);
+    }
+
+    out_mapping->data = data;
+    out_mapping->size = size;
+    out_mapping->is_valid = TRUE;
+    return TRUE;
+}
+
+
+/**
+ * @brief Starts read-ahead of part of a mapped file with madvise(MADV_WILLNEED).
+ * @param mapping A pointer to the mapping.
+ * @param offset The start of the range. Rounded down to the page size.
+ * @param size The size of the range. Clamped to the end of the file.
+ */
+void platform_file_map_prefetch(platform_file_mapping* mapping, u64 offset, u64 size) {
+    if (!mapping || !mapping->is_valid || offset >= mapping->size) {
+        return;
+    }
+    if (size > mapping->size - offset) {
+        size = mapping->size - offset;
+    }
+
+    // madvise() needs a page-aligned start.
+    u64 page_size = platform_get_page_size();
+    u64 aligned_offset = offset & ~(page_size - 1);
+    madvise((u8*)mapping->data + aligned_offset, size + (offset - aligned_offset), MADV_WILLNEED);
+}
+
+
+/**
+ * @brief Unmaps a file mapped with platform_file_map.
+ * @param mapping A pointer to the mapping.
+ */
+void platform_file_unmap(platform_file_mapping* mapping) {
+    if (mapping && mapping->is_valid) {
+        if (mapping->data) {
+            munmap((void*)mapping->data, mapping->size);
+        }
+        mapping->data = 0;
+        mapping->size = 0;
+        mapping->is_valid = FALSE;
+    }
+}
+
+
+/** @brief The number of threads the thread-pool backend of a platform_io_queue runs. */
+#define LINUX_IO_WORKER_COUNT 4
+
+/**
+ * @struct linux_io_request
+ * @brief A read handed to the thread-pool backend.
+ */
+typedef struct linux_io_request {
+    /** @brief The descriptor of the file to read from. */
+    i32 fd;
+
+    /** @brief The number of bytes to read. */
+    u32 size;
+
+    /** @brief The position in the file to read from. */
+    u64 offset;
+
+    /** @brief The buffer receiving the data. */
+    void* buffer;
+
+    /** @brief The user data returned with the completion. */
+    void* user_data;
+} linux_io_request;
+
+/**
+ * @struct linux_io_slot
+ * @brief The state of one io_uring read, kept until its completion has been polled.
+ */
+typedef struct linux_io_slot {
+    /** @brief The destination of the read. The kernel may read it until the read completes. */
+    struct iovec iov;
+
+    /** @brief The user data returned with the completion. */
+    void* user_data;
+
+    /** @brief The index of the next free slot while this one is free. */
+    u32 next_free;
+} linux_io_slot;
+
+/**
+ * @struct linux_io_queue
+ * @brief Holds the state of a platform_io_queue on Linux. Only one backend's fields are in use.
+ */
+typedef struct linux_io_queue {
+    /** @brief The thread-pool backend: reads waiting for an I/O thread. */
+    ring_queue requests;
+
+    /** @brief The thread-pool backend: finished reads waiting to be polled. */
+    ring_queue completions;
+
+    /** @brief Indicates if the queue runs on io_uring rather than the thread pool. */
+    b8 uses_io_uring;
+
+    /** @brief The maximum number of reads in flight. */
+    u32 capacity;
+
+    /** @brief The number of reads queued and not yet polled. Only touched by the owning thread. */
+    u32 in_flight;
+
+    /** @brief The number of reads queued since the last submit. */
+    u32 staged;
+
+    /** @brief The io_uring backend: the ring's file descriptor. */
+    i32 ring_fd;
+
+    /** @brief The io_uring backend: the mapped submission ring and its size. */
+    void* sq_ring;
+    u64 sq_ring_size;
+
+    /** @brief The io_uring backend: the mapped completion ring and its size. May alias the submission ring. */
+    void* cq_ring;
+    u64 cq_ring_size;
+
+    /** @brief The io_uring backend: the mapped submission entries and their size. */
+    void* sqes;
+    u64 sqes_size;
+
+    /** @brief The io_uring backend: pointers into the submission ring. */
+    u32* sq_tail;
+    u32* sq_array;
+    u32 sq_mask;
+
+    /** @brief The io_uring backend: the submission tail including staged entries the kernel has not seen yet. */
+    u32 sq_local_tail;
+
+    /** @brief The io_uring backend: pointers into the completion ring. */
+    u32* cq_head;
+    u32* cq_tail;
+    u32 cq_mask;
+    void* cqes;
+
+    /** @brief The io_uring backend: per-read state, `capacity` slots. */
+    linux_io_slot* slots;
+
+    /** @brief The io_uring backend: the head of the free slot list. */
+    u32 free_slot;
+
+    /** @brief The thread-pool backend: cleared to stop the I/O threads. */
+    b8 running;
+
+    /** @brief The thread-pool backend: signalled when requests are submitted. */
+    platform_semaphore work;
+
+    /** @brief The thread-pool backend: signalled for each finished read. */
+    platform_semaphore done;
+
+    /** @brief The thread-pool backend: the number of I/O threads started. */
+    u32 worker_count;
+
+    /** @brief The thread-pool backend: the I/O threads. */
+    platform_thread workers[LINUX_IO_WORKER_COUNT];
+} linux_io_queue;
+
+#if KPLATFORM_IO_URING
+
+/**
+ * @brief Sets up an io_uring for a queue and maps its rings.
+ * @param queue A pointer to the queue state.
+ * @return `b8` TRUE on success, FALSE if io_uring is unavailable.
+ */
+static b8 linux_io_uring_create(linux_io_queue* queue) {
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    i32 fd = (i32)syscall(__NR_io_uring_setup, queue->capacity, &params);
+    if (fd < 0) {
+        // ENOSYS on kernels before 5.1, EPERM where it is disabled (e.g. by a seccomp filter).
+        return FALSE;
+    }
+
+    queue->ring_fd = fd;
+    queue->sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(u32);
+    queue->cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    queue->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+
+    // Newer kernels map both rings with a single mmap.
+    b8 single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap) {
+        if (queue->cq_ring_size > queue->sq_ring_size) {
+            queue->sq_ring_size = queue->cq_ring_size;
+        }
+        queue->cq_ring_size = queue->sq_ring_size;
+    }
+
+    queue->sq_ring = mmap(0, queue->sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    queue->cq_ring = single_mmap ? queue->sq_ring : mmap(0, queue->cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+    queue->sqes = mmap(0, queue->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if (queue->sq_ring == MAP_FAILED || queue->cq_ring == MAP_FAILED || queue->sqes == MAP_FAILED) {
+        if (queue->sqes != MAP_FAILED) {
+            munmap(queue->sqes, queue->sqes_size);
+        }
+        if (!single_mmap && queue->cq_ring != MAP_FAILED) {
+            munmap(queue->cq_ring, queue->cq_ring_size);
+        }
+        if (queue->sq_ring != MAP_FAILED) {
+            munmap(queue->sq_ring, queue->sq_ring_size);
+        }
+        close(fd);
+        return FALSE;
+    }
+
+    u8* sq = queue->sq_ring;
+    queue->sq_tail = (u32*)(sq + params.sq_off.tail);
+    queue->sq_array = (u32*)(sq + params.sq_off.array);
+    queue->sq_mask = *(u32*)(sq + params.sq_off.ring_mask);
+    queue->sq_local_tail = *queue->sq_tail;
+
+    u8* cq = queue->cq_ring;
+    queue->cq_head = (u32*)(cq + params.cq_off.head);
+    queue->cq_tail = (u32*)(cq + params.cq_off.tail);
+    queue->cq_mask = *(u32*)(cq + params.cq_off.ring_mask);
+    queue->cqes = cq + params.cq_off.cqes;
+
+    // Chain every slot into the free list.
+    queue->slots = platform_allocate(sizeof(linux_io_slot) * queue->capacity, FALSE);
+    for (u32 i = 0; i < queue->capacity; ++i) {
+        queue->slots[i].next_free = i + 1;
+    }
+    queue->free_slot = 0;
+
+    queue->uses_io_uring = TRUE;
+    return TRUE;
+}
+
+/**
+ * @brief Unmaps and closes a queue's io_uring.
+ * @param queue A pointer to the queue state.
+ */
+static void linux_io_uring_destroy(linux_io_queue* queue) {
+    munmap(queue->sqes, queue->sqes_size);
+    if (queue->cq_ring != queue->sq_ring) {
+        munmap(queue->cq_ring, queue->cq_ring_size);
+    }
+    munmap(queue->sq_ring, queue->sq_ring_size);
+    close(queue->ring_fd);
+    platform_free(queue->slots, FALSE);
+}
+
+#endif
+
+/**
+ * @brief The entry point of the thread-pool backend's I/O threads.
+ * @param params The linux_io_queue the thread serves.
+ * @return `u32` The thread's exit code.
+ */
+static u32 linux_io_worker_main(void* params) {
+    linux_io_queue* queue = params;
+    linux_io_request request;
+    for (;;) {
+        platform_semaphore_wait(&queue->work, PLATFORM_WAIT_INFINITE);
+        if (!katomic_load(&queue->running, KATOMIC_ACQUIRE)) {
+            break;
+        }
+
+        while (ring_queue_dequeue(&queue->requests, &request)) {
+            platform_io_completion completion = {request.user_data, 0, TRUE};
+            while (completion.bytes_read < request.size) {
+                ssize_t result = pread(request.fd, (u8*)request.buffer + completion.bytes_read, request.size - completion.bytes_read, (off_t)(request.offset + completion.bytes_read));
+                if (result < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    completion.success = FALSE;
+                    break;
+                }
+                if (result == 0) {
+                    // End of file.
+                    break;
+                }
+                completion.bytes_read += (u32)result;
+            }
+
+            // Cannot fail: no more reads are in flight than the completion queue holds.
+            ring_queue_enqueue(&queue->completions, &completion);
+            platform_semaphore_signal(&queue->done);
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Starts the thread-pool backend of a queue.
+ * @param queue A pointer to the queue state.
+ * @return `b8` TRUE on success, FALSE on failure.
+ */
+static b8 linux_io_pool_create(linux_io_queue* queue) {
+    // The ring queues need a power-of-two capacity.
+    u64 ring_capacity = 1;
+    while (ring_capacity < queue->capacity) {
+        ring_capacity <<= 1;
+    }
+
+    if (!ring_queue_create(RING_QUEUE_TYPE_MPMC, sizeof(linux_io_request), ring_capacity, 0, &queue->requests)) {
+        return FALSE;
+    }
+    if (!ring_queue_create(RING_QUEUE_TYPE_MPMC, sizeof(platform_io_completion), ring_capacity, 0, &queue->completions)) {
+        ring_queue_destroy(&queue->requests);
+        return FALSE;
+    }
+    platform_semaphore_create(0, &queue->work);
+    platform_semaphore_create(0, &queue->done);
+
+    queue->running = TRUE;
+    for (u32 i = 0; i < LINUX_IO_WORKER_COUNT; ++i) {
+        if (!platform_thread_create(linux_io_worker_main, queue, &queue->workers[i])) {
+            break;
+        }
+        queue->worker_count++;
+    }
+    if (queue->worker_count == 0) {
+        KERROR("platform_io_queue_create - failed to start any I/O threads.");
+        platform_semaphore_destroy(&queue->done);
+        platform_semaphore_destroy(&queue->work);
+        ring_queue_destroy(&queue->completions);
+        ring_queue_destroy(&queue->requests);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/**
+ * @brief Stops and joins the I/O threads of a queue and releases the thread-pool backend.
+ * @param queue A pointer to the queue state.
+ */
+static void linux_io_pool_destroy(linux_io_queue* queue) {
+    katomic_store(&queue->running, FALSE, KATOMIC_RELEASE);
+    for (u32 i = 0; i < queue->worker_count; ++i) {
+        platform_semaphore_signal(&queue->work);
+    }
+    for (u32 i = 0; i < queue->worker_count; ++i) {
+        platform_thread_join(&queue->workers[i]);
+    }
+    platform_semaphore_destroy(&queue->done);
+    platform_semaphore_destroy(&queue->work);
+    ring_queue_destroy(&queue->completions);
+    ring_queue_destroy(&queue->requests);
+}
+
+
+/**
+ * @brief Creates an async I/O queue on io_uring, or on the thread pool if io_uring is unavailable.
+ * @param capacity The maximum number of reads in flight.
+ * @param backend The requested backend.
+ * @param out_queue A pointer to the queue handle to fill out.
+ * @return `b8` TRUE on success, FALSE on failure.
+ */
+b8 platform_io_queue_create(u32 capacity, platform_io_backend backend, platform_io_queue* out_queue) {
+    out_queue->internal_state = 0;
+    if (capacity == 0) {
+        KERROR("platform_io_queue_create - capacity must be greater than 0.");
+        return FALSE;
+    }
+
+    // Aligned, as the ring queues keep their positions on separate cache lines.
+    linux_io_queue* queue = platform_allocate_aligned(sizeof(linux_io_queue), KCACHE_LINE_SIZE);
+    memset(queue, 0, sizeof(linux_io_queue));
+    queue->capacity = capacity;
+
+    b8 created = FALSE;
+#if KPLATFORM_IO_URING
+    if (backend == PLATFORM_IO_BACKEND_DEFAULT) {
+        created = linux_io_uring_create(queue);
+        if (!created) {
+            KWARN("platform_io_queue_create - io_uring is unavailable, falling back to I/O threads.");
+        }
+    }
+#endif
+    if (!created && !linux_io_pool_create(queue)) {
+        platform_free_aligned(queue);
+        return FALSE;
+    }
+
+    out_queue->internal_state = queue;
+    return TRUE;
+}
+
+
+/**
+ * @brief Destroys an async I/O queue.
+ * @param queue A pointer to the queue handle.
+ */
+void platform_io_queue_destroy(platform_io_queue* queue) {
+    if (!queue || !queue->internal_state) {
+        return;
+    }
+
+    linux_io_queue* state = queue->internal_state;
+    if (state->in_flight > 0) {
+        KWARN("platform_io_queue_destroy - destroying a queue with %u reads in flight.", state->in_flight);
+    }
+
+#if KPLATFORM_IO_URING
+    if (state->uses_io_uring) {
+        linux_io_uring_destroy(state);
+    } else
+#endif
+    {
+        linux_io_pool_destroy(state);
+    }
+
+    platform_free_aligned(state);
+    queue->internal_state = 0;
+}
+
+
+/**
+ * @brief Gets the name of the backend a queue runs on.
+ * @param queue A pointer to the queue handle.
+ * @return `const char*` "io_uring" or "thread_pool".
+ */
+const char* platform_io_queue_backend_name(platform_io_queue* queue) {
+    linux_io_queue* state = queue->internal_state;
+    return state->uses_io_uring ? "io_uring" : "thread_pool";
+}
+
+
+/**
+ * @brief Queues a read: an io_uring submission entry, or a request for the I/O threads.
+ * @param queue A pointer to the queue handle.
+ * @param file The file to read from.
+ * @param offset The position in the file to read from.
+ * @param buffer The buffer receiving the data.
+ * @param size The number of bytes to read.
+ * @param user_data The user data returned with the completion.
+ * @return `b8` TRUE if the read was queued, FALSE if the queue is at capacity.
+ */
+b8 platform_io_queue_read(platform_io_queue* queue, platform_file* file, u64 offset, void* buffer, u32 size, void* user_data) {
+    linux_io_queue* state = queue->internal_state;
+    if (state->in_flight == state->capacity || !file || !file->is_valid) {
+        return FALSE;
+    }
+
+    i32 fd = (i32)(u64)file->handle;
+#if KPLATFORM_IO_URING
+    if (state->uses_io_uring) {
+        u32 slot_index = state->free_slot;
+        linux_io_slot* slot = &state->slots[slot_index];
+        state->free_slot = slot->next_free;
+        slot->iov.iov_base = buffer;
+        slot->iov.iov_len = size;
+        slot->user_data = user_data;
+
+        // READV rather than READ, as it exists since the first io_uring kernel (5.1).
+        u32 index = state->sq_local_tail & state->sq_mask;
+        struct io_uring_sqe* sqe = (struct io_uring_sqe*)state->sqes + index;
+        memset(sqe, 0, sizeof(struct io_uring_sqe));
+        sqe->opcode = IORING_OP_READV;
+        sqe->fd = fd;
+        sqe->off = offset;
+        sqe->addr = (u64)&slot->iov;
+        sqe->len = 1;
+        sqe->user_data = slot_index;
+        state->sq_array[index] = index;
+        state->sq_local_tail++;
+    } else
+#endif
+    {
+        linux_io_request request = {fd, size, offset, buffer, user_data};
+        ring_queue_enqueue(&state->requests, &request);
+    }
+
+    state->in_flight++;
+    state->staged++;
+    return TRUE;
+}
+
+
+/**
+ * @brief Submits the staged reads: one io_uring_enter for the batch, or one wake-up per I/O thread.
+ * @param queue A pointer to the queue handle.
+ */
+void platform_io_queue_submit(platform_io_queue* queue) {
+    linux_io_queue* state = queue->internal_state;
+    if (state->staged == 0) {
+        return;
+    }
+
+#if KPLATFORM_IO_URING
+    if (state->uses_io_uring) {
+        // Publish the entries, then tell the kernel how many to consume.
+        katomic_store(state->sq_tail, state->sq_local_tail, KATOMIC_RELEASE);
+        while (state->staged > 0) {
+            long result = syscall(__NR_io_uring_enter, state->ring_fd, state->staged, 0, 0, 0, 0);
+            if (result < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                // The entries stay in the ring and are retried on the next submit.
+                KERROR("platform_io_queue_submit - io_uring_enter failed with error %d.", errno);
+                return;
+            }
+            state->staged -= (u32)result;
+        }
+        return;
+    }
+#endif
+
+    u32 wake = state->staged < state->worker_count ? state->staged : state->worker_count;
+    for (u32 i = 0; i < wake; ++i) {
+        platform_semaphore_signal(&state->work);
+    }
+    state->staged = 0;
+}
+
+
+/**
+ * @brief Harvests finished reads from the completion ring or the I/O threads' completion queue.
+ * @param queue A pointer to the queue handle.
+ * @param out_completions The array receiving the completions.
+ * @param max_count The size of `out_completions`.
+ * @param wait If TRUE and reads are in flight, blocks until at least one has finished.
+ * @return `u32` The number of completions written.
+ */
+u32 platform_io_queue_poll(platform_io_queue* queue, platform_io_completion* out_completions, u32 max_count, b8 wait) {
+    linux_io_queue* state = queue->internal_state;
+    if (wait) {
+        // Nothing staged would ever finish.
+        platform_io_queue_submit(queue);
+    }
+
+    u32 count = 0;
+    for (;;) {
+#if KPLATFORM_IO_URING
+        if (state->uses_io_uring) {
+            // Only this thread moves the head; the kernel moves the tail.
+            u32 head = *state->cq_head;
+            u32 tail = katomic_load(state->cq_tail, KATOMIC_ACQUIRE);
+            while (count < max_count && head != tail) {
+                struct io_uring_cqe* cqe = (struct io_uring_cqe*)state->cqes + (head & state->cq_mask);
+                linux_io_slot* slot = &state->slots[cqe->user_data];
+                out_completions[count].user_data = slot->user_data;
+                out_completions[count].bytes_read = cqe->res > 0 ? (u32)cqe->res : 0;
+                out_completions[count].success = cqe->res >= 0;
+                slot->next_free = state->free_slot;
+                state->free_slot = (u32)cqe->user_data;
+                count++;
+                head++;
+            }
+            katomic_store(state->cq_head, head, KATOMIC_RELEASE);
+        } else
+#endif
+        {
+            count += (u32)ring_queue_dequeue_batch(&state->completions, out_completions + count, max_count - count);
+        }
+
+        state->in_flight -= count;
+        if (count > 0 || !wait || state->in_flight == 0) {
+            return count;
+        }
+
+#if KPLATFORM_IO_URING
+        if (state->uses_io_uring) {
+            syscall(__NR_io_uring_enter, state->ring_fd, 0, 1, IORING_ENTER_GETEVENTS, 0, 0);
+            continue;
+        }
+#endif
+        // Signals left over from completions that were polled without waiting make this return
+        // early at worst, in which case the loop simply looks again.
+        platform_semaphore_wait(&state->done, PLATFORM_WAIT_INFINITE);
+    }
+}
+
+
+/**
+ * @brief Gets the number of reads in flight.
+ * @param queue A pointer to the queue handle.
+ * @return `u32` The number of reads queued and not yet polled.
+ */
+u32 platform_io_queue_in_flight(platform_io_queue* queue) {
+    linux_io_queue* state = queue->internal_state;
+    return state->in_flight;
+}
+
+
+
+/**
+ * @param names_darray A pointer to a darray of `const char*` names.
+ */
+void platform_get_required_extension_names(const char*** names_darray) {
+    const char* name = VK_KHR_XCB_SURFACE_EXTENSION_NAME;
+    darray_push(*names_darray, name);
+}
+
+
+/**
+ * @param plat_state A pointer to the platform state.
+ * @param context A pointer to the Vulkan context.
+ * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+ */
+b8 platform_create_vulkan_surface(platform_state* plat_state, vulkan_context* context) {
+    internal_state* state = (internal_state*)plat_state->internal_state;
+
+    VkXcbSurfaceCreateInfoKHR create_info = {VK_STRUCTURE_TYPE_XCB_SURFACE_CREATE_INFO_KHR};
+    create_info.connection = state->connection;
+    create_info.window = state->window;
+
+    VkResult result = vkCreateXcbSurfaceKHR(context->instance, &create_info, context->allocator, &context->surface);
+    if (result != VK_SUCCESS) {
+        KERROR("vkCreateXcbSurfaceKHR failed with %d.", result);
+        return FALSE;
+    }
+    return TRUE;
+}
+
 #endif
\ No newline at end of file
@@ -14,10 +14,19 @@
 #if KPLATFORM_WINDOWS
 
 #include "core/logger.h"
+#include "core/event.h"
 
 #include <windows.h>
 #include <windowsx.h> // param input extraction
 #include <stdlib.h> // Required for malloc and free.
+#include <malloc.h> // Required for _aligned_malloc and _aligned_free.
+
+// Vulkan surfaces on the Win32 window. Must follow the windows.h include.
+#define VK_USE_PLATFORM_WIN32_KHR
+#include <vulkan/vulkan.h>
+#include "containers/darray.h"
+#include "renderer/vulkan/vulkan_platform.h"
+#include "renderer/vulkan/vulkan_types.h"
 
 /**
  * @struct internal_state
@@ -190,24 +199,69 @@ b8 platform_pump_messages(platform_state* plat_state) {
 }
 
 
+/**
+ * @param timeout_ms The `u32` maximum wait in milliseconds. PLATFORM_WAIT_INFINITE matches Win32's INFINITE.
+ */
+b8 platform_wait_messages(platform_state* plat_state, u32 timeout_ms) {
+    // Wakes on any input or posted message. Does not remove anything from the queue.
+    // MWMO_INPUTAVAILABLE also wakes on input that is already queued but was only peeked,
+    // which would otherwise not count as new and stall the loop until the next message.
+    DWORD result = MsgWaitForMultipleObjectsEx(0, 0, timeout_ms == PLATFORM_WAIT_INFINITE ? INFINITE : timeout_ms, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+    return result == WAIT_OBJECT_0;
+}
+
+
 /**
  * @param size The size in bytes to allocate. `u64` allows for large allocations on 64-bit systems.
- * @param aligned A `b8` flag indicating if the memory should be aligned (currently unused).
+ * @param aligned A `b8` flag indicating if the memory should be aligned to PLATFORM_DEFAULT_ALIGNMENT.
  */
 void* platform_allocate(u64 size, b8 aligned) {
+    if (aligned) {
+        return platform_allocate_aligned(size, PLATFORM_DEFAULT_ALIGNMENT);
+    }
     return malloc(size);
 }
 
 
+/**
+ * @param size The size in bytes to allocate. The CRT's calloc uses zero-initialized heap pages,
+ * so large blocks are not written over a second time.
+ */
+void* platform_allocate_zeroed(u64 size) {
+    return calloc(1, size);
+}
+
+
 /**
  * @param block A `void*` generic pointer to the memory to be freed.
- * @param aligned A `b8` flag indicating if the memory was aligned (currently unused).
+ * @param aligned A `b8` flag indicating if the memory was aligned. Aligned blocks must go through _aligned_free.
  */
 void platform_free(void* block, b8 aligned) {
+    if (aligned) {
+        platform_free_aligned(block);
+        return;
+    }
     free(block);
 }
 
 
+/**
+ * @param size The size in bytes to allocate.
+ * @param alignment The `u16` power-of-two alignment in bytes.
+ */
+void* platform_allocate_aligned(u64 size, u16 alignment) {
+    return _aligned_malloc(size, alignment);
+}
+
+
+/**
+ * @param block A `void*` pointer to a block returned by platform_allocate_aligned.
+ */
+void platform_free_aligned(void* block) {
+    _aligned_free(block);
+}
+
+
 /**
  * @param block A `void*` generic pointer to the memory block.
  * @param size The `u64` size in bytes of the block to be zeroed.
@@ -227,6 +281,16 @@ void* platform_copy_memory(void* dest, const void* source, u64 size) {
 }
 
 
+/**
+ * @param dest A `void*` pointer to the destination memory block.
+ * @param source A `const void*` pointer to the source, which may overlap `dest`.
+ * @param size The `u64` number of bytes to copy.
+ */
+void* platform_move_memory(void* dest, const void* source, u64 size) {
+    return memmove(dest, source, size);
+}
+
+
 /**
  * @param dest A `void*` pointer to the destination memory block.
  * @param value The `i32` value to set each byte to (will be truncated to a char).
@@ -238,6 +302,66 @@ void* platform_set_memory(void* dest, i32 value, u64 size) {
 
 
 
+/**
+ * @return The page size in bytes, as reported by GetSystemInfo.
+ */
+u64 platform_get_page_size() {
+    static u64 page_size = 0;
+    if (!page_size) {
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        page_size = info.dwPageSize;
+    }
+    return page_size;
+}
+
+
+/**
+ * @param size The `u64` size of the range to reserve.
+ * @param large_pages Ignored. Win32 large pages must be committed at reservation time and
+ * require the SeLockMemoryPrivilege, which does not fit the reserve/commit model.
+ */
+void* platform_reserve(u64 size, b8 large_pages) {
+    void* address = VirtualAlloc(0, size, MEM_RESERVE, PAGE_NOACCESS);
+    if (!address) {
+        KERROR("platform_reserve - VirtualAlloc failed to reserve %llu bytes.", size);
+    }
+    return address;
+}
+
+
+/**
+ * @param address The page-aligned start of the range to commit.
+ * @param size The `u64` size of the range to commit.
+ */
+b8 platform_commit(void* address, u64 size) {
+    if (!VirtualAlloc(address, size, MEM_COMMIT, PAGE_READWRITE)) {
+        KERROR("platform_commit - VirtualAlloc failed to commit %llu bytes.", size);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+
+/**
+ * @param address The page-aligned start of the range to decommit.
+ * @param size The `u64` size of the range to decommit.
+ */
+void platform_decommit(void* address, u64 size) {
+    VirtualFree(address, size, MEM_DECOMMIT);
+}
+
+
+/**
+ * @param address The start of the range, as returned by platform_reserve.
+ * @param size Unused. MEM_RELEASE always releases the entire reservation.
+ */
+void platform_release(void* address, u64 size) {
+    VirtualFree(address, 0, MEM_RELEASE);
+}
+
+
+
 /**
  * @param message The `const char*` message string to write.
  * @param colour A `u8` index representing the desired color level.
@@ -276,12 +400,39 @@ void platform_console_write_error(const char* message, u8 colour) {
  * @return Returns the absolute time in seconds as a high-precision `f64`.
  */
 f64 platform_get_absolute_time() {
+    // Tools that time code without ever calling platform_startup still get a valid clock.
+    if (clock_period == 0) {
+        LARGE_INTEGER frequency;
+        QueryPerformanceFrequency(&frequency);
+        clock_period = 1.0 / (f64) frequency.QuadPart;
+    }
+
     LARGE_INTEGER now_time;
     QueryPerformanceCounter(&now_time);
     return (f64) now_time.QuadPart * clock_period;
 }
 
 
+/**
+ * @return Returns the raw QueryPerformanceCounter value.
+ */
+u64 platform_get_ticks() {
+    LARGE_INTEGER now_time;
+    QueryPerformanceCounter(&now_time);
+    return (u64)now_time.QuadPart;
+}
+
+
+/**
+ * @return Returns the QueryPerformanceFrequency value, which is fixed at boot.
+ */
+u64 platform_get_tick_frequency() {
+    LARGE_INTEGER frequency;
+    QueryPerformanceFrequency(&frequency);
+    return (u64)frequency.QuadPart;
+}
+
+
 /**
  * @param ms The number of milliseconds to sleep. `u64` allows for very long durations if needed.
  */
@@ -290,6 +441,131 @@ void platform_sleep(u64 ms) {
 }
 
 
+/**
+ * @struct win32_thread_start_data
+ * @brief Carries the user's entry point across the Win32 thread procedure signature.
+ */
+typedef struct win32_thread_start_data {
+    /** @brief The user's entry point. */
+    platform_thread_start start;
+
+    /** @brief The user's parameter. */
+    void* params;
+} win32_thread_start_data;
+
+/**
+ * @brief The Win32 thread procedure. Unpacks the start data and calls the user's function.
+ */
+static DWORD WINAPI win32_thread_entry(LPVOID arg) {
+    win32_thread_start_data data = *(win32_thread_start_data*)arg;
+    free(arg);
+    return data.start(data.params);
+}
+
+
+/**
+ * @param start The entry point of the new thread.
+ * @param params A `void*` parameter forwarded to `start`.
+ * @param out_thread A pointer to the thread handle to fill out.
+ */
+b8 platform_thread_create(platform_thread_start start, void* params, platform_thread* out_thread) {
+    if (!start || !out_thread) {
+        return FALSE;
+    }
+
+    // Freed by the new thread once it has copied the data out.
+    win32_thread_start_data* data = malloc(sizeof(win32_thread_start_data));
+    data->start = start;
+    data->params = params;
+
+    DWORD thread_id = 0;
+    HANDLE handle = CreateThread(0, 0, win32_thread_entry, data, 0, &thread_id);
+    if (!handle) {
+        KERROR("platform_thread_create - CreateThread failed.");
+        free(data);
+        return FALSE;
+    }
+
+    out_thread->internal_data = handle;
+    out_thread->thread_id = thread_id;
+    return TRUE;
+}
+
+
+/**
+ * @param thread A pointer to the thread to wait for and release.
+ */
+void platform_thread_join(platform_thread* thread) {
+    if (thread && thread->internal_data) {
+        WaitForSingleObject((HANDLE)thread->internal_data, INFINITE);
+        CloseHandle((HANDLE)thread->internal_data);
+        thread->internal_data = 0;
+        thread->thread_id = 0;
+    }
+}
+
+
+/**
+ * @return The Win32 identifier of the calling thread.
+ */
+u64 platform_current_thread_id() {
+    return (u64)GetCurrentThreadId();
+}
+
+
+/**
+ * @return The number of logical processors, as reported by GetSystemInfo.
+ */
+u32 platform_get_processor_count() {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (u32)info.dwNumberOfProcessors : 1;
+}
+
+
+/**
+ * @param initial_count The `u32` starting count of the semaphore.
+ * @param out_semaphore A pointer to the semaphore handle to fill out.
+ */
+b8 platform_semaphore_create(u32 initial_count, platform_semaphore* out_semaphore) {
+    HANDLE handle = CreateSemaphoreA(0, initial_count, 0x7FFFFFFF, 0);
+    if (!handle) {
+        KERROR("platform_semaphore_create - CreateSemaphoreA failed.");
+        return FALSE;
+    }
+    out_semaphore->internal_data = handle;
+    return TRUE;
+}
+
+
+/**
+ * @param semaphore A pointer to the semaphore handle to close.
+ */
+void platform_semaphore_destroy(platform_semaphore* semaphore) {
+    if (semaphore && semaphore->internal_data) {
+        CloseHandle((HANDLE)semaphore->internal_data);
+        semaphore->internal_data = 0;
+    }
+}
+
+
+/**
+ * @param semaphore A pointer to the semaphore handle to signal.
+ */
+void platform_semaphore_signal(platform_semaphore* semaphore) {
+    ReleaseSemaphore((HANDLE)semaphore->internal_data, 1, 0);
+}
+
+
+/**
+ * @param semaphore A pointer to the semaphore handle to wait on.
+ * @param timeout_ms The `u32` timeout in milliseconds. PLATFORM_WAIT_INFINITE matches Win32's INFINITE.
+ */
+b8 platform_semaphore_wait(platform_semaphore* semaphore, u32 timeout_ms) {
+    return WaitForSingleObject((HANDLE)semaphore->internal_data, timeout_ms) == WAIT_OBJECT_0;
+}
+
+
 /**
  * @param hwnd A `HWND` handle to the window that received the message.
  * @param msg The `u32` message identifier (e.g., WM_CLOSE).
@@ -302,52 +578,57 @@ LRESULT CALLBACK win32_process_message(HWND hwnd, u32 msg, WPARAM w_param, LPARA
         case WM_ERASEBKGND:
             // Notify the OS that we will handle erasing the background to prevent flicker.
             return 1;
-        case WM_CLOSE:
-            // TODO: Fire an event for the application to quit gracefully.
-            return 0;
+        case WM_CLOSE: {
+            // Let the application shut down gracefully instead of destroying the window right away.
+            event quit_event = {0};
+            quit_event.code = EVENT_CODE_APPLICATION_QUIT;
+            event_post(&quit_event);
+        } return 0;
         case WM_DESTROY:
             // This message is sent when the window is being destroyed.
             PostQuitMessage(0);
             return 0;
         case WM_SIZE: {
-            // A resize event occurred.
-
-            // Get the updated size
-            // RECT r;
-            // GetClientRect(hwnd, &r);
-            // u32 width = r.right - r.left;
-            // u32 height = r.bottom - r.top;
-
-            // TODO: Fire an event for the renderer to handle the new window size.
+            // A resize event occurred. Get the updated size of the client area.
+            RECT r;
+            GetClientRect(hwnd, &r);
+
+            event resize_event = {0};
+            resize_event.code = EVENT_CODE_RESIZED;
+            resize_event.resize.width = (u16)(r.right - r.left);
+            resize_event.resize.height = (u16)(r.bottom - r.top);
+            event_post(&resize_event);
         }break;
         case WM_KEYDOWN:
         case WM_SYSKEYDOWN:
         case WM_KEYUP:
         case WM_SYSKEYUP: {
-            // Keyboard input event.
-
-            // Key pressed/released
-            // b8 pressed = (msg == WM_KEYDOWN || msg == WM_SYSKEYDOWN);
+            // Keyboard input event. The engine's key codes are the virtual-key codes.
+            b8 pressed = (msg == WM_KEYDOWN || msg == WM_SYSKEYDOWN);
 
-            // TODO: Process keyboard input and fire events.
+            event key_event = {0};
+            key_event.code = pressed ? EVENT_CODE_KEY_PRESSED : EVENT_CODE_KEY_RELEASED;
+            key_event.key.key = (keys)(w_param & 0xFF);
+            event_post(&key_event);
         }break;
         case WM_MOUSEMOVE: {
-            // Mouse movement event.
-
-            //i32 x_position = GET_X_LPARAM(l_param);
-            //i32 y_position = GET_Y_LPARAM(l_param);
-            
-            // TODO: Process mouse movement and fire events.
+            // Mouse movement event. Coalesced by the event system to one per frame.
+            event move_event = {0};
+            move_event.code = EVENT_CODE_MOUSE_MOVED;
+            move_event.mouse_move.x = (i16)GET_X_LPARAM(l_param);
+            move_event.mouse_move.y = (i16)GET_Y_LPARAM(l_param);
+            event_post(&move_event);
         }break;
         case WM_MOUSEWHEEL: {
             // Mouse wheel scroll event.
-            
-            // i32 z_delta = GET_WHEEL_DELTA_WPARAM(w_param);
-            // if (z_delta != 0) {
-            //     // Flatten the input to an OS-independent (-1, 1)
-            //     z_delta = (z_delta < 0) ? -1 : 1;
-            //     // TODO: Process mouse wheel input and fire events.
-            // } 
+            i32 z_delta = GET_WHEEL_DELTA_WPARAM(w_param);
+            if (z_delta != 0) {
+                // Flatten the input to an OS-independent (-1, 1)
+                event wheel_event = {0};
+                wheel_event.code = EVENT_CODE_MOUSE_WHEEL;
+                wheel_event.mouse_wheel.z_delta = (z_delta < 0) ? -1 : 1;
+                event_post(&wheel_event);
+            }
         }break;
         case WM_LBUTTONDOWN:
         case WM_MBUTTONDOWN:
@@ -356,10 +637,26 @@ LRESULT CALLBACK win32_process_message(HWND hwnd, u32 msg, WPARAM w_param, LPARA
         case WM_MBUTTONUP:
         case WM_RBUTTONUP: {
             // Mouse button event.
-
-            // b8 pressed = (msg == WM_LBUTTONDOWN || msg == WM_MBUTTONDOWN || msg == WM_RBUTTONDOWN);
-
-            // TODO: Process mouse button input and fire events.
+            b8 pressed = (msg == WM_LBUTTONDOWN || msg == WM_MBUTTONDOWN || msg == WM_RBUTTONDOWN);
+
+            event button_event = {0};
+            button_event.code = pressed ? EVENT_CODE_BUTTON_PRESSED : EVENT_CODE_BUTTON_RELEASED;
+            switch (msg) {
+                case WM_LBUTTONDOWN:
+                case WM_LBUTTONUP:
+                    button_event.button.button = BUTTON_LEFT;
+                    break;
+                case WM_MBUTTONDOWN:
+                case WM_MBUTTONUP:
+                    button_event.button.button = BUTTON_MIDDLE;
+                    break;
+                default:
+                    button_event.button.button = BUTTON_RIGHT;
+                    break;
+            }
+            button_event.button.x = (i16)GET_X_LPARAM(l_param);
+            button_event.button.y = (i16)GET_Y_LPARAM(l_param);
+            event_post(&button_event);
         }break;
     }
 
@@ -367,4 +664,515 @@ LRESULT CALLBACK win32_process_message(HWND hwnd, u32 msg, WPARAM w_param, LPARA
     return DefWindowProcA(hwnd, msg, w_param, l_param);
 }
 
+
+/**
+ * @param path The `const char*` path of the file to open.
+ * @param mode A combination of platform_file_mode flags.
+ * @param out_file A pointer to the file handle to fill out.
+ */
+b8 platform_file_open(const char* path, u32 mode, platform_file* out_file) {
+    out_file->handle = 0;
+    out_file->is_valid = FALSE;
+
+    DWORD access = 0;
+    DWORD creation = OPEN_EXISTING;
+    if (mode & PLATFORM_FILE_MODE_READ) {
+        access |= GENERIC_READ;
+    }
+    if (mode & PLATFORM_FILE_MODE_WRITE) {
+        access |= GENERIC_WRITE;
+        creation = (mode & PLATFORM_FILE_MODE_APPEND) ? OPEN_ALWAYS : CREATE_ALWAYS;
+    }
+
+    // Async files are read through an IOCP, which needs an overlapped handle.
+    DWORD flags = (mode & PLATFORM_FILE_MODE_ASYNC) ? FILE_FLAG_OVERLAPPED : FILE_ATTRIBUTE_NORMAL;
+    HANDLE handle = CreateFileA(path, access, FILE_SHARE_READ, 0, creation, flags, 0);
+    if (handle == INVALID_HANDLE_VALUE) {
+        return FALSE;
+    }
+
+    if ((mode & PLATFORM_FILE_MODE_WRITE) && (mode & PLATFORM_FILE_MODE_APPEND)) {
+        LARGE_INTEGER zero = {0};
+        SetFilePointerEx(handle, zero, 0, FILE_END);
+    }
+
+    out_file->handle = handle;
+    out_file->is_valid = TRUE;
+    return TRUE;
+}
+
+
+/**
+ * @param file A pointer to the file handle to close.
+ */
+void platform_file_close(platform_file* file) {
+    if (file && file->is_valid) {
+        CloseHandle((HANDLE)file->handle);
+        file->handle = 0;
+        file->is_valid = FALSE;
+    }
+}
+
+
+/**
+ * @param file A pointer to the file handle.
+ * @param data The `const void*` data to write.
+ * @param size The `u64` number of bytes to write. Written in chunks, as WriteFile takes a DWORD size.
+ * @param out_written An optional pointer receiving the number of bytes written.
+ */
+b8 platform_file_write(platform_file* file, const void* data, u64 size, u64* out_written) {
+    u64 total = 0;
+    while (total < size) {
+        u64 remaining = size - total;
+        DWORD chunk = remaining > 0x40000000 ? 0x40000000 : (DWORD)remaining;
+        DWORD written = 0;
+        if (!WriteFile((HANDLE)file->handle, (const u8*)data + total, chunk, &written, 0) || written == 0) {
+            break;
+        }
+        total += written;
+    }
+
+    if (out_written) {
+        *out_written = total;
+    }
+    return total == size;
+}
+
+
+/**
+ * @param file A pointer to the file handle.
+ * @param buffer The buffer receiving the data.
+ * @param size The `u64` maximum number of bytes to read.
+ * @param out_read An optional pointer receiving the number of bytes read.
+ */
+b8 platform_file_read(platform_file* file, void* buffer, u64 size, u64* out_read) {
+    u64 total = 0;
+    b8 success = TRUE;
+    while (total < size) {
+        u64 remaining = size - total;
+        DWORD chunk = remaining > 0x40000000 ? 0x40000000 : (DWORD)remaining;
+        DWORD read = 0;
+        if (!ReadFile((HANDLE)file->handle, (u8*)buffer + total, chunk, &read, 0)) {
+            success = FALSE;
+            break;
+        }
+        if (read == 0) {
+            // End of file.
+            break;
+        }
+        total += read;
+    }
+
+    if (out_read) {
+        *out_read = total;
+    }
+    return success;
+}
+
+
+/**
+ * @param file A pointer to the file handle.
+ * @param out_size A pointer receiving the `u64` size in bytes.
+ */
+b8 platform_file_size(platform_file* file, u64* out_size) {
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx((HANDLE)file->handle, &size)) {
+        return FALSE;
+    }
+    *out_size = (u64)size.QuadPart;
+    return TRUE;
+}
+
+
+/**
+ * @param path The `const char*` path of the file.
+ */
+b8 platform_file_exists(const char* path) {
+    return GetFileAttributesA(path) != INVALID_FILE_ATTRIBUTES;
+}
+
+
+/**
+ * @param from The current path of the file.
+ * @param to The new path of the file. Replaced if it exists.
+ */
+b8 platform_file_rename(const char* from, const char* to) {
+    return MoveFileExA(from, to, MOVEFILE_REPLACE_EXISTING) != 0;
+}
+
+
+/**
+ * @param path The path of the file to delete.
+ */
+b8 platform_file_delete(const char* path) {
+    return DeleteFileA(path) != 0;
+}
+
+
+/**
+ * @brief Mirrors WIN32_MEMORY_RANGE_ENTRY, which windows.h only declares when targeting Windows 8+.
+ */
+typedef struct win32_memory_range {
+    void* address;
+    SIZE_T size;
+} win32_memory_range;
+
+/** @brief The signature of PrefetchVirtualMemory. */
+typedef BOOL(WINAPI* PFN_prefetch_virtual_memory)(HANDLE process, ULONG_PTR entry_count, win32_memory_range* entries, ULONG flags);
+
+/**
+ * @brief Starts paging in a range of memory, if the OS supports it.
+ * @details PrefetchVirtualMemory is looked up at runtime, as it does not exist before
+ * Windows 8. Without it, pages are simply read in on first touch.
+ * @param address The start of the range.
+ * @param size The `u64` size of the range.
+ */
+static void win32_prefetch(const void* address, u64 size) {
+    static PFN_prefetch_virtual_memory prefetch = 0;
+    static b8 resolved = FALSE;
+    if (!resolved) {
+        prefetch = (PFN_prefetch_virtual_memory)(void*)GetProcAddress(GetModuleHandleA("kernel32.dll"), "PrefetchVirtualMemory");
+        resolved = TRUE;
+    }
+
+    if (prefetch) {
+        win32_memory_range range = {(void*)address, (SIZE_T)size};
+        prefetch(GetCurrentProcess(), 1, &range, 0);
+    }
+}
+
+
+/**
+ * @param path The `const char*` path of the file to map.
+ * @param hints A combination of platform_file_map_hint flags. SEQUENTIAL and RANDOM become
+ * the matching CreateFileA cache flags; WILL_NEED prefetches the whole view.
+ * @param out_mapping A pointer to the mapping to fill out.
+ */
+b8 platform_file_map(const char* path, u32 hints, platform_file_mapping* out_mapping) {
+    out_mapping->data = 0;
+    out_mapping->size = 0;
+    out_mapping->is_valid = FALSE;
+
+    DWORD flags = FILE_ATTRIBUTE_NORMAL;
+    if (hints & PLATFORM_FILE_MAP_HINT_SEQUENTIAL) {
+        flags |= FILE_FLAG_SEQUENTIAL_SCAN;
+    } else if (hints & PLATFORM_FILE_MAP_HINT_RANDOM) {
+        flags |= FILE_FLAG_RANDOM_ACCESS;
+    }
+
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, flags, 0);
+    if (file == INVALID_HANDLE_VALUE) {
+        return FALSE;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        return FALSE;
+    }
+    if (size.QuadPart == 0) {
+        // CreateFileMappingA rejects empty files, so an empty file maps to no data.
+        CloseHandle(file);
+        out_mapping->is_valid = TRUE;
+        return TRUE;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, 0, PAGE_READONLY, 0, 0, 0);
+    // The mapping object holds its own reference to the file, and the view to the mapping.
+    CloseHandle(file);
+    if (!mapping) {
+        KERROR("platform_file_map - CreateFileMappingA failed for '%s'.", path);
+        return FALSE;
+    }
+
+    const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!data) {
+        KERROR("platform_file_map - MapViewOfFile failed for '%s' (%llu bytes).", path, (u64)size.QuadPart);
+        return FALSE;
+    }
+
+    if (hints & PLATFORM_FILE_MAP_HINT_WILL_NEED) {
+        win32_prefetch(data, (u64)size.QuadPart);
+    }
+
+    out_mapping->data = data;
+    out_mapping->size = (u64)size.QuadPart;
+    out_mapping->is_valid = TRUE;
+    return TRUE;
+}
+
+
+/**
+ * @param mapping A pointer to the mapping.
+ * @param offset The `u64` start of the range.
+ * @param size The `u64` size of the range. Clamped to the end of the file.
+ */
+void platform_file_map_prefetch(platform_file_mapping* mapping, u64 offset, u64 size) {
+    if (!mapping || !mapping->is_valid || offset >= mapping->size) {
+        return;
+    }
+    if (size > mapping->size - offset) {
+        size = mapping->size - offset;
+    }
+    win32_prefetch((const u8*)mapping->data + offset, size);
+}
+
+
+/**
+ * @param mapping A pointer to the mapping to unmap.
+ */
+void platform_file_unmap(platform_file_mapping* mapping) {
+    if (mapping && mapping->is_valid) {
+        if (mapping->data) {
+            UnmapViewOfFile(mapping->data);
+        }
+        mapping->data = 0;
+        mapping->size = 0;
+        mapping->is_valid = FALSE;
+    }
+}
+
+
+
+/** @brief The number of completions platform_io_queue_poll takes from the port per call. */
+#define WIN32_IO_POLL_BATCH 64
+
+/**
+ * @struct win32_io_slot
+ * @brief The state of one overlapped read, kept until its completion has been polled.
+ */
+typedef struct win32_io_slot {
+    /** @brief The OVERLAPPED of the read. First, so the completion's pointer is the slot's. */
+    OVERLAPPED overlapped;
+
+    /** @brief The user data returned with the completion. */
+    void* user_data;
+
+    /**
+     * @brief Set if ReadFile finished without queuing a completion, in which case one is posted
+     * by hand and `succeeded` holds the outcome.
+     */
+    b8 posted;
+
+    /** @brief The outcome of a read whose completion was posted by hand. */
+    b8 succeeded;
+
+    /** @brief The index of the next free slot while this one is free. */
+    u32 next_free;
+} win32_io_slot;
+
+/**
+ * @struct win32_io_queue
+ * @brief Holds the state of a platform_io_queue on Win32.
+ */
+typedef struct win32_io_queue {
+    /** @brief The I/O completion port every read completes to. */
+    HANDLE port;
+
+    /** @brief The maximum number of reads in flight. */
+    u32 capacity;
+
+    /** @brief The number of reads issued and not yet polled. */
+    u32 in_flight;
+
+    /** @brief Per-read state, `capacity` slots. */
+    win32_io_slot* slots;
+
+    /** @brief The head of the free slot list. */
+    u32 free_slot;
+} win32_io_queue;
+
+
+/**
+ * @param capacity The `u32` maximum number of reads in flight.
+ * @param backend Ignored; Win32 always reads through an IOCP.
+ * @param out_queue A pointer to the queue handle to fill out.
+ */
+b8 platform_io_queue_create(u32 capacity, platform_io_backend backend, platform_io_queue* out_queue) {
+    out_queue->internal_state = 0;
+    if (capacity == 0) {
+        KERROR("platform_io_queue_create - capacity must be greater than 0.");
+        return FALSE;
+    }
+
+    HANDLE port = CreateIoCompletionPort(INVALID_HANDLE_VALUE, 0, 0, 1);
+    if (!port) {
+        KERROR("platform_io_queue_create - CreateIoCompletionPort failed.");
+        return FALSE;
+    }
+
+    win32_io_queue* queue = platform_allocate(sizeof(win32_io_queue), FALSE);
+    queue->port = port;
+    queue->capacity = capacity;
+    queue->in_flight = 0;
+    queue->slots = platform_allocate(sizeof(win32_io_slot) * capacity, FALSE);
+    for (u32 i = 0; i < capacity; ++i) {
+        queue->slots[i].next_free = i + 1;
+    }
+    queue->free_slot = 0;
+
+    out_queue->internal_state = queue;
+    return TRUE;
+}
+
+
+/**
+ * @param queue A pointer to the queue handle to destroy.
+ */
+void platform_io_queue_destroy(platform_io_queue* queue) {
+    if (!queue || !queue->internal_state) {
+        return;
+    }
+
+    win32_io_queue* state = queue->internal_state;
+    if (state->in_flight > 0) {
+        KWARN("platform_io_queue_destroy - destroying a queue with %u reads in flight.", state->in_flight);
+    }
+    CloseHandle(state->port);
+    platform_free(state->slots, FALSE);
+    platform_free(state, FALSE);
+    queue->internal_state = 0;
+}
+
+
+/**
+ * @param queue A pointer to the queue handle.
+ */
+const char* platform_io_queue_backend_name(platform_io_queue* queue) {
+    return "iocp";
+}
+
+
+/**
+ * @param queue A pointer to the queue handle.
+ * @param file The file to read from. Opened with PLATFORM_FILE_MODE_ASYNC, so its handle is overlapped.
+ * @param offset The `u64` position in the file to read from.
+ * @param buffer The buffer receiving the data.
+ * @param size The `u32` number of bytes to read.
+ * @param user_data The user data returned with the completion.
+ */
+b8 platform_io_queue_read(platform_io_queue* queue, platform_file* file, u64 offset, void* buffer, u32 size, void* user_data) {
+    win32_io_queue* state = queue->internal_state;
+    if (state->in_flight == state->capacity || !file || !file->is_valid) {
+        return FALSE;
+    }
+
+    // A handle can only be tied to one port. Tying it again fails harmlessly, so there is no
+    // need to track which files have been seen.
+    HANDLE handle = (HANDLE)file->handle;
+    CreateIoCompletionPort(handle, state->port, 0, 0);
+
+    u32 slot_index = state->free_slot;
+    win32_io_slot* slot = &state->slots[slot_index];
+    state->free_slot = slot->next_free;
+    ZeroMemory(&slot->overlapped, sizeof(OVERLAPPED));
+    slot->overlapped.Offset = (DWORD)(offset & 0xFFFFFFFF);
+    slot->overlapped.OffsetHigh = (DWORD)(offset >> 32);
+    slot->user_data = user_data;
+    slot->posted = FALSE;
+
+    // Overlapped reads start right away, so there is nothing left for submit to do.
+    if (!ReadFile(handle, buffer, size, 0, &slot->overlapped)) {
+        DWORD error = GetLastError();
+        if (error != ERROR_IO_PENDING) {
+            // No completion is queued for a read that failed outright; post one so the
+            // read is still reported through poll. A read at the end of the file reads 0 bytes.
+            slot->posted = TRUE;
+            slot->succeeded = error == ERROR_HANDLE_EOF;
+            PostQueuedCompletionStatus(state->port, 0, 0, &slot->overlapped);
+        }
+    }
+
+    state->in_flight++;
+    return TRUE;
+}
+
+
+/**
+ * @param queue A pointer to the queue handle. Reads are issued as they are queued, so this does nothing.
+ */
+void platform_io_queue_submit(platform_io_queue* queue) {
+}
+
+
+/**
+ * @param queue A pointer to the queue handle.
+ * @param out_completions The array receiving the completions.
+ * @param max_count The `u32` size of `out_completions`.
+ * @param wait If TRUE and reads are in flight, blocks until at least one has finished.
+ */
+u32 platform_io_queue_poll(platform_io_queue* queue, platform_io_completion* out_completions, u32 max_count, b8 wait) {
+    win32_io_queue* state = queue->internal_state;
+    if (state->in_flight == 0 || max_count == 0) {
+        return 0;
+    }
+
+    OVERLAPPED_ENTRY entries[WIN32_IO_POLL_BATCH];
+    ULONG batch = max_count < WIN32_IO_POLL_BATCH ? max_count : WIN32_IO_POLL_BATCH;
+    ULONG removed = 0;
+    if (!GetQueuedCompletionStatusEx(state->port, entries, batch, &removed, wait ? INFINITE : 0, FALSE)) {
+        // Also fails with WAIT_TIMEOUT when nothing has finished.
+        return 0;
+    }
+
+    for (ULONG i = 0; i < removed; ++i) {
+        win32_io_slot* slot = (win32_io_slot*)entries[i].lpOverlapped;
+        out_completions[i].user_data = slot->user_data;
+        out_completions[i].bytes_read = entries[i].dwNumberOfBytesTransferred;
+        if (slot->posted) {
+            out_completions[i].success = slot->succeeded;
+        } else {
+            // Internal holds the read's NTSTATUS. End of file only means a short read.
+            LONG status = (LONG)slot->overlapped.Internal;
+            out_completions[i].success = status >= 0 || (u32)status == 0xC0000011 /* STATUS_END_OF_FILE */;
+        }
+
+        u32 slot_index = (u32)(slot - state->slots);
+        slot->next_free = state->free_slot;
+        state->free_slot = slot_index;
+    }
+
+    state->in_flight -= removed;
+    return removed;
+}
+
+
+/**
+ * @param queue A pointer to the queue handle.
+ */
+u32 platform_io_queue_in_flight(platform_io_queue* queue) {
+    win32_io_queue* state = queue->internal_state;
+    return state->in_flight;
+}
+
+/**
+ * @param names_darray A pointer to a darray of `const char*` names.
+ */
+void platform_get_required_extension_names(const char*** names_darray) {
+    const char* name = VK_KHR_WIN32_SURFACE_EXTENSION_NAME;
+    darray_push(*names_darray, name);
+}
+
+
+/**
+ * @param plat_state A pointer to the platform state.
+ * @param context A pointer to the Vulkan context.
+ * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+ */
+b8 platform_create_vulkan_surface(platform_state* plat_state, vulkan_context* context) {
+    internal_state* state = (internal_state*)plat_state->internal_state;
+
+    VkWin32SurfaceCreateInfoKHR create_info = {VK_STRUCTURE_TYPE_WIN32_SURFACE_CREATE_INFO_KHR};
+    create_info.hinstance = state->h_instance;
+    create_info.hwnd = state->hwnd;
+
+    VkResult result = vkCreateWin32SurfaceKHR(context->instance, &create_info, context->allocator, &context->surface);
+    if (result != VK_SUCCESS) {
+        KERROR("vkCreateWin32SurfaceKHR failed with %d.", result);
+        return FALSE;
+    }
+    return TRUE;
+}
+
 #endif  // KPLATFORM_WINDOWS
\ No newline at end of file
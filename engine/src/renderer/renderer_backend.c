@@ -0,0 +1,35 @@
+/**
+ * @file renderer_backend.c
+ * @brief This file contains the implementation of renderer backend creation.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "renderer_backend.h"
+
+#include "core/kmemory.h"
+#include "core/logger.h"
+#include "renderer/vulkan/vulkan_backend.h"
+
+b8 renderer_backend_create(renderer_backend_type type, struct platform_state* plat_state, renderer_backend* out_backend) {
+    kzero_memory(out_backend, sizeof(renderer_backend));
+    out_backend->plat_state = plat_state;
+
+    switch (type) {
+        case RENDERER_BACKEND_TYPE_VULKAN:
+            out_backend->initialize = vulkan_renderer_backend_initialize;
+            out_backend->shutdown = vulkan_renderer_backend_shutdown;
+            out_backend->resized = vulkan_renderer_backend_on_resized;
+            out_backend->begin_frame = vulkan_renderer_backend_begin_frame;
+            out_backend->end_frame = vulkan_renderer_backend_end_frame;
+            out_backend->record_parallel = vulkan_renderer_backend_record_parallel;
+            return TRUE;
+
+        default:
+            KERROR("renderer_backend_create: backend type %d is not supported.", type);
+            return FALSE;
+    }
+}
+
+void renderer_backend_destroy(renderer_backend* backend) {
+    kzero_memory(backend, sizeof(renderer_backend));
+}
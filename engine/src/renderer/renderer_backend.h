@@ -0,0 +1,24 @@
+#pragma once
+
+/**
+ * @file renderer_backend.h
+ * @brief This file contains the creation of renderer backends.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "renderer/renderer_types.h"
+
+/**
+ * @brief Fills in the entry points of a backend for the given graphics API.
+ * @param type The graphics API.
+ * @param plat_state The platform state holding the window to present to.
+ * @param out_backend A pointer to the backend to fill in.
+ * @return `b8 TRUE` on success, `b8 FALSE` if there is no backend for `type`.
+ */
+b8 renderer_backend_create(renderer_backend_type type, struct platform_state* plat_state, renderer_backend* out_backend);
+
+/**
+ * @brief Clears the entry points of a backend. Call after its shutdown.
+ * @param backend A pointer to the backend.
+ */
+void renderer_backend_destroy(renderer_backend* backend);
@@ -0,0 +1,101 @@
+/**
+ * @file renderer_frontend.c
+ * @brief This file contains the implementation of the renderer system.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "renderer_frontend.h"
+
+#include "core/logger.h"
+#include "core/profiler.h"
+#include "renderer/renderer_backend.h"
+
+/**
+ * @struct renderer_system_state
+ * @brief The global state of the renderer system.
+ */
+typedef struct renderer_system_state {
+    /** @brief Indicates if the renderer system is initialized. */
+    b8 initialized;
+
+    /** @brief The backend doing the drawing. */
+    renderer_backend backend;
+} renderer_system_state;
+
+// Static so no allocation is needed and the state is private to this file.
+static renderer_system_state state;
+
+b8 renderer_system_initialize(const char* application_name, struct platform_state* plat_state, u8 frames_in_flight) {
+    if (state.initialized) {
+        KERROR("renderer_system_initialize called more than once.");
+        return FALSE;
+    }
+
+    if (frames_in_flight == 0) {
+        frames_in_flight = RENDERER_DEFAULT_FRAMES_IN_FLIGHT;
+    } else if (frames_in_flight < 2 || frames_in_flight > RENDERER_MAX_FRAMES_IN_FLIGHT) {
+        u8 clamped = CLAMP(frames_in_flight, 2, RENDERER_MAX_FRAMES_IN_FLIGHT);
+        KWARN("renderer_system_initialize: %u frames in flight is not supported, using %u.", frames_in_flight, clamped);
+        frames_in_flight = clamped;
+    }
+
+    // Vulkan is the only backend, so it is not part of the application config.
+    if (!renderer_backend_create(RENDERER_BACKEND_TYPE_VULKAN, plat_state, &state.backend)) {
+        return FALSE;
+    }
+
+    if (!state.backend.initialize(&state.backend, application_name, frames_in_flight)) {
+        KERROR("Renderer backend failed to initialize.");
+        renderer_backend_destroy(&state.backend);
+        return FALSE;
+    }
+
+    state.initialized = TRUE;
+    KINFO("Renderer system initialized with %u frames in flight.", frames_in_flight);
+    return TRUE;
+}
+
+void renderer_system_shutdown() {
+    if (!state.initialized) {
+        return;
+    }
+
+    state.backend.shutdown(&state.backend);
+    renderer_backend_destroy(&state.backend);
+    state.initialized = FALSE;
+}
+
+void renderer_on_resized(u16 width, u16 height) {
+    if (state.initialized) {
+        state.backend.resized(&state.backend, width, height);
+    }
+}
+
+b8 renderer_draw_frame(const render_packet* packet) {
+    KPROFILE_SCOPE("renderer_draw_frame");
+    if (!state.initialized) {
+        return TRUE;
+    }
+
+    // A skipped frame (e.g. while the swapchain is being recreated) is not an error.
+    if (!state.backend.begin_frame(&state.backend, packet->delta_time)) {
+        return TRUE;
+    }
+
+    // The frame is ended even if recording failed, so that the backend is left in a consistent state.
+    b8 recorded = TRUE;
+    if (packet->record && packet->record_count) {
+        recorded = state.backend.record_parallel(&state.backend, packet->record_count, packet->record_batch_size, packet->record, packet->record_data);
+        if (!recorded) {
+            KERROR("renderer_draw_frame: recording the frame failed.");
+        }
+    }
+
+    if (!state.backend.end_frame(&state.backend, packet->delta_time)) {
+        KERROR("renderer_end_frame failed.");
+        return FALSE;
+    }
+
+    state.backend.frame_number++;
+    return recorded;
+}
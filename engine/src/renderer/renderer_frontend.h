@@ -0,0 +1,53 @@
+#pragma once
+
+/**
+ * @file renderer_frontend.h
+ * @brief This file contains the renderer system, the engine's interface to rendering.
+ *
+ * @details The renderer system owns a backend for one graphics API (currently Vulkan) and
+ * drives it once per frame. It is created by the application after the window, and draws
+ * from the thread that renders: the main thread, or the render thread when pipelined
+ * rendering is on. Resizes may be reported from any thread; the backend applies them at
+ * the start of the next frame.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "renderer/renderer_types.h"
+
+/** @brief The number of frames in flight used when the application does not choose one. */
+#define RENDERER_DEFAULT_FRAMES_IN_FLIGHT 2
+
+/** @brief The most frames the CPU may record ahead of the GPU. More only adds latency. */
+#define RENDERER_MAX_FRAMES_IN_FLIGHT 3
+
+/**
+ * @brief Initializes the renderer system.
+ * @param application_name The name of the application, reported to the driver.
+ * @param plat_state The platform state holding the window to present to.
+ * @param frames_in_flight The number of frames the CPU may record ahead of the GPU: 2 or 3, or 0 for the default.
+ * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+ */
+KAPI b8 renderer_system_initialize(const char* application_name, struct platform_state* plat_state, u8 frames_in_flight);
+
+/**
+ * @brief Shuts the renderer system down, after the GPU has finished all submitted frames.
+ */
+KAPI void renderer_system_shutdown();
+
+/**
+ * @brief Reports a new window size to the renderer. May be called from any thread.
+ * @param width The new width in pixels.
+ * @param height The new height in pixels.
+ */
+KAPI void renderer_on_resized(u16 width, u16 height);
+
+/**
+ * @brief Draws a frame.
+ * @details The items of the packet are recorded in parallel on the job system's threads. Call
+ * from the main thread to use the workers: from another thread (e.g. the render thread of
+ * pipelined rendering) the batches are recorded one after another on that thread.
+ * Does nothing if the renderer is not initialized, as when the application runs headless.
+ * @param packet A pointer to the render packet of the frame.
+ * @return `b8 TRUE` on success (including frames skipped while the swapchain is recreated), otherwise `b8 FALSE`.
+ */
+KAPI b8 renderer_draw_frame(const render_packet* packet);
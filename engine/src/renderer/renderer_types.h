@@ -0,0 +1,124 @@
+#pragma once
+
+/**
+ * @file renderer_types.h
+ * @brief This file contains the types shared by the renderer frontend and its backends.
+ *
+ * @details The frontend (renderer_frontend.h) is what the rest of the engine talks to. It
+ * owns one backend, whose entry points are the function pointers of renderer_backend, so
+ * that graphics APIs can be added without the engine knowing anything about them.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "defines.h"
+
+struct platform_state;
+
+/**
+ * @enum renderer_backend_type
+ * @brief The graphics APIs a renderer backend can be created for.
+ */
+typedef enum renderer_backend_type {
+    /** @brief Vulkan 1.1 or later. */
+    RENDERER_BACKEND_TYPE_VULKAN,
+    /** @brief OpenGL. Not implemented. */
+    RENDERER_BACKEND_TYPE_OPENGL,
+    /** @brief DirectX. Not implemented. */
+    RENDERER_BACKEND_TYPE_DIRECTX
+} renderer_backend_type;
+
+/**
+ * @brief The signature of a function recording a batch of items (e.g. draws) into the frame.
+ * @details Batches are recorded in parallel on the job system's threads, each into its own
+ * command list, and executed in the order of their items. Must be thread-safe, and must not
+ * rely on state set by other batches, e.g. bound pipelines or the viewport.
+ * @param command_list The backend's command list to record into: a secondary VkCommandBuffer
+ * inside the main render pass for Vulkan. Only valid during the call.
+ * @param start The index of the first item of the batch.
+ * @param end One past the index of the last item of the batch.
+ * @param data The user data of the render packet.
+ */
+typedef void (*renderer_record_entry)(void* command_list, u32 start, u32 end, void* data);
+
+/**
+ * @struct renderer_backend
+ * @brief The interface to a graphics API backend.
+ */
+typedef struct renderer_backend {
+    /** @brief The platform state holding the window the backend presents to. */
+    struct platform_state* plat_state;
+
+    /** @brief The number of frames drawn so far. */
+    u64 frame_number;
+
+    /**
+     * @brief Initializes the backend.
+     * @param backend A pointer to the backend.
+     * @param application_name The name of the application, reported to the driver.
+     * @param frames_in_flight The number of frames the CPU may record ahead of the GPU.
+     * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+     */
+    b8 (*initialize)(struct renderer_backend* backend, const char* application_name, u8 frames_in_flight);
+
+    /**
+     * @brief Shuts the backend down, waiting for the GPU to finish first.
+     * @param backend A pointer to the backend.
+     */
+    void (*shutdown)(struct renderer_backend* backend);
+
+    /**
+     * @brief Notifies the backend that the window was resized. May be called from any thread.
+     * @param backend A pointer to the backend.
+     * @param width The new width in pixels.
+     * @param height The new height in pixels.
+     */
+    void (*resized)(struct renderer_backend* backend, u16 width, u16 height);
+
+    /**
+     * @brief Begins a frame: waits for its resources to be free, acquires an image and starts recording.
+     * @param backend A pointer to the backend.
+     * @param delta_time The time in seconds since the last frame.
+     * @return `b8 TRUE` if the frame was begun, `b8 FALSE` if it must be skipped (e.g. while the swapchain is recreated).
+     */
+    b8 (*begin_frame)(struct renderer_backend* backend, f32 delta_time);
+
+    /**
+     * @brief Ends a frame: submits what was recorded and presents the image.
+     * @param backend A pointer to the backend.
+     * @param delta_time The time in seconds since the last frame.
+     * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+     */
+    b8 (*end_frame)(struct renderer_backend* backend, f32 delta_time);
+
+    /**
+     * @brief Records items into the frame in parallel, between begin_frame and end_frame.
+     * @param backend A pointer to the backend.
+     * @param count The number of items.
+     * @param batch_size The most items per batch, or 0 for a size that gives every thread a few batches.
+     * @param entry The function recording each batch.
+     * @param data The user data passed to `entry`.
+     * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+     */
+    b8 (*record_parallel)(struct renderer_backend* backend, u32 count, u32 batch_size, renderer_record_entry entry, void* data);
+} renderer_backend;
+
+/**
+ * @struct render_packet
+ * @brief Everything the renderer needs to draw one frame.
+ */
+typedef struct render_packet {
+    /** @brief The time in seconds since the last frame. */
+    f32 delta_time;
+
+    /** @brief The number of items `record` is called for, or 0 to record nothing. */
+    u32 record_count;
+
+    /** @brief The most items recorded per batch, or 0 to let the backend choose. */
+    u32 record_batch_size;
+
+    /** @brief The function recording the items, in parallel batches. May be 0. */
+    renderer_record_entry record;
+
+    /** @brief The user data passed to `record`. */
+    void* record_data;
+} render_packet;
@@ -0,0 +1,471 @@
+/**
+ * @file vulkan_backend.c
+ * @brief This file contains the implementation of the Vulkan renderer backend.
+ * @details
+ * Each of the frames in flight owns a transient command pool with one primary command buffer,
+ * the semaphore signalled when its swapchain image is acquired, and the fence signalled when
+ * the GPU has finished it. Beginning a frame waits only on that frame's fence, so the CPU
+ * records up to frames_in_flight frames ahead of the GPU. Resetting the whole pool is cheaper
+ * than resetting its command buffer, and lets the driver recycle the pool's memory.
+ *
+ * The main render pass is recorded in secondary command buffers, on the job system's threads
+ * (see vulkan_command.h); the primary command buffer only begins it and executes them.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "vulkan_backend.h"
+
+#include "containers/darray.h"
+#include "core/katomic.h"
+#include "core/kmemory.h"
+#include "core/kstring.h"
+#include "core/logger.h"
+#include "core/profiler.h"
+#include "renderer/vulkan/vulkan_command.h"
+#include "renderer/vulkan/vulkan_device.h"
+#include "renderer/vulkan/vulkan_memory.h"
+#include "renderer/vulkan/vulkan_pipeline_cache.h"
+#include "renderer/vulkan/vulkan_platform.h"
+#include "renderer/vulkan/vulkan_renderpass.h"
+#include "renderer/vulkan/vulkan_staging.h"
+#include "renderer/vulkan/vulkan_swapchain.h"
+#include "renderer/vulkan/vulkan_types.h"
+
+/** @brief The size used for the swapchain before the window has reported one, if the surface leaves it to us. */
+#define VULKAN_FALLBACK_WIDTH 800
+#define VULKAN_FALLBACK_HEIGHT 600
+
+/** @brief Packs a framebuffer size the way vulkan_context::framebuffer_size holds it. */
+#define VULKAN_PACK_SIZE(width, height) (((u32)(width) << 16) | ((u32)(height) & 0xFFFF))
+
+// Static so no allocation is needed and the state is private to this file.
+static vulkan_context context;
+
+#if defined(_DEBUG)
+/** @brief The validation layer enabled in debug builds when it is installed. */
+#define VULKAN_VALIDATION_LAYER "VK_LAYER_KHRONOS_validation"
+
+/**
+ * @brief Forwards validation messages to the logger.
+ */
+static VKAPI_ATTR VkBool32 VKAPI_CALL vulkan_debug_callback(
+    VkDebugUtilsMessageSeverityFlagBitsEXT severity,
+    VkDebugUtilsMessageTypeFlagsEXT types,
+    const VkDebugUtilsMessengerCallbackDataEXT* callback_data,
+    void* user_data) {
+    switch (severity) {
+        case VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT:
+            KERROR("%s", callback_data->pMessage);
+            break;
+        case VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT:
+            KWARN("%s", callback_data->pMessage);
+            break;
+        case VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT:
+            KINFO("%s", callback_data->pMessage);
+            break;
+        default:
+            KTRACE("%s", callback_data->pMessage);
+            break;
+    }
+    // Never abort the call that triggered the message.
+    return VK_FALSE;
+}
+
+/** @brief Checks if an instance layer is installed. */
+static b8 vulkan_has_instance_layer(const char* name) {
+    u32 count = 0;
+    VK_CHECK(vkEnumerateInstanceLayerProperties(&count, 0));
+    if (!count) {
+        return FALSE;
+    }
+
+    VkLayerProperties* layers = kallocate(sizeof(VkLayerProperties) * count, MEMORY_TAG_RENDERER);
+    VK_CHECK(vkEnumerateInstanceLayerProperties(&count, layers));
+    b8 found = FALSE;
+    for (u32 i = 0; i < count && !found; ++i) {
+        found = kstring_equal(kstring_from_cstr(layers[i].layerName), kstring_from_cstr(name));
+    }
+    kfree(layers, sizeof(VkLayerProperties) * count, MEMORY_TAG_RENDERER);
+    return found;
+}
+#endif
+
+/** @brief Creates the instance, with the validation layer and a debug messenger in debug builds. */
+static b8 vulkan_create_instance(const char* application_name) {
+    VkApplicationInfo app_info = {VK_STRUCTURE_TYPE_APPLICATION_INFO};
+    app_info.pApplicationName = application_name;
+    app_info.applicationVersion = VK_MAKE_VERSION(1, 0, 0);
+    app_info.pEngineName = "Kaffi Engine";
+    app_info.engineVersion = VK_MAKE_VERSION(1, 0, 0);
+    app_info.apiVersion = VK_API_VERSION_1_1;
+
+    const char** extensions = darray_create(const char*);
+    const char* surface_extension = VK_KHR_SURFACE_EXTENSION_NAME;
+    darray_push(extensions, surface_extension);
+    platform_get_required_extension_names(&extensions);
+
+    const char* layers[1];
+    u32 layer_count = 0;
+#if defined(_DEBUG)
+    const char* debug_extension = VK_EXT_DEBUG_UTILS_EXTENSION_NAME;
+    darray_push(extensions, debug_extension);
+    if (vulkan_has_instance_layer(VULKAN_VALIDATION_LAYER)) {
+        layers[layer_count++] = VULKAN_VALIDATION_LAYER;
+    } else {
+        KWARN("%s is not installed, running without validation.", VULKAN_VALIDATION_LAYER);
+    }
+#endif
+
+    VkInstanceCreateInfo instance_info = {VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO};
+    instance_info.pApplicationInfo = &app_info;
+    instance_info.enabledExtensionCount = (u32)darray_length(extensions);
+    instance_info.ppEnabledExtensionNames = extensions;
+    instance_info.enabledLayerCount = layer_count;
+    instance_info.ppEnabledLayerNames = layer_count ? layers : 0;
+
+    VkResult result = vkCreateInstance(&instance_info, context.allocator, &context.instance);
+    darray_destroy(extensions);
+    if (result != VK_SUCCESS) {
+        KERROR("vkCreateInstance failed with %d. Vulkan 1.1 and a surface for the window are required.", result);
+        return FALSE;
+    }
+
+#if defined(_DEBUG)
+    VkDebugUtilsMessengerCreateInfoEXT messenger_info = {VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT};
+    messenger_info.messageSeverity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT;
+    messenger_info.messageType = VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT;
+    messenger_info.pfnUserCallback = vulkan_debug_callback;
+
+    PFN_vkCreateDebugUtilsMessengerEXT create_messenger =
+        (PFN_vkCreateDebugUtilsMessengerEXT)vkGetInstanceProcAddr(context.instance, "vkCreateDebugUtilsMessengerEXT");
+    if (!create_messenger || create_messenger(context.instance, &messenger_info, context.allocator, &context.debug_messenger) != VK_SUCCESS) {
+        KWARN("Failed to create the Vulkan debug messenger.");
+        context.debug_messenger = VK_NULL_HANDLE;
+    }
+#endif
+    return TRUE;
+}
+
+/** @brief Destroys the debug messenger, if any, and the instance. */
+static void vulkan_destroy_instance(void) {
+#if defined(_DEBUG)
+    if (context.debug_messenger) {
+        PFN_vkDestroyDebugUtilsMessengerEXT destroy_messenger =
+            (PFN_vkDestroyDebugUtilsMessengerEXT)vkGetInstanceProcAddr(context.instance, "vkDestroyDebugUtilsMessengerEXT");
+        if (destroy_messenger) {
+            destroy_messenger(context.instance, context.debug_messenger, context.allocator);
+        }
+        context.debug_messenger = VK_NULL_HANDLE;
+    }
+#endif
+    if (context.instance) {
+        vkDestroyInstance(context.instance, context.allocator);
+        context.instance = VK_NULL_HANDLE;
+    }
+}
+
+/** @brief Creates a framebuffer per swapchain image, sharing the depth attachment. */
+static b8 vulkan_create_framebuffers(void) {
+    vulkan_swapchain* swapchain = &context.swapchain;
+    for (u32 i = 0; i < swapchain->image_count; ++i) {
+        VkImageView attachments[2] = {swapchain->views[i], swapchain->depth_attachment.view};
+
+        VkFramebufferCreateInfo framebuffer_info = {VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO};
+        framebuffer_info.renderPass = context.main_renderpass;
+        framebuffer_info.attachmentCount = 2;
+        framebuffer_info.pAttachments = attachments;
+        framebuffer_info.width = swapchain->extent.width;
+        framebuffer_info.height = swapchain->extent.height;
+        framebuffer_info.layers = 1;
+
+        VkResult result = vkCreateFramebuffer(context.device.logical_device, &framebuffer_info, context.allocator, &swapchain->framebuffers[i]);
+        if (result != VK_SUCCESS) {
+            KERROR("vkCreateFramebuffer failed with %d.", result);
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+/** @brief Destroys the framebuffers of the swapchain images. */
+static void vulkan_destroy_framebuffers(void) {
+    for (u32 i = 0; i < VULKAN_MAX_SWAPCHAIN_IMAGES; ++i) {
+        if (context.swapchain.framebuffers[i]) {
+            vkDestroyFramebuffer(context.device.logical_device, context.swapchain.framebuffers[i], context.allocator);
+            context.swapchain.framebuffers[i] = VK_NULL_HANDLE;
+        }
+    }
+}
+
+/** @brief Creates the command pool, command buffer, semaphore and fence of each frame in flight. */
+static b8 vulkan_create_frames(void) {
+    VkDevice device = context.device.logical_device;
+    for (u32 i = 0; i < context.frames_in_flight; ++i) {
+        vulkan_frame* frame = &context.frames[i];
+
+        // Transient: the buffer is rerecorded every time the frame comes round.
+        VkCommandPoolCreateInfo pool_info = {VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO};
+        pool_info.queueFamilyIndex = context.device.graphics_queue_index;
+        pool_info.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+        if (vkCreateCommandPool(device, &pool_info, context.allocator, &frame->command_pool) != VK_SUCCESS) {
+            KERROR("Failed to create the command pool of frame %u.", i);
+            return FALSE;
+        }
+
+        VkCommandBufferAllocateInfo allocate_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+        allocate_info.commandPool = frame->command_pool;
+        allocate_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocate_info.commandBufferCount = 1;
+        if (vkAllocateCommandBuffers(device, &allocate_info, &frame->command_buffer) != VK_SUCCESS) {
+            KERROR("Failed to allocate the command buffer of frame %u.", i);
+            return FALSE;
+        }
+
+        VkSemaphoreCreateInfo semaphore_info = {VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO};
+        if (vkCreateSemaphore(device, &semaphore_info, context.allocator, &frame->image_available) != VK_SUCCESS) {
+            KERROR("Failed to create the image-available semaphore of frame %u.", i);
+            return FALSE;
+        }
+
+        // Signalled, so that the first wait on each frame returns at once.
+        VkFenceCreateInfo fence_info = {VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
+        fence_info.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+        if (vkCreateFence(device, &fence_info, context.allocator, &frame->in_flight) != VK_SUCCESS) {
+            KERROR("Failed to create the fence of frame %u.", i);
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+/** @brief Destroys the resources of the frames in flight. */
+static void vulkan_destroy_frames(void) {
+    VkDevice device = context.device.logical_device;
+    for (u32 i = 0; i < VULKAN_MAX_FRAMES_IN_FLIGHT; ++i) {
+        vulkan_frame* frame = &context.frames[i];
+        if (frame->in_flight) {
+            vkDestroyFence(device, frame->in_flight, context.allocator);
+        }
+        if (frame->image_available) {
+            vkDestroySemaphore(device, frame->image_available, context.allocator);
+        }
+        if (frame->command_pool) {
+            // Frees the command buffer with it.
+            vkDestroyCommandPool(device, frame->command_pool, context.allocator);
+        }
+        kzero_memory(frame, sizeof(vulkan_frame));
+    }
+}
+
+/** @brief Recreates the swapchain and framebuffers for a new size, after the GPU has finished with the old ones. */
+static b8 vulkan_recreate_swapchain(u32 size) {
+    KPROFILE_SCOPE("vulkan_recreate_swapchain");
+    VK_CHECK(vkDeviceWaitIdle(context.device.logical_device));
+
+    vulkan_destroy_framebuffers();
+    VkFormat previous_format = context.swapchain.image_format.format;
+    if (!vulkan_swapchain_create(&context, size >> 16, size & 0xFFFF, &context.swapchain)) {
+        // Minimised, or lost: try again next frame.
+        return FALSE;
+    }
+
+    // The render pass is tied to the format, which changes only if e.g. the window moved to another display.
+    if (context.swapchain.image_format.format != previous_format) {
+        vulkan_renderpass_destroy(&context, &context.main_renderpass);
+        if (!vulkan_renderpass_create(&context, &context.main_renderpass)) {
+            return FALSE;
+        }
+    }
+    if (!vulkan_create_framebuffers()) {
+        return FALSE;
+    }
+
+    // The images are new; no frame is using them.
+    kzero_memory(context.images_in_flight, sizeof(context.images_in_flight));
+    context.swapchain_size = size;
+    context.recreate_swapchain = FALSE;
+    return TRUE;
+}
+
+b8 vulkan_renderer_backend_initialize(renderer_backend* backend, const char* application_name, u8 frames_in_flight) {
+    kzero_memory(&context, sizeof(vulkan_context));
+    // The driver's own host allocator is used. Device memory, where the volume is, goes through
+    // vulkan_memory; host allocations are few and the driver's are already tuned for them.
+    context.allocator = 0;
+    context.frames_in_flight = frames_in_flight;
+    context.clear_colour = (VkClearColorValue){{0.0f, 0.0f, 0.2f, 1.0f}};
+
+    if (!vulkan_create_instance(application_name)) {
+        return FALSE;
+    }
+    if (!platform_create_vulkan_surface(backend->plat_state, &context)) {
+        KERROR("Failed to create the Vulkan surface.");
+        vulkan_renderer_backend_shutdown(backend);
+        return FALSE;
+    }
+    if (!vulkan_device_create(&context)) {
+        vulkan_renderer_backend_shutdown(backend);
+        return FALSE;
+    }
+    if (!vulkan_memory_allocator_create(&context) || !vulkan_staging_create(&context, VULKAN_STAGING_DEFAULT_SIZE)) {
+        vulkan_renderer_backend_shutdown(backend);
+        return FALSE;
+    }
+    // Loaded before any pipeline exists, so none is compiled from scratch if it was cached.
+    if (!vulkan_pipeline_cache_create(&context, VULKAN_PIPELINE_CACHE_PATH)) {
+        vulkan_renderer_backend_shutdown(backend);
+        return FALSE;
+    }
+
+    // The window reports its size after this; most surfaces dictate it anyway.
+    if (!vulkan_swapchain_create(&context, VULKAN_FALLBACK_WIDTH, VULKAN_FALLBACK_HEIGHT, &context.swapchain) ||
+        !vulkan_renderpass_create(&context, &context.main_renderpass) ||
+        !vulkan_create_framebuffers() ||
+        !vulkan_create_frames() ||
+        !vulkan_command_pools_create(&context)) {
+        KERROR("Failed to create the swapchain and frame resources.");
+        vulkan_renderer_backend_shutdown(backend);
+        return FALSE;
+    }
+    context.swapchain_size = VULKAN_PACK_SIZE(context.swapchain.extent.width, context.swapchain.extent.height);
+    katomic_store(&context.framebuffer_size, context.swapchain_size, KATOMIC_RELAXED);
+
+    KINFO("Vulkan renderer initialized.");
+    return TRUE;
+}
+
+void vulkan_renderer_backend_shutdown(renderer_backend* backend) {
+    if (context.device.logical_device) {
+        vkDeviceWaitIdle(context.device.logical_device);
+    }
+
+    // In the reverse order of creation.
+    vulkan_command_pools_destroy(&context);
+    vulkan_destroy_frames();
+    vulkan_destroy_framebuffers();
+    vulkan_renderpass_destroy(&context, &context.main_renderpass);
+    vulkan_swapchain_destroy(&context, &context.swapchain);
+    vulkan_pipeline_cache_destroy(&context, VULKAN_PIPELINE_CACHE_PATH);
+    vulkan_staging_destroy(&context);
+    vulkan_memory_allocator_destroy(&context);
+    vulkan_device_destroy(&context);
+    if (context.surface) {
+        vkDestroySurfaceKHR(context.instance, context.surface, context.allocator);
+        context.surface = VK_NULL_HANDLE;
+    }
+    vulkan_destroy_instance();
+    kzero_memory(&context, sizeof(vulkan_context));
+}
+
+void vulkan_renderer_backend_on_resized(renderer_backend* backend, u16 width, u16 height) {
+    // Only recorded: the swapchain is owned by the thread drawing, which may not be this one.
+    katomic_store(&context.framebuffer_size, VULKAN_PACK_SIZE(width, height), KATOMIC_RELAXED);
+}
+
+b8 vulkan_renderer_backend_begin_frame(renderer_backend* backend, f32 delta_time) {
+    KPROFILE_SCOPE("vulkan_begin_frame");
+    VkDevice device = context.device.logical_device;
+
+    u32 size = katomic_load(&context.framebuffer_size, KATOMIC_RELAXED);
+    if (size != context.swapchain_size) {
+        if ((size >> 16) == 0 || (size & 0xFFFF) == 0) {
+            // Minimised: there is nothing to draw to.
+            return FALSE;
+        }
+        context.recreate_swapchain = TRUE;
+    }
+    if (context.recreate_swapchain && !vulkan_recreate_swapchain(size)) {
+        return FALSE;
+    }
+
+    // Wait for the GPU to finish the last use of this frame's resources; the older frames are likely still running.
+    vulkan_frame* frame = &context.frames[context.current_frame];
+    VkResult result = vkWaitForFences(device, 1, &frame->in_flight, VK_TRUE, UINT64_MAX);
+    if (result != VK_SUCCESS) {
+        KERROR("vkWaitForFences failed with %d.", result);
+        return FALSE;
+    }
+    vulkan_staging_frame_completed(&context, context.current_frame);
+    vulkan_command_pools_reset(&context, context.current_frame);
+
+    result = vkAcquireNextImageKHR(device, context.swapchain.handle, UINT64_MAX, frame->image_available, VK_NULL_HANDLE, &context.image_index);
+    if (result == VK_ERROR_OUT_OF_DATE_KHR) {
+        context.recreate_swapchain = TRUE;
+        return FALSE;
+    } else if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) {
+        KERROR("vkAcquireNextImageKHR failed with %d.", result);
+        return FALSE;
+    }
+
+    // With more images than frames in flight, the image may still be in use by another frame.
+    VkFence* image_fence = &context.images_in_flight[context.image_index];
+    if (*image_fence && *image_fence != frame->in_flight) {
+        VK_CHECK(vkWaitForFences(device, 1, image_fence, VK_TRUE, UINT64_MAX));
+    }
+    *image_fence = frame->in_flight;
+
+    VK_CHECK(vkResetCommandPool(device, frame->command_pool, 0));
+    VkCommandBufferBeginInfo begin_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+    begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    VK_CHECK(vkBeginCommandBuffer(frame->command_buffer, &begin_info));
+
+    // Uploads must be recorded outside the render pass.
+    vulkan_staging_record(&context, frame->command_buffer, context.current_frame);
+    vulkan_renderpass_begin(&context, frame->command_buffer, context.main_renderpass, context.swapchain.framebuffers[context.image_index], VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+    return TRUE;
+}
+
+b8 vulkan_renderer_backend_end_frame(renderer_backend* backend, f32 delta_time) {
+    KPROFILE_SCOPE("vulkan_end_frame");
+    vulkan_frame* frame = &context.frames[context.current_frame];
+
+    vulkan_renderpass_end(frame->command_buffer);
+    VkResult result = vkEndCommandBuffer(frame->command_buffer);
+    if (result != VK_SUCCESS) {
+        KERROR("vkEndCommandBuffer failed with %d.", result);
+        return FALSE;
+    }
+
+    VK_CHECK(vkResetFences(context.device.logical_device, 1, &frame->in_flight));
+
+    // Only the colour output has to wait for the image; everything before it may run ahead.
+    VkPipelineStageFlags wait_stage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    VkSemaphore render_complete = context.swapchain.render_complete[context.image_index];
+    VkSubmitInfo submit_info = {VK_STRUCTURE_TYPE_SUBMIT_INFO};
+    submit_info.waitSemaphoreCount = 1;
+    submit_info.pWaitSemaphores = &frame->image_available;
+    submit_info.pWaitDstStageMask = &wait_stage;
+    submit_info.commandBufferCount = 1;
+    submit_info.pCommandBuffers = &frame->command_buffer;
+    submit_info.signalSemaphoreCount = 1;
+    submit_info.pSignalSemaphores = &render_complete;
+
+    result = vkQueueSubmit(context.device.graphics_queue, 1, &submit_info, frame->in_flight);
+    vulkan_staging_frame_submitted(&context);
+    if (result != VK_SUCCESS) {
+        KERROR("vkQueueSubmit failed with %d.", result);
+        return FALSE;
+    }
+
+    VkPresentInfoKHR present_info = {VK_STRUCTURE_TYPE_PRESENT_INFO_KHR};
+    present_info.waitSemaphoreCount = 1;
+    present_info.pWaitSemaphores = &render_complete;
+    present_info.swapchainCount = 1;
+    present_info.pSwapchains = &context.swapchain.handle;
+    present_info.pImageIndices = &context.image_index;
+
+    result = vkQueuePresentKHR(context.device.present_queue, &present_info);
+    context.current_frame = (context.current_frame + 1) % context.frames_in_flight;
+    if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR) {
+        // The frame was still submitted; the next one starts on a new swapchain.
+        context.recreate_swapchain = TRUE;
+    } else if (result != VK_SUCCESS) {
+        KERROR("vkQueuePresentKHR failed with %d.", result);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+b8 vulkan_renderer_backend_record_parallel(renderer_backend* backend, u32 count, u32 batch_size, renderer_record_entry entry, void* data) {
+    return vulkan_command_record_parallel(&context, count, batch_size, entry, data);
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+/**
+ * @file vulkan_backend.h
+ * @brief This file contains the Vulkan implementation of the renderer backend interface.
+ * @details The frontend reaches these through the function pointers of a renderer_backend;
+ * see renderer_types.h for what each one must do.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "renderer/renderer_types.h"
+
+/**
+ * @brief Creates the instance, device, swapchain and per-frame resources.
+ * @param backend A pointer to the backend.
+ * @param application_name The name of the application, reported to the driver.
+ * @param frames_in_flight The number of frames the CPU may record ahead of the GPU, 2 or 3.
+ * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+ */
+b8 vulkan_renderer_backend_initialize(renderer_backend* backend, const char* application_name, u8 frames_in_flight);
+
+/**
+ * @brief Waits for the GPU to go idle and destroys everything the backend created.
+ * @param backend A pointer to the backend.
+ */
+void vulkan_renderer_backend_shutdown(renderer_backend* backend);
+
+/**
+ * @brief Records the new window size. The swapchain is recreated at the start of the next frame.
+ * @param backend A pointer to the backend.
+ * @param width The new width in pixels.
+ * @param height The new height in pixels.
+ */
+void vulkan_renderer_backend_on_resized(renderer_backend* backend, u16 width, u16 height);
+
+/**
+ * @brief Waits for the frame's previous use to complete, acquires a swapchain image and begins the main render pass.
+ * @param backend A pointer to the backend.
+ * @param delta_time The time in seconds since the last frame.
+ * @return `b8 TRUE` if the frame was begun, `b8 FALSE` if it must be skipped.
+ */
+b8 vulkan_renderer_backend_begin_frame(renderer_backend* backend, f32 delta_time);
+
+/**
+ * @brief Ends the main render pass, submits the frame and presents its image.
+ * @param backend A pointer to the backend.
+ * @param delta_time The time in seconds since the last frame.
+ * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+ */
+b8 vulkan_renderer_backend_end_frame(renderer_backend* backend, f32 delta_time);
+
+/**
+ * @brief Records items into the main render pass of the current frame in parallel secondary command buffers.
+ * @param backend A pointer to the backend.
+ * @param count The number of items.
+ * @param batch_size The most items per secondary command buffer, or 0 to let the backend choose.
+ * @param entry The function recording each batch.
+ * @param data The user data passed to `entry`.
+ * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+ */
+b8 vulkan_renderer_backend_record_parallel(renderer_backend* backend, u32 count, u32 batch_size, renderer_record_entry entry, void* data);
@@ -0,0 +1,55 @@
+/**
+ * @file vulkan_buffer.c
+ * @brief This file contains the implementation of Vulkan buffers.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "vulkan_buffer.h"
+
+#include "core/kmemory.h"
+#include "core/logger.h"
+#include "renderer/vulkan/vulkan_memory.h"
+
+b8 vulkan_buffer_create(
+    vulkan_context* context,
+    VkDeviceSize size,
+    VkBufferUsageFlags usage,
+    VkMemoryPropertyFlags required,
+    VkMemoryPropertyFlags preferred,
+    vulkan_buffer* out_buffer) {
+    kzero_memory(out_buffer, sizeof(vulkan_buffer));
+    out_buffer->size = size;
+    out_buffer->usage = usage;
+
+    VkBufferCreateInfo buffer_info = {VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+    buffer_info.size = size;
+    buffer_info.usage = usage;
+    // Only ever used from the graphics queue.
+    buffer_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    VkResult result = vkCreateBuffer(context->device.logical_device, &buffer_info, context->allocator, &out_buffer->handle);
+    if (result != VK_SUCCESS) {
+        KERROR("vkCreateBuffer of %llu bytes failed with %d.", size, result);
+        return FALSE;
+    }
+
+    VkMemoryRequirements requirements;
+    vkGetBufferMemoryRequirements(context->device.logical_device, out_buffer->handle, &requirements);
+    if (!vulkan_memory_allocate(context, &requirements, required, preferred, VULKAN_MEMORY_KIND_LINEAR, &out_buffer->allocation)) {
+        KERROR("Failed to allocate memory for a buffer of %llu bytes.", size);
+        vkDestroyBuffer(context->device.logical_device, out_buffer->handle, context->allocator);
+        out_buffer->handle = VK_NULL_HANDLE;
+        return FALSE;
+    }
+
+    VK_CHECK(vkBindBufferMemory(context->device.logical_device, out_buffer->handle, out_buffer->allocation.memory, out_buffer->allocation.offset));
+    return TRUE;
+}
+
+void vulkan_buffer_destroy(vulkan_context* context, vulkan_buffer* buffer) {
+    if (buffer->handle) {
+        vkDestroyBuffer(context->device.logical_device, buffer->handle, context->allocator);
+    }
+    vulkan_memory_free(context, &buffer->allocation);
+    kzero_memory(buffer, sizeof(vulkan_buffer));
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+/**
+ * @file vulkan_buffer.h
+ * @brief This file contains the creation of Vulkan buffers backed by suballocated memory.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "renderer/vulkan/vulkan_types.h"
+
+/**
+ * @brief Creates a buffer and binds it to memory from the context's allocator.
+ * @param context A pointer to the Vulkan context.
+ * @param size The size of the buffer in bytes.
+ * @param usage How the buffer will be used.
+ * @param required The properties its memory must have, e.g. DEVICE_LOCAL, or HOST_VISIBLE | HOST_COHERENT for host-written buffers.
+ * @param preferred Additional properties its memory should have if a type offers them.
+ * @param out_buffer A pointer to the buffer to create. Host-visible buffers come mapped, at `allocation.mapped`.
+ * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+ */
+b8 vulkan_buffer_create(
+    vulkan_context* context,
+    VkDeviceSize size,
+    VkBufferUsageFlags usage,
+    VkMemoryPropertyFlags required,
+    VkMemoryPropertyFlags preferred,
+    vulkan_buffer* out_buffer);
+
+/**
+ * @brief Destroys a buffer and frees its memory. The GPU must no longer be using it.
+ * @param context A pointer to the Vulkan context.
+ * @param buffer A pointer to the buffer.
+ */
+void vulkan_buffer_destroy(vulkan_context* context, vulkan_buffer* buffer);
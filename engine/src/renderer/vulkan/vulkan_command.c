@@ -0,0 +1,225 @@
+/**
+ * @file vulkan_command.c
+ * @brief This file contains the implementation of parallel secondary command buffer recording.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "vulkan_command.h"
+
+#include "containers/darray.h"
+#include "core/job_system.h"
+#include "core/katomic.h"
+#include "core/kmemory.h"
+#include "core/logger.h"
+#include "core/profiler.h"
+
+/** @brief The number of batches per thread aimed for when no batch size is given. Fewer than the job system's, as each batch costs a command buffer. */
+#define VULKAN_RECORD_BATCHES_PER_THREAD 2
+
+/** @brief The number of secondary command buffers each pool has room for before its darray grows. */
+#define VULKAN_SECONDARIES_PER_POOL 8
+
+/**
+ * @struct vulkan_recording
+ * @brief The state shared by the batches of one vulkan_command_record_parallel call.
+ */
+typedef struct vulkan_recording {
+    /** @brief The frame being recorded. */
+    vulkan_frame* frame;
+
+    /** @brief The number of thread pools of the frame. The last one is for threads outside the job system. */
+    u32 thread_pool_count;
+
+    /** @brief The device. */
+    VkDevice device;
+
+    /** @brief What the secondary command buffers continue: the main render pass and the frame's framebuffer. */
+    VkCommandBufferInheritanceInfo inheritance;
+
+    /** @brief The function recording each batch. */
+    renderer_record_entry entry;
+
+    /** @brief The user data passed to `entry`. */
+    void* data;
+
+    /** @brief The number of items per batch. */
+    u32 batch_size;
+
+    /** @brief The secondary command buffer of each batch, indexed by the batch's first item / batch_size. */
+    VkCommandBuffer* secondaries;
+
+    /** @brief Set if any batch could not be recorded. Accessed atomically. */
+    u32 failed;
+} vulkan_recording;
+
+b8 vulkan_command_pools_create(vulkan_context* context) {
+    VkDevice device = context->device.logical_device;
+    context->thread_pool_count = job_system_thread_count() + 1;
+    context->recorded_secondaries = darray_create(VkCommandBuffer);
+
+    for (u32 f = 0; f < context->frames_in_flight; ++f) {
+        vulkan_frame* frame = &context->frames[f];
+        frame->thread_pools = kallocate_aligned(sizeof(vulkan_thread_command_pool) * context->thread_pool_count, KCACHE_LINE_SIZE, MEMORY_TAG_RENDERER);
+
+        for (u32 t = 0; t < context->thread_pool_count; ++t) {
+            vulkan_thread_command_pool* pool = &frame->thread_pools[t];
+            VkCommandPoolCreateInfo pool_info = {VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO};
+            pool_info.queueFamilyIndex = context->device.graphics_queue_index;
+            pool_info.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+            VkResult result = vkCreateCommandPool(device, &pool_info, context->allocator, &pool->handle);
+            if (result != VK_SUCCESS) {
+                KERROR("vkCreateCommandPool for thread %u of frame %u failed with %d.", t, f, result);
+                return FALSE;
+            }
+            pool->secondaries = darray_reserve(VkCommandBuffer, VULKAN_SECONDARIES_PER_POOL);
+        }
+    }
+    return TRUE;
+}
+
+void vulkan_command_pools_destroy(vulkan_context* context) {
+    for (u32 f = 0; f < VULKAN_MAX_FRAMES_IN_FLIGHT; ++f) {
+        vulkan_frame* frame = &context->frames[f];
+        if (!frame->thread_pools) {
+            continue;
+        }
+        for (u32 t = 0; t < context->thread_pool_count; ++t) {
+            vulkan_thread_command_pool* pool = &frame->thread_pools[t];
+            if (pool->handle) {
+                // Frees the secondary command buffers with it.
+                vkDestroyCommandPool(context->device.logical_device, pool->handle, context->allocator);
+            }
+            if (pool->secondaries) {
+                darray_destroy(pool->secondaries);
+            }
+        }
+        kfree_aligned(frame->thread_pools, sizeof(vulkan_thread_command_pool) * context->thread_pool_count, KCACHE_LINE_SIZE, MEMORY_TAG_RENDERER);
+        frame->thread_pools = 0;
+    }
+    if (context->recorded_secondaries) {
+        darray_destroy(context->recorded_secondaries);
+        context->recorded_secondaries = 0;
+    }
+    context->thread_pool_count = 0;
+}
+
+void vulkan_command_pools_reset(vulkan_context* context, u32 frame) {
+    vulkan_thread_command_pool* pools = context->frames[frame].thread_pools;
+    for (u32 t = 0; t < context->thread_pool_count; ++t) {
+        // Pools of threads that recorded nothing need no reset.
+        if (pools[t].used) {
+            VK_CHECK(vkResetCommandPool(context->device.logical_device, pools[t].handle, 0));
+            pools[t].used = 0;
+        }
+    }
+}
+
+/**
+ * @brief Gets the next free secondary command buffer of a pool, allocating one if all are in use.
+ * @return The command buffer, or VK_NULL_HANDLE if it could not be allocated.
+ */
+static VkCommandBuffer vulkan_thread_pool_acquire(VkDevice device, vulkan_thread_command_pool* pool) {
+    if (pool->used == darray_length(pool->secondaries)) {
+        VkCommandBufferAllocateInfo allocate_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+        allocate_info.commandPool = pool->handle;
+        allocate_info.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+        allocate_info.commandBufferCount = 1;
+        VkCommandBuffer command_buffer;
+        if (vkAllocateCommandBuffers(device, &allocate_info, &command_buffer) != VK_SUCCESS) {
+            return VK_NULL_HANDLE;
+        }
+        darray_push(pool->secondaries, command_buffer);
+    }
+    return pool->secondaries[pool->used++];
+}
+
+/**
+ * @brief Records one batch into a secondary command buffer from the calling thread's pool. Run by the job system.
+ */
+static void vulkan_record_batch(u32 start, u32 end, void* data) {
+    KPROFILE_SCOPE("vulkan_record_batch");
+    vulkan_recording* recording = data;
+
+    // Threads outside the job system run their batches inline, so they never share the last pool with a worker.
+    i32 thread_index = job_system_thread_index();
+    u32 pool_index = (thread_index >= 0 && (u32)thread_index < recording->thread_pool_count - 1) ? (u32)thread_index : recording->thread_pool_count - 1;
+    vulkan_thread_command_pool* pool = &recording->frame->thread_pools[pool_index];
+
+    VkCommandBuffer command_buffer = vulkan_thread_pool_acquire(recording->device, pool);
+    if (!command_buffer) {
+        katomic_store(&recording->failed, 1, KATOMIC_RELAXED);
+        return;
+    }
+
+    VkCommandBufferBeginInfo begin_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+    begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+    begin_info.pInheritanceInfo = &recording->inheritance;
+    if (vkBeginCommandBuffer(command_buffer, &begin_info) != VK_SUCCESS) {
+        katomic_store(&recording->failed, 1, KATOMIC_RELAXED);
+        return;
+    }
+
+    recording->entry(command_buffer, start, end, recording->data);
+
+    if (vkEndCommandBuffer(command_buffer) != VK_SUCCESS) {
+        katomic_store(&recording->failed, 1, KATOMIC_RELAXED);
+        return;
+    }
+    recording->secondaries[start / recording->batch_size] = command_buffer;
+}
+
+b8 vulkan_command_record_parallel(vulkan_context* context, u32 count, u32 batch_size, renderer_record_entry entry, void* data) {
+    KPROFILE_SCOPE("vulkan_command_record_parallel");
+    if (count == 0) {
+        return TRUE;
+    }
+
+    if (batch_size == 0) {
+        u32 batches = job_system_thread_count() * VULKAN_RECORD_BATCHES_PER_THREAD;
+        batch_size = (count + batches - 1) / batches;
+    }
+    u32 batch_count = (count + batch_size - 1) / batch_size;
+
+    // One slot per batch, so that the buffers execute in item order whatever order they finish in.
+    if (!darray_reserve_capacity(context->recorded_secondaries, batch_count)) {
+        KERROR("vulkan_command_record_parallel: no room to record %u batches.", batch_count);
+        return FALSE;
+    }
+    darray_length_set(context->recorded_secondaries, batch_count);
+    kzero_memory(context->recorded_secondaries, sizeof(VkCommandBuffer) * batch_count);
+
+    vulkan_frame* frame = &context->frames[context->current_frame];
+    vulkan_recording recording = {0};
+    recording.frame = frame;
+    recording.thread_pool_count = context->thread_pool_count;
+    recording.device = context->device.logical_device;
+    recording.inheritance.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    recording.inheritance.renderPass = context->main_renderpass;
+    recording.inheritance.subpass = 0;
+    recording.inheritance.framebuffer = context->swapchain.framebuffers[context->image_index];
+    recording.entry = entry;
+    recording.data = data;
+    recording.batch_size = batch_size;
+    recording.secondaries = context->recorded_secondaries;
+
+    job_counter counter = {0};
+    job_system_parallel_for(count, batch_size, vulkan_record_batch, &recording, &counter);
+    job_system_wait(&counter);
+
+    // Skip the batches that failed; the rest of the frame is still worth drawing.
+    u32 recorded = 0;
+    for (u32 i = 0; i < batch_count; ++i) {
+        if (recording.secondaries[i]) {
+            recording.secondaries[recorded++] = recording.secondaries[i];
+        }
+    }
+    if (recorded) {
+        vkCmdExecuteCommands(frame->command_buffer, recorded, recording.secondaries);
+    }
+
+    if (katomic_load(&recording.failed, KATOMIC_RELAXED)) {
+        KERROR("vulkan_command_record_parallel: %u of %u batches could not be recorded.", batch_count - recorded, batch_count);
+        return FALSE;
+    }
+    return TRUE;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+/**
+ * @file vulkan_command.h
+ * @brief This file contains the recording of secondary command buffers in parallel on the job system.
+ * @details Each frame in flight has a command pool per recording thread. Workers allocate their
+ * secondary command buffers from their own pool, so recording needs no lock, and the primary
+ * command buffer executes the results in item order. The pools are reset when their frame
+ * comes round again, which recycles every buffer allocated from them at once.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "renderer/vulkan/vulkan_types.h"
+
+/**
+ * @brief Creates the per-thread command pools of every frame in flight.
+ * @details One pool per job system thread, plus one for recording from any other thread.
+ * @param context A pointer to the Vulkan context. frames_in_flight must be set.
+ * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+ */
+b8 vulkan_command_pools_create(vulkan_context* context);
+
+/**
+ * @brief Destroys the per-thread command pools. The GPU must be done with every frame.
+ * @param context A pointer to the Vulkan context.
+ */
+void vulkan_command_pools_destroy(vulkan_context* context);
+
+/**
+ * @brief Resets the per-thread command pools of a frame the GPU has finished.
+ * @param context A pointer to the Vulkan context.
+ * @param frame The index of the frame in flight.
+ */
+void vulkan_command_pools_reset(vulkan_context* context, u32 frame);
+
+/**
+ * @brief Records items into secondary command buffers in parallel and executes them in the current frame.
+ * @details The current frame's primary command buffer must be inside the main render pass, begun
+ * with VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS. Blocks until every batch is recorded,
+ * running batches on the calling thread too.
+ * @param context A pointer to the Vulkan context.
+ * @param count The number of items.
+ * @param batch_size The most items per secondary command buffer, or 0 to give every thread a couple of batches.
+ * @param entry The function recording each batch. Receives the VkCommandBuffer to record into.
+ * @param data The user data passed to `entry`.
+ * @return `b8 TRUE` on success, `b8 FALSE` if any batch could not be recorded; the others are still executed.
+ */
+b8 vulkan_command_record_parallel(vulkan_context* context, u32 count, u32 batch_size, renderer_record_entry entry, void* data);
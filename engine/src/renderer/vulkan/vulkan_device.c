@@ -0,0 +1,246 @@
+/**
+ * @file vulkan_device.c
+ * @brief This file contains the implementation of Vulkan device selection and creation.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "vulkan_device.h"
+
+#include "core/kmemory.h"
+#include "core/kstring.h"
+#include "core/logger.h"
+
+/** @brief The most physical devices considered. */
+#define VULKAN_MAX_PHYSICAL_DEVICES 16
+
+/** @brief The most queue families inspected per physical device. */
+#define VULKAN_MAX_QUEUE_FAMILIES 32
+
+/**
+ * @struct vulkan_device_candidate
+ * @brief What device selection found out about a physical device.
+ */
+typedef struct vulkan_device_candidate {
+    /** @brief The index of the queue family for graphics. */
+    u32 graphics_queue_index;
+
+    /** @brief The index of the queue family for presenting. */
+    u32 present_queue_index;
+
+    /** @brief How desirable the device is. 0 if unusable. */
+    u32 score;
+} vulkan_device_candidate;
+
+void vulkan_device_free_swapchain_support(vulkan_swapchain_support_info* support_info) {
+    if (support_info->formats) {
+        kfree(support_info->formats, sizeof(VkSurfaceFormatKHR) * support_info->format_count, MEMORY_TAG_RENDERER);
+    }
+    if (support_info->present_modes) {
+        kfree(support_info->present_modes, sizeof(VkPresentModeKHR) * support_info->present_mode_count, MEMORY_TAG_RENDERER);
+    }
+    kzero_memory(support_info, sizeof(vulkan_swapchain_support_info));
+}
+
+void vulkan_device_query_swapchain_support(VkPhysicalDevice physical_device, VkSurfaceKHR surface, vulkan_swapchain_support_info* support_info) {
+    vulkan_device_free_swapchain_support(support_info);
+    VK_CHECK(vkGetPhysicalDeviceSurfaceCapabilitiesKHR(physical_device, surface, &support_info->capabilities));
+
+    VK_CHECK(vkGetPhysicalDeviceSurfaceFormatsKHR(physical_device, surface, &support_info->format_count, 0));
+    if (support_info->format_count) {
+        support_info->formats = kallocate(sizeof(VkSurfaceFormatKHR) * support_info->format_count, MEMORY_TAG_RENDERER);
+        VK_CHECK(vkGetPhysicalDeviceSurfaceFormatsKHR(physical_device, surface, &support_info->format_count, support_info->formats));
+    }
+
+    VK_CHECK(vkGetPhysicalDeviceSurfacePresentModesKHR(physical_device, surface, &support_info->present_mode_count, 0));
+    if (support_info->present_mode_count) {
+        support_info->present_modes = kallocate(sizeof(VkPresentModeKHR) * support_info->present_mode_count, MEMORY_TAG_RENDERER);
+        VK_CHECK(vkGetPhysicalDeviceSurfacePresentModesKHR(physical_device, surface, &support_info->present_mode_count, support_info->present_modes));
+    }
+}
+
+/** @brief Checks if a physical device supports an extension. */
+static b8 vulkan_device_has_extension(VkPhysicalDevice physical_device, const char* name) {
+    u32 count = 0;
+    VK_CHECK(vkEnumerateDeviceExtensionProperties(physical_device, 0, &count, 0));
+    if (!count) {
+        return FALSE;
+    }
+
+    VkExtensionProperties* extensions = kallocate(sizeof(VkExtensionProperties) * count, MEMORY_TAG_RENDERER);
+    VK_CHECK(vkEnumerateDeviceExtensionProperties(physical_device, 0, &count, extensions));
+    b8 found = FALSE;
+    for (u32 i = 0; i < count && !found; ++i) {
+        found = kstring_equal(kstring_from_cstr(extensions[i].extensionName), kstring_from_cstr(name));
+    }
+    kfree(extensions, sizeof(VkExtensionProperties) * count, MEMORY_TAG_RENDERER);
+    return found;
+}
+
+/** @brief Checks if a physical device is usable, finds its queue families, and scores it. */
+static vulkan_device_candidate vulkan_device_evaluate(vulkan_context* context, VkPhysicalDevice physical_device) {
+    vulkan_device_candidate candidate = {0};
+
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(physical_device, &properties);
+    if (properties.apiVersion < VK_API_VERSION_1_1) {
+        KINFO("Skipping '%s': Vulkan 1.1 is required.", properties.deviceName);
+        return candidate;
+    }
+
+    u32 family_count = VULKAN_MAX_QUEUE_FAMILIES;
+    VkQueueFamilyProperties families[VULKAN_MAX_QUEUE_FAMILIES];
+    vkGetPhysicalDeviceQueueFamilyProperties(physical_device, &family_count, families);
+
+    // Prefer one family that does both, so nothing has to move between queues.
+    b8 found_graphics = FALSE;
+    b8 found_present = FALSE;
+    for (u32 i = 0; i < family_count; ++i) {
+        VkBool32 can_present = VK_FALSE;
+        VK_CHECK(vkGetPhysicalDeviceSurfaceSupportKHR(physical_device, i, context->surface, &can_present));
+        b8 graphics = (families[i].queueFlags & VK_QUEUE_GRAPHICS_BIT) != 0;
+
+        if (graphics && can_present) {
+            candidate.graphics_queue_index = i;
+            candidate.present_queue_index = i;
+            found_graphics = found_present = TRUE;
+            break;
+        }
+        if (graphics && !found_graphics) {
+            candidate.graphics_queue_index = i;
+            found_graphics = TRUE;
+        }
+        if (can_present && !found_present) {
+            candidate.present_queue_index = i;
+            found_present = TRUE;
+        }
+    }
+    if (!found_graphics || !found_present) {
+        KINFO("Skipping '%s': no graphics queue able to present.", properties.deviceName);
+        return candidate;
+    }
+
+    if (!vulkan_device_has_extension(physical_device, VK_KHR_SWAPCHAIN_EXTENSION_NAME)) {
+        KINFO("Skipping '%s': %s is not supported.", properties.deviceName, VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+        return candidate;
+    }
+
+    vulkan_swapchain_support_info support = {0};
+    vulkan_device_query_swapchain_support(physical_device, context->surface, &support);
+    b8 can_swap = support.format_count > 0 && support.present_mode_count > 0;
+    vulkan_device_free_swapchain_support(&support);
+    if (!can_swap) {
+        KINFO("Skipping '%s': the surface has no formats or present modes.", properties.deviceName);
+        return candidate;
+    }
+
+    candidate.score = 1;
+    if (properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU) {
+        candidate.score += 1000;
+    } else if (properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU) {
+        candidate.score += 100;
+    }
+    return candidate;
+}
+
+/** @brief Picks the first depth format usable as an optimal-tiling depth attachment. */
+static b8 vulkan_device_detect_depth_format(vulkan_device* device) {
+    const VkFormat candidates[] = {VK_FORMAT_D32_SFLOAT, VK_FORMAT_D32_SFLOAT_S8_UINT, VK_FORMAT_D24_UNORM_S8_UINT};
+    for (u32 i = 0; i < sizeof(candidates) / sizeof(candidates[0]); ++i) {
+        VkFormatProperties properties;
+        vkGetPhysicalDeviceFormatProperties(device->physical_device, candidates[i], &properties);
+        if (properties.optimalTilingFeatures & VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT) {
+            device->depth_format = candidates[i];
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+b8 vulkan_device_create(vulkan_context* context) {
+    vulkan_device* device = &context->device;
+    kzero_memory(device, sizeof(vulkan_device));
+
+    u32 physical_device_count = VULKAN_MAX_PHYSICAL_DEVICES;
+    VkPhysicalDevice physical_devices[VULKAN_MAX_PHYSICAL_DEVICES];
+    VkResult result = vkEnumeratePhysicalDevices(context->instance, &physical_device_count, physical_devices);
+    if ((result != VK_SUCCESS && result != VK_INCOMPLETE) || physical_device_count == 0) {
+        KERROR("No Vulkan devices were found.");
+        return FALSE;
+    }
+
+    vulkan_device_candidate best = {0};
+    for (u32 i = 0; i < physical_device_count; ++i) {
+        vulkan_device_candidate candidate = vulkan_device_evaluate(context, physical_devices[i]);
+        if (candidate.score > best.score) {
+            best = candidate;
+            device->physical_device = physical_devices[i];
+        }
+    }
+    if (!best.score) {
+        KERROR("No Vulkan device meets the requirements.");
+        return FALSE;
+    }
+
+    device->graphics_queue_index = best.graphics_queue_index;
+    device->present_queue_index = best.present_queue_index;
+    vkGetPhysicalDeviceProperties(device->physical_device, &device->properties);
+    vkGetPhysicalDeviceMemoryProperties(device->physical_device, &device->memory);
+    vulkan_device_query_swapchain_support(device->physical_device, context->surface, &device->swapchain_support);
+    KINFO("Selected GPU: %s (driver %u.%u.%u, Vulkan %u.%u.%u).",
+          device->properties.deviceName,
+          VK_VERSION_MAJOR(device->properties.driverVersion),
+          VK_VERSION_MINOR(device->properties.driverVersion),
+          VK_VERSION_PATCH(device->properties.driverVersion),
+          VK_VERSION_MAJOR(device->properties.apiVersion),
+          VK_VERSION_MINOR(device->properties.apiVersion),
+          VK_VERSION_PATCH(device->properties.apiVersion));
+
+    // One queue from each distinct family.
+    f32 queue_priority = 1.0f;
+    VkDeviceQueueCreateInfo queue_infos[2];
+    u32 queue_info_count = device->graphics_queue_index == device->present_queue_index ? 1 : 2;
+    u32 family_indices[2] = {device->graphics_queue_index, device->present_queue_index};
+    for (u32 i = 0; i < queue_info_count; ++i) {
+        VkDeviceQueueCreateInfo info = {VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO};
+        info.queueFamilyIndex = family_indices[i];
+        info.queueCount = 1;
+        info.pQueuePriorities = &queue_priority;
+        queue_infos[i] = info;
+    }
+
+    VkPhysicalDeviceFeatures features = {0};
+    const char* extension_names[] = {VK_KHR_SWAPCHAIN_EXTENSION_NAME};
+
+    VkDeviceCreateInfo device_info = {VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO};
+    device_info.queueCreateInfoCount = queue_info_count;
+    device_info.pQueueCreateInfos = queue_infos;
+    device_info.pEnabledFeatures = &features;
+    device_info.enabledExtensionCount = 1;
+    device_info.ppEnabledExtensionNames = extension_names;
+
+    result = vkCreateDevice(device->physical_device, &device_info, context->allocator, &device->logical_device);
+    if (result != VK_SUCCESS) {
+        KERROR("vkCreateDevice failed with %d.", result);
+        vulkan_device_free_swapchain_support(&device->swapchain_support);
+        return FALSE;
+    }
+
+    vkGetDeviceQueue(device->logical_device, device->graphics_queue_index, 0, &device->graphics_queue);
+    vkGetDeviceQueue(device->logical_device, device->present_queue_index, 0, &device->present_queue);
+
+    if (!vulkan_device_detect_depth_format(device)) {
+        KERROR("The device supports none of the depth formats.");
+        vulkan_device_destroy(context);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+void vulkan_device_destroy(vulkan_context* context) {
+    vulkan_device* device = &context->device;
+    vulkan_device_free_swapchain_support(&device->swapchain_support);
+    if (device->logical_device) {
+        vkDestroyDevice(device->logical_device, context->allocator);
+    }
+    kzero_memory(device, sizeof(vulkan_device));
+}
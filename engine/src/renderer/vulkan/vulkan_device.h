@@ -0,0 +1,38 @@
+#pragma once
+
+/**
+ * @file vulkan_device.h
+ * @brief This file contains the selection of the physical device and the creation of the logical device.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "renderer/vulkan/vulkan_types.h"
+
+/**
+ * @brief Picks the best physical device able to present to the context's surface and creates a logical device on it.
+ * @details Discrete GPUs are preferred over integrated ones. The device must have a graphics
+ * queue, a queue able to present to the surface (ideally the same one), and VK_KHR_swapchain.
+ * @param context A pointer to the Vulkan context. The instance and surface must be created.
+ * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+ */
+b8 vulkan_device_create(vulkan_context* context);
+
+/**
+ * @brief Destroys the logical device of a context.
+ * @param context A pointer to the Vulkan context.
+ */
+void vulkan_device_destroy(vulkan_context* context);
+
+/**
+ * @brief Queries what a surface supports on a physical device.
+ * @param physical_device The physical device.
+ * @param surface The surface.
+ * @param support_info A pointer to the info to fill in. Arrays it already holds are reused or freed.
+ */
+void vulkan_device_query_swapchain_support(VkPhysicalDevice physical_device, VkSurfaceKHR surface, vulkan_swapchain_support_info* support_info);
+
+/**
+ * @brief Frees the arrays of a swapchain support info.
+ * @param support_info A pointer to the info.
+ */
+void vulkan_device_free_swapchain_support(vulkan_swapchain_support_info* support_info);
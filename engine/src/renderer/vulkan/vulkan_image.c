@@ -0,0 +1,84 @@
+/**
+ * @file vulkan_image.c
+ * @brief This file contains the implementation of Vulkan images.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "vulkan_image.h"
+
+#include "core/kmemory.h"
+#include "core/logger.h"
+#include "renderer/vulkan/vulkan_memory.h"
+
+b8 vulkan_image_create(
+    vulkan_context* context,
+    u32 width,
+    u32 height,
+    VkFormat format,
+    VkImageTiling tiling,
+    VkImageUsageFlags usage,
+    VkMemoryPropertyFlags memory_flags,
+    VkImageAspectFlags aspect_flags,
+    vulkan_image* out_image) {
+    kzero_memory(out_image, sizeof(vulkan_image));
+    out_image->width = width;
+    out_image->height = height;
+    out_image->format = format;
+
+    VkImageCreateInfo image_info = {VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO};
+    image_info.imageType = VK_IMAGE_TYPE_2D;
+    image_info.extent.width = width;
+    image_info.extent.height = height;
+    image_info.extent.depth = 1;
+    image_info.mipLevels = 1;
+    image_info.arrayLayers = 1;
+    image_info.format = format;
+    image_info.tiling = tiling;
+    image_info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    image_info.usage = usage;
+    image_info.samples = VK_SAMPLE_COUNT_1_BIT;
+    image_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    VkResult result = vkCreateImage(context->device.logical_device, &image_info, context->allocator, &out_image->handle);
+    if (result != VK_SUCCESS) {
+        KERROR("vkCreateImage of %ux%u failed with %d.", width, height, result);
+        return FALSE;
+    }
+
+    VkMemoryRequirements requirements;
+    vkGetImageMemoryRequirements(context->device.logical_device, out_image->handle, &requirements);
+    vulkan_memory_kind kind = tiling == VK_IMAGE_TILING_OPTIMAL ? VULKAN_MEMORY_KIND_OPTIMAL : VULKAN_MEMORY_KIND_LINEAR;
+    if (!vulkan_memory_allocate(context, &requirements, memory_flags, 0, kind, &out_image->allocation)) {
+        KERROR("Failed to allocate memory for a %ux%u image.", width, height);
+        vulkan_image_destroy(context, out_image);
+        return FALSE;
+    }
+    VK_CHECK(vkBindImageMemory(context->device.logical_device, out_image->handle, out_image->allocation.memory, out_image->allocation.offset));
+
+    VkImageViewCreateInfo view_info = {VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO};
+    view_info.image = out_image->handle;
+    view_info.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    view_info.format = format;
+    view_info.subresourceRange.aspectMask = aspect_flags;
+    view_info.subresourceRange.levelCount = 1;
+    view_info.subresourceRange.layerCount = 1;
+
+    result = vkCreateImageView(context->device.logical_device, &view_info, context->allocator, &out_image->view);
+    if (result != VK_SUCCESS) {
+        KERROR("vkCreateImageView failed with %d.", result);
+        vulkan_image_destroy(context, out_image);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+void vulkan_image_destroy(vulkan_context* context, vulkan_image* image) {
+    if (image->view) {
+        vkDestroyImageView(context->device.logical_device, image->view, context->allocator);
+    }
+    if (image->handle) {
+        vkDestroyImage(context->device.logical_device, image->handle, context->allocator);
+    }
+    vulkan_memory_free(context, &image->allocation);
+    kzero_memory(image, sizeof(vulkan_image));
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+/**
+ * @file vulkan_image.h
+ * @brief This file contains the creation of Vulkan images backed by suballocated memory.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "renderer/vulkan/vulkan_types.h"
+
+/**
+ * @brief Creates a 2D image, binds it to memory from the context's allocator and creates a view of it.
+ * @param context A pointer to the Vulkan context.
+ * @param width The width in pixels.
+ * @param height The height in pixels.
+ * @param format The format.
+ * @param tiling The tiling. Optimal and linear images are kept in separate memory blocks.
+ * @param usage How the image will be used.
+ * @param memory_flags The properties its memory must have.
+ * @param aspect_flags The aspects the view covers, e.g. COLOR or DEPTH.
+ * @param out_image A pointer to the image to create.
+ * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+ */
+b8 vulkan_image_create(
+    vulkan_context* context,
+    u32 width,
+    u32 height,
+    VkFormat format,
+    VkImageTiling tiling,
+    VkImageUsageFlags usage,
+    VkMemoryPropertyFlags memory_flags,
+    VkImageAspectFlags aspect_flags,
+    vulkan_image* out_image);
+
+/**
+ * @brief Destroys an image and its view and frees its memory. The GPU must no longer be using it.
+ * @param context A pointer to the Vulkan context.
+ * @param image A pointer to the image.
+ */
+void vulkan_image_destroy(vulkan_context* context, vulkan_image* image);
@@ -0,0 +1,359 @@
+/**
+ * @file vulkan_memory.c
+ * @brief This file contains the implementation of the Vulkan device memory suballocator.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "vulkan_memory.h"
+
+#include "containers/darray.h"
+#include "core/kmemory.h"
+#include "core/logger.h"
+
+/**
+ * @struct vulkan_memory_block
+ * @brief One device memory object and the buddy tree splitting it.
+ */
+typedef struct vulkan_memory_block {
+    /** @brief The device memory. */
+    VkDeviceMemory memory;
+
+    /** @brief The size of the memory. */
+    VkDeviceSize size;
+
+    /** @brief The host address of the memory if it is host visible, otherwise 0. */
+    u8* mapped;
+
+    /** @brief The index of the pool the block belongs to. */
+    u32 pool_index;
+
+    /** @brief The order of the whole block: its size is VULKAN_MEMORY_MIN_ALLOCATION << levels. */
+    u32 levels;
+
+    /**
+     * @brief The buddy tree, as a complete binary tree in an array (children of i at 2i+1 and 2i+2).
+     * Each node holds 1 + the order of the largest free range below it, or 0 if none is free.
+     * 0 for dedicated blocks, which hold a single resource.
+     */
+    u8* longest;
+
+    /** @brief The number of bytes handed out from the block. */
+    VkDeviceSize used;
+} vulkan_memory_block;
+
+/** @brief Gets the number of nodes in the buddy tree of a block of the given order. */
+static inline u64 buddy_node_count(u32 levels) {
+    return (2ULL << levels) - 1;
+}
+
+/** @brief Gets the smallest order whose range holds `size` bytes. */
+static u32 buddy_order_for(VkDeviceSize size) {
+    u32 order = 0;
+    while (((VkDeviceSize)VULKAN_MEMORY_MIN_ALLOCATION << order) < size) {
+        order++;
+    }
+    return order;
+}
+
+/** @brief Recomputes the nodes above `node` after it changed. */
+static void buddy_update_parents(u8* longest, u64 node, u32 order) {
+    while (node) {
+        node = (node - 1) / 2;
+        order++;
+        u8 left = longest[2 * node + 1];
+        u8 right = longest[2 * node + 2];
+        // Two wholly free children (each holding their own order + 1) merge into a free parent.
+        if (left == order && right == order) {
+            longest[node] = (u8)(order + 1);
+        } else {
+            longest[node] = left > right ? left : right;
+        }
+    }
+}
+
+/**
+ * @brief Takes a free range of the given order from a block's buddy tree.
+ * @return `b8 TRUE` with the range's offset, or `b8 FALSE` if the block has no free range that large.
+ */
+static b8 buddy_allocate(vulkan_memory_block* block, u32 order, VkDeviceSize* out_offset) {
+    u8* longest = block->longest;
+    if (longest[0] < order + 1) {
+        return FALSE;
+    }
+
+    // Walk down to a free node of exactly `order`, preferring the left child to keep the block packed.
+    u64 node = 0;
+    u32 depth = 0;
+    while (block->levels - depth != order) {
+        u64 left = 2 * node + 1;
+        node = longest[left] >= order + 1 ? left : left + 1;
+        depth++;
+    }
+
+    longest[node] = 0;
+    buddy_update_parents(longest, node, order);
+
+    u64 index_in_level = node + 1 - (1ULL << depth);
+    *out_offset = index_in_level * ((VkDeviceSize)VULKAN_MEMORY_MIN_ALLOCATION << order);
+    return TRUE;
+}
+
+/** @brief Returns a range to a block's buddy tree, merging it with its free buddies. */
+static void buddy_free(vulkan_memory_block* block, VkDeviceSize offset, u32 order) {
+    u32 depth = block->levels - order;
+    u64 node = (1ULL << depth) - 1 + offset / ((VkDeviceSize)VULKAN_MEMORY_MIN_ALLOCATION << order);
+    block->longest[node] = (u8)(order + 1);
+    buddy_update_parents(block->longest, node, order);
+}
+
+/**
+ * @brief Allocates a device memory block for a pool.
+ * @param dedicated_size The size of a dedicated block for a single resource, or 0 for a shared block with a buddy tree.
+ */
+static vulkan_memory_block* vulkan_memory_block_create(vulkan_context* context, u32 pool_index, VkDeviceSize dedicated_size) {
+    vulkan_memory_allocator* allocator = &context->memory;
+    u32 memory_type = pool_index / VULKAN_MEMORY_KIND_COUNT;
+
+    VkMemoryAllocateInfo allocate_info = {VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO};
+    allocate_info.allocationSize = dedicated_size ? dedicated_size : allocator->block_size;
+    allocate_info.memoryTypeIndex = memory_type;
+
+    if (allocator->device_allocation_count >= context->device.properties.limits.maxMemoryAllocationCount) {
+        KERROR("Device memory allocation limit (%u) reached.", context->device.properties.limits.maxMemoryAllocationCount);
+        return 0;
+    }
+
+    VkDeviceMemory memory;
+    VkResult result = vkAllocateMemory(context->device.logical_device, &allocate_info, context->allocator, &memory);
+    if (result != VK_SUCCESS) {
+        KERROR("vkAllocateMemory of %llu bytes from memory type %u failed with %d.", allocate_info.allocationSize, memory_type, result);
+        return 0;
+    }
+
+    vulkan_memory_block* block = kallocate(sizeof(vulkan_memory_block), MEMORY_TAG_RENDERER);
+    block->memory = memory;
+    block->size = allocate_info.allocationSize;
+    block->pool_index = pool_index;
+
+    if (!dedicated_size) {
+        block->levels = buddy_order_for(block->size);
+        u64 node_count = buddy_node_count(block->levels);
+        block->longest = kallocate_uninit(node_count, MEMORY_TAG_RENDERER);
+        // Every node starts wholly free: a node at depth d holds 1 + its order, levels - d.
+        for (u32 depth = 0; depth <= block->levels; ++depth) {
+            u64 first = (1ULL << depth) - 1;
+            kset_memory(block->longest + first, (i32)(block->levels - depth + 1), 1ULL << depth);
+        }
+    }
+
+    if (context->device.memory.memoryTypes[memory_type].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) {
+        void* mapped;
+        result = vkMapMemory(context->device.logical_device, memory, 0, VK_WHOLE_SIZE, 0, &mapped);
+        if (result != VK_SUCCESS) {
+            KERROR("vkMapMemory of a host-visible block failed with %d.", result);
+        } else {
+            block->mapped = mapped;
+        }
+    }
+
+    allocator->device_allocation_count++;
+    allocator->bytes_reserved += block->size;
+    return block;
+}
+
+/** @brief Frees a block's device memory and host bookkeeping. */
+static void vulkan_memory_block_destroy(vulkan_context* context, vulkan_memory_block* block) {
+    vulkan_memory_allocator* allocator = &context->memory;
+    if (block->mapped) {
+        vkUnmapMemory(context->device.logical_device, block->memory);
+    }
+    vkFreeMemory(context->device.logical_device, block->memory, context->allocator);
+    allocator->device_allocation_count--;
+    allocator->bytes_reserved -= block->size;
+
+    if (block->longest) {
+        kfree(block->longest, buddy_node_count(block->levels), MEMORY_TAG_RENDERER);
+    }
+    kfree(block, sizeof(vulkan_memory_block), MEMORY_TAG_RENDERER);
+}
+
+/** @brief Removes a block from its pool and destroys it. */
+static void vulkan_memory_block_release(vulkan_context* context, vulkan_memory_block* block) {
+    vulkan_memory_block** pool = context->memory.pools[block->pool_index];
+    u64 count = darray_length(pool);
+    for (u64 i = 0; i < count; ++i) {
+        if (pool[i] == block) {
+            darray_swap_remove(pool, i, 0);
+            break;
+        }
+    }
+    vulkan_memory_block_destroy(context, block);
+}
+
+/** @brief Checks if the pool of a shared block has another shared block, so the block may be released when empty. */
+static b8 vulkan_memory_pool_has_other_shared_block(vulkan_context* context, const vulkan_memory_block* block) {
+    vulkan_memory_block** pool = context->memory.pools[block->pool_index];
+    u64 count = darray_length(pool);
+    for (u64 i = 0; i < count; ++i) {
+        if (pool[i] != block && pool[i]->longest) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+b8 vulkan_memory_allocator_create(vulkan_context* context) {
+    vulkan_memory_allocator* allocator = &context->memory;
+    kzero_memory(allocator, sizeof(vulkan_memory_allocator));
+    allocator->block_size = VULKAN_MEMORY_DEFAULT_BLOCK_SIZE;
+
+    // Keep blocks to an eighth of the smallest heap, so small heaps (e.g. a 256 MiB
+    // host-visible device-local window) are not exhausted by a few mostly empty blocks.
+    const VkPhysicalDeviceMemoryProperties* memory = &context->device.memory;
+    for (u32 i = 0; i < memory->memoryHeapCount; ++i) {
+        VkDeviceSize eighth = memory->memoryHeaps[i].size / 8;
+        while (allocator->block_size > eighth && allocator->block_size > 4ULL * 1024 * 1024) {
+            allocator->block_size /= 2;
+        }
+    }
+
+    KDEBUG("Vulkan memory allocator created with %llu MiB blocks.", allocator->block_size / (1024 * 1024));
+    return TRUE;
+}
+
+void vulkan_memory_allocator_destroy(vulkan_context* context) {
+    vulkan_memory_allocator* allocator = &context->memory;
+    if (allocator->bytes_in_use) {
+        KWARN("Vulkan memory allocator destroyed with %llu bytes still allocated.", allocator->bytes_in_use);
+    }
+
+    for (u32 i = 0; i < VK_MAX_MEMORY_TYPES * VULKAN_MEMORY_KIND_COUNT; ++i) {
+        vulkan_memory_block** pool = allocator->pools[i];
+        if (!pool) {
+            continue;
+        }
+        u64 count = darray_length(pool);
+        for (u64 b = 0; b < count; ++b) {
+            vulkan_memory_block_destroy(context, pool[b]);
+        }
+        darray_destroy(pool);
+    }
+    kzero_memory(allocator, sizeof(vulkan_memory_allocator));
+}
+
+i32 vulkan_memory_find_type(vulkan_context* context, u32 type_bits, VkMemoryPropertyFlags required, VkMemoryPropertyFlags preferred) {
+    const VkPhysicalDeviceMemoryProperties* memory = &context->device.memory;
+    i32 fallback = -1;
+    for (u32 i = 0; i < memory->memoryTypeCount; ++i) {
+        if (!(type_bits & (1u << i))) {
+            continue;
+        }
+        VkMemoryPropertyFlags flags = memory->memoryTypes[i].propertyFlags;
+        if ((flags & required) != required) {
+            continue;
+        }
+        if ((flags & preferred) == preferred) {
+            return (i32)i;
+        }
+        if (fallback < 0) {
+            fallback = (i32)i;
+        }
+    }
+    return fallback;
+}
+
+b8 vulkan_memory_allocate(
+    vulkan_context* context,
+    const VkMemoryRequirements* requirements,
+    VkMemoryPropertyFlags required,
+    VkMemoryPropertyFlags preferred,
+    vulkan_memory_kind kind,
+    vulkan_allocation* out_allocation) {
+    vulkan_memory_allocator* allocator = &context->memory;
+    kzero_memory(out_allocation, sizeof(vulkan_allocation));
+
+    i32 memory_type = vulkan_memory_find_type(context, requirements->memoryTypeBits, required, required | preferred);
+    if (memory_type < 0) {
+        KERROR("No memory type has the required properties 0x%x.", required);
+        return FALSE;
+    }
+
+    u32 pool_index = (u32)memory_type * VULKAN_MEMORY_KIND_COUNT + kind;
+    if (!allocator->pools[pool_index]) {
+        allocator->pools[pool_index] = darray_create(vulkan_memory_block*);
+    }
+
+    // Large resources get their own memory: in a shared block they would waste up to half of it to rounding.
+    if (requirements->size > allocator->block_size / 2) {
+        vulkan_memory_block* block = vulkan_memory_block_create(context, pool_index, requirements->size);
+        if (!block) {
+            return FALSE;
+        }
+        block->used = requirements->size;
+        darray_push(allocator->pools[pool_index], block);
+
+        out_allocation->memory = block->memory;
+        out_allocation->size = requirements->size;
+        out_allocation->mapped = block->mapped;
+        out_allocation->block = block;
+        allocator->bytes_in_use += out_allocation->size;
+        return TRUE;
+    }
+
+    // A buddy range is aligned to its own size, so rounding up to the alignment satisfies it too.
+    VkDeviceSize needed = requirements->size > requirements->alignment ? requirements->size : requirements->alignment;
+    u32 order = buddy_order_for(needed);
+
+    vulkan_memory_block* block = 0;
+    VkDeviceSize offset = 0;
+    vulkan_memory_block** pool = allocator->pools[pool_index];
+    u64 count = darray_length(pool);
+    for (u64 i = 0; i < count; ++i) {
+        if (pool[i]->longest && buddy_allocate(pool[i], order, &offset)) {
+            block = pool[i];
+            break;
+        }
+    }
+
+    if (!block) {
+        block = vulkan_memory_block_create(context, pool_index, 0);
+        if (!block) {
+            return FALSE;
+        }
+        darray_push(allocator->pools[pool_index], block);
+        buddy_allocate(block, order, &offset);
+    }
+
+    block->used += (VkDeviceSize)VULKAN_MEMORY_MIN_ALLOCATION << order;
+    out_allocation->memory = block->memory;
+    out_allocation->offset = offset;
+    out_allocation->size = (VkDeviceSize)VULKAN_MEMORY_MIN_ALLOCATION << order;
+    out_allocation->mapped = block->mapped ? block->mapped + offset : 0;
+    out_allocation->block = block;
+    out_allocation->order = order;
+    allocator->bytes_in_use += out_allocation->size;
+    return TRUE;
+}
+
+void vulkan_memory_free(vulkan_context* context, vulkan_allocation* allocation) {
+    vulkan_memory_block* block = allocation->block;
+    if (!block) {
+        return;
+    }
+
+    context->memory.bytes_in_use -= allocation->size;
+    block->used -= allocation->size;
+
+    if (!block->longest) {
+        vulkan_memory_block_release(context, block);
+    } else {
+        buddy_free(block, allocation->offset, allocation->order);
+
+        // Keep one empty block per pool so that a steady churn does not allocate and free device memory.
+        if (block->used == 0 && vulkan_memory_pool_has_other_shared_block(context, block)) {
+            vulkan_memory_block_release(context, block);
+        }
+    }
+
+    kzero_memory(allocation, sizeof(vulkan_allocation));
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+/**
+ * @file vulkan_memory.h
+ * @brief This file contains the device memory suballocator of the Vulkan backend.
+ *
+ * @details Drivers limit the number of live device memory objects (often to 4096), and
+ * vkAllocateMemory is slow, so resources never allocate memory themselves. The allocator
+ * instead reserves large blocks per memory type and splits them with a buddy allocator:
+ * every range is a power of two times VULKAN_MEMORY_MIN_ALLOCATION, aligned to its own size,
+ * which satisfies any alignment up to that size, and freeing merges ranges back with their
+ * buddies in O(log n). The tree tracking the free ranges lives in host memory, so device-local
+ * memory is never touched by the CPU.
+ *
+ * Host-visible blocks are mapped once when they are created and stay mapped, so every
+ * allocation from them comes with a host address.
+ *
+ * The allocator is not thread-safe. It is used from the thread that owns the renderer.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "renderer/vulkan/vulkan_types.h"
+
+/** @brief The size of a shared device memory block, unless the heap is small. */
+#define VULKAN_MEMORY_DEFAULT_BLOCK_SIZE (64ULL * 1024 * 1024)
+
+/** @brief The smallest range the allocator hands out. Smaller requests are rounded up to it. */
+#define VULKAN_MEMORY_MIN_ALLOCATION 512
+
+/**
+ * @brief Creates the device memory allocator of a context. The device must be created.
+ * @param context A pointer to the Vulkan context.
+ * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+ */
+b8 vulkan_memory_allocator_create(vulkan_context* context);
+
+/**
+ * @brief Destroys the device memory allocator of a context, freeing every block. Reports ranges that were never freed.
+ * @param context A pointer to the Vulkan context.
+ */
+void vulkan_memory_allocator_destroy(vulkan_context* context);
+
+/**
+ * @brief Finds a memory type.
+ * @param context A pointer to the Vulkan context.
+ * @param type_bits The memory types the resource may use, from its VkMemoryRequirements.
+ * @param required The properties the type must have.
+ * @param preferred Additional properties a type is preferred for, e.g. HOST_CACHED for readback.
+ * @return The index of the memory type, or -1 if none has the required properties.
+ */
+i32 vulkan_memory_find_type(vulkan_context* context, u32 type_bits, VkMemoryPropertyFlags required, VkMemoryPropertyFlags preferred);
+
+/**
+ * @brief Allocates device memory for a resource.
+ * @param context A pointer to the Vulkan context.
+ * @param requirements The memory requirements of the resource.
+ * @param required The properties the memory must have.
+ * @param preferred Additional properties the memory should have if a type offers them.
+ * @param kind Whether the resource is a buffer or linear image, or an optimal-tiling image.
+ * @param out_allocation A pointer to the allocation to fill in.
+ * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+ */
+b8 vulkan_memory_allocate(
+    vulkan_context* context,
+    const VkMemoryRequirements* requirements,
+    VkMemoryPropertyFlags required,
+    VkMemoryPropertyFlags preferred,
+    vulkan_memory_kind kind,
+    vulkan_allocation* out_allocation);
+
+/**
+ * @brief Frees an allocation. The GPU must no longer be using the resources bound to it.
+ * @param context A pointer to the Vulkan context.
+ * @param allocation A pointer to the allocation. Zeroed on return.
+ */
+void vulkan_memory_free(vulkan_context* context, vulkan_allocation* allocation);
@@ -0,0 +1,157 @@
+/**
+ * @file vulkan_pipeline_cache.c
+ * @brief This file contains the implementation of the persistent pipeline cache.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "vulkan_pipeline_cache.h"
+
+#include "core/kmemory.h"
+#include "core/kstring.h"
+#include "core/logger.h"
+#include "platform/platform.h"
+
+/** @brief The largest cache file loaded. Anything bigger is assumed to be corrupt. */
+#define VULKAN_PIPELINE_CACHE_MAX_SIZE (256ull * 1024 * 1024)
+
+/** @brief Checks that saved cache data was written by this device and driver. */
+static b8 vulkan_pipeline_cache_header_matches(vulkan_context* context, const u8* data, u64 size) {
+    VkPipelineCacheHeaderVersionOne header;
+    if (size < sizeof(header)) {
+        return FALSE;
+    }
+    kcopy_memory(&header, data, sizeof(header));
+
+    const VkPhysicalDeviceProperties* properties = &context->device.properties;
+    if (header.headerSize < sizeof(header) || header.headerSize > size ||
+        header.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE ||
+        header.vendorID != properties->vendorID ||
+        header.deviceID != properties->deviceID) {
+        return FALSE;
+    }
+    // The UUID changes with the driver version.
+    for (u32 i = 0; i < VK_UUID_SIZE; ++i) {
+        if (header.pipelineCacheUUID[i] != properties->pipelineCacheUUID[i]) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+/**
+ * @brief Reads a saved cache file.
+ * @return The data, allocated with MEMORY_TAG_RENDERER, or 0 if there is none.
+ */
+static u8* vulkan_pipeline_cache_read(const char* path, u64* out_size) {
+    *out_size = 0;
+    if (!platform_file_exists(path)) {
+        return 0;
+    }
+
+    platform_file file;
+    if (!platform_file_open(path, PLATFORM_FILE_MODE_READ, &file)) {
+        KWARN("Unable to open the pipeline cache '%s'.", path);
+        return 0;
+    }
+
+    u64 size = 0;
+    u64 read = 0;
+    u8* data = 0;
+    if (platform_file_size(&file, &size) && size > 0 && size <= VULKAN_PIPELINE_CACHE_MAX_SIZE) {
+        data = kallocate_uninit(size, MEMORY_TAG_RENDERER);
+        if (!platform_file_read(&file, data, size, &read) || read != size) {
+            KWARN("Unable to read the pipeline cache '%s'.", path);
+            kfree(data, size, MEMORY_TAG_RENDERER);
+            data = 0;
+        }
+    }
+    platform_file_close(&file);
+
+    if (data) {
+        *out_size = size;
+    }
+    return data;
+}
+
+b8 vulkan_pipeline_cache_create(vulkan_context* context, const char* path) {
+    u64 size = 0;
+    u8* data = vulkan_pipeline_cache_read(path, &size);
+    if (data && !vulkan_pipeline_cache_header_matches(context, data, size)) {
+        KINFO("The pipeline cache '%s' is from another GPU or driver, starting over.", path);
+        kfree(data, size, MEMORY_TAG_RENDERER);
+        data = 0;
+        size = 0;
+    }
+
+    VkPipelineCacheCreateInfo cache_info = {VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO};
+    cache_info.initialDataSize = (size_t)size;
+    cache_info.pInitialData = data;
+    VkResult result = vkCreatePipelineCache(context->device.logical_device, &cache_info, context->allocator, &context->pipeline_cache);
+    if (result != VK_SUCCESS && data) {
+        // The driver may still reject data it does not like. An empty cache is better than none.
+        KWARN("The pipeline cache '%s' was rejected with %d, starting over.", path, result);
+        cache_info.initialDataSize = 0;
+        cache_info.pInitialData = 0;
+        result = vkCreatePipelineCache(context->device.logical_device, &cache_info, context->allocator, &context->pipeline_cache);
+    }
+    if (data) {
+        kfree(data, size, MEMORY_TAG_RENDERER);
+    }
+    if (result != VK_SUCCESS) {
+        KERROR("vkCreatePipelineCache failed with %d.", result);
+        return FALSE;
+    }
+
+    if (size) {
+        KDEBUG("Pipeline cache loaded from '%s' (%llu bytes).", path, size);
+    }
+    return TRUE;
+}
+
+/** @brief Writes the cache data to a temporary file and moves it over the saved one. */
+static void vulkan_pipeline_cache_save(vulkan_context* context, const char* path) {
+    VkDevice device = context->device.logical_device;
+    size_t size = 0;
+    if (vkGetPipelineCacheData(device, context->pipeline_cache, &size, 0) != VK_SUCCESS || size == 0) {
+        return;
+    }
+
+    u8* data = kallocate_uninit(size, MEMORY_TAG_RENDERER);
+    size_t written_size = size;
+    VkResult result = vkGetPipelineCacheData(device, context->pipeline_cache, &written_size, data);
+    if (result != VK_SUCCESS) {
+        KWARN("vkGetPipelineCacheData failed with %d, the pipeline cache is not saved.", result);
+        kfree(data, size, MEMORY_TAG_RENDERER);
+        return;
+    }
+
+    char temporary_path[512];
+    kstring_format_into(temporary_path, sizeof(temporary_path), "%s.tmp", path);
+
+    platform_file file;
+    b8 saved = FALSE;
+    if (platform_file_open(temporary_path, PLATFORM_FILE_MODE_WRITE, &file)) {
+        saved = platform_file_write(&file, data, written_size, 0);
+        platform_file_close(&file);
+        saved = saved && platform_file_rename(temporary_path, path);
+        if (!saved) {
+            platform_file_delete(temporary_path);
+        }
+    }
+    kfree(data, size, MEMORY_TAG_RENDERER);
+
+    if (saved) {
+        KDEBUG("Pipeline cache saved to '%s' (%llu bytes).", path, (u64)written_size);
+    } else {
+        KWARN("Unable to save the pipeline cache to '%s'.", path);
+    }
+}
+
+void vulkan_pipeline_cache_destroy(vulkan_context* context, const char* path) {
+    if (!context->pipeline_cache) {
+        return;
+    }
+    vulkan_pipeline_cache_save(context, path);
+    vkDestroyPipelineCache(context->device.logical_device, context->pipeline_cache, context->allocator);
+    context->pipeline_cache = VK_NULL_HANDLE;
+}
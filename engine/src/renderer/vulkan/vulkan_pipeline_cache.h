@@ -0,0 +1,35 @@
+#pragma once
+
+/**
+ * @file vulkan_pipeline_cache.h
+ * @brief This file contains the pipeline cache, which is kept on disk between runs.
+ * @details Drivers compile shaders to GPU code when pipelines are created, which can take
+ * long enough to stall a frame. The pipeline cache keeps the compiled code, so that a second
+ * run creating the same pipelines on the same GPU and driver skips the compilation.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "renderer/vulkan/vulkan_types.h"
+
+/** @brief The file the pipeline cache is kept in, relative to the working directory. */
+#define VULKAN_PIPELINE_CACHE_PATH "vulkan_pipeline_cache.bin"
+
+/**
+ * @brief Creates the pipeline cache of a context, seeded with the data saved at a previous shutdown.
+ * @details Saved data is only used if its header matches the device: data from another GPU or
+ * driver version is discarded, as drivers are not required to reject it safely. A missing or
+ * discarded file is not an error; the cache then starts empty.
+ * @param context A pointer to the Vulkan context. The device must be created.
+ * @param path The path of the file the cache was saved to.
+ * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+ */
+b8 vulkan_pipeline_cache_create(vulkan_context* context, const char* path);
+
+/**
+ * @brief Saves the pipeline cache of a context and destroys it.
+ * @details The data is written to a temporary file first and moved over the old one, so an
+ * interrupted save never leaves a truncated cache behind.
+ * @param context A pointer to the Vulkan context.
+ * @param path The path of the file to save the cache to.
+ */
+void vulkan_pipeline_cache_destroy(vulkan_context* context, const char* path);
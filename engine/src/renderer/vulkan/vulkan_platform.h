@@ -0,0 +1,28 @@
+#pragma once
+
+/**
+ * @file vulkan_platform.h
+ * @brief This file contains the parts of the Vulkan backend implemented by each platform layer.
+ * @details The platform layers implement these next to their windowing code, since creating a
+ * surface needs the native window handles they keep private.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "defines.h"
+
+struct platform_state;
+struct vulkan_context;
+
+/**
+ * @brief Creates the Vulkan surface of the platform's window.
+ * @param plat_state A pointer to the platform state.
+ * @param context A pointer to the Vulkan context. Its instance must be created; its surface is set.
+ * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+ */
+b8 platform_create_vulkan_surface(struct platform_state* plat_state, struct vulkan_context* context);
+
+/**
+ * @brief Appends the names of the instance extensions the platform needs for its surface.
+ * @param names_darray A pointer to a darray of `const char*` names.
+ */
+void platform_get_required_extension_names(const char*** names_darray);
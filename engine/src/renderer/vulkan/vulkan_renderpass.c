@@ -0,0 +1,93 @@
+/**
+ * @file vulkan_renderpass.c
+ * @brief This file contains the implementation of the main render pass.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "vulkan_renderpass.h"
+
+#include "core/logger.h"
+
+b8 vulkan_renderpass_create(vulkan_context* context, VkRenderPass* out_renderpass) {
+    VkAttachmentDescription attachments[2] = {0};
+
+    VkAttachmentDescription* colour = &attachments[0];
+    colour->format = context->swapchain.image_format.format;
+    colour->samples = VK_SAMPLE_COUNT_1_BIT;
+    colour->loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+    colour->storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+    colour->stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    colour->stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    colour->initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    colour->finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+
+    VkAttachmentDescription* depth = &attachments[1];
+    depth->format = context->device.depth_format;
+    depth->samples = VK_SAMPLE_COUNT_1_BIT;
+    depth->loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+    depth->storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    depth->stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    depth->stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    depth->initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    depth->finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+    VkAttachmentReference colour_reference = {0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL};
+    VkAttachmentReference depth_reference = {1, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL};
+
+    VkSubpassDescription subpass = {0};
+    subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    subpass.colorAttachmentCount = 1;
+    subpass.pColorAttachments = &colour_reference;
+    subpass.pDepthStencilAttachment = &depth_reference;
+
+    // The swapchain image is only acquired once the semaphore waited at colour output is signalled,
+    // and the single depth attachment is shared by all frames: order both against the previous frame.
+    VkSubpassDependency dependency = {0};
+    dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
+    dependency.dstSubpass = 0;
+    dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+    dependency.srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+    dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+
+    VkRenderPassCreateInfo renderpass_info = {VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO};
+    renderpass_info.attachmentCount = 2;
+    renderpass_info.pAttachments = attachments;
+    renderpass_info.subpassCount = 1;
+    renderpass_info.pSubpasses = &subpass;
+    renderpass_info.dependencyCount = 1;
+    renderpass_info.pDependencies = &dependency;
+
+    VkResult result = vkCreateRenderPass(context->device.logical_device, &renderpass_info, context->allocator, out_renderpass);
+    if (result != VK_SUCCESS) {
+        KERROR("vkCreateRenderPass failed with %d.", result);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+void vulkan_renderpass_destroy(vulkan_context* context, VkRenderPass* renderpass) {
+    if (*renderpass) {
+        vkDestroyRenderPass(context->device.logical_device, *renderpass, context->allocator);
+        *renderpass = VK_NULL_HANDLE;
+    }
+}
+
+void vulkan_renderpass_begin(vulkan_context* context, VkCommandBuffer command_buffer, VkRenderPass renderpass, VkFramebuffer framebuffer, VkSubpassContents contents) {
+    VkClearValue clear_values[2];
+    clear_values[0].color = context->clear_colour;
+    clear_values[1].depthStencil.depth = 1.0f;
+    clear_values[1].depthStencil.stencil = 0;
+
+    VkRenderPassBeginInfo begin_info = {VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO};
+    begin_info.renderPass = renderpass;
+    begin_info.framebuffer = framebuffer;
+    begin_info.renderArea.extent = context->swapchain.extent;
+    begin_info.clearValueCount = 2;
+    begin_info.pClearValues = clear_values;
+    vkCmdBeginRenderPass(command_buffer, &begin_info, contents);
+}
+
+void vulkan_renderpass_end(VkCommandBuffer command_buffer) {
+    vkCmdEndRenderPass(command_buffer);
+}
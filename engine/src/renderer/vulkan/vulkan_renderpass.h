@@ -0,0 +1,42 @@
+#pragma once
+
+/**
+ * @file vulkan_renderpass.h
+ * @brief This file contains the main render pass, which draws to a swapchain image and the depth attachment.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "renderer/vulkan/vulkan_types.h"
+
+/**
+ * @brief Creates the main render pass of a context, for its swapchain format and depth format.
+ * @details Both attachments are cleared on load. Colour is stored and left ready to present;
+ * depth is discarded.
+ * @param context A pointer to the Vulkan context. The swapchain must be created.
+ * @param out_renderpass A pointer to hold the render pass.
+ * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+ */
+b8 vulkan_renderpass_create(vulkan_context* context, VkRenderPass* out_renderpass);
+
+/**
+ * @brief Destroys a render pass.
+ * @param context A pointer to the Vulkan context.
+ * @param renderpass A pointer to the render pass. Set to VK_NULL_HANDLE.
+ */
+void vulkan_renderpass_destroy(vulkan_context* context, VkRenderPass* renderpass);
+
+/**
+ * @brief Begins a render pass over the whole swapchain extent, clearing to the context's clear colour.
+ * @param context A pointer to the Vulkan context.
+ * @param command_buffer The command buffer to record into.
+ * @param renderpass The render pass.
+ * @param framebuffer The framebuffer to draw to.
+ * @param contents How the subpass contents are recorded: inline or in secondary command buffers.
+ */
+void vulkan_renderpass_begin(vulkan_context* context, VkCommandBuffer command_buffer, VkRenderPass renderpass, VkFramebuffer framebuffer, VkSubpassContents contents);
+
+/**
+ * @brief Ends a render pass.
+ * @param command_buffer The command buffer being recorded.
+ */
+void vulkan_renderpass_end(VkCommandBuffer command_buffer);
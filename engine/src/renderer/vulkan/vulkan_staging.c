@@ -0,0 +1,249 @@
+/**
+ * @file vulkan_staging.c
+ * @brief This file contains the implementation of the Vulkan staging ring.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "vulkan_staging.h"
+
+#include "containers/darray.h"
+#include "core/kmemory.h"
+#include "core/logger.h"
+#include "renderer/vulkan/vulkan_buffer.h"
+
+/** @brief The value of recording_frame between frames. */
+#define VULKAN_STAGING_NO_FRAME 0xFFFFFFFFu
+
+/** @brief The stages that read uploaded data, waited on before copies overwrite it and made to wait for the copies. */
+#define VULKAN_STAGING_CONSUMER_STAGES \
+    (VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT)
+
+/** @brief The accesses that read uploaded data. */
+#define VULKAN_STAGING_CONSUMER_ACCESS                                                                 \
+    (VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_UNIFORM_READ_BIT | \
+     VK_ACCESS_SHADER_READ_BIT)
+
+b8 vulkan_staging_create(vulkan_context* context, VkDeviceSize size) {
+    vulkan_staging_ring* ring = &context->staging;
+    kzero_memory(ring, sizeof(vulkan_staging_ring));
+    ring->recording_frame = VULKAN_STAGING_NO_FRAME;
+
+    // Host coherent, so that writes need no flush: every implementation has such a type.
+    if (!vulkan_buffer_create(
+            context,
+            size,
+            VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            0,
+            &ring->buffer)) {
+        KERROR("Failed to create the staging ring buffer.");
+        return FALSE;
+    }
+    ring->mapped = ring->buffer.allocation.mapped;
+    if (!ring->mapped) {
+        KERROR("The staging ring buffer is not mapped.");
+        vulkan_buffer_destroy(context, &ring->buffer);
+        return FALSE;
+    }
+
+    VkCommandPoolCreateInfo pool_info = {VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO};
+    pool_info.queueFamilyIndex = context->device.graphics_queue_index;
+    pool_info.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+    VkResult result = vkCreateCommandPool(context->device.logical_device, &pool_info, context->allocator, &ring->immediate_pool);
+    if (result != VK_SUCCESS) {
+        KERROR("vkCreateCommandPool for the staging ring failed with %d.", result);
+        vulkan_buffer_destroy(context, &ring->buffer);
+        return FALSE;
+    }
+
+    ring->pending_copies = darray_create(vulkan_staging_copy);
+    KDEBUG("Vulkan staging ring created with %llu MiB.", size / (1024 * 1024));
+    return TRUE;
+}
+
+void vulkan_staging_destroy(vulkan_context* context) {
+    vulkan_staging_ring* ring = &context->staging;
+    if (ring->pending_copies) {
+        if (darray_length(ring->pending_copies)) {
+            KWARN("Vulkan staging ring destroyed with %llu uploads never recorded.", darray_length(ring->pending_copies));
+        }
+        darray_destroy(ring->pending_copies);
+    }
+    if (ring->immediate_pool) {
+        vkDestroyCommandPool(context->device.logical_device, ring->immediate_pool, context->allocator);
+    }
+    vulkan_buffer_destroy(context, &ring->buffer);
+    kzero_memory(ring, sizeof(vulkan_staging_ring));
+}
+
+/**
+ * @brief Records the pending copies, between the barriers that order them against the frames around them.
+ */
+static void vulkan_staging_record_copies(vulkan_staging_ring* ring, VkCommandBuffer command_buffer) {
+    u64 count = darray_length(ring->pending_copies);
+    if (!count) {
+        return;
+    }
+
+    // Earlier frames may still read the destinations being overwritten. An execution dependency covers that write-after-read.
+    vkCmdPipelineBarrier(command_buffer, VULKAN_STAGING_CONSUMER_STAGES, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, 0, 0, 0, 0, 0);
+
+    for (u64 i = 0; i < count; ++i) {
+        vulkan_staging_copy* copy = &ring->pending_copies[i];
+        vkCmdCopyBuffer(command_buffer, ring->buffer.handle, copy->destination, 1, &copy->region);
+    }
+
+    VkMemoryBarrier barrier = {VK_STRUCTURE_TYPE_MEMORY_BARRIER};
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VULKAN_STAGING_CONSUMER_ACCESS;
+    vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VULKAN_STAGING_CONSUMER_STAGES, 0, 1, &barrier, 0, 0, 0, 0);
+
+    darray_clear(ring->pending_copies);
+}
+
+/**
+ * @brief Submits the pending copies at once and drains the graphics queue, freeing all ring space
+ * but that of the frame being recorded.
+ */
+static b8 vulkan_staging_flush_immediate(vulkan_context* context) {
+    vulkan_staging_ring* ring = &context->staging;
+    VkDevice device = context->device.logical_device;
+
+    VkCommandBufferAllocateInfo allocate_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+    allocate_info.commandPool = ring->immediate_pool;
+    allocate_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocate_info.commandBufferCount = 1;
+    VkCommandBuffer command_buffer;
+    VkResult result = vkAllocateCommandBuffers(device, &allocate_info, &command_buffer);
+    if (result != VK_SUCCESS) {
+        KERROR("vkAllocateCommandBuffers for a staging flush failed with %d.", result);
+        return FALSE;
+    }
+
+    VkCommandBufferBeginInfo begin_info = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+    begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    VK_CHECK(vkBeginCommandBuffer(command_buffer, &begin_info));
+    vulkan_staging_record_copies(ring, command_buffer);
+    VK_CHECK(vkEndCommandBuffer(command_buffer));
+
+    VkSubmitInfo submit_info = {VK_STRUCTURE_TYPE_SUBMIT_INFO};
+    submit_info.commandBufferCount = 1;
+    submit_info.pCommandBuffers = &command_buffer;
+    result = vkQueueSubmit(context->device.graphics_queue, 1, &submit_info, VK_NULL_HANDLE);
+    if (result == VK_SUCCESS) {
+        // Also waits for every frame in flight, whose ring space can then be released too.
+        result = vkQueueWaitIdle(context->device.graphics_queue);
+    }
+    vkResetCommandPool(device, ring->immediate_pool, 0);
+    if (result != VK_SUCCESS) {
+        KERROR("Staging flush failed with %d.", result);
+        return FALSE;
+    }
+
+    // The frame being recorded has not been submitted; the copies in its command buffer still read
+    // its space. The space written after it stays reserved with it too, so that the live space stays
+    // one run ending at the head.
+    VkDeviceSize kept = 0;
+    for (u32 i = 0; i < VULKAN_MAX_FRAMES_IN_FLIGHT; ++i) {
+        if (i == ring->recording_frame) {
+            ring->frame_bytes[i] += ring->pending_bytes;
+            kept = ring->frame_bytes[i];
+        } else {
+            ring->frame_bytes[i] = 0;
+        }
+    }
+    ring->used = kept;
+    ring->pending_bytes = 0;
+    return TRUE;
+}
+
+/**
+ * @brief Reserves space at the head of the ring.
+ * @return `b8 TRUE` with the offset of the space, or `b8 FALSE` if the ring is too full.
+ */
+static b8 vulkan_staging_reserve(vulkan_staging_ring* ring, VkDeviceSize size, VkDeviceSize* out_offset) {
+    VkDeviceSize capacity = ring->buffer.size;
+    if (ring->used == 0) {
+        // Nothing is live: start over at the beginning instead of wrapping sooner than needed.
+        ring->head = 0;
+    }
+
+    VkDeviceSize offset = KALIGN_UP(ring->head, VULKAN_STAGING_ALIGNMENT);
+    VkDeviceSize padding = offset - ring->head;
+    if (offset + size > capacity) {
+        // Skip the end of the ring; the skipped bytes are released with this frame's space.
+        padding = capacity - ring->head;
+        offset = 0;
+    }
+
+    if (ring->used + padding + size > capacity) {
+        return FALSE;
+    }
+
+    ring->head = offset + size;
+    ring->used += padding + size;
+    ring->pending_bytes += padding + size;
+    *out_offset = offset;
+    return TRUE;
+}
+
+b8 vulkan_staging_upload(vulkan_context* context, VkBuffer destination, VkDeviceSize destination_offset, const void* data, VkDeviceSize size) {
+    vulkan_staging_ring* ring = &context->staging;
+    const u8* source = data;
+    VkDeviceSize max_chunk = ring->buffer.size - VULKAN_STAGING_ALIGNMENT;
+
+    while (size) {
+        VkDeviceSize chunk = size < max_chunk ? size : max_chunk;
+        VkDeviceSize offset;
+        if (!vulkan_staging_reserve(ring, chunk, &offset)) {
+            KDEBUG("Staging ring full, flushing %llu uploads.", darray_length(ring->pending_copies));
+            if (!vulkan_staging_flush_immediate(context)) {
+                return FALSE;
+            }
+            if (!vulkan_staging_reserve(ring, chunk, &offset)) {
+                // Only the frame being recorded is left. The free space is at most two pieces, after the
+                // head and before that frame's space; the larger one holds half of it.
+                VkDeviceSize half_free = (ring->buffer.size - ring->used) / 2;
+                chunk = half_free > VULKAN_STAGING_ALIGNMENT ? half_free - VULKAN_STAGING_ALIGNMENT : 0;
+                if (!chunk || !vulkan_staging_reserve(ring, chunk, &offset)) {
+                    KERROR("vulkan_staging_upload: the staging ring is filled by the frame being recorded.");
+                    return FALSE;
+                }
+            }
+        }
+
+        kcopy_memory(ring->mapped + offset, source, chunk);
+        vulkan_staging_copy copy;
+        copy.destination = destination;
+        copy.region.srcOffset = offset;
+        copy.region.dstOffset = destination_offset;
+        copy.region.size = chunk;
+        darray_push(ring->pending_copies, copy);
+
+        source += chunk;
+        destination_offset += chunk;
+        size -= chunk;
+    }
+    return TRUE;
+}
+
+void vulkan_staging_frame_completed(vulkan_context* context, u32 frame) {
+    vulkan_staging_ring* ring = &context->staging;
+    // Frames complete in submission order, so this is always the oldest live space.
+    ring->used -= ring->frame_bytes[frame];
+    ring->frame_bytes[frame] = 0;
+}
+
+void vulkan_staging_record(vulkan_context* context, VkCommandBuffer command_buffer, u32 frame) {
+    vulkan_staging_ring* ring = &context->staging;
+    vulkan_staging_record_copies(ring, command_buffer);
+
+    // Everything written so far is read by this frame's copies, and is free again once it completes.
+    ring->frame_bytes[frame] += ring->pending_bytes;
+    ring->pending_bytes = 0;
+    ring->recording_frame = frame;
+}
+
+void vulkan_staging_frame_submitted(vulkan_context* context) {
+    context->staging.recording_frame = VULKAN_STAGING_NO_FRAME;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+/**
+ * @file vulkan_staging.h
+ * @brief This file contains the staging ring the Vulkan backend uploads buffer data through.
+ *
+ * @details Uploading to device-local memory goes through a host-visible buffer that a copy
+ * command then reads from. Rather than creating a staging buffer per upload, the backend
+ * keeps one persistently mapped ring: an upload is written at the ring's head, and its copy
+ * is recorded at the start of the next frame's command buffer. The space is released when
+ * the GPU signals that frame's fence, so the ring never waits on the GPU in a steady state.
+ *
+ * When the ring is full (e.g. while loading a level), the pending copies are submitted at
+ * once and the queue is drained, which frees the whole ring. Uploads larger than the ring
+ * are split into ring-sized pieces that way.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "renderer/vulkan/vulkan_types.h"
+
+/** @brief The size of the staging ring. */
+#define VULKAN_STAGING_DEFAULT_SIZE (32ULL * 1024 * 1024)
+
+/** @brief The alignment of every upload in the ring, enough for buffer-to-image copies of any format. */
+#define VULKAN_STAGING_ALIGNMENT 16
+
+/**
+ * @brief Creates the staging ring of a context. The device and memory allocator must be created.
+ * @param context A pointer to the Vulkan context.
+ * @param size The size of the ring in bytes.
+ * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+ */
+b8 vulkan_staging_create(vulkan_context* context, VkDeviceSize size);
+
+/**
+ * @brief Destroys the staging ring of a context. The GPU must be idle.
+ * @param context A pointer to the Vulkan context.
+ */
+void vulkan_staging_destroy(vulkan_context* context);
+
+/**
+ * @brief Uploads data to a buffer. The data is copied into the ring before this returns.
+ * @details The copy runs at the start of the next frame begun after this call, and is made
+ * visible to that frame's vertex, index, uniform and shader reads.
+ * @param context A pointer to the Vulkan context.
+ * @param destination The buffer to upload to. Must have been created with TRANSFER_DST usage.
+ * @param destination_offset The offset in `destination` to write at.
+ * @param data The data to upload.
+ * @param size The number of bytes to upload.
+ * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+ */
+b8 vulkan_staging_upload(vulkan_context* context, VkBuffer destination, VkDeviceSize destination_offset, const void* data, VkDeviceSize size);
+
+/**
+ * @brief Releases the ring space of a frame whose fence has been waited on.
+ * @param context A pointer to the Vulkan context.
+ * @param frame The index of the frame in flight.
+ */
+void vulkan_staging_frame_completed(vulkan_context* context, u32 frame);
+
+/**
+ * @brief Records the pending copies into a frame's command buffer, outside of any render pass.
+ * @param context A pointer to the Vulkan context.
+ * @param command_buffer The frame's command buffer, in the recording state.
+ * @param frame The index of the frame in flight. The ring space of the copies is released when it completes.
+ */
+void vulkan_staging_record(vulkan_context* context, VkCommandBuffer command_buffer, u32 frame);
+
+/**
+ * @brief Marks the frame passed to vulkan_staging_record as submitted.
+ * @param context A pointer to the Vulkan context.
+ */
+void vulkan_staging_frame_submitted(vulkan_context* context);
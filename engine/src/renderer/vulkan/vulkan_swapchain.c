@@ -0,0 +1,170 @@
+/**
+ * @file vulkan_swapchain.c
+ * @brief This file contains the implementation of the Vulkan swapchain.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "vulkan_swapchain.h"
+
+#include "core/kmemory.h"
+#include "core/logger.h"
+#include "renderer/vulkan/vulkan_device.h"
+#include "renderer/vulkan/vulkan_image.h"
+
+/** @brief Destroys the per-image objects and depth attachment of a swapchain, keeping the swapchain itself. */
+static void vulkan_swapchain_destroy_images(vulkan_context* context, vulkan_swapchain* swapchain) {
+    VkDevice device = context->device.logical_device;
+    vulkan_image_destroy(context, &swapchain->depth_attachment);
+    for (u32 i = 0; i < swapchain->image_count; ++i) {
+        if (swapchain->views[i]) {
+            vkDestroyImageView(device, swapchain->views[i], context->allocator);
+        }
+        if (swapchain->render_complete[i]) {
+            vkDestroySemaphore(device, swapchain->render_complete[i], context->allocator);
+        }
+        swapchain->views[i] = VK_NULL_HANDLE;
+        swapchain->render_complete[i] = VK_NULL_HANDLE;
+    }
+    swapchain->image_count = 0;
+}
+
+b8 vulkan_swapchain_create(vulkan_context* context, u32 width, u32 height, vulkan_swapchain* swapchain) {
+    vulkan_device* device = &context->device;
+    vulkan_device_query_swapchain_support(device->physical_device, context->surface, &device->swapchain_support);
+    const vulkan_swapchain_support_info* support = &device->swapchain_support;
+
+    VkSurfaceFormatKHR image_format = support->formats[0];
+    for (u32 i = 0; i < support->format_count; ++i) {
+        if (support->formats[i].format == VK_FORMAT_B8G8R8A8_UNORM && support->formats[i].colorSpace == VK_COLOR_SPACE_SRGB_NONLINEAR_KHR) {
+            image_format = support->formats[i];
+            break;
+        }
+    }
+
+    // MAILBOX presents the newest frame without tearing, and does not block the CPU on the display;
+    // the application's frame limiter paces it. FIFO is the guaranteed fallback.
+    VkPresentModeKHR present_mode = VK_PRESENT_MODE_FIFO_KHR;
+    for (u32 i = 0; i < support->present_mode_count; ++i) {
+        if (support->present_modes[i] == VK_PRESENT_MODE_MAILBOX_KHR) {
+            present_mode = VK_PRESENT_MODE_MAILBOX_KHR;
+            break;
+        }
+    }
+
+    // Most surfaces dictate their size; the window's is only used when they leave it to us.
+    const VkSurfaceCapabilitiesKHR* capabilities = &support->capabilities;
+    VkExtent2D extent = capabilities->currentExtent;
+    if (extent.width == 0xFFFFFFFFu) {
+        extent.width = CLAMP(width, capabilities->minImageExtent.width, capabilities->maxImageExtent.width);
+        extent.height = CLAMP(height, capabilities->minImageExtent.height, capabilities->maxImageExtent.height);
+    }
+    if (extent.width == 0 || extent.height == 0) {
+        KDEBUG("Not creating a swapchain for a zero-sized surface.");
+        return FALSE;
+    }
+
+    // One more than the minimum, so the CPU need not wait for the driver to release an image.
+    u32 image_count = capabilities->minImageCount + 1;
+    if (capabilities->maxImageCount > 0 && image_count > capabilities->maxImageCount) {
+        image_count = capabilities->maxImageCount;
+    }
+    if (image_count > VULKAN_MAX_SWAPCHAIN_IMAGES) {
+        image_count = VULKAN_MAX_SWAPCHAIN_IMAGES;
+    }
+
+    VkSwapchainCreateInfoKHR swapchain_info = {VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR};
+    swapchain_info.surface = context->surface;
+    swapchain_info.minImageCount = image_count;
+    swapchain_info.imageFormat = image_format.format;
+    swapchain_info.imageColorSpace = image_format.colorSpace;
+    swapchain_info.imageExtent = extent;
+    swapchain_info.imageArrayLayers = 1;
+    swapchain_info.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+
+    u32 queue_family_indices[] = {device->graphics_queue_index, device->present_queue_index};
+    if (device->graphics_queue_index != device->present_queue_index) {
+        swapchain_info.imageSharingMode = VK_SHARING_MODE_CONCURRENT;
+        swapchain_info.queueFamilyIndexCount = 2;
+        swapchain_info.pQueueFamilyIndices = queue_family_indices;
+    } else {
+        swapchain_info.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    }
+
+    swapchain_info.preTransform = capabilities->currentTransform;
+    swapchain_info.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
+    swapchain_info.presentMode = present_mode;
+    swapchain_info.clipped = VK_TRUE;
+    swapchain_info.oldSwapchain = swapchain->handle;
+
+    VkSwapchainKHR handle;
+    VkResult result = vkCreateSwapchainKHR(device->logical_device, &swapchain_info, context->allocator, &handle);
+
+    // The old swapchain is retired either way.
+    vulkan_swapchain_destroy(context, swapchain);
+    if (result != VK_SUCCESS) {
+        KERROR("vkCreateSwapchainKHR failed with %d.", result);
+        return FALSE;
+    }
+
+    swapchain->handle = handle;
+    swapchain->image_format = image_format;
+    swapchain->extent = extent;
+    swapchain->image_count = 0;
+    VK_CHECK(vkGetSwapchainImagesKHR(device->logical_device, handle, &swapchain->image_count, 0));
+    if (swapchain->image_count > VULKAN_MAX_SWAPCHAIN_IMAGES) {
+        // The driver may create more images than asked for, and vkAcquireNextImageKHR may then
+        // return any of them, so using only the first few is not an option.
+        KERROR("The swapchain has %u images, more than the %u supported.", swapchain->image_count, VULKAN_MAX_SWAPCHAIN_IMAGES);
+        vulkan_swapchain_destroy(context, swapchain);
+        return FALSE;
+    }
+    result = vkGetSwapchainImagesKHR(device->logical_device, handle, &swapchain->image_count, swapchain->images);
+    if (result != VK_SUCCESS) {
+        KERROR("vkGetSwapchainImagesKHR failed with %d.", result);
+        vulkan_swapchain_destroy(context, swapchain);
+        return FALSE;
+    }
+
+    VkSemaphoreCreateInfo semaphore_info = {VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO};
+    for (u32 i = 0; i < swapchain->image_count; ++i) {
+        VkImageViewCreateInfo view_info = {VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO};
+        view_info.image = swapchain->images[i];
+        view_info.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        view_info.format = image_format.format;
+        view_info.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        view_info.subresourceRange.levelCount = 1;
+        view_info.subresourceRange.layerCount = 1;
+        if (vkCreateImageView(device->logical_device, &view_info, context->allocator, &swapchain->views[i]) != VK_SUCCESS ||
+            vkCreateSemaphore(device->logical_device, &semaphore_info, context->allocator, &swapchain->render_complete[i]) != VK_SUCCESS) {
+            KERROR("Failed to create the view or semaphore of swapchain image %u.", i);
+            vulkan_swapchain_destroy(context, swapchain);
+            return FALSE;
+        }
+    }
+
+    if (!vulkan_image_create(
+            context,
+            extent.width,
+            extent.height,
+            device->depth_format,
+            VK_IMAGE_TILING_OPTIMAL,
+            VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            VK_IMAGE_ASPECT_DEPTH_BIT,
+            &swapchain->depth_attachment)) {
+        KERROR("Failed to create the depth attachment.");
+        vulkan_swapchain_destroy(context, swapchain);
+        return FALSE;
+    }
+
+    KDEBUG("Swapchain created: %ux%u, %u images, present mode %d.", extent.width, extent.height, swapchain->image_count, present_mode);
+    return TRUE;
+}
+
+void vulkan_swapchain_destroy(vulkan_context* context, vulkan_swapchain* swapchain) {
+    vulkan_swapchain_destroy_images(context, swapchain);
+    if (swapchain->handle) {
+        vkDestroySwapchainKHR(context->device.logical_device, swapchain->handle, context->allocator);
+        swapchain->handle = VK_NULL_HANDLE;
+    }
+}
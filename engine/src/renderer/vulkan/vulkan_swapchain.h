@@ -0,0 +1,30 @@
+#pragma once
+
+/**
+ * @file vulkan_swapchain.h
+ * @brief This file contains the creation of the swapchain and its depth attachment.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "renderer/vulkan/vulkan_types.h"
+
+/**
+ * @brief Creates the swapchain of a context, with a view and a render-complete semaphore per image and a depth attachment.
+ * @details Prefers an 8-bit BGRA sRGB-nonlinear format and MAILBOX presentation (falling back
+ * to FIFO, which is always available). Framebuffers are left to the caller, which owns the
+ * render pass.
+ * @param context A pointer to the Vulkan context.
+ * @param width The width of the window, used when the surface does not dictate the size.
+ * @param height The height of the window, used when the surface does not dictate the size.
+ * @param swapchain A pointer to the swapchain to create. If it holds a swapchain, that one is
+ * handed to the driver for reuse and destroyed.
+ * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+ */
+b8 vulkan_swapchain_create(vulkan_context* context, u32 width, u32 height, vulkan_swapchain* swapchain);
+
+/**
+ * @brief Destroys a swapchain and everything vulkan_swapchain_create made for it. The GPU must be done with it.
+ * @param context A pointer to the Vulkan context.
+ * @param swapchain A pointer to the swapchain.
+ */
+void vulkan_swapchain_destroy(vulkan_context* context, vulkan_swapchain* swapchain);
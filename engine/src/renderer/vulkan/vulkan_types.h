@@ -0,0 +1,382 @@
+#pragma once
+
+/**
+ * @file vulkan_types.h
+ * @brief This file contains the types of the Vulkan renderer backend.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "defines.h"
+#include "core/asserts.h"
+#include "renderer/renderer_types.h"
+
+#include <vulkan/vulkan.h>
+
+/** @brief Asserts that a Vulkan call returned VK_SUCCESS. For calls that can only fail on programmer error or device loss. */
+#define VK_CHECK(expr)                 \
+    {                                  \
+        KASSERT((expr) == VK_SUCCESS); \
+    }
+
+/** @brief The most frames the backend records ahead of the GPU. Matches RENDERER_MAX_FRAMES_IN_FLIGHT. */
+#define VULKAN_MAX_FRAMES_IN_FLIGHT 3
+
+/** @brief The most images a swapchain is created with. */
+#define VULKAN_MAX_SWAPCHAIN_IMAGES 8
+
+/**
+ * @enum vulkan_memory_kind
+ * @brief Which resources may share a device memory block.
+ * @details Buffers and linear images must be kept apart from optimal-tiling images by
+ * bufferImageGranularity. Keeping them in separate blocks avoids padding every suballocation.
+ */
+typedef enum vulkan_memory_kind {
+    /** @brief Buffers and linear-tiling images. */
+    VULKAN_MEMORY_KIND_LINEAR,
+    /** @brief Optimal-tiling images. */
+    VULKAN_MEMORY_KIND_OPTIMAL,
+    /** @brief The number of kinds. */
+    VULKAN_MEMORY_KIND_COUNT
+} vulkan_memory_kind;
+
+/**
+ * @struct vulkan_allocation
+ * @brief A range of device memory handed out by the vulkan_memory_allocator.
+ */
+typedef struct vulkan_allocation {
+    /** @brief The device memory the range is in, shared with other allocations. */
+    VkDeviceMemory memory;
+
+    /** @brief The offset of the range in `memory`, to bind resources at. */
+    VkDeviceSize offset;
+
+    /** @brief The size of the range, at least the requested size. */
+    VkDeviceSize size;
+
+    /** @brief The host address of the range if its memory is host visible, otherwise 0. Mapped for the allocation's whole life. */
+    void* mapped;
+
+    /** @brief The block the range was suballocated from. */
+    struct vulkan_memory_block* block;
+
+    /** @brief The buddy order of the range within its block. */
+    u32 order;
+} vulkan_allocation;
+
+/**
+ * @struct vulkan_memory_allocator
+ * @brief Suballocates device memory from large blocks, so resources never call vkAllocateMemory themselves.
+ * @details There is one pool of blocks per memory type and vulkan_memory_kind. Each block is
+ * split with a buddy allocator. Resources larger than half a block get a block of their own.
+ */
+typedef struct vulkan_memory_allocator {
+    /** @brief The size of a shared block. */
+    VkDeviceSize block_size;
+
+    /** @brief The blocks of each pool, as darrays of block pointers, indexed by memory type * VULKAN_MEMORY_KIND_COUNT + kind. */
+    struct vulkan_memory_block** pools[VK_MAX_MEMORY_TYPES * VULKAN_MEMORY_KIND_COUNT];
+
+    /** @brief The number of live device memory objects. */
+    u32 device_allocation_count;
+
+    /** @brief The total size of the live device memory objects. */
+    VkDeviceSize bytes_reserved;
+
+    /** @brief The total size of the ranges handed out. */
+    VkDeviceSize bytes_in_use;
+} vulkan_memory_allocator;
+
+/**
+ * @struct vulkan_buffer
+ * @brief A buffer bound to suballocated memory.
+ */
+typedef struct vulkan_buffer {
+    /** @brief The buffer handle. */
+    VkBuffer handle;
+
+    /** @brief The size of the buffer. */
+    VkDeviceSize size;
+
+    /** @brief The usage the buffer was created with. */
+    VkBufferUsageFlags usage;
+
+    /** @brief The memory backing the buffer. */
+    vulkan_allocation allocation;
+} vulkan_buffer;
+
+/**
+ * @struct vulkan_image
+ * @brief A 2D image bound to suballocated memory, with a view of it.
+ */
+typedef struct vulkan_image {
+    /** @brief The image handle. */
+    VkImage handle;
+
+    /** @brief A view of the whole image. */
+    VkImageView view;
+
+    /** @brief The format of the image. */
+    VkFormat format;
+
+    /** @brief The width in pixels. */
+    u32 width;
+
+    /** @brief The height in pixels. */
+    u32 height;
+
+    /** @brief The memory backing the image. */
+    vulkan_allocation allocation;
+} vulkan_image;
+
+/**
+ * @struct vulkan_staging_copy
+ * @brief A buffer upload waiting to be recorded into the next frame.
+ */
+typedef struct vulkan_staging_copy {
+    /** @brief The destination buffer. */
+    VkBuffer destination;
+
+    /** @brief The source range in the staging ring and the destination range. */
+    VkBufferCopy region;
+} vulkan_staging_copy;
+
+/**
+ * @struct vulkan_staging_ring
+ * @brief A persistently mapped, host-visible buffer that uploads are written into, used as a ring.
+ * @details Space written during a frame is released once the GPU has finished that frame,
+ * which the backend knows from the frame's fence, so uploads never wait for the GPU unless
+ * the ring is full.
+ */
+typedef struct vulkan_staging_ring {
+    /** @brief The ring buffer. */
+    vulkan_buffer buffer;
+
+    /** @brief The host address of the ring. */
+    u8* mapped;
+
+    /** @brief The offset the next upload is written at. */
+    VkDeviceSize head;
+
+    /** @brief The number of bytes in use, including padding skipped at the end when wrapping. */
+    VkDeviceSize used;
+
+    /** @brief The bytes written since the last vulkan_staging_record, released with the frame that records their copies. */
+    VkDeviceSize pending_bytes;
+
+    /** @brief The bytes released when each frame in flight completes. */
+    VkDeviceSize frame_bytes[VULKAN_MAX_FRAMES_IN_FLIGHT];
+
+    /** @brief The frame being recorded with copies from the ring, whose space stays in use until it completes, or U32 max between frames. */
+    u32 recording_frame;
+
+    /** @brief The copies to record into the next frame, as a darray. */
+    vulkan_staging_copy* pending_copies;
+
+    /** @brief A command pool for the uploads that cannot wait for the next frame. */
+    VkCommandPool immediate_pool;
+} vulkan_staging_ring;
+
+/**
+ * @struct vulkan_swapchain_support_info
+ * @brief What a surface supports on a physical device.
+ */
+typedef struct vulkan_swapchain_support_info {
+    /** @brief The surface capabilities. */
+    VkSurfaceCapabilitiesKHR capabilities;
+
+    /** @brief The number of surface formats. */
+    u32 format_count;
+
+    /** @brief The surface formats. */
+    VkSurfaceFormatKHR* formats;
+
+    /** @brief The number of present modes. */
+    u32 present_mode_count;
+
+    /** @brief The present modes. */
+    VkPresentModeKHR* present_modes;
+} vulkan_swapchain_support_info;
+
+/**
+ * @struct vulkan_device
+ * @brief The physical device in use and the logical device created on it.
+ */
+typedef struct vulkan_device {
+    /** @brief The physical device. */
+    VkPhysicalDevice physical_device;
+
+    /** @brief The logical device. */
+    VkDevice logical_device;
+
+    /** @brief What the surface supports on this device. Refreshed when the swapchain is recreated. */
+    vulkan_swapchain_support_info swapchain_support;
+
+    /** @brief The index of the queue family used for graphics and transfers. */
+    u32 graphics_queue_index;
+
+    /** @brief The index of the queue family used for presenting. */
+    u32 present_queue_index;
+
+    /** @brief The graphics queue. */
+    VkQueue graphics_queue;
+
+    /** @brief The present queue. May be the graphics queue. */
+    VkQueue present_queue;
+
+    /** @brief The properties of the physical device. */
+    VkPhysicalDeviceProperties properties;
+
+    /** @brief The memory heaps and types of the physical device. */
+    VkPhysicalDeviceMemoryProperties memory;
+
+    /** @brief The depth format chosen for depth attachments. */
+    VkFormat depth_format;
+} vulkan_device;
+
+/**
+ * @struct vulkan_swapchain
+ * @brief The swapchain, its images, and the depth attachment drawn alongside them.
+ */
+typedef struct vulkan_swapchain {
+    /** @brief The swapchain handle. */
+    VkSwapchainKHR handle;
+
+    /** @brief The format of the images. */
+    VkSurfaceFormatKHR image_format;
+
+    /** @brief The size of the images. */
+    VkExtent2D extent;
+
+    /** @brief The number of images. */
+    u32 image_count;
+
+    /** @brief The images, owned by the swapchain. */
+    VkImage images[VULKAN_MAX_SWAPCHAIN_IMAGES];
+
+    /** @brief A view of each image. */
+    VkImageView views[VULKAN_MAX_SWAPCHAIN_IMAGES];
+
+    /** @brief A framebuffer per image, for the main render pass. */
+    VkFramebuffer framebuffers[VULKAN_MAX_SWAPCHAIN_IMAGES];
+
+    /**
+     * @brief A semaphore per image, signalled when rendering to it has finished and waited on by present.
+     * Per image rather than per frame, as the presentation engine may hold it past the frame's fence.
+     */
+    VkSemaphore render_complete[VULKAN_MAX_SWAPCHAIN_IMAGES];
+
+    /** @brief The depth attachment, shared by every image. */
+    vulkan_image depth_attachment;
+} vulkan_swapchain;
+
+/**
+ * @struct vulkan_thread_command_pool
+ * @brief The command pool one thread records a frame's secondary command buffers from.
+ * @details Command pools are externally synchronized, so each recording thread has its own
+ * per frame and needs no lock. Cache-line aligned, as neighbours are written by other threads.
+ */
+typedef struct KALIGN(KCACHE_LINE_SIZE) vulkan_thread_command_pool {
+    /** @brief The pool, reset as a whole when the frame starts over. */
+    VkCommandPool handle;
+
+    /** @brief A darray of the secondary command buffers allocated from the pool, reused every time the frame comes round. */
+    VkCommandBuffer* secondaries;
+
+    /** @brief The number of `secondaries` recorded since the pool was last reset. */
+    u32 used;
+} vulkan_thread_command_pool;
+
+/**
+ * @struct vulkan_frame
+ * @brief The resources of one frame in flight, reused every `frames_in_flight` frames.
+ */
+typedef struct vulkan_frame {
+    /** @brief The frame's command pool, reset as a whole when the frame starts over. */
+    VkCommandPool command_pool;
+
+    /** @brief The primary command buffer, allocated once from `command_pool`. */
+    VkCommandBuffer command_buffer;
+
+    /** @brief Signalled when the swapchain image the frame renders to is available. */
+    VkSemaphore image_available;
+
+    /** @brief Signalled when the GPU has finished the frame. */
+    VkFence in_flight;
+
+    /**
+     * @brief The secondary command pools of the frame, one per job system thread plus one
+     * for any other thread recording (e.g. the render thread of pipelined rendering).
+     */
+    vulkan_thread_command_pool* thread_pools;
+} vulkan_frame;
+
+/**
+ * @struct vulkan_context
+ * @brief The state of the Vulkan backend.
+ */
+typedef struct vulkan_context {
+    /** @brief The Vulkan instance. */
+    VkInstance instance;
+
+    /** @brief The host allocation callbacks passed to Vulkan, or 0 for the driver's own. */
+    VkAllocationCallbacks* allocator;
+
+    /** @brief The surface of the window. */
+    VkSurfaceKHR surface;
+
+#if defined(_DEBUG)
+    /** @brief The messenger forwarding validation messages to the logger. */
+    VkDebugUtilsMessengerEXT debug_messenger;
+#endif
+
+    /** @brief The device. */
+    vulkan_device device;
+
+    /** @brief The device memory suballocator. */
+    vulkan_memory_allocator memory;
+
+    /** @brief The staging ring for uploads. */
+    vulkan_staging_ring staging;
+
+    /** @brief The swapchain. */
+    vulkan_swapchain swapchain;
+
+    /** @brief The render pass drawing to the swapchain images. */
+    VkRenderPass main_renderpass;
+
+    /** @brief The pipeline cache every pipeline is created through, persisted between runs. */
+    VkPipelineCache pipeline_cache;
+
+    /** @brief The colour the swapchain images are cleared to. */
+    VkClearColorValue clear_colour;
+
+    /** @brief The number of frames in flight, 2 or 3. */
+    u32 frames_in_flight;
+
+    /** @brief The resources of each frame in flight. */
+    vulkan_frame frames[VULKAN_MAX_FRAMES_IN_FLIGHT];
+
+    /** @brief The number of thread_pools of each frame. */
+    u32 thread_pool_count;
+
+    /** @brief A darray of the secondary command buffers of a parallel recording, in recording order. */
+    VkCommandBuffer* recorded_secondaries;
+
+    /** @brief The index of the frame being recorded, in [0, frames_in_flight). */
+    u32 current_frame;
+
+    /** @brief The index of the swapchain image the current frame renders to. */
+    u32 image_index;
+
+    /** @brief For each swapchain image, the fence of the frame last rendering to it, or VK_NULL_HANDLE. */
+    VkFence images_in_flight[VULKAN_MAX_SWAPCHAIN_IMAGES];
+
+    /** @brief The size of the window, packed as width << 16 | height. Written by any thread, read at the start of each frame. */
+    u32 framebuffer_size;
+
+    /** @brief The framebuffer size the swapchain was last created for, packed the same way. */
+    u32 swapchain_size;
+
+    /** @brief Set when the swapchain must be recreated before the next frame, e.g. after presenting reported it out of date. */
+    b8 recreate_swapchain;
+} vulkan_context;
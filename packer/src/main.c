@@ -0,0 +1,156 @@
+/**
+ * @file main.c
+ * @brief This file contains the entry point of the kpak archive packer.
+ *
+ * @details Usage:
+ *
+ *     packer [-c] [-v] [-a alignment] [-m manifest] -o archive.kpak [files...]
+ *     packer -l archive.kpak
+ *
+ * Every file given on the command line or listed in the manifest (one path per line, blank
+ * lines and lines starting with '#' are skipped) is packed under its path, with backslashes
+ * turned into forward slashes and any leading "./" removed. That path is the name the asset
+ * is found by at runtime. -c compresses assets with LZ4 where worthwhile, -a sets the blob
+ * alignment (default KPAK_DEFAULT_ALIGNMENT) and -l lists and verifies an existing archive.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "packer.h"
+
+#include <containers/darray.h>
+#include <core/kmemory.h>
+#include <core/kpak.h>
+#include <core/logger.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void print_usage() {
+    printf("Usage: packer [-c] [-v] [-a alignment] [-m manifest] -o archive.kpak [files...]\n");
+    printf("       packer -l archive.kpak\n");
+}
+
+/**
+ * @brief Makes a copy of a path to use as an asset name: forward slashes, no leading "./".
+ * @return The name, allocated under MEMORY_TAG_STRING.
+ */
+static char* make_asset_name(const char* path) {
+    while (path[0] == '.' && (path[1] == '/' || path[1] == '\\')) {
+        path += 2;
+    }
+
+    u64 length = strlen(path);
+    char* name = kallocate(length + 1, MEMORY_TAG_STRING);
+    for (u64 i = 0; i < length; ++i) {
+        name[i] = path[i] == '\\' ? '/' : path[i];
+    }
+    return name;
+}
+
+/**
+ * @brief Makes a copy of a string.
+ * @return The copy, allocated under MEMORY_TAG_STRING.
+ */
+static char* copy_string(const char* text) {
+    u64 length = strlen(text);
+    char* copy = kallocate(length + 1, MEMORY_TAG_STRING);
+    kcopy_memory(copy, text, length);
+    return copy;
+}
+
+/**
+ * @brief Appends every path listed in a manifest file to `paths`.
+ * @return `b8 TRUE` on success, `b8 FALSE` if the manifest cannot be read.
+ */
+static b8 read_manifest(const char* manifest_path, char*** paths) {
+    FILE* file = fopen(manifest_path, "r");
+    if (!file) {
+        fprintf(stderr, "packer - unable to open the manifest '%s'.\n", manifest_path);
+        return FALSE;
+    }
+
+    char line[4096];
+    while (fgets(line, sizeof(line), file)) {
+        // Trim the line ending and trailing whitespace.
+        u64 length = strlen(line);
+        while (length > 0 && (line[length - 1] == '\n' || line[length - 1] == '\r' || line[length - 1] == ' ' || line[length - 1] == '\t')) {
+            line[--length] = 0;
+        }
+        if (length == 0 || line[0] == '#') {
+            continue;
+        }
+        char* path = copy_string(line);
+        darray_push(*paths, path);
+    }
+
+    fclose(file);
+    return TRUE;
+}
+
+int main(int argc, char** argv) {
+    packer_config config = {0};
+    config.alignment = KPAK_DEFAULT_ALIGNMENT;
+
+    const char* list_path = 0;
+    const char* manifest_path = 0;
+
+    initialize_memory();
+    initialize_logging();
+
+    // Owned copies, so manifest and command line paths are freed the same way.
+    char** paths = darray_create(char*);
+    b8 valid_arguments = TRUE;
+    for (int i = 1; i < argc; ++i) {
+        b8 has_value = i + 1 < argc;
+        if (strcmp(argv[i], "-c") == 0) {
+            config.compress = TRUE;
+        } else if (strcmp(argv[i], "-v") == 0) {
+            config.verbose = TRUE;
+        } else if (strcmp(argv[i], "-a") == 0 && has_value) {
+            config.alignment = strtoull(argv[++i], 0, 10);
+        } else if (strcmp(argv[i], "-m") == 0 && has_value) {
+            manifest_path = argv[++i];
+        } else if (strcmp(argv[i], "-o") == 0 && has_value) {
+            config.output_path = argv[++i];
+        } else if (strcmp(argv[i], "-l") == 0 && has_value) {
+            list_path = argv[++i];
+        } else if (argv[i][0] == '-') {
+            valid_arguments = FALSE;
+            break;
+        } else {
+            char* path = copy_string(argv[i]);
+            darray_push(paths, path);
+        }
+    }
+
+    b8 success = FALSE;
+    if (!valid_arguments || (!list_path && !config.output_path)) {
+        print_usage();
+    } else if (list_path) {
+        success = packer_list(list_path);
+    } else if (!manifest_path || read_manifest(manifest_path, &paths)) {
+        u32 count = (u32)darray_length(paths);
+        packer_input* inputs = kallocate(sizeof(packer_input) * (count ? count : 1), MEMORY_TAG_APPLICATION);
+        for (u32 i = 0; i < count; ++i) {
+            inputs[i].path = paths[i];
+            inputs[i].name = make_asset_name(paths[i]);
+        }
+
+        success = packer_write(&config, inputs, count);
+
+        for (u32 i = 0; i < count; ++i) {
+            kfree((char*)inputs[i].name, strlen(inputs[i].name) + 1, MEMORY_TAG_STRING);
+        }
+        kfree(inputs, sizeof(packer_input) * (count ? count : 1), MEMORY_TAG_APPLICATION);
+    }
+
+    for (u64 i = 0; i < darray_length(paths); ++i) {
+        kfree(paths[i], strlen(paths[i]) + 1, MEMORY_TAG_STRING);
+    }
+    darray_destroy(paths);
+
+    shutdown_logging();
+    shutdown_memory();
+    return success ? 0 : 1;
+}
@@ -0,0 +1,291 @@
+/**
+ * @file packer.c
+ * @brief This file contains the implementation of the kpak archive writer.
+ * @copyright Copyright (c) 2025
+ */
+
+#include "packer.h"
+
+#include <containers/hashtable.h>
+#include <core/kcompress.h>
+#include <core/kmemory.h>
+#include <core/kpak.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief A compressed blob is only kept if it is at most this fraction of the original
+ * (in 1/16ths), as a few percent are not worth the decompression at load time.
+ */
+#define PACKER_COMPRESSION_THRESHOLD 15
+
+/**
+ * @struct packer_asset
+ * @brief An asset being packed.
+ */
+typedef struct packer_asset {
+    /** @brief The input the asset is read from. */
+    const packer_input* input;
+
+    /** @brief The index entry of the asset. */
+    kpak_entry entry;
+
+    /** @brief The blob to write: the file contents, or their compressed form. */
+    u8* blob;
+
+    /** @brief The size of the `blob` allocation. */
+    u64 blob_capacity;
+} packer_asset;
+
+/** @brief Orders assets by name hash for qsort, then by name so duplicates end up side by side. */
+static int packer_compare_assets(const void* a, const void* b) {
+    const packer_asset* x = a;
+    const packer_asset* y = b;
+    if (x->entry.name_hash != y->entry.name_hash) {
+        return x->entry.name_hash < y->entry.name_hash ? -1 : 1;
+    }
+    return strcmp(x->input->name, y->input->name);
+}
+
+/**
+ * @brief Reads a whole file into a new allocation.
+ * @param path The path of the file.
+ * @param out_size A pointer receiving the size of the file.
+ * @return The contents of the file, to be freed with kfree (MEMORY_TAG_APPLICATION), or 0 on failure.
+ */
+static u8* packer_read_file(const char* path, u64* out_size) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        fprintf(stderr, "packer - unable to open '%s'.\n", path);
+        return 0;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (size < 0) {
+        fprintf(stderr, "packer - unable to get the size of '%s'.\n", path);
+        fclose(file);
+        return 0;
+    }
+
+    // Never zero-sized, so empty files still get a valid allocation.
+    u8* data = kallocate_uninit((u64)size + 1, MEMORY_TAG_APPLICATION);
+    if (fread(data, 1, (u64)size, file) != (u64)size) {
+        fprintf(stderr, "packer - unable to read '%s'.\n", path);
+        kfree(data, (u64)size + 1, MEMORY_TAG_APPLICATION);
+        fclose(file);
+        return 0;
+    }
+
+    fclose(file);
+    *out_size = (u64)size;
+    return data;
+}
+
+/**
+ * @brief Reads an asset and compresses it if that is worth it.
+ * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+ */
+static b8 packer_load_asset(const packer_config* config, packer_asset* asset) {
+    u64 size = 0;
+    u8* data = packer_read_file(asset->input->path, &size);
+    if (!data) {
+        return FALSE;
+    }
+
+    asset->blob = data;
+    asset->blob_capacity = size + 1;
+    asset->entry.size = size;
+    asset->entry.stored_size = size;
+
+    if (config->compress && size > 0) {
+        u64 capacity = kcompress_lz4_bound(size);
+        u8* compressed = kallocate_uninit(capacity, MEMORY_TAG_APPLICATION);
+        u64 compressed_size = kcompress_lz4(data, size, compressed, capacity);
+        if (compressed_size > 0 && compressed_size * 16 <= size * PACKER_COMPRESSION_THRESHOLD) {
+            kfree(data, size + 1, MEMORY_TAG_APPLICATION);
+            asset->blob = compressed;
+            asset->blob_capacity = capacity;
+            asset->entry.stored_size = compressed_size;
+            asset->entry.flags |= KPAK_ENTRY_FLAG_LZ4;
+        } else {
+            kfree(compressed, capacity, MEMORY_TAG_APPLICATION);
+        }
+    }
+
+    return TRUE;
+}
+
+/**
+ * @brief Writes `size` zero bytes, to pad a section to its alignment.
+ */
+static b8 packer_write_padding(FILE* file, u64 size) {
+    static const u8 zeros[256] = {0};
+    while (size > 0) {
+        u64 chunk = size < sizeof(zeros) ? size : sizeof(zeros);
+        if (fwrite(zeros, 1, chunk, file) != chunk) {
+            return FALSE;
+        }
+        size -= chunk;
+    }
+    return TRUE;
+}
+
+b8 packer_write(const packer_config* config, const packer_input* inputs, u32 count) {
+    if (!KIS_POWER_OF_TWO(config->alignment)) {
+        fprintf(stderr, "packer - the alignment must be a power of two (got %llu).\n", config->alignment);
+        return FALSE;
+    }
+
+    b8 success = FALSE;
+    FILE* file = 0;
+    u64 names_size = 0;
+    packer_asset* assets = kallocate(sizeof(packer_asset) * (count ? count : 1), MEMORY_TAG_APPLICATION);
+    u32 loaded = 0;
+    for (; loaded < count; ++loaded) {
+        packer_asset* asset = &assets[loaded];
+        asset->input = &inputs[loaded];
+        u64 name_length = strlen(asset->input->name);
+        asset->entry.name_hash = hashtable_hash(asset->input->name, name_length);
+        asset->entry.name_length = (u32)name_length;
+        names_size += name_length;
+        if (!packer_load_asset(config, asset)) {
+            goto cleanup;
+        }
+    }
+
+    qsort(assets, count, sizeof(packer_asset), packer_compare_assets);
+    for (u32 i = 1; i < count; ++i) {
+        if (strcmp(assets[i - 1].input->name, assets[i].input->name) == 0) {
+            fprintf(stderr, "packer - '%s' is packed more than once.\n", assets[i].input->name);
+            goto cleanup;
+        }
+    }
+
+    // About one bucket per entry keeps lookups at one or two probes.
+    u32 bucket_bits = 0;
+    while (bucket_bits < KPAK_MAX_BUCKET_BITS && (1u << bucket_bits) < count) {
+        bucket_bits++;
+    }
+    u32 bucket_count = 1u << bucket_bits;
+
+    // The index: header, entries, buckets, names. The blobs follow at the alignment.
+    kpak_header header = {0};
+    header.magic = KPAK_MAGIC;
+    header.version = KPAK_VERSION;
+    header.entry_count = count;
+    header.bucket_bits = bucket_bits;
+    header.alignment = config->alignment;
+    header.entries_offset = sizeof(kpak_header);
+    header.buckets_offset = header.entries_offset + (u64)count * sizeof(kpak_entry);
+    header.names_offset = header.buckets_offset + ((u64)bucket_count + 1) * sizeof(u32);
+    header.names_size = names_size;
+
+    u64 offset = KALIGN_UP(header.names_offset + names_size, config->alignment);
+    u64 name_offset = 0;
+    for (u32 i = 0; i < count; ++i) {
+        assets[i].entry.offset = offset;
+        assets[i].entry.name_offset = (u32)name_offset;
+        name_offset += assets[i].entry.name_length;
+        offset = KALIGN_UP(offset + assets[i].entry.stored_size, config->alignment);
+    }
+    // No padding after the last blob.
+    header.file_size = count ? assets[count - 1].entry.offset + assets[count - 1].entry.stored_size : header.names_offset + names_size;
+
+    // buckets[b] is the first entry whose bucket is at least b.
+    u32* buckets = kallocate(sizeof(u32) * ((u64)bucket_count + 1), MEMORY_TAG_APPLICATION);
+    u32 entry_index = 0;
+    for (u32 b = 0; b <= bucket_count; ++b) {
+        while (entry_index < count && kpak_bucket(assets[entry_index].entry.name_hash, bucket_bits) < b) {
+            entry_index++;
+        }
+        buckets[b] = entry_index;
+    }
+
+    file = fopen(config->output_path, "wb");
+    if (!file) {
+        fprintf(stderr, "packer - unable to create '%s'.\n", config->output_path);
+        kfree(buckets, sizeof(u32) * ((u64)bucket_count + 1), MEMORY_TAG_APPLICATION);
+        goto cleanup;
+    }
+
+    b8 written = fwrite(&header, sizeof(header), 1, file) == 1;
+    for (u32 i = 0; written && i < count; ++i) {
+        written = fwrite(&assets[i].entry, sizeof(kpak_entry), 1, file) == 1;
+    }
+    written = written && fwrite(buckets, sizeof(u32), (u64)bucket_count + 1, file) == (u64)bucket_count + 1;
+    for (u32 i = 0; written && i < count; ++i) {
+        written = fwrite(assets[i].input->name, 1, assets[i].entry.name_length, file) == assets[i].entry.name_length;
+    }
+
+    u64 position = header.names_offset + names_size;
+    for (u32 i = 0; written && i < count; ++i) {
+        const packer_asset* asset = &assets[i];
+        written = packer_write_padding(file, asset->entry.offset - position) &&
+                  fwrite(asset->blob, 1, asset->entry.stored_size, file) == asset->entry.stored_size;
+        position = asset->entry.offset + asset->entry.stored_size;
+
+        if (config->verbose) {
+            printf("%-48s %12llu -> %12llu%s\n", asset->input->name, asset->entry.size, asset->entry.stored_size,
+                   (asset->entry.flags & KPAK_ENTRY_FLAG_LZ4) ? " lz4" : "");
+        }
+    }
+    kfree(buckets, sizeof(u32) * ((u64)bucket_count + 1), MEMORY_TAG_APPLICATION);
+
+    if (fclose(file) != 0 || !written) {
+        fprintf(stderr, "packer - unable to write '%s'.\n", config->output_path);
+        goto cleanup;
+    }
+
+    printf("Packed %u assets into '%s' (%llu bytes).\n", count, config->output_path, header.file_size);
+    success = TRUE;
+
+cleanup:
+    for (u32 i = 0; i < loaded; ++i) {
+        kfree(assets[i].blob, assets[i].blob_capacity, MEMORY_TAG_APPLICATION);
+    }
+    kfree(assets, sizeof(packer_asset) * (count ? count : 1), MEMORY_TAG_APPLICATION);
+    return success;
+}
+
+b8 packer_list(const char* path) {
+    kpak pak;
+    if (!kpak_open(path, &pak)) {
+        return FALSE;
+    }
+
+    b8 success = TRUE;
+    u64 total_size = 0;
+    u64 total_stored = 0;
+    for (u32 i = 0; i < kpak_count(&pak); ++i) {
+        kpak_asset asset;
+        kpak_get(&pak, i, &asset);
+
+        // Decode every compressed asset, so listing doubles as an integrity check.
+        b8 valid = TRUE;
+        if (asset.is_compressed) {
+            void* buffer = kallocate_uninit(asset.size + 1, MEMORY_TAG_APPLICATION);
+            valid = kpak_read(&asset, buffer, asset.size);
+            kfree(buffer, asset.size + 1, MEMORY_TAG_APPLICATION);
+        }
+
+        // Lookups by name must find the very same entry.
+        char name[1024];
+        kpak_asset found;
+        snprintf(name, sizeof(name), "%.*s", asset.name_length, asset.name);
+        valid = valid && kpak_find(&pak, name, &found) && found.data == asset.data;
+
+        printf("%-48s %12llu -> %12llu%s%s\n", name, asset.size, asset.stored_size, asset.is_compressed ? " lz4" : "",
+               valid ? "" : " CORRUPT");
+        success = success && valid;
+        total_size += asset.size;
+        total_stored += asset.stored_size;
+    }
+    printf("%u assets, %llu bytes stored as %llu.\n", kpak_count(&pak), total_size, total_stored);
+
+    kpak_close(&pak);
+    return success;
+}
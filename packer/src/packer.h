@@ -0,0 +1,61 @@
+#pragma once
+
+/**
+ * @file packer.h
+ * @brief This file contains the declarations for the kpak archive writer.
+ *
+ * @details The packer reads every input file, optionally compresses it with LZ4, and writes
+ * the archive in a single pass: the index first (sorted by name hash, with its bucket table),
+ * then the blobs, each padded to the archive's alignment. See core/kpak.h for the format.
+ * @copyright Copyright (c) 2025
+ */
+
+#include <defines.h>
+
+/**
+ * @struct packer_config
+ * @brief Options for writing an archive.
+ */
+typedef struct packer_config {
+    /** @brief The path of the archive to write. */
+    const char* output_path;
+
+    /** @brief The alignment of every blob. Must be a power of two. */
+    u64 alignment;
+
+    /** @brief If TRUE, assets are LZ4-compressed when that saves enough space to be worth decompressing. */
+    b8 compress;
+
+    /** @brief If TRUE, every packed asset is printed. */
+    b8 verbose;
+} packer_config;
+
+/**
+ * @struct packer_input
+ * @brief A file to pack.
+ */
+typedef struct packer_input {
+    /** @brief The path to read the file from. */
+    const char* path;
+
+    /** @brief The name the asset is looked up by at runtime. */
+    const char* name;
+} packer_input;
+
+
+/**
+ * @brief Writes an archive.
+ * @param config The options for the archive.
+ * @param inputs An array of `count` files to pack.
+ * @param count The number of files in `inputs`.
+ * @return `b8 TRUE` on success, otherwise `b8 FALSE`. Fails on unreadable files and duplicate names.
+ */
+b8 packer_write(const packer_config* config, const packer_input* inputs, u32 count);
+
+
+/**
+ * @brief Prints the contents of an archive, reading it with the engine's runtime reader.
+ * @param path The path of the archive.
+ * @return `b8 TRUE` if the archive is valid and every asset decodes, otherwise `b8 FALSE`.
+ */
+b8 packer_list(const char* path);
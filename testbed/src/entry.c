@@ -16,6 +16,13 @@
 // TODO: Remove this
 #include <platform/platform.h>
 
+/**
+ * @brief Runs the testbed with pipelined rendering: frame N is updated while the render thread renders N-1.
+ * Define it to 0 on the command line to render on the main thread instead.
+ */
+#ifndef TESTBED_PIPELINED_RENDERING
+    #define TESTBED_PIPELINED_RENDERING 1
+#endif
 
 
 /**
@@ -34,12 +41,25 @@ b8 create_game(game* out_game) {
     // The name is a `char*`, a standard C-style (ANSI) string for maximum portability.
     out_game->app_config.name = "Kaffi Engine Testbed";
 
+    // Cap the frame rate so the testbed does not spin a full core. Use a variable timestep.
+    out_game->app_config.target_fps = 60;
+    out_game->app_config.fixed_update_rate = 0;
+
     // Assign the game's lifecycle functions to the engine's function pointers.
     out_game->update = game_update;
     out_game->render = game_render;
     out_game->initilize = game_initialize;
     out_game->on_resize = game_on_resize;
 
+    // The frame packet API used when pipelined rendering is enabled.
+    out_game->app_config.pipelined_rendering = TESTBED_PIPELINED_RENDERING;
+    out_game->frame_packet_size = sizeof(game_frame_packet);
+    out_game->write_frame_packet = game_write_frame_packet;
+    out_game->render_frame_packet = game_render_frame_packet;
+
+    // Double buffering: the CPU records one frame while the GPU draws the previous one.
+    out_game->app_config.frames_in_flight = 2;
+
     // Allocate memory for the game's state.
     // This is the only state the game itself needs to manage
     out_game->state = kallocate(sizeof(game_state), MEMORY_TAG_GAME);
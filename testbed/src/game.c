@@ -12,6 +12,11 @@
 #include "game.h"
 
 #include <core/logger.h>
+#include <core/input.h>
+#include <core/event.h>
+
+/** @brief The number of frames between two "rendered frame" debug logs. */
+#define GAME_RENDER_LOG_INTERVAL 300
 
 
 /**
@@ -36,6 +41,17 @@ b8 game_initialize(game* game_inst) {
  */
 b8 game_update(game* game_inst, f32 delta_time) {
     // This is the main game logic update loop.
+    game_state* state = (game_state*)game_inst->state;
+    state->delta_time = delta_time;
+    state->elapsed_time += delta_time;
+    state->frame_number++;
+
+    // Escape quits. Edge-triggered, so it fires once per press.
+    if (input_was_key_pressed(KEY_ESCAPE)) {
+        event quit_event = {0};
+        quit_event.code = EVENT_CODE_APPLICATION_QUIT;
+        event_post(&quit_event);
+    }
     return TRUE;
 }
 
@@ -47,8 +63,12 @@ b8 game_update(game* game_inst, f32 delta_time) {
  * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
  */
 b8 game_render(game* game_inst, f32 delta_time) {
-    // This is the main game rendering loop.
-    return TRUE;
+    // Without pipelining the packet is written and rendered right away, so both paths render the same way.
+    game_frame_packet packet;
+    if (!game_write_frame_packet(game_inst, &packet)) {
+        return FALSE;
+    }
+    return game_render_frame_packet(game_inst, &packet, delta_time);
 }
 
 
@@ -62,3 +82,47 @@ b8 game_render(game* game_inst, f32 delta_time) {
 void game_on_resize(game* game_inst, u32 width, u32 height) {
     // This function handles window resize events.
 }
+
+
+/**
+ * @brief Copies the state rendering needs into a frame packet.
+ * @param game_inst A pointer to the game instance.
+ * @param packet A pointer to the game_frame_packet to fill out. `void*` keeps the engine's interface game-agnostic.
+ * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+ */
+b8 game_write_frame_packet(game* game_inst, void* packet) {
+    game_state* state = (game_state*)game_inst->state;
+    game_frame_packet* frame_packet = (game_frame_packet*)packet;
+    frame_packet->delta_time = state->delta_time;
+    frame_packet->elapsed_time = state->elapsed_time;
+    frame_packet->frame_number = state->frame_number;
+    return TRUE;
+}
+
+
+/**
+ * @brief Renders a frame packet. Runs on the render thread, so it only reads the packet.
+ * @param game_inst A pointer to the game instance.
+ * @param packet A pointer to the game_frame_packet to render.
+ * @param delta_time The delta time of the frame the packet was written in.
+ * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+ */
+b8 game_render_frame_packet(game* game_inst, const void* packet, f32 delta_time) {
+    game_state* state = (game_state*)game_inst->state;
+    const game_frame_packet* frame_packet = (const game_frame_packet*)packet;
+
+    // Packets are written once per update and must be rendered in that order, none skipped.
+    if (frame_packet->frame_number <= state->rendered_frame_number) {
+        KERROR("game_render_frame_packet - frame %llu rendered after frame %llu.", frame_packet->frame_number, state->rendered_frame_number);
+        return FALSE;
+    }
+    if (frame_packet->frame_number != state->rendered_frame_number + 1) {
+        KWARN("game_render_frame_packet - frames %llu to %llu were never rendered.", state->rendered_frame_number + 1, frame_packet->frame_number - 1);
+    }
+    state->rendered_frame_number = frame_packet->frame_number;
+
+    if (frame_packet->frame_number % GAME_RENDER_LOG_INTERVAL == 0) {
+        KDEBUG("Rendered frame %llu at %.2fs of game time.", frame_packet->frame_number, frame_packet->elapsed_time);
+    }
+    return TRUE;
+}
@@ -27,8 +27,36 @@ typedef struct game_state {
      */
     f32 delta_time;
 
+    /** @brief The game time in seconds, summed from the delta times of every update. */
+    f64 elapsed_time;
+
+    /** @brief The number of updates so far. Each frame packet carries the value it was written at. */
+    u64 frame_number;
+
+    /** @brief The frame number of the last rendered packet.
+     * Only touched by the thread that renders (the render thread when pipelined), never by update.
+     */
+    u64 rendered_frame_number;
+
 } game_state;
 
+
+/**
+ * @struct game_frame_packet
+ * @brief The snapshot of game state handed to the render thread when pipelined rendering is enabled.
+ * Everything rendering needs is copied in here, so the render thread never reads game_state.
+ */
+typedef struct game_frame_packet {
+    /** @brief The delta time of the update that produced this packet. */
+    f32 delta_time;
+
+    /** @brief The game time at the update that produced this packet. */
+    f64 elapsed_time;
+
+    /** @brief The number of the update that produced this packet. Rendering checks they arrive in order. */
+    u64 frame_number;
+} game_frame_packet;
+
 /**
  * @brief Initializes the game state.
  * @param game_inst A pointer to the game instance. `game*` is used to allow this
@@ -65,3 +93,22 @@ b8 game_render(game* game_inst, f32 delta_time);
  * @param height The new height of the window in pixels. `u32` is used for the same reason.
  */
 void game_on_resize(game* game_inst, u32 width, u32 height);
+
+
+/**
+ * @brief Copies the state rendering needs into a frame packet. Used with pipelined rendering.
+ * @param game_inst A pointer to the game instance.
+ * @param packet A pointer to the game_frame_packet to fill out.
+ * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+ */
+b8 game_write_frame_packet(game* game_inst, void* packet);
+
+
+/**
+ * @brief Renders a frame packet on the render thread. Used with pipelined rendering.
+ * @param game_inst A pointer to the game instance.
+ * @param packet A pointer to the game_frame_packet to render.
+ * @param delta_time The delta time of the frame the packet was written in.
+ * @return `b8 TRUE` on success, otherwise `b8 FALSE`.
+ */
+b8 game_render_frame_packet(game* game_inst, const void* packet, f32 delta_time);